@@ -1,6 +1,9 @@
 #include "AutoInterface.h"
 #include <microReticulum/Log.h>
 #include <microReticulum/Utilities/OS.h>
+#include <Instrumentation/AllocTrace.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
 #include <cstring>
 #include <algorithm>
@@ -13,8 +16,14 @@
 #include <lwip/mld6.h>
 #include <lwip/netif.h>
 #include <errno.h>
+// VFS eventfd; the VFS select() waits on it and lwIP sockets together
+#include <esp_vfs_eventfd.h>
+#include <sys/select.h>
+#include <unistd.h>
 #else
 #include <sys/ioctl.h>
+#include <sys/select.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <netdb.h>
 #include <arpa/inet.h>
@@ -23,9 +32,32 @@
 #include <net/if.h>
 #include <ifaddrs.h>
 #include <fcntl.h>
+#include <chrono>
 #endif
 
 using namespace RNS;
+using namespace RNS::Instrumentation;
+
+static void sleep_ms(uint32_t ms) {
+#ifdef ARDUINO
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+static int create_wake_fd() {
+#ifdef ARDUINO
+    // Registering twice (TCPClientInterface got there first, or start()
+    // after stop()) is fine
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_err_t err = esp_vfs_eventfd_register(&config);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return -1;
+    }
+#endif
+    return eventfd(0, 0);
+}
 
 // Helper: Convert IPv6 address bytes to compressed string format (RFC 5952)
 // This matches Python's inet_ntop output
@@ -87,11 +119,24 @@ AutoInterface::AutoInterface(const char* name) : InterfaceImpl(name) {
 
 AutoInterface::~AutoInterface() {
     stop();
+    if (_wake_fd >= 0) {
+        close(_wake_fd);
+        _wake_fd = -1;
+    }
 }
 
 bool AutoInterface::start() {
+    if (_task_running) {
+        return true;
+    }
     _online = false;
 
+    _peers_full_warned = false;
+    if (!_peers.init(_max_peers)) {
+        ERROR("AutoInterface: Could not allocate peer table for " + std::to_string(_max_peers) + " peers");
+        return false;
+    }
+
     INFO("AutoInterface: Starting with group_id: " + _group_id);
     INFO("AutoInterface: Discovery port: " + std::to_string(_discovery_port));
     INFO("AutoInterface: Data port: " + std::to_string(_data_port));
@@ -138,8 +183,6 @@ bool AutoInterface::start() {
     INFO("AutoInterface: Multicast address: " + _multicast_address_str);
     INFO("AutoInterface: Link-local address: " + _link_local_address_str);
     INFO("AutoInterface: Discovery token: " + _discovery_token.toHex());
-
-    return true;
 #else
     // Get link-local address for our interface
     if (!get_link_local_address()) {
@@ -181,12 +224,19 @@ bool AutoInterface::start() {
         (char*)_buffer.writable(INET6_ADDRSTRLEN), INET6_ADDRSTRLEN)));
     INFO("AutoInterface: Link-local address: " + _link_local_address_str);
     INFO("AutoInterface: Discovery token: " + _discovery_token.toHex());
+#endif
 
+    // Last, so nothing above races the task over the sockets or addresses
+    if (_socket_task && !start_task()) {
+        WARNING("AutoInterface: Socket task unavailable, polling from loop()");
+    }
     return true;
-#endif
 }
 
 void AutoInterface::stop() {
+    // The task owns the sockets while it runs: join it before closing them
+    stop_task();
+
 #ifdef ARDUINO
     // ESP32 cleanup - raw sockets for discovery, unicast discovery, and data
     if (_discovery_socket > -1) {
@@ -218,13 +268,23 @@ void AutoInterface::stop() {
 #endif
     _online = false;
     _peers.clear();
+    _peer_count = 0;
+    _peers_changed = true;
 }
 
 void AutoInterface::loop() {
     if (!_online) return;
 
-    double now = RNS::Utilities::OS::time();
+    if (_task_running) {
+        deliver_rx_packets();
+        return;
+    }
+    service(RNS::Utilities::OS::time());
+}
 
+// One pass of socket and timer work. Runs on whichever thread owns the
+// sockets: the main loop, or auto_task when it runs.
+void AutoInterface::service(double now) {
     // Send periodic discovery announce
     if (now - _last_announce >= ANNOUNCE_INTERVAL) {
 #ifdef ARDUINO
@@ -233,6 +293,7 @@ void AutoInterface::loop() {
         uint32_t max_block = ESP.getMaxAllocHeap();
         if (max_block < 8000) {
             WARNING("AutoInterface: Skipping announce - low memory (max_block=" + std::to_string(max_block) + ")");
+            ALLOC_TRACE_MARK(RNS::Instrumentation::ALLOC_TRACE_MARK_ANNOUNCE_SKIPPED);
             _last_announce = now;  // Still update timer to avoid tight loop
         } else {
             send_announce();
@@ -256,21 +317,26 @@ void AutoInterface::loop() {
     // Process incoming data packets
     process_data();
 
+    Metrics::set(METRIC_AUTO_PEERS, static_cast<int32_t>(_peers.size()));
+    _peer_count.store(_peers.size());
+
     // Periodic stats heartbeat — visibility into TX/RX during peer
     // discovery debugging. Without this it's hard to tell whether
     // pyxis is sending at all, sending and getting blocked at the
     // AP, or sending fine but rejecting the responses.
     if (now - _last_stats_log >= 10.0) {
         _last_stats_log = now;
-        char buf[160];
+        char buf[192];
         snprintf(buf, sizeof(buf),
-                 "AutoInterface: stats announce_tx=%lu tx_fail=%lu disc_rx=%lu disc_self=%lu data_rx=%lu peers=%u",
-                 (unsigned long)_stat_announce_sent,
-                 (unsigned long)_stat_announce_send_fail,
-                 (unsigned long)_stat_discovery_rx,
-                 (unsigned long)_stat_discovery_rx_self,
-                 (unsigned long)_stat_data_rx,
-                 (unsigned)_peers.size());
+                 "AutoInterface: stats announce_tx=%lu tx_fail=%lu disc_rx=%lu disc_self=%lu data_rx=%lu peers=%u evictions=%lu",
+                 (unsigned long)Metrics::counter(METRIC_AUTO_ANNOUNCE_TX),
+                 (unsigned long)Metrics::counter(METRIC_AUTO_ANNOUNCE_TX_FAIL),
+                 (unsigned long)Metrics::counter(METRIC_AUTO_DISCOVERY_RX),
+                 (unsigned long)Metrics::counter(METRIC_AUTO_DISCOVERY_RX_SELF),
+                 (unsigned long)(Metrics::counter(METRIC_AUTO_RX_PACKETS) +
+                                 Metrics::counter(METRIC_AUTO_RX_DROPS)),
+                 (unsigned)_peers.size(),
+                 (unsigned long)Metrics::counter(METRIC_AUTO_PEER_EVICTIONS));
         INFO(buf);
     }
 
@@ -281,7 +347,7 @@ void AutoInterface::loop() {
     expire_stale_peers();
 
     // Expire old deque entries
-    expire_deque_entries();
+    _packet_deque.expire(now);
 
     // Periodic peer job (every 4 seconds) - check for address changes
     if (now - _last_peer_job >= PEER_JOB_INTERVAL) {
@@ -291,72 +357,316 @@ void AutoInterface::loop() {
 }
 
 bool AutoInterface::send_outgoing(const Bytes& data) {
+    EVENT_TRACE_SCOPE_V(AUTO_TX, data.size());
     DEBUG(toString() + ".send_outgoing: data: " + data.toHex());
 
-    if (!_online) return false;
+    if (!_online) {
+        Metrics::add(METRIC_AUTO_TX_DROPS);
+        return false;
+    }
 
-#ifdef ARDUINO
-    // ESP32: Send to all known peers via unicast using persistent raw IPv6 socket
-    // (WiFiUDP doesn't support IPv6)
+    if (_task_running) {
+        // auto_task fans it out; the main loop never waits on the sockets
+        if (!_tx_packets->push(data.data(), data.size())) {
+            Metrics::add(METRIC_AUTO_TX_DROPS);
+            return false;
+        }
+        wake_task();
+    } else if (!send_to_peers(data.data(), data.size())) {
+        return false;
+    }
+
+    // Perform post-send housekeeping
+    InterfaceImpl::handle_outgoing(data);
+    return true;
+}
+
+// Unicast to every known peer on the data socket (on ESP32 a raw lwIP IPv6
+// socket; WiFiUDP doesn't support IPv6). Socket owner only.
+bool AutoInterface::send_to_peers(const uint8_t* data, size_t len) {
     if (_data_socket < 0) {
         WARNING("AutoInterface: Data socket not ready, cannot send");
+        Metrics::add(METRIC_AUTO_TX_DROPS);
         return false;
     }
 
-    for (const auto& peer : _peers) {
-        if (peer.is_local) continue;  // Don't send to ourselves
-
-        struct sockaddr_in6 peer_addr;
-        memset(&peer_addr, 0, sizeof(peer_addr));
-        peer_addr.sin6_family = AF_INET6;
-        peer_addr.sin6_port = htons(_data_port);
-        peer_addr.sin6_scope_id = _if_index;
+    if (_peers_changed) rebuild_fanout();
+    size_t failed = 0;
+    int send_errno = 0;
+    size_t sent = _fanout.send(_data_socket, data, len, &failed, &send_errno);
+    if (sent > 0) {
+        Metrics::add(METRIC_AUTO_TX_PACKETS, static_cast<uint32_t>(sent));
+        Metrics::add(METRIC_AUTO_TX_BYTES, static_cast<uint32_t>(sent * len));
+        TRACE("AutoInterface: Sent " + std::to_string(len) + " bytes to " +
+              std::to_string(sent) + " peers");
+    }
+    if (failed > 0) {
+        Metrics::add(METRIC_AUTO_TX_DROPS, static_cast<uint32_t>(failed));
+        WARNING("AutoInterface: Failed to send to " + std::to_string(failed) + " of " +
+                std::to_string(_fanout.size()) + " peers: " + std::string(strerror(send_errno)));
+    }
+    return true;
+}
 
-        // Copy IPv6 address from peer (IPv6Address stores 16 bytes)
+void AutoInterface::rebuild_fanout() {
+    _fanout.clear();
+    _peers.for_each([this](const AutoInterfacePeer& peer) {
+        if (peer.is_local) return;  // Don't send to ourselves
+#ifdef ARDUINO
+        // IPv6Address stores 16 bytes, network order
+        uint8_t addr[16];
         for (int i = 0; i < 16; i++) {
-            ((uint8_t*)&peer_addr.sin6_addr)[i] = peer.address[i];
+            addr[i] = peer.address[i];
+        }
+#else
+        const uint8_t* addr = reinterpret_cast<const uint8_t*>(&peer.address);
+#endif
+        _fanout.add(addr, _data_port, _if_index);
+    });
+    _peers_changed = false;
+}
+
+void AutoInterface::process_data() {
+    if (_data_socket < 0) return;
+
+    // Drain at most RX_BUDGET datagrams per loop(); the rest wait in the
+    // socket buffer so a flood can't starve the rest of the main loop
+    size_t budget = RX_BUDGET;
+    while (budget > 0) {
+        // On auto_task, only read what _rx_packets can take; until loop()
+        // drains it the rest wait in the socket buffer and select() leaves
+        // the data socket alone
+        size_t want = budget;
+        if (_rx_packets) {
+            size_t room = rx_room();
+            if (room == 0) {
+                _rx_paused.store(true);
+                break;
+            }
+            if (want > room) want = room;
         }
+        size_t count = _rx_batch.receive(_data_socket, want);
+        if (count == 0) break;
+        budget -= count;
+        uint32_t rx_us = Metrics::nowUs();
+
+        for (size_t i = 0; i < count; i++) {
+            size_t len = _rx_batch.length(i);
+            _buffer.clear();
+            _buffer.append(_rx_batch.data(i), len);
+
+            // Check for duplicates (multi-interface deduplication)
+            if (is_duplicate(_buffer)) {
+                TRACE("AutoInterface: Dropping duplicate packet");
+                Metrics::add(METRIC_AUTO_RX_DROPS);
+                continue;
+            }
 
-        ssize_t sent = sendto(_data_socket, data.data(), data.size(), 0,
-                              (struct sockaddr*)&peer_addr, sizeof(peer_addr));
-        if (sent < 0) {
-            WARNING("AutoInterface: Failed to send to peer " + peer.address_string() +
-                    " errno=" + std::to_string(errno));
-        } else {
-            INFO("AutoInterface: Sent " + std::to_string(sent) + " bytes to " + peer.address_string() +
-                 " port " + std::to_string(_data_port));
+            DEBUG("AutoInterface: Received data from " +
+                  ipv6_to_compressed_string((const uint8_t*)&_rx_batch.source(i).sin6_addr) +
+                  " (" + std::to_string(len) + " bytes)");
+
+            if (_rx_packets) {
+                // loop() passes it to transport; the batch was sized to the
+                // free slots
+                if (!_rx_packets->push(_rx_batch.data(i), len, rx_us)) {
+                    Metrics::add(METRIC_AUTO_RX_DROPS);
+                }
+                continue;
+            }
+
+            // Pass to transport
+            {
+                EVENT_TRACE_SCOPE_V(AUTO_RX, _buffer.size());
+                InterfaceImpl::handle_incoming(_buffer);
+            }
+            Metrics::add(METRIC_AUTO_RX_PACKETS);
+            Metrics::add(METRIC_AUTO_RX_BYTES, static_cast<uint32_t>(len));
+            Metrics::observeSince(METRIC_AUTO_RX_LATENCY, rx_us);
         }
     }
+}
 
-    // Perform post-send housekeeping
-    InterfaceImpl::handle_outgoing(data);
-    return true;
-#else
-    // POSIX: Send to all known peers via unicast
-    for (const auto& peer : _peers) {
-        if (peer.is_local) continue;  // Don't send to ourselves
-
-        struct sockaddr_in6 peer_addr;
-        memset(&peer_addr, 0, sizeof(peer_addr));
-        peer_addr.sin6_family = AF_INET6;
-        peer_addr.sin6_port = htons(_data_port);
-        peer_addr.sin6_addr = peer.address;
-        peer_addr.sin6_scope_id = _if_index;
-
-        ssize_t sent = sendto(_data_socket, data.data(), data.size(), 0,
-                              (struct sockaddr*)&peer_addr, sizeof(peer_addr));
-        if (sent < 0) {
-            WARNING("AutoInterface: Failed to send to peer " + peer.address_string() +
-                    ": " + std::string(strerror(errno)));
-        } else {
-            TRACE("AutoInterface: Sent " + std::to_string(sent) + " bytes to " + peer.address_string());
+// ============================================================================
+// Platform-independent: socket task
+// ============================================================================
+
+bool AutoInterface::start_task() {
+    if (!_rx_packets) {
+        _rx_packets.reset(new RNS::SPSCPacketQueue(RX_PACKET_SLOTS, HW_MTU));
+        _tx_packets.reset(new RNS::SPSCPacketQueue(TX_PACKET_SLOTS, HW_MTU));
+    }
+    if (!_rx_packets->valid() || !_tx_packets->valid()) {
+        ERROR("AutoInterface: Failed to allocate packet queues");
+        _rx_packets.reset();
+        _tx_packets.reset();
+        return false;
+    }
+    if (_wake_fd < 0) {
+        _wake_fd = create_wake_fd();
+        if (_wake_fd < 0) {
+            ERROR("AutoInterface: Failed to create wake eventfd");
+            _rx_packets.reset();
+            _tx_packets.reset();
+            return false;
         }
     }
 
-    // Perform post-send housekeeping
-    InterfaceImpl::handle_outgoing(data);
+    _task_running = true;
+#ifdef ARDUINO
+    _task_done = false;
+    BaseType_t r = xTaskCreatePinnedToCore(auto_task, "auto", 6144, this, 1, &_task_handle, 0);
+    if (r != pdPASS) {
+        ERROR("AutoInterface: Failed to create socket task");
+        _task_running = false;
+        _rx_packets.reset();
+        _tx_packets.reset();
+        return false;
+    }
+#else
+    _task_thread = std::thread([this]() { task_loop(); });
+#endif
+    INFO("AutoInterface: socket task running");
     return true;
+}
+
+void AutoInterface::stop_task() {
+    _task_running = false;
+    wake_task();
+#ifdef ARDUINO
+    // Wait for the task to leave task_loop() and set _task_done; after that
+    // it only calls vTaskDelete(nullptr) and never touches `this` again.
+    // Nothing on the task blocks for long, so the deadline is generous.
+    if (_task_handle != nullptr) {
+        uint32_t deadline = millis() + 5000;
+        while (!_task_done && (int32_t)(millis() - deadline) < 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+        if (!_task_done) {
+            vTaskDelete(_task_handle);
+        }
+        _task_handle = nullptr;
+    }
+#else
+    if (_task_thread.joinable()) {
+        _task_thread.join();
+    }
 #endif
+    // The task is gone; both ends of the queues are ours now
+    if (_rx_packets) {
+        _rx_packets->reset();
+        _tx_packets->reset();
+    }
+    _rx_paused = false;
+}
+
+void AutoInterface::wake_task() {
+    if (_wake_fd >= 0) {
+        uint64_t one = 1;
+        (void)!write(_wake_fd, &one, sizeof(one));
+    }
+}
+
+#ifdef ARDUINO
+/*static*/ void AutoInterface::auto_task(void* arg) {
+    auto* self = static_cast<AutoInterface*>(arg);
+    self->task_loop();
+    self->_task_done = true;   // let stop() join before the object is freed
+    vTaskDelete(nullptr);
+}
+#endif
+
+// Owns the sockets: waits in select() for a datagram on any of them, an
+// outgoing packet or stop(), then runs the same service() pass loop() runs
+// without the task. The wait ends at the next announce at the latest, and
+// the slower timers (reverse peering, echo timeout, expiry, peer job) are
+// checked at least every TASK_TICK.
+void AutoInterface::task_loop() {
+    while (_task_running) {
+        double timeout = _last_announce + ANNOUNCE_INTERVAL - RNS::Utilities::OS::time();
+        if (timeout > TASK_TICK) timeout = TASK_TICK;
+        wait_for_sockets(timeout);
+        if (!_task_running) break;
+        drain_tx_packets();
+        service(RNS::Utilities::OS::time());
+    }
+}
+
+void AutoInterface::wait_for_sockets(double timeout) {
+    // Re-check: loop() wakes us if it drains in between
+    if (_rx_paused.load() && rx_room() > 0) {
+        _rx_paused.store(false);
+    }
+
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(_wake_fd, &read_fds);
+    int max_fd = _wake_fd;
+    int sockets[3] = {_discovery_socket, _unicast_discovery_socket,
+                      _rx_paused.load() ? -1 : _data_socket};
+    for (int fd : sockets) {
+        if (fd < 0) continue;
+        FD_SET(fd, &read_fds);
+        if (fd > max_fd) max_fd = fd;
+    }
+
+    if (timeout < 0) timeout = 0;
+    struct timeval tv;
+    tv.tv_sec = static_cast<long>(timeout);
+    tv.tv_usec = static_cast<long>((timeout - tv.tv_sec) * 1000000);
+    int ready = select(max_fd + 1, &read_fds, nullptr, nullptr, &tv);
+    if (ready < 0) {
+        if (errno != EINTR) {
+            WARNING("AutoInterface: select error " + std::to_string(errno));
+            sleep_ms(static_cast<uint32_t>(TASK_TICK * 1000));   // don't spin on a bad socket
+        }
+        return;
+    }
+    if (ready > 0 && FD_ISSET(_wake_fd, &read_fds)) {
+        uint64_t count;
+        (void)!read(_wake_fd, &count, sizeof(count));
+    }
+}
+
+// Free _rx_packets slots (exact on auto_task, a lower bound on the main loop)
+size_t AutoInterface::rx_room() const {
+    return RX_PACKET_SLOTS - _rx_packets->size();
+}
+
+// auto_task: fan out the packets send_outgoing() queued
+void AutoInterface::drain_tx_packets() {
+    const uint8_t* data;
+    size_t len;
+    while (_tx_packets->front(&data, &len)) {
+        send_to_peers(data, len);
+        _tx_packets->pop();
+    }
+}
+
+// Main loop: hand packets auto_task received to Transport. Never touches
+// the sockets.
+void AutoInterface::deliver_rx_packets() {
+    // Bounded so a flood can't hold the main loop; the rest wait for the
+    // next pass
+    for (size_t budget = RX_PACKET_SLOTS; budget > 0; --budget) {
+        const uint8_t* data;
+        size_t len;
+        uint32_t rx_us;
+        if (!_rx_packets->front(&data, &len, &rx_us)) break;
+
+        Bytes packet(data, len);
+        _rx_packets->pop();
+
+        EVENT_TRACE_SCOPE_V(AUTO_RX, len);
+        InterfaceImpl::handle_incoming(packet);
+        Metrics::add(METRIC_AUTO_RX_PACKETS);
+        Metrics::add(METRIC_AUTO_RX_BYTES, static_cast<uint32_t>(len));
+        Metrics::observeSince(METRIC_AUTO_RX_LATENCY, rx_us);
+    }
+    if (_rx_paused.load() && rx_room() > 0) {
+        _rx_paused.store(false);
+        wake_task();
+    }
 }
 
 // ============================================================================
@@ -793,6 +1103,8 @@ bool AutoInterface::setup_discovery_socket() {
 }
 
 bool AutoInterface::setup_data_socket() {
+    _peers_changed = true;  // peer addresses carry the (possibly new) interface index
+
     // ESP32: Use raw IPv6 socket for data port (WiFiUDP doesn't support IPv6)
     _data_socket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
     if (_data_socket < 0) {
@@ -913,10 +1225,10 @@ void AutoInterface::send_announce() {
     ssize_t sent = sendto(_discovery_socket, _discovery_token.data(), _discovery_token.size(), 0,
                           (struct sockaddr*)&dest_addr, sizeof(dest_addr));
     if (sent > 0) {
-        _stat_announce_sent++;
+        Metrics::add(METRIC_AUTO_ANNOUNCE_TX);
         DEBUG("AutoInterface: Sent discovery announce (" + std::to_string(sent) + " bytes) to " + _multicast_address_str);
     } else {
-        _stat_announce_send_fail++;
+        Metrics::add(METRIC_AUTO_ANNOUNCE_TX_FAIL);
         WARNING("AutoInterface: Failed to send discovery announce (errno=" + std::to_string(errno) + ")");
     }
 }
@@ -944,13 +1256,13 @@ void AutoInterface::process_discovery() {
     // Hot path - no logging to avoid heap allocation on every packet
 
     while (len > 0) {
-        _stat_discovery_rx++;
+        Metrics::add(METRIC_AUTO_DISCOVERY_RX);
         // Convert source address to COMPRESSED string format (match Python)
         std::string src_str = ipv6_to_compressed_string((const uint8_t*)&src_addr.sin6_addr);
 
         // Self-echo bookkeeping (sender == us → multicast loopback works)
         if (src_str == _link_local_address_str) {
-            _stat_discovery_rx_self++;
+            Metrics::add(METRIC_AUTO_DISCOVERY_RX_SELF);
             _last_multicast_echo = RNS::Utilities::OS::time();
             if (!_initial_echo_received) {
                 _initial_echo_received = true;
@@ -986,47 +1298,6 @@ void AutoInterface::process_discovery() {
     }
 }
 
-void AutoInterface::process_data() {
-    // ESP32: Use raw socket for IPv6 data reception
-    if (_data_socket < 0) return;
-
-    uint8_t recv_buffer[Type::Reticulum::MTU + 64];
-    struct sockaddr_in6 src_addr;
-    socklen_t src_len = sizeof(src_addr);
-
-    ssize_t len = recvfrom(_data_socket, recv_buffer, sizeof(recv_buffer), 0,
-                           (struct sockaddr*)&src_addr, &src_len);
-
-    while (len > 0) {
-        _stat_data_rx++;
-        _buffer.clear();
-        _buffer.append(recv_buffer, len);
-
-        // Check for duplicates
-        if (is_duplicate(_buffer)) {
-            TRACE("AutoInterface: Dropping duplicate packet");
-            src_len = sizeof(src_addr);
-            len = recvfrom(_data_socket, recv_buffer, sizeof(recv_buffer), 0,
-                           (struct sockaddr*)&src_addr, &src_len);
-            continue;
-        }
-
-        add_to_deque(_buffer);
-
-        // Convert source address to string for logging
-        std::string src_str = ipv6_to_compressed_string((const uint8_t*)&src_addr.sin6_addr);
-        DEBUG("AutoInterface: Received data from " + src_str + " (" + std::to_string(len) + " bytes)");
-
-        // Pass to transport
-        InterfaceImpl::handle_incoming(_buffer);
-
-        // Try to receive more
-        src_len = sizeof(src_addr);
-        len = recvfrom(_data_socket, recv_buffer, sizeof(recv_buffer), 0,
-                       (struct sockaddr*)&src_addr, &src_len);
-    }
-}
-
 void AutoInterface::process_unicast_discovery() {
     // ESP32: Process incoming unicast discovery packets (reverse peering)
     if (_unicast_discovery_socket < 0) return;
@@ -1105,16 +1376,11 @@ void AutoInterface::send_reverse_peering() {
     // This maintains peer connections even when multicast is unreliable
     double now = RNS::Utilities::OS::time();
 
-    for (auto& peer : _peers) {
+    // Only the peers due, oldest first; each moves to the back once sent
+    _peers.due_outbound(now, REVERSE_PEERING_INTERVAL, [this](AutoInterfacePeer& peer) {
         // Skip local peers (our own announcements)
-        if (peer.is_local) continue;
-
-        // Check if it's time to send reverse peering to this peer
-        if (now > peer.last_outbound + REVERSE_PEERING_INTERVAL) {
-            reverse_announce(peer);
-            peer.last_outbound = now;
-        }
-    }
+        if (!peer.is_local) reverse_announce(peer);
+    });
 }
 
 #else  // POSIX/Linux
@@ -1168,6 +1434,8 @@ bool AutoInterface::setup_discovery_socket() {
 }
 
 bool AutoInterface::setup_data_socket() {
+    _peers_changed = true;  // peer addresses carry the (possibly new) interface index
+
     // Create IPv6 UDP socket for data
     _data_socket = socket(AF_INET6, SOCK_DGRAM, 0);
     if (_data_socket < 0) {
@@ -1274,39 +1542,6 @@ void AutoInterface::process_discovery() {
     }
 }
 
-void AutoInterface::process_data() {
-    if (_data_socket < 0) return;
-
-    struct sockaddr_in6 src_addr;
-    socklen_t addr_len = sizeof(src_addr);
-
-    while (true) {
-        _buffer.clear();
-        ssize_t len = recvfrom(_data_socket, _buffer.writable(Type::Reticulum::MTU),
-                               Type::Reticulum::MTU, 0,
-                               (struct sockaddr*)&src_addr, &addr_len);
-        if (len <= 0) break;
-
-        _buffer.resize(len);
-
-        // Check for duplicates (multi-interface deduplication)
-        if (is_duplicate(_buffer)) {
-            TRACE("AutoInterface: Dropping duplicate packet");
-            continue;
-        }
-
-        add_to_deque(_buffer);
-
-        char src_str[INET6_ADDRSTRLEN];
-        inet_ntop(AF_INET6, &src_addr.sin6_addr, src_str, sizeof(src_str));
-        DEBUG("AutoInterface: Received data from " + std::string(src_str) +
-              " (" + std::to_string(len) + " bytes)");
-
-        // Pass to transport
-        InterfaceImpl::handle_incoming(_buffer);
-    }
-}
-
 bool AutoInterface::setup_unicast_discovery_socket() {
     // POSIX: Create socket for receiving unicast discovery (reverse peering)
     _unicast_discovery_socket = socket(AF_INET6, SOCK_DGRAM, 0);
@@ -1419,16 +1654,11 @@ void AutoInterface::send_reverse_peering() {
     // This maintains peer connections even when multicast is unreliable
     double now = RNS::Utilities::OS::time();
 
-    for (auto& peer : _peers) {
+    // Only the peers due, oldest first; each moves to the back once sent
+    _peers.due_outbound(now, REVERSE_PEERING_INTERVAL, [this](AutoInterfacePeer& peer) {
         // Skip local peers (our own announcements)
-        if (peer.is_local) continue;
-
-        // Check if it's time to send reverse peering to this peer
-        if (now > peer.last_outbound + REVERSE_PEERING_INTERVAL) {
-            reverse_announce(peer);
-            peer.last_outbound = now;
-        }
-    }
+        if (!peer.is_local) reverse_announce(peer);
+    });
 }
 
 #endif  // ARDUINO
@@ -1455,20 +1685,12 @@ void AutoInterface::add_or_refresh_peer(const IPv6Address& addr, double timestam
         return;
     }
 
-    // Check if peer already exists
-    for (auto& peer : _peers) {
-        if (peer.same_address(addr)) {
-            peer.last_heard = timestamp;
-            TRACE("AutoInterface: Refreshed peer " + peer.address_string());
-            return;
-        }
+    // IPv6Address stores 16 bytes, network order
+    uint8_t key[16];
+    for (int i = 0; i < 16; i++) {
+        key[i] = addr[i];
     }
-
-    // Add new peer
-    AutoInterfacePeer new_peer(addr, _data_port, timestamp);
-    _peers.push_back(new_peer);
-
-    INFO("AutoInterface: Added new peer " + new_peer.address_string());
+    refresh_or_add_peer(key, AutoInterfacePeer(addr, _data_port, timestamp), timestamp);
 }
 
 #else  // POSIX
@@ -1489,24 +1711,42 @@ void AutoInterface::add_or_refresh_peer(const struct in6_addr& addr, double time
         return;
     }
 
-    // Check if peer already exists
-    for (auto& peer : _peers) {
-        if (peer.same_address(addr)) {
-            peer.last_heard = timestamp;
-            TRACE("AutoInterface: Refreshed peer " + peer.address_string());
-            return;
+    refresh_or_add_peer(reinterpret_cast<const uint8_t*>(&addr),
+                        AutoInterfacePeer(addr, _data_port, timestamp), timestamp);
+}
+
+#endif  // ARDUINO
+
+void AutoInterface::refresh_or_add_peer(const uint8_t* key, const AutoInterfacePeer& peer, double timestamp) {
+    AutoInterfacePeer evicted;
+    switch (_peers.refresh_or_add(key, peer, timestamp, &evicted)) {
+    case AutoPeerTable::Add::REFRESHED:
+        TRACE("AutoInterface: Refreshed peer " + peer.address_string());
+        return;
+    case AutoPeerTable::Add::FULL:
+        return;
+    case AutoPeerTable::Add::EVICTED:
+        // With more nodes than capacity this happens on nearly every
+        // discovery packet: warn once, then it is only counted (see the
+        // stats line)
+        Metrics::add(METRIC_AUTO_PEER_EVICTIONS);
+        if (!_peers_full_warned) {
+            _peers_full_warned = true;
+            WARNING("AutoInterface: Peer table full (" + std::to_string(_peers.capacity()) +
+                    "), evicting least recently heard peers");
         }
+        TRACE("AutoInterface: Evicted peer " + evicted.address_string() +
+              " for " + peer.address_string());
+        _peers_changed = true;
+        return;
+    case AutoPeerTable::Add::ADDED:
+        break;
     }
+    _peers_changed = true;
 
-    // Add new peer
-    AutoInterfacePeer new_peer(addr, _data_port, timestamp);
-    _peers.push_back(new_peer);
-
-    INFO("AutoInterface: Added new peer " + new_peer.address_string());
+    INFO("AutoInterface: Added new peer " + peer.address_string());
 }
 
-#endif  // ARDUINO
-
 // ============================================================================
 // Platform-independent: Echo Timeout Checking
 // ============================================================================
@@ -1554,46 +1794,14 @@ void AutoInterface::check_echo_timeout() {
 void AutoInterface::expire_stale_peers() {
     double now = RNS::Utilities::OS::time();
 
-    _peers.erase(
-        std::remove_if(_peers.begin(), _peers.end(),
-            [this, now](const AutoInterfacePeer& peer) {
-                if (now - peer.last_heard > PEERING_TIMEOUT) {
-                    INFO("AutoInterface: Removed stale peer " + peer.address_string());
-                    return true;
-                }
-                return false;
-            }),
-        _peers.end());
+    size_t removed = _peers.expire(now, PEERING_TIMEOUT, [](const AutoInterfacePeer& peer) {
+        INFO("AutoInterface: Removed stale peer " + peer.address_string());
+    });
+    if (removed > 0) _peers_changed = true;
 }
 
 bool AutoInterface::is_duplicate(const Bytes& packet) {
     Bytes packet_hash = Identity::full_hash(packet);
-
-    for (const auto& entry : _packet_deque) {
-        if (entry.hash == packet_hash) {
-            return true;
-        }
-    }
-    return false;
-}
-
-void AutoInterface::add_to_deque(const Bytes& packet) {
-    DequeEntry entry;
-    entry.hash = Identity::full_hash(packet);
-    entry.timestamp = RNS::Utilities::OS::time();
-
-    _packet_deque.push_back(entry);
-
-    // Limit deque size
-    while (_packet_deque.size() > DEQUE_SIZE) {
-        _packet_deque.pop_front();
-    }
-}
-
-void AutoInterface::expire_deque_entries() {
-    double now = RNS::Utilities::OS::time();
-
-    while (!_packet_deque.empty() && now - _packet_deque.front().timestamp > DEQUE_TTL) {
-        _packet_deque.pop_front();
-    }
+    return _packet_deque.check_and_add(packet_hash.data(), packet_hash.size(),
+                                       RNS::Utilities::OS::time());
 }
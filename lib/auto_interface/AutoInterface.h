@@ -5,8 +5,14 @@
 #include <microReticulum/Bytes.h>
 #include <microReticulum/Type.h>
 #include "AutoInterfacePeer.h"
+#include "AutoPeerTable.h"
+#include "DatagramBatch.h"
+#include "PacketDedupWindow.h"
+#include <SPSCPacketQueue.h>
 
 #ifdef ARDUINO
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #include <WiFi.h>
 #include <WiFiUdp.h>
 #include <IPv6Address.h>
@@ -17,15 +23,23 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
+#include <thread>
 #endif
 
-#include <vector>
-#include <deque>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <cstdint>
 
 // AutoInterface - automatic peer discovery via IPv6 multicast
 // Matches Python RNS AutoInterface behavior for interoperability
+//
+// By default loop() polls the three sockets and runs the discovery timers.
+// With set_socket_task(true), start() instead runs an auto_task that
+// blocks in select() on the sockets and owns them, the peer table and the
+// timers. loop() only hands received packets to Transport, and
+// send_outgoing() only queues packets for the task. This is the same
+// pattern as TCPClientInterface's tcp_task.
 class AutoInterface : public RNS::InterfaceImpl {
 
 public:
@@ -42,6 +56,15 @@ public:
     static constexpr double DEQUE_TTL = 0.75;            // seconds
     static const uint32_t BITRATE_GUESS = 10 * 1000 * 1000;
     static const uint16_t HW_MTU = 1196;
+    static const size_t RX_BUDGET = 32;                  // datagrams handled per loop()
+    static const size_t DEFAULT_MAX_PEERS = 128;         // least recently heard evicted past this
+
+    // Socket task: packets in flight to and from it (PSRAM, HW_MTU slots),
+    // and its longest select() wait. stop() and outgoing packets wake it
+    // early, so the wait only sets the resolution of the timers.
+    static const size_t RX_PACKET_SLOTS = 64;
+    static const size_t TX_PACKET_SLOTS = 16;
+    static constexpr double TASK_TICK = 0.25;            // seconds
 
     // Discovery token is full_hash(group_id + link_local_address) = 32 bytes
     // Python RNS sends and expects the full 32-byte hash (HASHLENGTH//8 = 256//8 = 32)
@@ -56,6 +79,8 @@ public:
     void set_discovery_port(uint16_t port) { _discovery_port = port; }
     void set_data_port(uint16_t port) { _data_port = port; }
     void set_interface_name(const std::string& ifname) { _ifname = ifname; }
+    void set_max_peers(size_t max_peers) { _max_peers = max_peers; }
+    void set_socket_task(bool enabled) { _socket_task = enabled; }
 
     // InterfaceImpl overrides
     virtual bool start() override;
@@ -66,16 +91,15 @@ public:
         return "AutoInterface[" + _name + "/" + _group_id + "]";
     }
 
-    // Getters for testing
+    // Getters for testing (the token changes with the link-local address,
+    // on the socket task when one runs)
     const RNS::Bytes& get_discovery_token() const { return _discovery_token; }
     const RNS::Bytes& get_multicast_address() const { return _multicast_address_bytes; }
-    size_t peer_count() const { return _peers.size(); }
+    size_t peer_count() const { return _peer_count.load(); }
 
     // Carrier state tracking (matches Python RNS)
     bool carrier_changed() {
-        bool changed = _carrier_changed;
-        _carrier_changed = false;  // Clear flag on read
-        return changed;
+        return _carrier_changed.exchange(false);  // Clear flag on read
     }
     void clear_carrier_changed() { _carrier_changed = false; }
     bool is_timed_out() const { return _timed_out; }
@@ -95,13 +119,16 @@ private:
     bool setup_data_socket();
     bool join_multicast_group();
 
-    // Main loop operations
+    // Socket and timer work: from loop(), or from auto_task when it runs
+    void service(double now);
     void send_announce();
     void process_discovery();
     void process_unicast_discovery();
     void send_reverse_peering();
     void reverse_announce(AutoInterfacePeer& peer);
     void process_data();
+    bool send_to_peers(const uint8_t* data, size_t len);
+    void rebuild_fanout();
     void check_echo_timeout();
     void check_link_local_address();
 
@@ -111,12 +138,40 @@ private:
 #else
     void add_or_refresh_peer(const struct in6_addr& addr, double timestamp);
 #endif
+    void refresh_or_add_peer(const uint8_t* key, const AutoInterfacePeer& peer, double timestamp);
     void expire_stale_peers();
 
-    // Deduplication
+    // Deduplication: hashes the packet once, records it if new
     bool is_duplicate(const RNS::Bytes& packet);
-    void add_to_deque(const RNS::Bytes& packet);
-    void expire_deque_entries();
+
+    // Socket task. While it runs it owns the sockets, the peer table, the
+    // dedup window and the fan-out; the main loop only touches the two
+    // packet queues and the atomics:
+    //   _rx_packets  auto_task -> main loop   new data packets, deduplicated
+    //   _tx_packets  main loop -> auto_task   packets from send_outgoing(),
+    //                                         which then rings _wake_fd
+    // ARDUINO runs it as a FreeRTOS task on core 0, POSIX as a std::thread.
+    bool start_task();
+    void stop_task();
+#ifdef ARDUINO
+    static void auto_task(void* arg);
+    TaskHandle_t _task_handle = nullptr;
+    std::atomic<bool> _task_done{false};   // task sets this right before exit; stop() joins on it
+#else
+    std::thread _task_thread;
+#endif
+    void task_loop();
+    void wait_for_sockets(double timeout);
+    void drain_tx_packets();
+    void deliver_rx_packets();
+    void wake_task();
+    size_t rx_room() const;
+    bool _socket_task = false;
+    std::atomic<bool> _task_running{false};
+    std::atomic<bool> _rx_paused{false};   // task stopped reading the data socket; loop() wakes it
+    std::unique_ptr<RNS::SPSCPacketQueue> _rx_packets;   // allocated by start() with the task
+    std::unique_ptr<RNS::SPSCPacketQueue> _tx_packets;
+    int _wake_fd = -1;
 
     // Configuration
     std::string _group_id = DEFAULT_GROUP_ID;
@@ -152,32 +207,32 @@ private:
 #endif
 
     // Peers and state
-    std::vector<AutoInterfacePeer> _peers;
+    AutoPeerTable _peers;                     // sized to _max_peers by start()
+    size_t _max_peers = DEFAULT_MAX_PEERS;
+    bool _peers_full_warned = false;          // first eviction since start() only
+    std::atomic<size_t> _peer_count{0};       // _peers.size(), published for peer_count()
     double _last_announce = 0;
     double _last_peer_job = 0;  // Timestamp of last peer job check
 
     // Echo tracking (matches Python RNS multicast_echoes / initial_echoes)
     double _last_multicast_echo = 0.0;       // Timestamp of last own echo received
     bool _initial_echo_received = false;      // True once first echo received
-    bool _timed_out = false;                  // Current timeout state
-    bool _carrier_changed = false;            // Flag for Transport layer notification
+    std::atomic<bool> _timed_out{false};       // Current timeout state
+    std::atomic<bool> _carrier_changed{false}; // Flag for Transport layer notification
     bool _firewall_warning_logged = false;    // Track firewall warning (log once)
 
-    // Deduplication: pairs of (packet_hash, timestamp)
-    struct DequeEntry {
-        RNS::Bytes hash;
-        double timestamp;
-    };
-    std::deque<DequeEntry> _packet_deque;
+    // Deduplication: the last DEQUE_SIZE packet hashes seen within DEQUE_TTL
+    PacketDedupWindow<DEQUE_SIZE> _packet_deque{DEQUE_TTL};
+
+    // Peer address table for send_outgoing(), rebuilt when _peers changes
+    PeerFanout _fanout;
+    bool _peers_changed = true;
 
-    // Receive buffer
+    // Batched datagram receive (HW_MTU slots), then _buffer for handle_incoming()
+    DatagramBatch _rx_batch{HW_MTU};
     RNS::Bytes _buffer;
 
-    // Diagnostic counters (printed periodically as INFO)
-    uint32_t _stat_announce_sent = 0;
-    uint32_t _stat_announce_send_fail = 0;
-    uint32_t _stat_discovery_rx = 0;
-    uint32_t _stat_discovery_rx_self = 0;
-    uint32_t _stat_data_rx = 0;
+    // Diagnostic counters live in Instrumentation::Metrics (iface.auto.*,
+    // auto.*); this paces the periodic INFO summary of them
     double   _last_stats_log = 0;
 };
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <cstdint>
+#include <cstring>
 
 #ifdef ARDUINO
 #include <WiFi.h>
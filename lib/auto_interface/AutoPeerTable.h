@@ -0,0 +1,307 @@
+#pragma once
+
+#include "AutoInterfacePeer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef BOARD_HAS_PSRAM
+#include <esp_heap_caps.h>
+#endif
+
+/**
+ * AutoPeerTable - AutoInterface's peers, keyed by raw 16-byte IPv6 address.
+ *
+ * Discovery packets arrive every ANNOUNCE_INTERVAL from every node on the
+ * segment, so with a hundred nodes the per-packet peer lookup, the expiry
+ * sweep and the reverse-peering pass are the hot path. Here:
+ *
+ *   - lookup is a linear-probed index over the address bytes (at most half
+ *     full, backward-shift removal), so no IPv6Address operator calls
+ *   - peers sit on a list in last_heard order: a refresh moves the peer to
+ *     the tail, so expiry only looks at the head, and when the table is
+ *     full the head (least recently heard) is evicted for the newcomer
+ *   - a second list in last_outbound order gives the peers due a reverse
+ *     peering without visiting the rest
+ *
+ * Both orders rely on the caller's clock being monotonic (OS::time()).
+ * Capacity is fixed by init(); entries (PSRAM when available) are
+ * allocated once there. Not thread-safe: AutoInterface's loop only.
+ */
+class AutoPeerTable {
+public:
+    static const size_t ADDRESS_SIZE = 16;
+    static const size_t MAX_CAPACITY = 4096;
+
+    enum class Add : uint8_t {
+        REFRESHED,   // known peer, last_heard updated
+        ADDED,
+        EVICTED,     // added in place of the least recently heard peer
+        FULL,        // no capacity (init() not called)
+    };
+
+    AutoPeerTable() = default;
+    ~AutoPeerTable() { release(); }
+
+    AutoPeerTable(const AutoPeerTable&) = delete;
+    AutoPeerTable& operator=(const AutoPeerTable&) = delete;
+
+    /** (Re)allocate for capacity peers (clamped to MAX_CAPACITY), dropping all. */
+    bool init(size_t capacity) {
+        release();
+        if (capacity > MAX_CAPACITY) capacity = MAX_CAPACITY;
+        if (capacity == 0) return true;
+        size_t slots = 1;
+        while (slots < 2 * capacity) slots <<= 1;
+#ifdef BOARD_HAS_PSRAM
+        void* entries = heap_caps_malloc(sizeof(Entry) * capacity, MALLOC_CAP_SPIRAM);
+        void* index = heap_caps_malloc(sizeof(uint16_t) * slots, MALLOC_CAP_SPIRAM);
+#else
+        void* entries = malloc(sizeof(Entry) * capacity);
+        void* index = malloc(sizeof(uint16_t) * slots);
+#endif
+        if (!entries || !index) {
+            free(entries);
+            free(index);
+            return false;
+        }
+        _entries = static_cast<Entry*>(entries);
+        _index = static_cast<uint16_t*>(index);
+        for (size_t i = 0; i < capacity; ++i) new (&_entries[i]) Entry();
+        _capacity = capacity;
+        _mask = slots - 1;
+        clear();
+        return true;
+    }
+
+    void clear() {
+        if (_index) memset(_index, 0xFF, sizeof(uint16_t) * (_mask + 1));
+        _heard = List();
+        _outbound = List();
+        _count = 0;
+        // Free list threads through heard.next
+        _free = _capacity > 0 ? 0 : NONE;
+        for (size_t i = 0; i < _capacity; ++i) {
+            _entries[i].heard.next = i + 1 < _capacity ? static_cast<uint16_t>(i + 1) : NONE;
+        }
+    }
+
+    size_t size() const { return _count; }
+    size_t capacity() const { return _capacity; }
+
+    AutoInterfacePeer* find(const uint8_t* addr) {
+        uint16_t e = lookup(addr, nullptr);
+        return e == NONE ? nullptr : &_entries[e].peer;
+    }
+
+    /**
+     * Refresh the peer at addr (last_heard = now), or add it as a copy of
+     * peer. When the table is full the least recently heard peer makes room
+     * and, if evicted is given, is copied there first.
+     */
+    Add refresh_or_add(const uint8_t* addr, const AutoInterfacePeer& peer, double now,
+                       AutoInterfacePeer* evicted = nullptr) {
+        uint16_t e = lookup(addr, nullptr);
+        if (e != NONE) {
+            _entries[e].peer.last_heard = now;
+            unlink(_heard, e, &Entry::heard);
+            push_back(_heard, e, &Entry::heard);
+            return Add::REFRESHED;
+        }
+        if (_capacity == 0) return Add::FULL;
+
+        Add result = Add::ADDED;
+        if (_free == NONE) {
+            if (evicted) *evicted = _entries[_heard.head].peer;
+            remove(_heard.head);
+            result = Add::EVICTED;
+        }
+        e = _free;
+        _free = _entries[e].heard.next;
+
+        Entry& entry = _entries[e];
+        memcpy(entry.key, addr, ADDRESS_SIZE);
+        entry.peer = peer;
+        entry.peer.last_heard = now;
+        push_back(_heard, e, &Entry::heard);
+        // last_outbound is normally 0 (never sent): due first
+        push_front(_outbound, e, &Entry::outbound);
+        size_t slot = home(addr);
+        while (_index[slot] != NONE) slot = (slot + 1) & _mask;
+        _index[slot] = e;
+        _count++;
+        return result;
+    }
+
+    /** Remove the peer at addr. False if unknown. */
+    bool erase(const uint8_t* addr) {
+        uint16_t e = lookup(addr, nullptr);
+        if (e == NONE) return false;
+        remove(e);
+        return true;
+    }
+
+    /**
+     * Remove peers not heard from for more than timeout seconds, calling
+     * on_removed(const AutoInterfacePeer&) for each first. Returns how many.
+     */
+    template <typename Fn>
+    size_t expire(double now, double timeout, Fn on_removed) {
+        size_t removed = 0;
+        while (_heard.head != NONE && now - _entries[_heard.head].peer.last_heard > timeout) {
+            on_removed(static_cast<const AutoInterfacePeer&>(_entries[_heard.head].peer));
+            remove(_heard.head);
+            removed++;
+        }
+        return removed;
+    }
+
+    /**
+     * Call fn(AutoInterfacePeer&) for every peer whose last reverse peering
+     * is more than interval seconds old, oldest first, and set its
+     * last_outbound to now. Returns how many.
+     */
+    template <typename Fn>
+    size_t due_outbound(double now, double interval, Fn fn) {
+        size_t due = 0;
+        while (_outbound.head != NONE) {
+            uint16_t e = _outbound.head;
+            AutoInterfacePeer& peer = _entries[e].peer;
+            if (!(now > peer.last_outbound + interval)) break;
+            fn(peer);
+            peer.last_outbound = now;
+            unlink(_outbound, e, &Entry::outbound);
+            push_back(_outbound, e, &Entry::outbound);
+            due++;
+        }
+        return due;
+    }
+
+    /** Call fn(const AutoInterfacePeer&) for every peer, least recently heard first. */
+    template <typename Fn>
+    void for_each(Fn fn) const {
+        for (uint16_t e = _heard.head; e != NONE; e = _entries[e].heard.next) {
+            fn(static_cast<const AutoInterfacePeer&>(_entries[e].peer));
+        }
+    }
+
+private:
+    static const uint16_t NONE = 0xFFFF;
+
+    struct Links {
+        uint16_t prev = NONE;
+        uint16_t next = NONE;
+    };
+
+    struct Entry {
+        uint8_t key[ADDRESS_SIZE] = {};
+        Links heard;        // last_heard order; free list when unused
+        Links outbound;     // last_outbound order
+        AutoInterfacePeer peer;
+    };
+
+    struct List {
+        uint16_t head = NONE;
+        uint16_t tail = NONE;
+    };
+
+    // Link-local addresses share their first 8 bytes; the interface ids
+    // differ, so fold both halves and let the multiply spread them
+    size_t home(const uint8_t* addr) const {
+        uint64_t hi, lo;
+        memcpy(&hi, addr, 8);
+        memcpy(&lo, addr + 8, 8);
+        uint64_t h = (hi ^ (lo * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+        return static_cast<size_t>(h >> 40) & _mask;
+    }
+
+    // Entry for addr or NONE; *slot_out gets its index slot
+    uint16_t lookup(const uint8_t* addr, size_t* slot_out) const {
+        if (_capacity == 0) return NONE;
+        for (size_t slot = home(addr);; slot = (slot + 1) & _mask) {
+            uint16_t e = _index[slot];
+            if (e == NONE) return NONE;
+            if (memcmp(_entries[e].key, addr, ADDRESS_SIZE) == 0) {
+                if (slot_out) *slot_out = slot;
+                return e;
+            }
+        }
+    }
+
+    void remove(uint16_t e) {
+        Entry& entry = _entries[e];
+        size_t hole = 0;
+        lookup(entry.key, &hole);
+
+        // Backward-shift deletion: pull each later entry of the probe run
+        // into the hole unless its home lies after the hole
+        for (size_t next = (hole + 1) & _mask; _index[next] != NONE; next = (next + 1) & _mask) {
+            size_t h = home(_entries[_index[next]].key);
+            if (((next - h) & _mask) >= ((next - hole) & _mask)) {
+                _index[hole] = _index[next];
+                hole = next;
+            }
+        }
+        _index[hole] = NONE;
+
+        unlink(_heard, e, &Entry::heard);
+        unlink(_outbound, e, &Entry::outbound);
+        entry.peer = AutoInterfacePeer();
+        entry.heard.next = _free;
+        _free = e;
+        _count--;
+    }
+
+    void unlink(List& list, uint16_t e, Links Entry::*links) {
+        Links& l = _entries[e].*links;
+        if (l.prev != NONE) (_entries[l.prev].*links).next = l.next;
+        else list.head = l.next;
+        if (l.next != NONE) (_entries[l.next].*links).prev = l.prev;
+        else list.tail = l.prev;
+        l.prev = l.next = NONE;
+    }
+
+    void push_back(List& list, uint16_t e, Links Entry::*links) {
+        Links& l = _entries[e].*links;
+        l.prev = list.tail;
+        l.next = NONE;
+        if (list.tail != NONE) (_entries[list.tail].*links).next = e;
+        else list.head = e;
+        list.tail = e;
+    }
+
+    void push_front(List& list, uint16_t e, Links Entry::*links) {
+        Links& l = _entries[e].*links;
+        l.prev = NONE;
+        l.next = list.head;
+        if (list.head != NONE) (_entries[list.head].*links).prev = e;
+        else list.tail = e;
+        list.head = e;
+    }
+
+    void release() {
+        for (size_t i = 0; i < _capacity; ++i) _entries[i].~Entry();
+        free(_entries);
+        free(_index);
+        _entries = nullptr;
+        _index = nullptr;
+        _capacity = 0;
+        _mask = 0;
+        _count = 0;
+        _free = NONE;
+        _heard = List();
+        _outbound = List();
+    }
+
+    Entry* _entries = nullptr;
+    uint16_t* _index = nullptr;
+    size_t _capacity = 0;
+    size_t _mask = 0;
+    size_t _count = 0;
+    uint16_t _free = NONE;
+    List _heard;
+    List _outbound;
+};
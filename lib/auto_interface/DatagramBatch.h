@@ -0,0 +1,193 @@
+#pragma once
+
+#ifdef ARDUINO
+#include <lwip/sockets.h>
+#else
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Linux has sendmmsg()/recvmmsg(); lwIP and macOS get the per-datagram
+// fallback behind the same interface
+#if defined(__linux__) && !defined(ARDUINO)
+#define AUTO_DATAGRAM_MMSG 1
+#else
+#define AUTO_DATAGRAM_MMSG 0
+#endif
+
+/**
+ * PeerFanout - send one datagram to every AutoInterface peer.
+ *
+ * Holds a prebuilt sockaddr_in6 per peer, rebuilt only when the peer set
+ * changes (clear() + add()), so a send does no per-peer address setup. On
+ * Linux the whole fan-out is one sendmmsg() whose messages all point at the
+ * same iovec, i.e. the caller's buffer; elsewhere it is one sendto() per
+ * peer from the same table.
+ *
+ * The socket is expected to be non-blocking: a peer the stack can't take
+ * right now is counted as failed, not retried.
+ */
+class PeerFanout {
+public:
+    PeerFanout() = default;
+    PeerFanout(const PeerFanout&) = delete;             // messages point into this object
+    PeerFanout& operator=(const PeerFanout&) = delete;
+
+    void clear() {
+        _addrs.clear();
+        _stale = true;
+    }
+
+    /** Add a peer: 16-byte IPv6 address (network order), port, scope id. */
+    void add(const uint8_t* addr, uint16_t port, uint32_t scope_id) {
+        struct sockaddr_in6 sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin6_family = AF_INET6;
+        sa.sin6_port = htons(port);
+        memcpy(&sa.sin6_addr, addr, 16);
+        sa.sin6_scope_id = scope_id;
+        _addrs.push_back(sa);
+        _stale = true;
+    }
+
+    size_t size() const { return _addrs.size(); }
+    const struct sockaddr_in6& peer(size_t i) const { return _addrs[i]; }
+
+    /**
+     * Send len bytes to every peer. Returns the number of peers the stack
+     * accepted it for; the rest are counted in *failed, with the errno of
+     * the first failure in *first_errno.
+     */
+    size_t send(int fd, const uint8_t* data, size_t len, size_t* failed = nullptr, int* first_errno = nullptr) {
+        size_t sent = 0;
+        size_t fails = 0;
+        int err = 0;
+#if AUTO_DATAGRAM_MMSG
+        if (_stale) rebuild_messages();
+        _iov.iov_base = const_cast<uint8_t*>(data);
+        _iov.iov_len = len;
+        size_t off = 0;
+        while (off < _msgs.size()) {
+            int r = sendmmsg(fd, _msgs.data() + off, _msgs.size() - off, 0);
+            if (r > 0) {
+                sent += r;
+                off += r;
+            } else {
+                // The message at off failed (a partial batch reports its
+                // error on the next call, which starts there)
+                if (fails++ == 0) err = r < 0 ? errno : 0;
+                off++;
+            }
+        }
+#else
+        for (const struct sockaddr_in6& sa : _addrs) {
+            if (sendto(fd, data, len, 0, (const struct sockaddr*)&sa, sizeof(sa)) >= 0) {
+                sent++;
+            } else if (fails++ == 0) {
+                err = errno;
+            }
+        }
+#endif
+        if (failed) *failed = fails;
+        if (first_errno) *first_errno = err;
+        return sent;
+    }
+
+private:
+#if AUTO_DATAGRAM_MMSG
+    void rebuild_messages() {
+        _msgs.resize(_addrs.size());
+        for (size_t i = 0; i < _addrs.size(); ++i) {
+            struct msghdr& h = _msgs[i].msg_hdr;
+            memset(&_msgs[i], 0, sizeof(_msgs[i]));
+            h.msg_name = &_addrs[i];
+            h.msg_namelen = sizeof(_addrs[i]);
+            h.msg_iov = &_iov;
+            h.msg_iovlen = 1;
+        }
+        _stale = false;
+    }
+
+    std::vector<struct mmsghdr> _msgs;
+    struct iovec _iov = {};
+#endif
+    std::vector<struct sockaddr_in6> _addrs;
+    bool _stale = true;
+};
+
+/**
+ * DatagramBatch - receive waiting datagrams in batches.
+ *
+ * One buffer of MAX_BATCH slots of max_datagram bytes, allocated up front.
+ * receive() fills up to `max` slots without blocking: one recvmmsg() on
+ * Linux, repeated recvfrom() elsewhere (where MAX_BATCH is 1, so each call
+ * is one datagram). Slots stay valid until the next receive().
+ */
+class DatagramBatch {
+public:
+    static const size_t MAX_BATCH = AUTO_DATAGRAM_MMSG ? 16 : 1;
+
+    explicit DatagramBatch(size_t max_datagram)
+        : _max_datagram(max_datagram), _buffer(MAX_BATCH * max_datagram) {
+#if AUTO_DATAGRAM_MMSG
+        memset(_msgs, 0, sizeof(_msgs));
+        for (size_t i = 0; i < MAX_BATCH; ++i) {
+            _iovs[i].iov_base = _buffer.data() + i * max_datagram;
+            _iovs[i].iov_len = max_datagram;
+            _msgs[i].msg_hdr.msg_iov = &_iovs[i];
+            _msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+#endif
+    }
+
+    DatagramBatch(const DatagramBatch&) = delete;
+    DatagramBatch& operator=(const DatagramBatch&) = delete;
+
+    /** Receive up to max (capped at MAX_BATCH) waiting datagrams. Returns how many. */
+    size_t receive(int fd, size_t max = MAX_BATCH) {
+        if (max > MAX_BATCH) max = MAX_BATCH;
+        _count = 0;
+#if AUTO_DATAGRAM_MMSG
+        for (size_t i = 0; i < max; ++i) {
+            _msgs[i].msg_hdr.msg_name = &_sources[i];
+            _msgs[i].msg_hdr.msg_namelen = sizeof(_sources[i]);
+            _msgs[i].msg_hdr.msg_flags = 0;
+        }
+        int r = recvmmsg(fd, _msgs, max, MSG_DONTWAIT, nullptr);
+        if (r <= 0) return 0;
+        for (int i = 0; i < r; ++i) _lengths[i] = _msgs[i].msg_len;
+        _count = r;
+#else
+        while (_count < max) {
+            socklen_t src_len = sizeof(_sources[_count]);
+            ssize_t len = recvfrom(fd, _buffer.data() + _count * _max_datagram, _max_datagram, 0,
+                                   (struct sockaddr*)&_sources[_count], &src_len);
+            if (len <= 0) break;
+            _lengths[_count++] = len;
+        }
+#endif
+        return _count;
+    }
+
+    size_t size() const { return _count; }
+    const uint8_t* data(size_t i) const { return _buffer.data() + i * _max_datagram; }
+    size_t length(size_t i) const { return _lengths[i]; }
+    const struct sockaddr_in6& source(size_t i) const { return _sources[i]; }
+
+private:
+    const size_t _max_datagram;
+    std::vector<uint8_t> _buffer;
+    size_t _count = 0;
+    size_t _lengths[MAX_BATCH] = {};
+    struct sockaddr_in6 _sources[MAX_BATCH];
+#if AUTO_DATAGRAM_MMSG
+    struct iovec _iovs[MAX_BATCH];
+    struct mmsghdr _msgs[MAX_BATCH];
+#endif
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * PacketDedupWindow - recently seen packet hashes for AutoInterface.
+ *
+ * Python RNS AutoInterface drops a datagram whose full_hash is among the last
+ * WINDOW packets received within ttl seconds (the same packet arrives once
+ * per peer interface and multicast path). This keeps that window without a
+ * deque or a Bytes per entry:
+ *
+ *   - each packet is hashed once by the caller; check_and_add() both tests
+ *     and records it
+ *   - the key is the first 16 bytes of the hash (128 bits, so a false
+ *     duplicate inside a 48-entry window is not a concern), held inline
+ *   - entries sit in a fixed ring in arrival order, so the oldest is always
+ *     the next to expire or to be displaced once WINDOW are live
+ *   - a linear-probed index of ring positions (at most half full) finds a
+ *     key in one or two probes; removal shifts later probes back, so there
+ *     are no tombstones to accumulate
+ *
+ * Times are caller-supplied seconds (OS::time()). Fixed size, no heap.
+ * Not thread-safe: AutoInterface's loop only.
+ */
+template <size_t WINDOW>
+class PacketDedupWindow {
+    static_assert(WINDOW > 0 && WINDOW < 128, "ring positions are stored in a byte");
+
+public:
+    static const size_t KEY_BYTES = 16;
+
+    explicit PacketDedupWindow(double ttl) : _ttl(ttl) { clear(); }
+
+    /**
+     * True if hash was seen within the window (a duplicate; nothing is
+     * recorded). Otherwise records it, displacing the oldest entry when
+     * WINDOW are live, and returns false. Hashes shorter than KEY_BYTES are
+     * zero-padded.
+     */
+    bool check_and_add(const uint8_t* hash, size_t len, double now) {
+        expire(now);
+        Key key = make_key(hash, len);
+        if (find(key) != NOT_FOUND) return true;
+
+        if (_count == WINDOW) remove_oldest();
+        size_t pos = (_first + _count) % WINDOW;
+        _ring[pos].key = key;
+        _ring[pos].stamp = now;
+        _count++;
+
+        size_t slot = home(key);
+        while (_index[slot] != EMPTY) slot = (slot + 1) & MASK;
+        _index[slot] = static_cast<uint8_t>(pos);
+        return false;
+    }
+
+    /** Recorded and not yet expired (as of the last expire()), without recording. */
+    bool contains(const uint8_t* hash, size_t len) const {
+        return find(make_key(hash, len)) != NOT_FOUND;
+    }
+
+    /** Drop entries older than ttl. */
+    void expire(double now) {
+        while (_count > 0 && now - _ring[_first].stamp > _ttl) remove_oldest();
+    }
+
+    void clear() {
+        memset(_index, EMPTY, sizeof(_index));
+        _first = 0;
+        _count = 0;
+    }
+
+    size_t size() const { return _count; }
+
+private:
+    struct Key {
+        uint64_t hi;
+        uint64_t lo;
+        bool operator==(const Key& o) const { return hi == o.hi && lo == o.lo; }
+    };
+
+    struct Entry {
+        Key key;
+        double stamp;
+    };
+
+    // Index slots: the next power of two at or above 2 * WINDOW
+    static constexpr size_t pow2_at_least(size_t n, size_t p = 1) {
+        return p >= n ? p : pow2_at_least(n, p * 2);
+    }
+    static const size_t SLOTS = pow2_at_least(2 * WINDOW);
+    static const size_t MASK = SLOTS - 1;
+    static const uint8_t EMPTY = 0xFF;       // free index slot
+    static const size_t NOT_FOUND = SLOTS;
+
+    static Key make_key(const uint8_t* hash, size_t len) {
+        uint8_t raw[KEY_BYTES] = {};
+        memcpy(raw, hash, len < KEY_BYTES ? len : KEY_BYTES);
+        Key key;
+        memcpy(&key.hi, raw, 8);
+        memcpy(&key.lo, raw + 8, 8);
+        return key;
+    }
+
+    // Keys are normally SHA-256 output already; the multiply only matters
+    // for structured keys (tests)
+    static size_t home(const Key& key) {
+        uint64_t h = (key.hi ^ key.lo) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32) & MASK;
+    }
+
+    // Index slot holding key, or NOT_FOUND
+    size_t find(const Key& key) const {
+        for (size_t slot = home(key);; slot = (slot + 1) & MASK) {
+            uint8_t pos = _index[slot];
+            if (pos == EMPTY) return NOT_FOUND;
+            if (_ring[pos].key == key) return slot;
+        }
+    }
+
+    void remove_oldest() {
+        const Entry& oldest = _ring[_first];
+        size_t slot = home(oldest.key);
+        while (_index[slot] != _first) slot = (slot + 1) & MASK;
+
+        // Backward-shift deletion: pull each later entry of the probe run
+        // into the hole unless its home lies after the hole
+        size_t hole = slot;
+        for (size_t next = (hole + 1) & MASK; _index[next] != EMPTY; next = (next + 1) & MASK) {
+            size_t h = home(_ring[_index[next]].key);
+            if (((next - h) & MASK) >= ((next - hole) & MASK)) {
+                _index[hole] = _index[next];
+                hole = next;
+            }
+        }
+        _index[hole] = EMPTY;
+
+        _first = (_first + 1) % WINDOW;
+        _count--;
+    }
+
+    const double _ttl;
+    Entry _ring[WINDOW];
+    uint8_t _index[SLOTS];
+    size_t _first = 0;
+    size_t _count = 0;
+};
@@ -149,7 +149,7 @@ void BLEIdentityManager::completeHandshake(const Bytes& mac_address, const Bytes
     AddressIdentitySlot* existing_slot = findIdentityToAddressSlot(identity);
     if (existing_slot && existing_slot->mac_address != mac) {
         // MAC rotation detected!
-        old_mac = existing_slot->mac_address;
+        old_mac = existing_slot->mac_address.toBytes();
         is_rotation = true;
 
         INFO("BLEIdentityManager: MAC rotation detected for identity " +
@@ -204,7 +204,7 @@ void BLEIdentityManager::checkTimeouts() {
         if (session.state != HandshakeState::COMPLETE) {
             double age = now - session.started_at;
             if (age > Timing::HANDSHAKE_TIMEOUT) {
-                Bytes mac = session.mac_address;
+                Bytes mac = session.mac_address.toBytes();
 
                 WARNING("BLEIdentityManager: Handshake timeout for " +
                         BLEAddress(mac.data()).toString());
@@ -232,7 +232,7 @@ Bytes BLEIdentityManager::getIdentityForMac(const Bytes& mac_address) const {
 
     const AddressIdentitySlot* slot = findAddressToIdentitySlot(mac);
     if (slot) {
-        return slot->identity;
+        return slot->identity.toBytes();
     }
 
     return Bytes();
@@ -245,7 +245,7 @@ Bytes BLEIdentityManager::getMacForIdentity(const Bytes& identity) const {
 
     const AddressIdentitySlot* slot = findIdentityToAddressSlot(identity);
     if (slot) {
-        return slot->mac_address;
+        return slot->mac_address.toBytes();
     }
 
     return Bytes();
@@ -268,10 +268,10 @@ Bytes BLEIdentityManager::findIdentityByPrefix(const Bytes& prefix) const {
     // Search through all known identities for one that starts with this prefix
     for (size_t i = 0; i < ADDRESS_IDENTITY_POOL_SIZE; i++) {
         if (_address_identity_pool[i].in_use) {
-            const Bytes& identity = _address_identity_pool[i].identity;
+            const Hash16& identity = _address_identity_pool[i].identity;
             if (identity.size() >= prefix.size() &&
                 memcmp(identity.data(), prefix.data(), prefix.size()) == 0) {
-                return identity;
+                return identity.toBytes();
             }
         }
     }
@@ -356,10 +356,11 @@ bool BLEIdentityManager::isHandshakeInProgress(const Bytes& mac_address) const {
 
 BLEIdentityManager::AddressIdentitySlot* BLEIdentityManager::findAddressToIdentitySlot(const Bytes& mac) {
     if (mac.size() < Limits::MAC_SIZE) return nullptr;
+    const MacKey key(mac.data(), Limits::MAC_SIZE);
 
     for (size_t i = 0; i < ADDRESS_IDENTITY_POOL_SIZE; i++) {
         if (_address_identity_pool[i].in_use &&
-            _address_identity_pool[i].mac_address == mac) {
+            _address_identity_pool[i].mac_address == key) {
             return &_address_identity_pool[i];
         }
     }
@@ -372,10 +373,11 @@ const BLEIdentityManager::AddressIdentitySlot* BLEIdentityManager::findAddressTo
 
 BLEIdentityManager::AddressIdentitySlot* BLEIdentityManager::findIdentityToAddressSlot(const Bytes& identity) {
     if (identity.size() != Limits::IDENTITY_SIZE) return nullptr;
+    const Hash16 key(identity);
 
     for (size_t i = 0; i < ADDRESS_IDENTITY_POOL_SIZE; i++) {
         if (_address_identity_pool[i].in_use &&
-            _address_identity_pool[i].identity == identity) {
+            _address_identity_pool[i].identity == key) {
             return &_address_identity_pool[i];
         }
     }
@@ -436,10 +438,11 @@ void BLEIdentityManager::removeAddressIdentityMapping(const Bytes& mac) {
 
 BLEIdentityManager::HandshakeSession* BLEIdentityManager::findHandshakeSession(const Bytes& mac) {
     if (mac.size() < Limits::MAC_SIZE) return nullptr;
+    const MacKey key(mac.data(), Limits::MAC_SIZE);
 
     for (size_t i = 0; i < HANDSHAKE_POOL_SIZE; i++) {
         if (_handshakes_pool[i].in_use &&
-            _handshakes_pool[i].mac_address == mac) {
+            _handshakes_pool[i].mac_address == key) {
             return &_handshakes_pool[i];
         }
     }
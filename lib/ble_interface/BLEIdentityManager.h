@@ -241,8 +241,8 @@ private:
      */
     struct HandshakeSession {
         bool in_use = false;
-        Bytes mac_address;
-        Bytes peer_identity;
+        MacKey mac_address;
+        Hash16 peer_identity;
         HandshakeState state = HandshakeState::NONE;
         bool is_central = false;
         double started_at = 0.0;
@@ -262,8 +262,8 @@ private:
      */
     struct AddressIdentitySlot {
         bool in_use = false;
-        Bytes mac_address;    // 6-byte MAC key
-        Bytes identity;       // 16-byte identity value
+        MacKey mac_address;   // 6-byte MAC key
+        Hash16 identity;      // 16-byte identity value
 
         void clear() {
             in_use = false;
@@ -6,6 +6,8 @@
 #include "BLEInterface.h"
 #include <microReticulum/Log.h>
 #include <microReticulum/Utilities/OS.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -14,6 +16,7 @@
 
 using namespace RNS;
 using namespace RNS::BLE;
+using namespace RNS::Instrumentation;
 
 BLEInterface::BLEInterface(const char* name) : InterfaceImpl(name) {
     _IN = true;
@@ -128,6 +131,10 @@ void BLEInterface::stop() {
         _fragmenter_pool[i].clear();
     }
     _pending_handshake_count = 0;
+    for (size_t i = 0; i < _pending_data_count; i++) {
+        _pending_data_pool.deallocate(_pending_data[i]);
+        _pending_data[i] = nullptr;
+    }
     _pending_data_count = 0;
     _online = false;
 
@@ -212,7 +219,9 @@ void BLEInterface::loop() {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
         size_t requeue_count = 0;
         for (size_t i = 0; i < _pending_data_count; i++) {
-            Bytes& stored_id = _pending_data_pool[i].identity;
+            PendingData* pending = _pending_data[i];
+            _pending_data[i] = nullptr;
+            Bytes& stored_id = pending->identity;
             // Check if this entry was MAC-keyed (size 6) and try to resolve to identity
             if (stored_id.size() == Limits::MAC_SIZE) {
                 Bytes resolved = _identity_manager.getIdentityForMac(stored_id);
@@ -222,37 +231,42 @@ void BLEInterface::loop() {
                     // Expire entries that have waited longer than HANDSHAKE_TIMEOUT.
                     // If a peer sends data but never completes handshake (e.g., disconnect
                     // during handshake), these entries would stay indefinitely.
-                    if (now - _pending_data_pool[i].queued_at > Timing::HANDSHAKE_TIMEOUT) {
+                    if (now - pending->queued_at > Timing::HANDSHAKE_TIMEOUT) {
                         DEBUG("BLEInterface: Expiring stale pending data (no identity after " +
-                              std::to_string((int)(now - _pending_data_pool[i].queued_at)) + "s)");
+                              std::to_string((int)(now - pending->queued_at)) + "s)");
+                        _pending_data_pool.deallocate(pending);
+                        Metrics::add(METRIC_BLE_RX_DROPS);
                         continue;  // Drop this entry
                     }
                     // Still no identity — keep for next loop iteration
-                    if (requeue_count != i) {
-                        _pending_data_pool[requeue_count] = _pending_data_pool[i];
-                    }
-                    requeue_count++;
+                    _pending_data[requeue_count++] = pending;
                     continue;
                 }
             }
             _stat_rx_fragments++;
-            _stat_rx_bytes += _pending_data_pool[i].data.size();
-            _reassembler.processFragment(stored_id, _pending_data_pool[i].data);
+            _stat_rx_bytes += pending->data.size();
+            _rx_fragment_us = pending->queued_us;
+            _reassembler.processFragment(stored_id, pending->data);
+            _pending_data_pool.deallocate(pending);
         }
         _pending_data_count = requeue_count;
+        Metrics::set(METRIC_BLE_QUEUE_DEPTH, static_cast<int32_t>(_pending_data_count));
     }
 
     // Debug: log loop status every 10 seconds
     if (now - last_loop_log >= 10.0) {
-        char stats[160];
+        char stats[200];
         snprintf(stats, sizeof(stats),
-                 " tx_pkt=%lu tx_frag=%lu tx_b=%lu tx_fail=%lu rx_frag=%lu rx_b=%lu",
+                 " tx_pkt=%lu tx_frag=%lu tx_b=%lu tx_fail=%lu rx_frag=%lu rx_b=%lu"
+                 " slabs(reasm=%u/%u data=%u/%u)",
                  (unsigned long)_stat_tx_packets,
                  (unsigned long)_stat_tx_fragments,
                  (unsigned long)_stat_tx_bytes,
                  (unsigned long)_stat_tx_fail,
                  (unsigned long)_stat_rx_fragments,
-                 (unsigned long)_stat_rx_bytes);
+                 (unsigned long)_stat_rx_bytes,
+                 (unsigned)_reassembler.poolSlabs(), (unsigned)_reassembler.poolPeakSlabs(),
+                 (unsigned)_pending_data_pool.slabs(), (unsigned)_pending_data_pool.peak_slabs());
         INFO("BLE: running=" + std::string(_platform && _platform->isRunning() ? "yes" : "no") +
              " scanning=" + std::string(_platform && _platform->isScanning() ? "yes" : "no") +
              " connected=" + std::to_string(_peer_manager.connectedCount()) +
@@ -312,7 +326,9 @@ void BLEInterface::loop() {
 //=============================================================================
 
 bool BLEInterface::send_outgoing(const Bytes& data) {
+    EVENT_TRACE_SCOPE_V(BLE_TX, data.size());
     if (!_platform || !_platform->isRunning()) {
+        Metrics::add(METRIC_BLE_TX_DROPS);
         return false;
     }
 
@@ -321,6 +337,7 @@ bool BLEInterface::send_outgoing(const Bytes& data) {
     // retransmission at the transport layer.
     if (!_mutex.try_lock()) {
         TRACE("BLEInterface: send_outgoing skipped - BLE task busy");
+        Metrics::add(METRIC_BLE_TX_DROPS);
         return false;
     }
     std::lock_guard<std::recursive_mutex> lock(_mutex, std::adopt_lock);
@@ -330,6 +347,7 @@ bool BLEInterface::send_outgoing(const Bytes& data) {
 
     if (connected_peers.empty()) {
         TRACE("BLEInterface: No connected peers, dropping packet");
+        Metrics::add(METRIC_BLE_TX_DROPS);
         return false;
     }
 
@@ -346,7 +364,12 @@ bool BLEInterface::send_outgoing(const Bytes& data) {
     // Send to all connected peers with identity
     for (PeerInfo* peer : connected_peers) {
         if (peer->hasIdentity()) {
-            sendToPeer(peer->identity, data);
+            if (sendToPeer(peer->identity, data)) {
+                Metrics::add(METRIC_BLE_TX_PACKETS);
+                Metrics::add(METRIC_BLE_TX_BYTES, static_cast<uint32_t>(data.size()));
+            } else {
+                Metrics::add(METRIC_BLE_TX_DROPS);
+            }
         }
     }
 
@@ -866,10 +889,17 @@ void BLEInterface::onMacRotation(const Bytes& old_mac, const Bytes& new_mac, con
 void BLEInterface::onPacketReassembled(const Bytes& peer_identity, const Bytes& packet) {
     // Packet reassembly complete - pass to transport
     _peer_manager.recordPacketReceived(peer_identity);
-    handle_incoming(packet);
+    {
+        EVENT_TRACE_SCOPE_V(BLE_RX, packet.size());
+        handle_incoming(packet);
+    }
+    Metrics::add(METRIC_BLE_RX_PACKETS);
+    Metrics::add(METRIC_BLE_RX_BYTES, static_cast<uint32_t>(packet.size()));
+    Metrics::observeSince(METRIC_BLE_RX_LATENCY, _rx_fragment_us);
 }
 
 void BLEInterface::onReassemblyTimeout(const Bytes& peer_identity, const std::string& reason) {
+    Metrics::add(METRIC_BLE_RX_DROPS);
     WARNING("BLEInterface: Reassembly timeout for " +
             peer_identity.toHex().substr(0, 8) + ": " + reason);
 }
@@ -1038,8 +1068,9 @@ void BLEInterface::sendKeepalives() {
 void BLEInterface::performMaintenance() {
     std::lock_guard<std::recursive_mutex> lock(_mutex);
 
-    // Check reassembly timeouts
+    // Check reassembly timeouts (also trims idle reassembly slabs)
     _reassembler.checkTimeouts();
+    _pending_data_pool.trim(Utilities::OS::time(), PENDING_DATA_TRIM_QUIET);
 
     // Check handshake timeouts
     _identity_manager.checkTimeouts();
@@ -1107,26 +1138,32 @@ void BLEInterface::handleIncomingData(const ConnectionHandle& conn, const Bytes&
         // No identity yet - buffer data for replay after handshake completes
         // This handles the race where data arrives before deferred handshake is processed
         TRACE("BLEInterface: Buffering data from peer without identity (handshake pending)");
-        if (_pending_data_count < MAX_PENDING_DATA) {
-            PendingData& pending = _pending_data_pool[_pending_data_count];
-            pending.identity = mac;  // Use MAC as temporary key
-            pending.data = data;
-            pending.queued_at = Utilities::OS::time();
-            _pending_data_count++;
-        }
+        queuePendingData(mac, data);  // Use MAC as temporary key
         return;
     }
 
-    if (_pending_data_count >= MAX_PENDING_DATA) {
+    if (!queuePendingData(identity, data)) {
         WARNING("BLEInterface: Pending data queue full, dropping data");
-        return;
     }
+}
 
-    PendingData& pending = _pending_data_pool[_pending_data_count];
-    pending.identity = identity;
-    pending.data = data;
-    pending.queued_at = Utilities::OS::time();
-    _pending_data_count++;
+bool BLEInterface::queuePendingData(const Bytes& key, const Bytes& data) {
+    if (_pending_data_count >= MAX_PENDING_DATA) {
+        Metrics::add(METRIC_BLE_RX_DROPS);
+        return false;
+    }
+    PendingData* pending = _pending_data_pool.allocate();
+    if (!pending) {
+        Metrics::add(METRIC_BLE_RX_DROPS);
+        return false;
+    }
+    pending->identity = key;
+    pending->data = data;
+    pending->queued_at = Utilities::OS::time();
+    pending->queued_us = Metrics::nowUs();
+    _pending_data[_pending_data_count++] = pending;
+    Metrics::set(METRIC_BLE_QUEUE_DEPTH, static_cast<int32_t>(_pending_data_count));
+    return true;
 }
 
 void BLEInterface::initiateHandshake(const ConnectionHandle& conn) {
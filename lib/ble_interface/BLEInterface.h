@@ -218,6 +218,12 @@ private:
      */
     void handleIncomingData(const RNS::BLE::ConnectionHandle& conn, const RNS::Bytes& data);
 
+    /**
+     * @brief Queue a fragment for loop() processing
+     * @return false if the pending queue is full
+     */
+    bool queuePendingData(const RNS::Bytes& key, const RNS::Bytes& data);
+
     /**
      * @brief Initiate handshake for a new connection
      */
@@ -271,15 +277,23 @@ private:
     PendingHandshake _pending_handshake_pool[MAX_PENDING_HANDSHAKES];
     size_t _pending_handshake_count = 0;
 
-    // Pending data fragments (deferred from callback to loop for stack safety)
-    static constexpr size_t MAX_PENDING_DATA = 8;
+    // Pending data fragments (deferred from callback to loop for stack safety).
+    // FIFO of pointers into a slab pool, so a burst of fragments from several
+    // peers queues up instead of being dropped; slabs are trimmed once idle.
+    static constexpr size_t PENDING_DATA_SLAB_SLOTS = 8;
+    static constexpr size_t PENDING_DATA_MAX_SLABS = 4;
+    static constexpr size_t MAX_PENDING_DATA = PENDING_DATA_SLAB_SLOTS * PENDING_DATA_MAX_SLABS;
+    static constexpr double PENDING_DATA_TRIM_QUIET = 30.0;
     struct PendingData {
         RNS::Bytes identity;
         RNS::Bytes data;
         double queued_at = 0;  // Timestamp for expiry of unresolvable entries
+        uint32_t queued_us = 0;  // Metrics::nowUs() at arrival, for rx latency
     };
-    PendingData _pending_data_pool[MAX_PENDING_DATA];
+    RNS::SegmentedObjectPool<PendingData, PENDING_DATA_SLAB_SLOTS, PENDING_DATA_MAX_SLABS> _pending_data_pool;
+    PendingData* _pending_data[MAX_PENDING_DATA] = {};
     size_t _pending_data_count = 0;
+    uint32_t _rx_fragment_us = 0;  // Arrival stamp of the fragment being reassembled
 
     // Diagnostic counters — included in the periodic BLE heartbeat
     // log so we can see "did fragments actually flow over a peer
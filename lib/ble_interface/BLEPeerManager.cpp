@@ -587,7 +587,7 @@ void BLEPeerManager::cleanupStalePeers(double max_age) {
         if (peer.state == PeerState::DISCOVERED) {
             double age = now - peer.last_seen;
             if (age > max_age) {
-                Bytes mac = _peers_by_mac_only_pool[i].mac_address;
+                MacKey mac = _peers_by_mac_only_pool[i].mac_address;
                 _peers_by_mac_only_pool[i].clear();
                 char buf[80];
                 snprintf(buf, sizeof(buf), "BLEPeerManager: Removed stale peer %s",
@@ -732,10 +732,11 @@ void BLEPeerManager::promoteToIdentityKeyed(const Bytes& mac_address, const Byte
 
 BLEPeerManager::PeerByIdentitySlot* BLEPeerManager::findPeerByIdentitySlot(const Bytes& identity) {
     if (identity.size() != Limits::IDENTITY_SIZE) return nullptr;
+    const Hash16 key(identity);
 
     for (size_t i = 0; i < PEERS_POOL_SIZE; i++) {
         if (_peers_by_identity_pool[i].in_use &&
-            _peers_by_identity_pool[i].identity_hash == identity) {
+            _peers_by_identity_pool[i].identity_hash == key) {
             return &_peers_by_identity_pool[i];
         }
     }
@@ -768,11 +769,12 @@ size_t BLEPeerManager::peersByIdentityCount() const {
 //=============================================================================
 
 BLEPeerManager::PeerByMacSlot* BLEPeerManager::findPeerByMacSlot(const Bytes& mac) {
-    if (mac.size() < Limits::MAC_SIZE) return nullptr;
+    if (mac.size() != Limits::MAC_SIZE) return nullptr;
+    const MacKey key(mac);
 
     for (size_t i = 0; i < PEERS_POOL_SIZE; i++) {
         if (_peers_by_mac_only_pool[i].in_use &&
-            _peers_by_mac_only_pool[i].mac_address == mac) {
+            _peers_by_mac_only_pool[i].mac_address == key) {
             return &_peers_by_mac_only_pool[i];
         }
     }
@@ -805,11 +807,12 @@ size_t BLEPeerManager::peersByMacOnlyCount() const {
 //=============================================================================
 
 BLEPeerManager::MacToIdentitySlot* BLEPeerManager::findMacToIdentitySlot(const Bytes& mac) {
-    if (mac.size() < Limits::MAC_SIZE) return nullptr;
+    if (mac.size() != Limits::MAC_SIZE) return nullptr;
+    const MacKey key(mac);
 
     for (size_t i = 0; i < MAC_IDENTITY_POOL_SIZE; i++) {
         if (_mac_to_identity_pool[i].in_use &&
-            _mac_to_identity_pool[i].mac_address == mac) {
+            _mac_to_identity_pool[i].mac_address == key) {
             return &_mac_to_identity_pool[i];
         }
     }
@@ -860,7 +863,7 @@ void BLEPeerManager::removeMacToIdentity(const Bytes& mac) {
 Bytes BLEPeerManager::getIdentityForMac(const Bytes& mac) const {
     const MacToIdentitySlot* slot = findMacToIdentitySlot(mac);
     if (slot) {
-        return slot->identity;
+        return slot->identity.toBytes();
     }
     return Bytes();
 }
@@ -99,7 +99,7 @@ public:
      */
     struct PeerByIdentitySlot {
         bool in_use = false;
-        Bytes identity_hash;  // 16-byte identity key
+        Hash16 identity_hash; // 16-byte identity key
         PeerInfo peer;        // value
 
         void clear() {
@@ -114,7 +114,7 @@ public:
      */
     struct PeerByMacSlot {
         bool in_use = false;
-        Bytes mac_address;    // 6-byte MAC key
+        MacKey mac_address;   // 6-byte MAC key
         PeerInfo peer;        // value
 
         void clear() {
@@ -129,8 +129,8 @@ public:
      */
     struct MacToIdentitySlot {
         bool in_use = false;
-        Bytes mac_address;    // 6-byte MAC key
-        Bytes identity;       // 16-byte identity value
+        MacKey mac_address;   // 6-byte MAC key
+        Hash16 identity;      // 16-byte identity value
 
         void clear() {
             in_use = false;
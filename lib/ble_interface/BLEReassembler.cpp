@@ -3,6 +3,7 @@
  * @brief BLE-Reticulum Protocol v2.2 fragment reassembler implementation
  *
  * Uses fixed-size pools instead of STL containers to eliminate heap fragmentation.
+ * Session slots come from a SegmentedObjectPool that grows in PSRAM slabs.
  */
 
 #include "BLEReassembler.h"
@@ -13,52 +14,70 @@ namespace RNS { namespace BLE {
 BLEReassembler::BLEReassembler() {
     // Default timeout from protocol spec
     _timeout_seconds = Timing::REASSEMBLY_TIMEOUT;
-    // Initialize pool
+}
+
+BLEReassembler::~BLEReassembler() {
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        _pending_pool[i].clear();
+        if (_pending[i]) {
+            releaseSlot(_pending[i]);
+        }
     }
 }
 
-BLEReassembler::PendingReassemblySlot* BLEReassembler::findSlot(const Bytes& peer_identity) {
+BLEReassembler::PendingReassemblySlot* BLEReassembler::findSlot(const Hash16& peer_identity) {
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        if (_pending_pool[i].in_use && _pending_pool[i].transfer_id == peer_identity) {
-            return &_pending_pool[i];
+        if (_pending[i] && _pending[i]->transfer_id == peer_identity) {
+            return _pending[i];
         }
     }
     return nullptr;
 }
 
-const BLEReassembler::PendingReassemblySlot* BLEReassembler::findSlot(const Bytes& peer_identity) const {
+const BLEReassembler::PendingReassemblySlot* BLEReassembler::findSlot(const Hash16& peer_identity) const {
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        if (_pending_pool[i].in_use && _pending_pool[i].transfer_id == peer_identity) {
-            return &_pending_pool[i];
+        if (_pending[i] && _pending[i]->transfer_id == peer_identity) {
+            return _pending[i];
         }
     }
     return nullptr;
 }
 
-BLEReassembler::PendingReassemblySlot* BLEReassembler::allocateSlot(const Bytes& peer_identity) {
+BLEReassembler::PendingReassemblySlot* BLEReassembler::allocateSlot(const Hash16& peer_identity) {
     // First check if slot already exists for this peer
     PendingReassemblySlot* existing = findSlot(peer_identity);
     if (existing) {
         return existing;
     }
 
-    // Find a free slot
+    // Find a free entry and back it with a pooled slot
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        if (!_pending_pool[i].in_use) {
-            _pending_pool[i].in_use = true;
-            _pending_pool[i].transfer_id = peer_identity;
-            return &_pending_pool[i];
+        if (!_pending[i]) {
+            PendingReassemblySlot* slot = _pending_pool.allocate();
+            if (!slot) {
+                return nullptr;  // Pool is full (slab ceiling or out of memory)
+            }
+            slot->transfer_id = peer_identity;
+            _pending[i] = slot;
+            return slot;
         }
     }
     return nullptr;  // Pool is full
 }
 
+void BLEReassembler::releaseSlot(PendingReassemblySlot* slot) {
+    for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
+        if (_pending[i] == slot) {
+            _pending[i] = nullptr;
+            _pending_pool.deallocate(slot);
+            return;
+        }
+    }
+}
+
 size_t BLEReassembler::pendingCount() const {
     size_t count = 0;
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        if (_pending_pool[i].in_use) {
+        if (_pending[i]) {
             count++;
         }
     }
@@ -93,40 +112,48 @@ bool BLEReassembler::processFragment(const Bytes& peer_identity, const Bytes& fr
         return false;
     }
 
+    // Hash16 holds identities (16) and unresolved MACs (6); anything longer
+    // would collapse to the empty key and collide with other peers
+    const Hash16 key(peer_identity);
+    if (key.empty()) {
+        WARNING("BLEReassembler: Peer key empty or longer than 16 bytes, discarding");
+        return false;
+    }
+
     double now = Utilities::OS::time();
 
     // Handle START fragment - begins a new reassembly
     if (type == Fragment::START) {
         // Clear any existing incomplete reassembly for this peer
-        PendingReassemblySlot* existing = findSlot(peer_identity);
+        PendingReassemblySlot* existing = findSlot(key);
         if (existing) {
             TRACE("BLEReassembler: Discarding incomplete reassembly for new START");
-            existing->clear();
+            releaseSlot(existing);
         }
 
         // Start new reassembly
-        if (!startReassembly(peer_identity, total_fragments)) {
+        if (!startReassembly(key, total_fragments)) {
             return false;
         }
     }
 
     // Look up pending reassembly
-    PendingReassemblySlot* slot = findSlot(peer_identity);
+    PendingReassemblySlot* slot = findSlot(key);
     if (!slot) {
         // No pending reassembly and this isn't a START
         if (type != Fragment::START) {
             // For single-fragment packets (type=END, total=1, seq=0), start immediately
             if (type == Fragment::END && total_fragments == 1 && sequence == 0) {
-                if (!startReassembly(peer_identity, total_fragments)) {
+                if (!startReassembly(key, total_fragments)) {
                     return false;
                 }
-                slot = findSlot(peer_identity);
+                slot = findSlot(key);
             } else {
                 TRACE("BLEReassembler: Received fragment without START, discarding");
                 return false;
             }
         } else {
-            slot = findSlot(peer_identity);
+            slot = findSlot(key);
         }
     }
 
@@ -197,8 +224,8 @@ bool BLEReassembler::processFragment(const Bytes& peer_identity, const Bytes& fr
         }
 
         // Remove from pending before callback (callback might trigger new data)
-        Bytes identity_copy = reassembly.peer_identity;
-        slot->clear();
+        Bytes identity_copy = reassembly.peer_identity.toBytes();
+        releaseSlot(slot);
 
         // Invoke callback
         if (_reassembly_callback) {
@@ -214,11 +241,11 @@ void BLEReassembler::checkTimeouts() {
 
     // Find and clean up expired reassemblies
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        if (!_pending_pool[i].in_use) {
+        if (!_pending[i]) {
             continue;
         }
 
-        PendingReassembly& reassembly = _pending_pool[i].reassembly;
+        PendingReassembly& reassembly = _pending[i]->reassembly;
         double age = now - reassembly.started_at;
 
         if (age > _timeout_seconds) {
@@ -230,10 +257,10 @@ void BLEReassembler::checkTimeouts() {
             }
 
             // Copy identity before clearing
-            Bytes peer_identity = _pending_pool[i].transfer_id;
+            Bytes peer_identity = _pending[i]->transfer_id.toBytes();
 
             // Clear the slot
-            _pending_pool[i].clear();
+            releaseSlot(_pending[i]);
 
             // Invoke timeout callback after clearing (callback might start new reassembly)
             if (_timeout_callback) {
@@ -241,13 +268,16 @@ void BLEReassembler::checkTimeouts() {
             }
         }
     }
+
+    // Give back slabs left over from a burst
+    _pending_pool.trim(now, POOL_TRIM_QUIET);
 }
 
 void BLEReassembler::clearForPeer(const Bytes& peer_identity) {
     PendingReassemblySlot* slot = findSlot(peer_identity);
     if (slot) {
         TRACE("BLEReassembler: Clearing pending reassembly for peer");
-        slot->clear();
+        releaseSlot(slot);
     }
 }
 
@@ -256,7 +286,9 @@ void BLEReassembler::clearAll() {
     snprintf(buf, sizeof(buf), "BLEReassembler: Clearing all pending reassemblies (%zu sessions)", pendingCount());
     TRACE(buf);
     for (size_t i = 0; i < MAX_PENDING_REASSEMBLIES; i++) {
-        _pending_pool[i].clear();
+        if (_pending[i]) {
+            releaseSlot(_pending[i]);
+        }
     }
 }
 
@@ -264,7 +296,7 @@ bool BLEReassembler::hasPending(const Bytes& peer_identity) const {
     return findSlot(peer_identity) != nullptr;
 }
 
-bool BLEReassembler::startReassembly(const Bytes& peer_identity, uint16_t total_fragments) {
+bool BLEReassembler::startReassembly(const Hash16& peer_identity, uint16_t total_fragments) {
     // Validate fragment count fits in fixed-size array
     if (total_fragments > MAX_FRAGMENTS_PER_REASSEMBLY) {
         char buf[80];
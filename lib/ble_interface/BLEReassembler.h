@@ -7,10 +7,13 @@
  * This class has no BLE dependencies and can be used for testing on native builds.
  *
  * The reassembler is keyed by peer identity (16 bytes), not MAC address,
- * to survive BLE MAC address rotation.
+ * to survive BLE MAC address rotation. Keys are held inline as Hash16 (a
+ * 6-byte MAC also fits, for peers whose identity is not known yet).
  *
  * Uses fixed-size pools instead of STL containers to eliminate heap fragmentation
- * on embedded systems.
+ * on embedded systems. Session state comes from a SegmentedObjectPool: PSRAM
+ * slabs are added while a burst of peers is mid-transfer and returned once
+ * they have been idle for POOL_TRIM_QUIET seconds.
  */
 #pragma once
 
@@ -18,6 +21,8 @@
 #include "BLEFragmenter.h"
 #include <microReticulum/Bytes.h>
 #include <microReticulum/Utilities/OS.h>
+#include <ObjectPool.h>
+#include <FixedHash.h>
 
 #include <functional>
 #include <cstdint>
@@ -26,7 +31,10 @@
 namespace RNS { namespace BLE {
 
 // Pool sizing constants for fixed-size allocations
-static constexpr size_t MAX_PENDING_REASSEMBLIES = 4;
+// Sessions are ~4.3KB each; two per slab, slabs added on demand.
+static constexpr size_t REASSEMBLY_SLAB_SLOTS = 2;
+static constexpr size_t REASSEMBLY_MAX_SLABS = 8;
+static constexpr size_t MAX_PENDING_REASSEMBLIES = REASSEMBLY_SLAB_SLOTS * REASSEMBLY_MAX_SLABS;
 static constexpr size_t MAX_FRAGMENTS_PER_REASSEMBLY = 8;
 static constexpr size_t MAX_FRAGMENT_PAYLOAD_SIZE = 512;
 
@@ -51,6 +59,10 @@ public:
      * @brief Construct a reassembler with default timeout
      */
     BLEReassembler();
+    ~BLEReassembler();
+
+    BLEReassembler(const BLEReassembler&) = delete;
+    BLEReassembler& operator=(const BLEReassembler&) = delete;
 
     /**
      * @brief Set callback for successfully reassembled packets
@@ -83,10 +95,17 @@ public:
      * @brief Check for timed-out reassemblies and clean them up
      *
      * Should be called periodically from the interface loop().
-     * Invokes timeout callback for each expired reassembly.
+     * Invokes timeout callback for each expired reassembly, then returns
+     * session slabs that have been empty for POOL_TRIM_QUIET seconds.
      */
     void checkTimeouts();
 
+    /**
+     * @brief Slabs currently backing the session pool (for diagnostics)
+     */
+    size_t poolSlabs() const { return _pending_pool.slabs(); }
+    size_t poolPeakSlabs() const { return _pending_pool.peak_slabs(); }
+
     /**
      * @brief Get count of pending (incomplete) reassemblies
      */
@@ -127,7 +146,7 @@ private:
      * @brief State for a pending (incomplete) reassembly (fixed-size)
      */
     struct PendingReassembly {
-        Bytes peer_identity;
+        Hash16 peer_identity;
         uint16_t total_fragments = 0;
         uint16_t received_count = 0;
         FragmentInfo fragments[MAX_FRAGMENTS_PER_REASSEMBLY];
@@ -135,7 +154,7 @@ private:
         double last_activity = 0.0;
 
         void clear() {
-            peer_identity = Bytes();
+            peer_identity.clear();
             total_fragments = 0;
             received_count = 0;
             for (size_t i = 0; i < MAX_FRAGMENTS_PER_REASSEMBLY; i++) {
@@ -147,32 +166,33 @@ private:
     };
 
     /**
-     * @brief Slot in the fixed-size pool for pending reassemblies
+     * @brief Slot in the session pool for pending reassemblies
      */
     struct PendingReassemblySlot {
-        bool in_use = false;
-        Bytes transfer_id;  // key (peer_identity)
+        Hash16 transfer_id;  // key (peer_identity)
         PendingReassembly reassembly;
-
-        void clear() {
-            in_use = false;
-            transfer_id = Bytes();
-            reassembly.clear();
-        }
     };
 
+    // Empty session slabs are returned after this long
+    static constexpr double POOL_TRIM_QUIET = 60.0;
+
     /**
      * @brief Find a slot by peer identity
      * @return Pointer to slot or nullptr if not found
      */
-    PendingReassemblySlot* findSlot(const Bytes& peer_identity);
-    const PendingReassemblySlot* findSlot(const Bytes& peer_identity) const;
+    PendingReassemblySlot* findSlot(const Hash16& peer_identity);
+    const PendingReassemblySlot* findSlot(const Hash16& peer_identity) const;
 
     /**
      * @brief Allocate a new slot for a peer
      * @return Pointer to slot or nullptr if pool is full
      */
-    PendingReassemblySlot* allocateSlot(const Bytes& peer_identity);
+    PendingReassemblySlot* allocateSlot(const Hash16& peer_identity);
+
+    /**
+     * @brief Drop a session and return its slot to the pool
+     */
+    void releaseSlot(PendingReassemblySlot* slot);
 
     /**
      * @brief Concatenate all fragments in order to produce the complete packet
@@ -183,10 +203,11 @@ private:
      * @brief Start a new reassembly session
      * @return true if started, false if pool is full or too many fragments
      */
-    bool startReassembly(const Bytes& peer_identity, uint16_t total_fragments);
+    bool startReassembly(const Hash16& peer_identity, uint16_t total_fragments);
 
-    // Fixed-size pool of pending reassemblies
-    PendingReassemblySlot _pending_pool[MAX_PENDING_REASSEMBLIES];
+    // Active sessions (nullptr = free entry), backed by slab-allocated slots
+    PendingReassemblySlot* _pending[MAX_PENDING_REASSEMBLIES] = {};
+    SegmentedObjectPool<PendingReassemblySlot, REASSEMBLY_SLAB_SLOTS, REASSEMBLY_MAX_SLABS> _pending_pool;
 
     // Callbacks
     ReassemblyCallback _reassembly_callback = nullptr;
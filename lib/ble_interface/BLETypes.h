@@ -10,6 +10,7 @@
 
 #include <microReticulum/Bytes.h>
 #include <microReticulum/Log.h>
+#include <FixedHash.h>
 
 #include <functional>
 #include <memory>
@@ -93,6 +94,9 @@ namespace Limits {
     static constexpr uint8_t BLACKLIST_MAX_MULTIPLIER = 8;    // Max 2^n backoff multiplier
 }
 
+// Inline key for slot tables keyed by MAC (identities use Hash16)
+using MacKey = FixedHash<Limits::MAC_SIZE>;
+
 //=============================================================================
 // Peer Scoring Weights (v2.2 spec)
 //=============================================================================
@@ -2,13 +2,19 @@
  * @file lv_mem_hybrid.h
  * @brief Hybrid memory allocator for LVGL
  *
- * Uses internal RAM for small allocations (fast, good for UI responsiveness)
- * and PSRAM for large allocations (preserves internal heap for BLE/network).
+ * Small allocations (<= 256 bytes) come from the LVGL slab allocator: a
+ * region of internal RAM reserved at boot and split into size classes, so
+ * lv_obj_clean() churn can't fragment the general internal heap.
+ * Large allocations, and small ones the slab can't fit, go to PSRAM
+ * (preserves internal heap for BLE/network/LXST).
  */
 #pragma once
 
 #include <esp_heap_caps.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "lv_mem_slab/lv_mem_slab.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,29 +24,34 @@ extern "C" {
  * Lowered 1024->256 (2026-06-24): pushes most small LVGL objects (styles, obj
  * metadata, labels, anim descriptors) into PSRAM, de-fragmenting the scarce
  * ~57-66KB internal block so the LXST audio pipeline can allocate reliably
- * during a call. UI alloc latency on PSRAM is imperceptible. */
-#define LV_MEM_HYBRID_PSRAM_THRESHOLD 256
+ * during a call. UI alloc latency on PSRAM is imperceptible.
+ * Below the threshold the slab region serves requests (2026-10); small
+ * objects no longer reach the general internal heap. */
+#define LV_MEM_HYBRID_PSRAM_THRESHOLD LV_MEM_SLAB_MAX_SIZE
 
 static inline void* lv_mem_hybrid_alloc(size_t size) {
     void* ptr;
 
-    if (size >= LV_MEM_HYBRID_PSRAM_THRESHOLD) {
-        /* Large allocation -> PSRAM */
-        ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (size <= LV_MEM_HYBRID_PSRAM_THRESHOLD) {
+        /* Small allocation -> reserved internal slab region */
+        ptr = lv_mem_slab_alloc(size);
         if (ptr) return ptr;
-        /* Fall back to internal if PSRAM fails */
     }
+    lv_mem_slab_note_fallback(size);
 
-    /* Small allocation or PSRAM fallback -> internal RAM */
-    ptr = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    /* Large allocation or slab full -> PSRAM */
+    ptr = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
     if (ptr) return ptr;
 
-    /* Last resort: try PSRAM for small allocs if internal is exhausted */
-    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    /* Last resort: internal RAM if PSRAM is exhausted */
+    return heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
 }
 
 static inline void lv_mem_hybrid_free(void* ptr) {
-    if (ptr) {
+    if (!ptr) return;
+    if (lv_mem_slab_owns(ptr)) {
+        lv_mem_slab_free(ptr);
+    } else {
         heap_caps_free(ptr);
     }
 }
@@ -55,24 +66,27 @@ static inline void* lv_mem_hybrid_realloc(void* ptr, size_t size) {
         return NULL;
     }
 
-    /* heap_caps_realloc has libc realloc semantics and can move an allocation
-     * between capability sets while preserving min(old_size, size) bytes. */
-    const uint32_t preferred_caps =
-        (size >= LV_MEM_HYBRID_PSRAM_THRESHOLD
-             ? MALLOC_CAP_SPIRAM
-             : MALLOC_CAP_INTERNAL) |
-        MALLOC_CAP_8BIT;
-    const uint32_t fallback_caps =
-        (size >= LV_MEM_HYBRID_PSRAM_THRESHOLD
-             ? MALLOC_CAP_INTERNAL
-             : MALLOC_CAP_SPIRAM) |
-        MALLOC_CAP_8BIT;
+    if (lv_mem_slab_owns(ptr)) {
+        /* Slab blocks have a fixed class size: shrink in place, otherwise
+         * move. On failure the old block is untouched, as realloc requires. */
+        size_t old_size = lv_mem_slab_block_size(ptr);
+        if (size <= old_size) return ptr;
+        void* new_ptr = lv_mem_hybrid_alloc(size);
+        if (!new_ptr) return NULL;
+        memcpy(new_ptr, ptr, old_size);
+        lv_mem_slab_free(ptr);
+        return new_ptr;
+    }
 
-    void* new_ptr = heap_caps_realloc(ptr, size, preferred_caps);
+    /* heap_caps_realloc has libc realloc semantics and can move an allocation
+     * between capability sets while preserving min(old_size, size) bytes.
+     * Heap blocks stay on the heap (the old size isn't known here), PSRAM
+     * first so a grown fallback never lands in internal RAM by default. */
+    void* new_ptr = heap_caps_realloc(ptr, size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
     if (new_ptr) return new_ptr;
 
     /* realloc failure leaves ptr valid, so trying the alternate heap is safe. */
-    return heap_caps_realloc(ptr, size, fallback_caps);
+    return heap_caps_realloc(ptr, size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
 }
 
 #ifdef __cplusplus
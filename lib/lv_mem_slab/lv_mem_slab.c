@@ -0,0 +1,229 @@
+/**
+ * @file lv_mem_slab.c
+ * @brief Size-class slab allocator for small LVGL objects (see lv_mem_slab.h)
+ *
+ * Layout: the region is LV_MEM_SLAB_PAGE_COUNT pages of 1KB. Per-page
+ * metadata (class, blocks in use, intrusive free list) lives in static
+ * arrays beside the region so blocks stay 16-byte aligned and a free needs
+ * only an address range check and a shift to find its page.
+ *
+ * Kept C (and C++-compatible) because lv_mem.c calls it through lv_conf.h.
+ */
+
+#include "lv_mem_slab.h"
+
+#include <string.h>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+#define SLAB_LOCK() portENTER_CRITICAL(&s_lock)
+#define SLAB_UNLOCK() portEXIT_CRITICAL(&s_lock)
+#define SLAB_REGION_ALLOC(n) heap_caps_aligned_alloc(16, (n), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#else
+/* Native tests: LVGL is single-threaded there */
+#include <stdlib.h>
+#define SLAB_LOCK() do { } while (0)
+#define SLAB_UNLOCK() do { } while (0)
+#define SLAB_REGION_ALLOC(n) aligned_alloc(16, (n))
+#endif
+
+#define PAGE_UNASSIGNED 0xFF
+
+static const uint16_t k_class_size[LV_MEM_SLAB_CLASS_COUNT] = {
+    16, 32, 48, 64, 96, 128, 192, 256
+};
+
+typedef struct free_block {
+    struct free_block* next;
+} free_block_t;
+
+static uint8_t* s_region = NULL;
+static bool s_init_attempted = false;
+
+static uint8_t s_page_class[LV_MEM_SLAB_PAGE_COUNT];
+static uint16_t s_page_used[LV_MEM_SLAB_PAGE_COUNT];
+static free_block_t* s_page_free[LV_MEM_SLAB_PAGE_COUNT];
+
+static uint16_t s_class_hint[LV_MEM_SLAB_CLASS_COUNT];   /* Last page that had room */
+static uint32_t s_class_in_use[LV_MEM_SLAB_CLASS_COUNT];
+static uint32_t s_class_peak[LV_MEM_SLAB_CLASS_COUNT];
+static uint32_t s_class_fallbacks[LV_MEM_SLAB_CLASS_COUNT];
+static uint32_t s_large_allocs = 0;
+
+static int class_for(size_t size) {
+    for (int c = 0; c < LV_MEM_SLAB_CLASS_COUNT; c++) {
+        if (size <= k_class_size[c]) return c;
+    }
+    return -1;
+}
+
+static uint16_t blocks_per_page(int cls) {
+    return (uint16_t)(LV_MEM_SLAB_PAGE_BYTES / k_class_size[cls]);
+}
+
+static uint8_t* page_base(size_t page) {
+    return s_region + page * LV_MEM_SLAB_PAGE_BYTES;
+}
+
+/* Hand an unassigned page to a class and thread its free list. Lock held. */
+static void assign_page(size_t page, int cls) {
+    uint16_t count = blocks_per_page(cls);
+    uint16_t size = k_class_size[cls];
+    uint8_t* base = page_base(page);
+    free_block_t* head = NULL;
+    for (int i = count - 1; i >= 0; i--) {
+        free_block_t* b = (free_block_t*)(base + (size_t)i * size);
+        b->next = head;
+        head = b;
+    }
+    s_page_class[page] = (uint8_t)cls;
+    s_page_used[page] = 0;
+    s_page_free[page] = head;
+}
+
+bool lv_mem_slab_init(void) {
+    if (s_init_attempted) return s_region != NULL;
+    s_init_attempted = true;
+    s_region = (uint8_t*)SLAB_REGION_ALLOC(LV_MEM_SLAB_REGION_BYTES);
+    for (size_t p = 0; p < LV_MEM_SLAB_PAGE_COUNT; p++) {
+        s_page_class[p] = PAGE_UNASSIGNED;
+        s_page_used[p] = 0;
+        s_page_free[p] = NULL;
+    }
+    return s_region != NULL;
+}
+
+void* lv_mem_slab_alloc(size_t size) {
+    if (size == 0) return NULL;
+    int cls = class_for(size);
+    if (cls < 0) return NULL;
+    if (!s_init_attempted) lv_mem_slab_init();
+    if (!s_region) return NULL;
+
+    SLAB_LOCK();
+    size_t page = s_class_hint[cls];
+    if (s_page_class[page] != cls || !s_page_free[page]) {
+        /* Hint is stale: first page of this class with room, else a new page */
+        size_t spare = LV_MEM_SLAB_PAGE_COUNT;
+        page = LV_MEM_SLAB_PAGE_COUNT;
+        for (size_t p = 0; p < LV_MEM_SLAB_PAGE_COUNT; p++) {
+            if (s_page_class[p] == cls && s_page_free[p]) {
+                page = p;
+                break;
+            }
+            if (spare == LV_MEM_SLAB_PAGE_COUNT && s_page_class[p] == PAGE_UNASSIGNED) {
+                spare = p;
+            }
+        }
+        if (page == LV_MEM_SLAB_PAGE_COUNT) {
+            if (spare == LV_MEM_SLAB_PAGE_COUNT) {
+                SLAB_UNLOCK();
+                return NULL;
+            }
+            page = spare;
+            assign_page(page, cls);
+        }
+        s_class_hint[cls] = (uint16_t)page;
+    }
+
+    free_block_t* b = s_page_free[page];
+    s_page_free[page] = b->next;
+    s_page_used[page]++;
+    if (++s_class_in_use[cls] > s_class_peak[cls]) {
+        s_class_peak[cls] = s_class_in_use[cls];
+    }
+    SLAB_UNLOCK();
+    return b;
+}
+
+void lv_mem_slab_free(void* ptr) {
+    if (!lv_mem_slab_owns(ptr)) return;
+    size_t page = (size_t)((uint8_t*)ptr - s_region) / LV_MEM_SLAB_PAGE_BYTES;
+
+    SLAB_LOCK();
+    uint8_t cls = s_page_class[page];
+    if (cls == PAGE_UNASSIGNED || s_page_used[page] == 0) {
+        SLAB_UNLOCK();
+        return;  /* Stray pointer or a page already released; ignore */
+    }
+    free_block_t* b = (free_block_t*)ptr;
+    b->next = s_page_free[page];
+    s_page_free[page] = b;
+    s_class_in_use[cls]--;
+    if (--s_page_used[page] == 0) {
+        /* Whole page free: give it back so any class can use it */
+        s_page_class[page] = PAGE_UNASSIGNED;
+        s_page_free[page] = NULL;
+    }
+    SLAB_UNLOCK();
+}
+
+bool lv_mem_slab_owns(const void* ptr) {
+    const uint8_t* p = (const uint8_t*)ptr;
+    return s_region && p >= s_region && p < s_region + LV_MEM_SLAB_REGION_BYTES;
+}
+
+size_t lv_mem_slab_block_size(const void* ptr) {
+    if (!lv_mem_slab_owns(ptr)) return 0;
+    size_t page = (size_t)((const uint8_t*)ptr - s_region) / LV_MEM_SLAB_PAGE_BYTES;
+    uint8_t cls = s_page_class[page];
+    return cls == PAGE_UNASSIGNED ? 0 : k_class_size[cls];
+}
+
+void lv_mem_slab_note_fallback(size_t size) {
+    int cls = class_for(size);
+    SLAB_LOCK();
+    if (cls >= 0) s_class_fallbacks[cls]++;
+    else s_large_allocs++;
+    SLAB_UNLOCK();
+}
+
+void lv_mem_slab_get_stats(lv_mem_slab_stats_t* stats,
+                           lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT]) {
+    uint16_t pages[LV_MEM_SLAB_CLASS_COUNT] = {0};
+    uint16_t pages_free = 0;
+
+    SLAB_LOCK();
+    for (size_t p = 0; p < LV_MEM_SLAB_PAGE_COUNT; p++) {
+        if (!s_region || s_page_class[p] == PAGE_UNASSIGNED) pages_free++;
+        else pages[s_page_class[p]]++;
+    }
+    uint32_t blocks_total = 0;
+    uint32_t in_use_total = 0;
+    for (int c = 0; c < LV_MEM_SLAB_CLASS_COUNT; c++) {
+        uint32_t blocks = (uint32_t)pages[c] * blocks_per_page(c);
+        blocks_total += blocks;
+        in_use_total += s_class_in_use[c];
+        if (classes) {
+            classes[c].block_size = k_class_size[c];
+            classes[c].pages = pages[c];
+            classes[c].blocks = blocks;
+            classes[c].in_use = s_class_in_use[c];
+            classes[c].peak = s_class_peak[c];
+            classes[c].fallbacks = s_class_fallbacks[c];
+        }
+    }
+    SLAB_UNLOCK();
+
+    if (stats) {
+        stats->region_bytes = s_region ? LV_MEM_SLAB_REGION_BYTES : 0;
+        stats->pages_total = LV_MEM_SLAB_PAGE_COUNT;
+        stats->pages_free = pages_free;
+        stats->fragmentation = blocks_total
+            ? (uint8_t)(((blocks_total - in_use_total) * 100) / blocks_total)
+            : 0;
+        stats->large_allocs = s_large_allocs;
+    }
+}
+
+void lv_mem_slab_reset_peaks(void) {
+    SLAB_LOCK();
+    for (int c = 0; c < LV_MEM_SLAB_CLASS_COUNT; c++) {
+        s_class_peak[c] = s_class_in_use[c];
+        s_class_fallbacks[c] = 0;
+    }
+    s_large_allocs = 0;
+    SLAB_UNLOCK();
+}
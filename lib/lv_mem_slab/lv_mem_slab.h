@@ -0,0 +1,94 @@
+/**
+ * @file lv_mem_slab.h
+ * @brief Size-class slab allocator for small LVGL objects
+ *
+ * lv_obj_clean() rebuilds in ConversationListScreen/ChatScreen create and
+ * destroy thousands of 16-256 byte objects. Served from the general internal
+ * heap they fragment the ~60KB block the LXST pipeline needs during a call.
+ *
+ * This allocator reserves one internal-RAM region at boot and splits it into
+ * 1KB pages. A page is handed to one size class (16..256 bytes) when that
+ * class needs room and goes back to the free-page list once every block on it
+ * is freed, so UI churn only ever reshuffles its own region. When the region
+ * is full, requests fall back to PSRAM. Nothing from LVGL's small objects
+ * touches the general internal heap after boot.
+ *
+ * Used by lv_mem_hybrid.h; not called directly by UI code. Stats are read by
+ * the [LVMEM] diagnostics line and the T:LVMEM test hook.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Reserved internal region. 16KB covers the steady-state widget tree of the
+ * busiest screens; a burst beyond it spills to PSRAM, not internal heap. */
+#ifndef LV_MEM_SLAB_REGION_BYTES
+#define LV_MEM_SLAB_REGION_BYTES (16 * 1024)
+#endif
+
+#define LV_MEM_SLAB_PAGE_BYTES 1024
+#define LV_MEM_SLAB_PAGE_COUNT (LV_MEM_SLAB_REGION_BYTES / LV_MEM_SLAB_PAGE_BYTES)
+#define LV_MEM_SLAB_CLASS_COUNT 8
+#define LV_MEM_SLAB_MAX_SIZE 256
+
+typedef struct {
+    uint16_t block_size;     /* Class size in bytes */
+    uint16_t pages;          /* Pages currently assigned to this class */
+    uint32_t blocks;         /* Blocks on those pages */
+    uint32_t in_use;         /* Blocks handed out */
+    uint32_t peak;           /* High-water mark of in_use */
+    uint32_t fallbacks;      /* Requests of this class served from PSRAM */
+} lv_mem_slab_class_stats_t;
+
+typedef struct {
+    uint32_t region_bytes;   /* 0 if the region could not be reserved */
+    uint16_t pages_total;
+    uint16_t pages_free;
+    uint8_t fragmentation;   /* % of blocks on assigned pages that are free */
+    uint32_t large_allocs;   /* > LV_MEM_SLAB_MAX_SIZE requests (PSRAM path) */
+} lv_mem_slab_stats_t;
+
+/**
+ * Reserve the internal region. Call before lv_init() so the region is
+ * carved out before the heap fragments; alloc also calls it lazily.
+ * Returns false if the region could not be reserved (everything then goes
+ * to PSRAM).
+ */
+bool lv_mem_slab_init(void);
+
+/**
+ * Allocate from the size class that fits. Returns NULL for size 0, for
+ * size > LV_MEM_SLAB_MAX_SIZE, or when the class has no room and no free
+ * page is left; the caller then falls back to PSRAM.
+ */
+void* lv_mem_slab_alloc(size_t size);
+
+/* Return a block. Only valid for pointers where lv_mem_slab_owns() is true. */
+void lv_mem_slab_free(void* ptr);
+
+/* True if ptr lies inside the reserved region */
+bool lv_mem_slab_owns(const void* ptr);
+
+/* Usable size of a slab block (its class size); 0 if not owned */
+size_t lv_mem_slab_block_size(const void* ptr);
+
+/* Count a request served from PSRAM: a slab class fallback, or a large
+ * allocation if size > LV_MEM_SLAB_MAX_SIZE */
+void lv_mem_slab_note_fallback(size_t size);
+
+/* Snapshot of region and per-class counters (classes may be NULL) */
+void lv_mem_slab_get_stats(lv_mem_slab_stats_t* stats,
+                           lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT]);
+
+/* Clear peak and fallback counters */
+void lv_mem_slab_reset_peaks(void);
+
+#ifdef __cplusplus
+}
+#endif
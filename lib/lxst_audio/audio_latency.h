@@ -0,0 +1,68 @@
+// Copyright (c) 2024 LXST contributors
+// SPDX-License-Identifier: MPL-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Latency stamps that travel with audio through the LXST pipeline.
+ *
+ * TX: a capture batch is stamped when the i2s_read() that completes it
+ * returns, i.e. at its NEWEST sample; the oldest sample in the batch is one
+ * batch (FRAMES_PER_BATCH codec frames) older. The stamp rides the PCM
+ * through EncodedRingBuffer, Codec2 encode and call_send_audio_batch().
+ *
+ * RX: a packet is stamped on arrival in call_on_packet(); every frame it
+ * decodes to carries that stamp through PacketRingBuffer to the i2s_write()
+ * hand-off. The I2S DMA queue (8 x 64 samples, <= 64ms at 8kHz) sits after
+ * that hand-off and is not measured.
+ *
+ * Per-stage histograms go to the metrics registry as lxst.tx.* / lxst.rx.*
+ * (T:METRICS, summarised by T:CALL_LATENCY). Times are Metrics::nowUs()
+ * microseconds; 32-bit, so any one stage must be under ~71 minutes.
+ */
+struct AudioStamp {
+    uint32_t origin_us = 0;    // Entered this direction's pipeline; 0 = unstamped
+    uint32_t queued_us = 0;    // Written into the ring it is travelling through
+    uint32_t upstream_us = 0;  // Latency accrued before origin (sender's in-band TX age); 0 = unknown
+};
+
+/**
+ * Optional in-band timing extension for pyxis-to-pyxis and loopback calls.
+ *
+ * The sender adds one msgpack entry ahead of the frames, turning the LXST
+ * packet from {0x01: frames} into {0x70: uint32 age_us, 0x01: frames}. age_us
+ * is the sender's capture -> send time for the batch; the receiver adds its
+ * own arrival -> I2S time to get mouth-to-ear, excluding network transit
+ * (which is zero in loopback). Python LXST and Columba peers do not expect
+ * the extra key, so it is opt-in (T:CALL_LATENCY ext on) and pyxis accepts
+ * packets with or without it.
+ */
+namespace LxstTimingExt {
+    static constexpr uint8_t FIELD = 0x70;
+    static constexpr size_t SIZE = 6;          // key, uint32 marker (0xCE), 4 bytes big-endian
+
+    /** Write the entry at out (SIZE bytes). */
+    inline size_t write(uint8_t* out, uint32_t age_us) {
+        out[0] = FIELD;
+        out[1] = 0xCE;
+        out[2] = static_cast<uint8_t>(age_us >> 24);
+        out[3] = static_cast<uint8_t>(age_us >> 16);
+        out[4] = static_cast<uint8_t>(age_us >> 8);
+        out[5] = static_cast<uint8_t>(age_us);
+        return SIZE;
+    }
+
+    /**
+     * Parse the entry at buf (a map key position). Returns false, leaving
+     * age_us untouched, if it is not there or truncated.
+     */
+    inline bool read(const uint8_t* buf, size_t len, uint32_t* age_us) {
+        if (len < SIZE || buf[0] != FIELD || buf[1] != 0xCE) return false;
+        *age_us = (static_cast<uint32_t>(buf[2]) << 24) | (static_cast<uint32_t>(buf[3]) << 16) |
+                  (static_cast<uint32_t>(buf[4]) << 8) | buf[5];
+        return true;
+    }
+}
@@ -4,6 +4,7 @@
 #include "encoded_ring_buffer.h"
 
 #include <cstdlib>     // malloc, free — needed on Linux clang; macOS leaks via header transitivity
+#include <memory>
 #include <cstring>
 
 #ifdef ARDUINO
@@ -23,13 +24,23 @@ EncodedRingBuffer::EncodedRingBuffer(int maxSlots, int maxBytesPerSlot)
     if (buffer_) {
         memset(buffer_, 0, bytes);
     }
+    size_t stampBytes = sizeof(AudioStamp) * maxSlots;
+#ifdef BOARD_HAS_PSRAM
+    stamps_ = static_cast<AudioStamp*>(heap_caps_malloc(stampBytes, MALLOC_CAP_SPIRAM));
+#else
+    stamps_ = static_cast<AudioStamp*>(malloc(stampBytes));
+#endif
+    if (stamps_) {
+        std::uninitialized_fill_n(stamps_, maxSlots, AudioStamp());
+    }
 }
 
 EncodedRingBuffer::~EncodedRingBuffer() {
     free(buffer_);
+    free(stamps_);
 }
 
-bool EncodedRingBuffer::write(const uint8_t* data, int length) {
+bool EncodedRingBuffer::write(const uint8_t* data, int length, const AudioStamp* stamp) {
     if (length <= 0 || length > maxBytesPerSlot_ || !buffer_) return false;
 
     int w = writeIndex_.load(std::memory_order_relaxed);
@@ -41,12 +52,13 @@ bool EncodedRingBuffer::write(const uint8_t* data, int length) {
     uint8_t* slot = buffer_ + w * slotSize_;
     memcpy(slot, &length, sizeof(int32_t));
     memcpy(slot + sizeof(int32_t), data, length);
+    if (stamps_) stamps_[w] = stamp ? *stamp : AudioStamp();
 
     writeIndex_.store(nextW, std::memory_order_release);
     return true;
 }
 
-bool EncodedRingBuffer::read(uint8_t* dest, int maxLength, int* actualLength) {
+bool EncodedRingBuffer::read(uint8_t* dest, int maxLength, int* actualLength, AudioStamp* stamp) {
     if (!buffer_) return false;
 
     int r = readIndex_.load(std::memory_order_relaxed);
@@ -66,6 +78,7 @@ bool EncodedRingBuffer::read(uint8_t* dest, int maxLength, int* actualLength) {
 
     memcpy(dest, slot + sizeof(int32_t), length);
     *actualLength = length;
+    if (stamp) *stamp = stamps_ ? stamps_[r] : AudioStamp();
 
     readIndex_.store((r + 1) % maxSlots_, std::memory_order_release);
     return true;
@@ -6,6 +6,8 @@
 #include <atomic>
 #include <cstdint>
 
+#include "audio_latency.h"
+
 /**
  * Lock-free SPSC ring buffer for variable-length encoded audio packets.
  *
@@ -13,6 +15,7 @@
  * tracks actual length. Lock-free protocol identical to PacketRingBuffer.
  *
  * Slot layout: [int32 length][uint8 data[maxBytesPerSlot]] x maxSlots
+ * Each slot also carries an AudioStamp (zeroed when the writer passes none).
  */
 class EncodedRingBuffer {
 public:
@@ -22,8 +25,8 @@ public:
     EncodedRingBuffer(const EncodedRingBuffer&) = delete;
     EncodedRingBuffer& operator=(const EncodedRingBuffer&) = delete;
 
-    bool write(const uint8_t* data, int length);
-    bool read(uint8_t* dest, int maxLength, int* actualLength);
+    bool write(const uint8_t* data, int length, const AudioStamp* stamp = nullptr);
+    bool read(uint8_t* dest, int maxLength, int* actualLength, AudioStamp* stamp = nullptr);
     int availableSlots() const;
     void reset();
 
@@ -33,6 +36,7 @@ private:
     const int slotSize_;
 
     uint8_t* buffer_;
+    AudioStamp* stamps_;  // Optional: null if its allocation failed; reads give zero stamps
 
     std::atomic<int> writeIndex_{0};
     std::atomic<int> readIndex_{0};
@@ -15,8 +15,11 @@
 #include "encoded_ring_buffer.h"
 #include <Arduino.h>
 #include <freertos/semphr.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
 using namespace Hardware::TDeck;
+using RNS::Instrumentation::Metrics;
 
 static const char* TAG = "LXST:Capture";
 
@@ -231,6 +234,7 @@ void I2SCapture::releaseBuffers() {
 void I2SCapture::captureTask(void* param) {
     auto* self = static_cast<I2SCapture*>(param);
     self->captureLoop();
+    EVENT_TRACE_THREAD_EXIT();
     self->capturing_.store(false, std::memory_order_relaxed);
     self->taskHandle_ = nullptr;
     auto done = static_cast<SemaphoreHandle_t>(self->taskExited_);
@@ -263,6 +267,8 @@ void I2SCapture::captureLoop() {
         esp_err_t err = i2s_read(I2S_NUM_1, readBuf, sizeof(readBuf), &bytesRead,
                                  pdMS_TO_TICKS(100));
         if (err != ESP_OK || bytesRead == 0) continue;
+        // Latency origin for a batch this read completes (its newest sample)
+        const uint32_t readDoneUs = Metrics::nowUs();
 
         int samplesRead = bytesRead / sizeof(int16_t);
 
@@ -337,6 +343,7 @@ void I2SCapture::captureLoop() {
 
             if (accumCount_ == frameSamples_) {
                 // Full frame ready — process it
+                EVENT_TRACE_SCOPE_V(CAPTURE_FRAME, framesEncoded);
                 // RAWMIC stage 1: decimated mic PCM (8kHz) BEFORE filters + inject.
                 if (pyxis_rawmic_mode() && pyxis_rawmic_stage() == 1) {
                     pyxis_audio_dump(accumBuffer_, (size_t)frameSamples_ * sizeof(int16_t));
@@ -418,8 +425,13 @@ void I2SCapture::captureLoop() {
                 }
 
                 const int pcmBytes = frameSamples_ * static_cast<int>(sizeof(int16_t));
+                AudioStamp stamp;
+                stamp.origin_us = readDoneUs;
+                stamp.queued_us = Metrics::nowUs();
                 if (encodedRing_ && encodedRing_->write(
-                        reinterpret_cast<const uint8_t*>(frameData), pcmBytes)) {
+                        reinterpret_cast<const uint8_t*>(frameData), pcmBytes, &stamp)) {
+                    Metrics::observe(RNS::Instrumentation::METRIC_LXST_TX_CAPTURE,
+                                     stamp.queued_us - stamp.origin_us);
                     framesEncoded++;
                     if (framesEncoded <= 3 || (framesEncoded % 500 == 0)) {
                         char logbuf[112];
@@ -431,6 +443,7 @@ void I2SCapture::captureLoop() {
                     }
                 } else {
                     ringDrops++;
+                    EVENT_TRACE_COUNTER(CAPTURE_RING_DROPS, ringDrops);
                 }
 
                 accumCount_ = 0;
@@ -441,21 +454,27 @@ void I2SCapture::captureLoop() {
     ESP_LOGI(TAG, "Capture task exiting");
 }
 
-bool I2SCapture::readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength) {
+bool I2SCapture::readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength,
+                                   AudioStamp* stamp) {
     if (!encodedRing_ || !encodePcmBuffer_ || !codec_ || !actualLength) return false;
     int pcmBytes = 0;
     const int expectedBytes = frameSamples_ * static_cast<int>(sizeof(int16_t));
+    AudioStamp batchStamp;
     if (!encodedRing_->read(reinterpret_cast<uint8_t*>(encodePcmBuffer_),
-                            expectedBytes, &pcmBytes) || pcmBytes != expectedBytes) {
+                            expectedBytes, &pcmBytes, &batchStamp) || pcmBytes != expectedBytes) {
         *actualLength = 0;
         return false;
     }
+    const uint32_t dequeuedUs = Metrics::nowUs();
+    Metrics::observe(RNS::Instrumentation::METRIC_LXST_TX_QUEUE, dequeuedUs - batchStamp.queued_us);
 
     // Codec2 now runs on loopTask, which already has a large stack. Encode and
     // decode are also naturally serialized when LXSTAudio shares one codec.
     pyxis_audio_phase(110);
     int encodedLen = codec_->encode(encodePcmBuffer_, frameSamples_, dest, maxLength);
     pyxis_audio_phase(111);
+    Metrics::observeSince(RNS::Instrumentation::METRIC_LXST_TX_ENCODE, dequeuedUs);
+    if (stamp) *stamp = batchStamp;
     *actualLength = encodedLen > 0 ? encodedLen : 0;
     return encodedLen > 0;
 }
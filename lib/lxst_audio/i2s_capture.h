@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <atomic>
 
+#include "audio_latency.h"
+
 class EncodedRingBuffer;
 class VoiceFilterChain;
 class Codec2Wrapper;
@@ -84,9 +86,11 @@ public:
      * @param dest        Output buffer for encoded packet
      * @param maxLength   Size of output buffer
      * @param actualLength [out] Actual packet size
+     * @param stamp       [out] Optional: the batch's capture stamp
      * @return true if a packet was read
      */
-    bool readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength);
+    bool readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength,
+                           AudioStamp* stamp = nullptr);
 
     /** Number of encoded packets waiting in the ring buffer. */
     int availablePackets() const;
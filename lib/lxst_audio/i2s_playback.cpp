@@ -12,8 +12,11 @@
 #include "packet_ring_buffer.h"
 #include <Arduino.h>
 #include <freertos/semphr.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
 using namespace Hardware::TDeck;
+using RNS::Instrumentation::Metrics;
 
 static const char* TAG = "LXST:Playback";
 
@@ -194,7 +197,7 @@ void I2SPlayback::releaseBuffers() {
     frameSamples_ = 0;
 }
 
-bool I2SPlayback::writeEncodedPacket(const uint8_t* data, int length) {
+bool I2SPlayback::writeEncodedPacket(const uint8_t* data, int length, const AudioStamp* stamp) {
     if (!codec_ || !pcmRing_ || !decodeBuf_ || !frameSamples_) return false;
 
     int decodedSamples = codec_->decode(data, length, decodeBuf_, decodeBufSize_);
@@ -228,12 +231,21 @@ bool I2SPlayback::writeEncodedPacket(const uint8_t* data, int length) {
         pyxis_audio_dump(decodeBuf_, (size_t)decodedSamples * sizeof(int16_t));
     }
 
+    // Frames inherit the packet's arrival stamp; queued_us starts ring residency
+    AudioStamp frameStamp;
+    if (stamp && stamp->origin_us) {
+        frameStamp = *stamp;
+        frameStamp.queued_us = Metrics::nowUs();
+        Metrics::observe(RNS::Instrumentation::METRIC_LXST_RX_DECODE,
+                         frameStamp.queued_us - frameStamp.origin_us);
+    }
+
     // Write decoded PCM to ring buffer one frame at a time
     // (ring buffer only accepts exactly frameSamples_ per write)
     int numFrames = decodedSamples / frameSamples_;
     for (int i = 0; i < numFrames; i++) {
         int16_t* framePtr = decodeBuf_ + i * frameSamples_;
-        if (!pcmRing_->write(framePtr, frameSamples_)) {
+        if (!pcmRing_->write(framePtr, frameSamples_, &frameStamp)) {
             // Ring full — drop this frame (playback task will drain)
             // NOTE: Do NOT call read() here — this is SPSC and
             // the playback task is the sole consumer on another core.
@@ -252,6 +264,7 @@ int I2SPlayback::bufferedFrames() const {
 void I2SPlayback::playbackTask(void* param) {
     auto* self = static_cast<I2SPlayback*>(param);
     self->playbackLoop();
+    EVENT_TRACE_THREAD_EXIT();
     self->playing_.store(false, std::memory_order_relaxed);
     self->taskHandle_ = nullptr;
     auto done = static_cast<SemaphoreHandle_t>(self->taskExited_);
@@ -297,8 +310,13 @@ void I2SPlayback::playbackLoop() {
             }
         }
 
+        // Span covers the ring read and the (DMA-paced) I2S write
+        EVENT_TRACE_SCOPE_V(PLAYBACK_FRAME, framesPlayed);
+
         // Read a frame from the ring buffer
-        bool hasFrame = pcmRing_ && pcmRing_->read(frameBuf, frameSamples_);
+        AudioStamp stamp;
+        bool hasFrame = pcmRing_ && pcmRing_->read(frameBuf, frameSamples_, &stamp);
+        const uint32_t readUs = Metrics::nowUs();
         if (hasFrame) {
             framesPlayed++;
             if (framesPlayed <= 3 || (framesPlayed % 500 == 0)) {
@@ -325,6 +343,15 @@ void I2SPlayback::playbackLoop() {
                                   &bytesWritten, pdMS_TO_TICKS(100));
         if (err != ESP_OK) {
             ESP_LOGW(TAG, "I2S write error: %d", err);
+        } else if (hasFrame && stamp.origin_us) {
+            const uint32_t outUs = Metrics::nowUs();
+            Metrics::observe(RNS::Instrumentation::METRIC_LXST_RX_QUEUE, readUs - stamp.queued_us);
+            Metrics::observe(RNS::Instrumentation::METRIC_LXST_RX_OUTPUT, outUs - readUs);
+            Metrics::observe(RNS::Instrumentation::METRIC_LXST_RX_TOTAL, outUs - stamp.origin_us);
+            if (stamp.upstream_us) {
+                Metrics::observe(RNS::Instrumentation::METRIC_LXST_MOUTH_TO_EAR,
+                                 stamp.upstream_us + (outUs - stamp.origin_us));
+            }
         }
     }
 
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <atomic>
 
+#include "audio_latency.h"
+
 class PacketRingBuffer;
 class Codec2Wrapper;
 
@@ -53,9 +55,11 @@ public:
      *
      * @param data    Encoded packet (with LXST mode header byte)
      * @param length  Packet length in bytes
+     * @param stamp   Optional arrival stamp; every decoded frame carries it
+     *                to the I2S hand-off for the lxst.rx.* histograms
      * @return true on success
      */
-    bool writeEncodedPacket(const uint8_t* data, int length);
+    bool writeEncodedPacket(const uint8_t* data, int length, const AudioStamp* stamp = nullptr);
 
     /** Mute/unmute playback (outputs silence but keeps consuming data). */
     void setMute(bool muted) { muted_.store(muted, std::memory_order_relaxed); }
@@ -331,14 +331,15 @@ bool LXSTAudio::startFullDuplex() {
     return true;
 }
 
-bool LXSTAudio::readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength) {
+bool LXSTAudio::readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength,
+                                  AudioStamp* stamp) {
     if (!capture_ || !isCapturing()) return false;
-    return capture_->readEncodedPacket(dest, maxLength, actualLength);
+    return capture_->readEncodedPacket(dest, maxLength, actualLength, stamp);
 }
 
-bool LXSTAudio::writeEncodedPacket(const uint8_t* data, int length) {
+bool LXSTAudio::writeEncodedPacket(const uint8_t* data, int length, const AudioStamp* stamp) {
     if (!playback_ || !isPlaying()) return false;
-    return playback_->writeEncodedPacket(data, length);
+    return playback_->writeEncodedPacket(data, length, stamp);
 }
 
 void LXSTAudio::setCaptureMute(bool muted) {
@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <functional>
 
+#include "audio_latency.h"
+
 class I2SCapture;
 class I2SPlayback;
 class Codec2Wrapper;
@@ -110,9 +112,11 @@ public:
      * @param dest        Output buffer
      * @param maxLength   Buffer size
      * @param actualLength [out] Actual packet size
+     * @param stamp       [out] Optional: the batch's capture stamp
      * @return true if a packet was read
      */
-    bool readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength);
+    bool readEncodedPacket(uint8_t* dest, int maxLength, int* actualLength,
+                           AudioStamp* stamp = nullptr);
 
     /**
      * Write an encoded packet into the playback pipeline.
@@ -120,9 +124,10 @@ public:
      *
      * @param data   Encoded packet (with LXST mode header)
      * @param length Packet length
+     * @param stamp  Optional arrival stamp (see audio_latency.h)
      * @return true on success
      */
-    bool writeEncodedPacket(const uint8_t* data, int length);
+    bool writeEncodedPacket(const uint8_t* data, int length, const AudioStamp* stamp = nullptr);
 
     /** Mute/unmute the microphone (sends silence). */
     void setCaptureMute(bool muted);
@@ -4,6 +4,7 @@
 #include "packet_ring_buffer.h"
 
 #include <cstdlib>     // malloc, free — needed on Linux clang; macOS leaks via header transitivity
+#include <memory>
 
 #ifdef ARDUINO
 #include <esp_heap_caps.h>
@@ -20,13 +21,23 @@ PacketRingBuffer::PacketRingBuffer(int maxFrames, int frameSamples)
     if (buffer_) {
         memset(buffer_, 0, bytes);
     }
+    size_t stampBytes = sizeof(AudioStamp) * maxFrames;
+#ifdef BOARD_HAS_PSRAM
+    stamps_ = static_cast<AudioStamp*>(heap_caps_malloc(stampBytes, MALLOC_CAP_SPIRAM));
+#else
+    stamps_ = static_cast<AudioStamp*>(malloc(stampBytes));
+#endif
+    if (stamps_) {
+        std::uninitialized_fill_n(stamps_, maxFrames, AudioStamp());
+    }
 }
 
 PacketRingBuffer::~PacketRingBuffer() {
     free(buffer_);
+    free(stamps_);
 }
 
-bool PacketRingBuffer::write(const int16_t* samples, int count) {
+bool PacketRingBuffer::write(const int16_t* samples, int count, const AudioStamp* stamp) {
     if (count != frameSamples_ || !buffer_) return false;
 
     int w = writeIndex_.load(std::memory_order_relaxed);
@@ -36,11 +47,12 @@ bool PacketRingBuffer::write(const int16_t* samples, int count) {
     if (nextW == r) return false;
 
     memcpy(buffer_ + w * frameSamples_, samples, sizeof(int16_t) * frameSamples_);
+    if (stamps_) stamps_[w] = stamp ? *stamp : AudioStamp();
     writeIndex_.store(nextW, std::memory_order_release);
     return true;
 }
 
-bool PacketRingBuffer::read(int16_t* dest, int count) {
+bool PacketRingBuffer::read(int16_t* dest, int count, AudioStamp* stamp) {
     if (count != frameSamples_ || !buffer_) return false;
 
     int r = readIndex_.load(std::memory_order_relaxed);
@@ -49,6 +61,7 @@ bool PacketRingBuffer::read(int16_t* dest, int count) {
     if (r == w) return false;
 
     memcpy(dest, buffer_ + r * frameSamples_, sizeof(int16_t) * frameSamples_);
+    if (stamp) *stamp = stamps_ ? stamps_[r] : AudioStamp();
     readIndex_.store((r + 1) % maxFrames_, std::memory_order_release);
     return true;
 }
@@ -7,6 +7,8 @@
 #include <cstdint>
 #include <cstring>
 
+#include "audio_latency.h"
+
 /**
  * Lock-free Single-Producer Single-Consumer (SPSC) ring buffer for int16 audio.
  *
@@ -14,6 +16,7 @@
  * on read/write indices for correct cross-thread visibility without mutexes.
  *
  * On ESP32-S3, the buffer is allocated in PSRAM to conserve internal RAM.
+ * Each frame also carries an AudioStamp (zeroed when the writer passes none).
  */
 class PacketRingBuffer {
 public:
@@ -23,8 +26,8 @@ public:
     PacketRingBuffer(const PacketRingBuffer&) = delete;
     PacketRingBuffer& operator=(const PacketRingBuffer&) = delete;
 
-    bool write(const int16_t* samples, int count);
-    bool read(int16_t* dest, int count);
+    bool write(const int16_t* samples, int count, const AudioStamp* stamp = nullptr);
+    bool read(int16_t* dest, int count, AudioStamp* stamp = nullptr);
     int availableFrames() const;
     int capacity() const { return maxFrames_; }
     int frameSamples() const { return frameSamples_; }
@@ -34,6 +37,7 @@ private:
     const int maxFrames_;
     const int frameSamples_;
     int16_t* buffer_;
+    AudioStamp* stamps_;  // Optional: null if its allocation failed; reads give zero stamps
 
     std::atomic<int> writeIndex_{0};
     std::atomic<int> readIndex_{0};
@@ -0,0 +1,406 @@
+#pragma once
+
+/**
+ * BootGraph.h - Dependency-graph boot scheduler
+ *
+ * Problem: setup() ran every init phase back to back on loopTask, so boot
+ * time was the sum of all phases even though most of them are waits (WiFi
+ * association, GPS probing, LittleFS mount, NVS identity load, the TCP
+ * settle before the first announce) and the second core sat idle.
+ *
+ * Solution: each phase is added with the phases it depends on and where it
+ * may run. run() executes the graph on the calling task plus a worker task
+ * on the other core; a phase starts as soon as its dependencies are done.
+ *
+ *   - MAIN phases run only on the task that called run(). Use this for
+ *     anything that touches LVGL, which must stay on one task until the
+ *     LVGL task is started.
+ *   - ANY phases run wherever a runner is free. The calling task prefers
+ *     MAIN phases and the ANY phases they depend on, so the UI comes up as
+ *     soon as its own dependencies are met instead of behind unrelated waits.
+ *
+ * Dependencies can only name phases that were already added, so the graph
+ * is acyclic by construction and add order is a valid sequential order
+ * (used when no worker can be started).
+ *
+ * After run(), start/end times per phase give the critical path (the
+ * dependency chain with the largest summed duration, i.e. the floor on
+ * boot time for this graph) and how much of each phase overlapped others.
+ * BootProfiler::reportGraph() logs both.
+ */
+
+#include "Instrumentation/BootProfiler.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include <esp_timer.h>
+#define BOOT_GRAPH_ESP32 1
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#define BOOT_GRAPH_ESP32 0
+#endif
+
+namespace RNS {
+
+namespace BootGraphConfig {
+    static constexpr size_t MAX_PHASES = 16;
+    static constexpr size_t MAX_WORKERS = 2;
+    static constexpr uint32_t WORKER_STACK = 16384;   // Freed when run() returns
+    static constexpr uint32_t WORKER_PRIORITY = 1;    // Same as loopTask
+    static constexpr uint32_t WAIT_POLL_MS = 100;     // Upper bound on a missed wakeup
+}
+
+class BootGraph {
+public:
+    using PhaseFn = void (*)();
+
+    enum Where : uint8_t {
+        ANY = 0,    // Any runner
+        MAIN = 1,   // Only the task that calls run()
+    };
+
+    struct Phase {
+        const char* name = nullptr;   // Must outlive the graph (string literal)
+        PhaseFn fn = nullptr;
+        uint32_t deps = 0;            // Bit per phase id
+        Where where = ANY;
+        uint8_t runner = 0;           // 0 = calling task, 1.. = workers
+        uint32_t start_ms = 0;
+        uint32_t end_ms = 0;
+    };
+
+    /**
+     * Add a phase that runs after every phase in deps. Returns its id, or
+     * -1 if the graph is full or a dependency isn't an existing id; run()
+     * then refuses to start.
+     */
+    int add(const char* name, PhaseFn fn, std::initializer_list<int> deps = {},
+            Where where = ANY) {
+        if (_count >= BootGraphConfig::MAX_PHASES || !fn || _ran) {
+            _invalid = true;
+            return -1;
+        }
+        uint32_t mask = 0;
+        for (int d : deps) {
+            if (d < 0 || static_cast<size_t>(d) >= _count) {
+                _invalid = true;
+                return -1;
+            }
+            mask |= bit(d);
+        }
+        Phase& p = _phases[_count];
+        p.name = name;
+        p.fn = fn;
+        p.deps = mask;
+        p.where = where;
+        return static_cast<int>(_count++);
+    }
+
+    /**
+     * Run every phase and return when all are done. Uses up to `workers`
+     * extra tasks (pinned to the other cores on ESP32); with 0 workers, or
+     * if none can be created, phases run in add order on the caller.
+     * Returns false without running anything if an add() failed.
+     */
+    bool run(size_t workers = 1) {
+        if (_invalid || _ran) return false;
+        _ran = true;
+        _epoch_ms = nowMs();
+
+        // Phases the MAIN phases transitively wait on. Deps always have
+        // lower ids, so one pass from the top closes the set.
+        for (size_t i = _count; i-- > 0;) {
+            if (_phases[i].where == MAIN || (_ui_path & bit(i))) _ui_path |= _phases[i].deps;
+        }
+
+        if (workers > BootGraphConfig::MAX_WORKERS) workers = BootGraphConfig::MAX_WORKERS;
+        if (workers > 0 && _count > 1 && openSync(workers)) {
+            for (size_t w = 0; w < workers; w++) {
+                _worker_ctx[w].graph = this;
+                _worker_ctx[w].runner = static_cast<uint8_t>(w + 1);
+                // Counted before the worker exists: it decrements on exit
+                lock();
+                _workers_alive++;
+                unlock();
+                if (!startWorker(w)) {
+                    lock();
+                    _workers_alive--;
+                    unlock();
+                }
+            }
+        }
+        if (_workers_alive == 0) {
+            closeSync();
+            for (size_t i = 0; i < _count; i++) execute(i, 0);
+            return true;
+        }
+
+        runnerLoop(0);
+        joinWorkers();
+        closeSync();
+        return true;
+    }
+
+    size_t size() const { return _count; }
+    const Phase& phase(size_t id) const { return _phases[id]; }
+
+    // Phase timing relative to the start of run()
+    uint32_t startMs(size_t id) const { return _phases[id].start_ms - _epoch_ms; }
+    uint32_t durationMs(size_t id) const { return _phases[id].end_ms - _phases[id].start_ms; }
+
+    // First phase start to last phase end
+    uint32_t wallMs() const {
+        uint32_t end = 0;
+        for (size_t i = 0; i < _count; i++) {
+            if (_phases[i].end_ms - _epoch_ms > end) end = _phases[i].end_ms - _epoch_ms;
+        }
+        return end;
+    }
+
+    // Sum of phase durations; busyMs() / wallMs() is the achieved parallelism
+    uint32_t busyMs() const {
+        uint32_t sum = 0;
+        for (size_t i = 0; i < _count; i++) sum += durationMs(i);
+        return sum;
+    }
+
+    // Time phase `id` spent running alongside at least one other phase
+    uint32_t overlapMs(size_t id) const {
+        const uint32_t s = _phases[id].start_ms - _epoch_ms;
+        const uint32_t e = _phases[id].end_ms - _epoch_ms;
+        uint32_t starts[BootGraphConfig::MAX_PHASES];
+        uint32_t ends[BootGraphConfig::MAX_PHASES];
+        size_t n = 0;
+        for (size_t i = 0; i < _count; i++) {
+            if (i == id) continue;
+            uint32_t os = _phases[i].start_ms - _epoch_ms;
+            uint32_t oe = _phases[i].end_ms - _epoch_ms;
+            if (os < s) os = s;
+            if (oe > e) oe = e;
+            if (os >= oe) continue;
+            // Insertion sort by start; at most MAX_PHASES entries
+            size_t j = n++;
+            for (; j > 0 && starts[j - 1] > os; j--) {
+                starts[j] = starts[j - 1];
+                ends[j] = ends[j - 1];
+            }
+            starts[j] = os;
+            ends[j] = oe;
+        }
+        uint32_t covered = 0;
+        uint32_t reach = s;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t from = starts[i] > reach ? starts[i] : reach;
+            if (ends[i] > from) {
+                covered += ends[i] - from;
+                reach = ends[i];
+            }
+        }
+        return covered;
+    }
+
+    /**
+     * Longest dependency chain by summed phase duration, written to `ids`
+     * in run order. Returns the chain length (capped at `max`); `total_ms`
+     * receives the chain's summed duration if non-null.
+     */
+    size_t criticalPath(uint8_t* ids, size_t max, uint32_t* total_ms = nullptr) const {
+        uint32_t dist[BootGraphConfig::MAX_PHASES];
+        int8_t pred[BootGraphConfig::MAX_PHASES];
+        size_t last = 0;
+        for (size_t i = 0; i < _count; i++) {
+            uint32_t best = 0;
+            pred[i] = -1;
+            for (size_t d = 0; d < i; d++) {
+                if ((_phases[i].deps & bit(d)) && (pred[i] < 0 || dist[d] > best)) {
+                    best = dist[d];
+                    pred[i] = static_cast<int8_t>(d);
+                }
+            }
+            dist[i] = best + durationMs(i);
+            if (dist[i] > dist[last]) last = i;
+        }
+        if (total_ms) *total_ms = _count ? dist[last] : 0;
+        if (_count == 0) return 0;
+
+        size_t len = 0;
+        for (int i = static_cast<int>(last); i >= 0; i = pred[i]) len++;
+        size_t pos = len;
+        for (int i = static_cast<int>(last); i >= 0; i = pred[i]) {
+            if (--pos < max) ids[pos] = static_cast<uint8_t>(i);
+        }
+        return len < max ? len : max;
+    }
+
+private:
+    struct WorkerCtx {
+        BootGraph* graph = nullptr;
+        uint8_t runner = 0;
+    };
+
+    static uint32_t bit(size_t id) { return uint32_t(1) << id; }
+
+    static uint32_t nowMs() {
+#if BOOT_GRAPH_ESP32
+        return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+#else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    void execute(size_t id, uint8_t runner) {
+        Phase& p = _phases[id];
+        p.runner = runner;
+        p.start_ms = nowMs();
+        BOOT_PROFILE_START(p.name);
+        p.fn();
+        BOOT_PROFILE_END(p.name);
+        p.end_ms = nowMs();
+    }
+
+    // Lock held. Next phase for this runner, or -1 if none is ready.
+    int pick(uint8_t runner) const {
+        int any_ui = -1, any_other = -1;
+        bool main_pending = false;
+        for (size_t i = 0; i < _count; i++) {
+            if ((_started | _done) & bit(i)) {
+                continue;
+            }
+            const Phase& p = _phases[i];
+            if (p.where == MAIN) main_pending = true;
+            if ((p.deps & _done) != p.deps) continue;
+            if (p.where == MAIN) {
+                if (runner == 0) return static_cast<int>(i);
+                continue;
+            }
+            if (_ui_path & bit(i)) {
+                if (any_ui < 0) any_ui = static_cast<int>(i);
+            } else if (any_other < 0) {
+                any_other = static_cast<int>(i);
+            }
+        }
+        if (any_ui >= 0) return any_ui;
+        // Keep the calling task free for the UI path while any MAIN phase
+        // is still to come; the workers take everything else
+        if (runner == 0 && main_pending) return -1;
+        return any_other;
+    }
+
+    void runnerLoop(uint8_t runner) {
+        const uint32_t all = bit(_count) - 1;
+        lock();
+        while (_done != all) {
+            int id = pick(runner);
+            if (id < 0) {
+                waitLocked();
+                continue;
+            }
+            _started |= bit(id);
+            unlock();
+            execute(static_cast<size_t>(id), runner);
+            lock();
+            _done |= bit(id);
+            wakeAll();
+        }
+        unlock();
+    }
+
+#if BOOT_GRAPH_ESP32
+    bool openSync(size_t workers) {
+        _mutex = xSemaphoreCreateMutex();
+        _wake = xSemaphoreCreateCounting(workers + 1, 0);
+        if (_mutex && _wake) return true;
+        closeSync();
+        return false;
+    }
+    void closeSync() {
+        if (_mutex) vSemaphoreDelete(_mutex);
+        if (_wake) vSemaphoreDelete(_wake);
+        _mutex = nullptr;
+        _wake = nullptr;
+    }
+    bool startWorker(size_t w) {
+        const BaseType_t core = (xPortGetCoreID() + 1 + w) % portNUM_PROCESSORS;
+        return xTaskCreatePinnedToCore(workerEntry, "boot", BootGraphConfig::WORKER_STACK,
+                                       &_worker_ctx[w], BootGraphConfig::WORKER_PRIORITY,
+                                       nullptr, core) == pdPASS;
+    }
+    static void workerEntry(void* arg) {
+        WorkerCtx* ctx = static_cast<WorkerCtx*>(arg);
+        BootGraph* g = ctx->graph;
+        g->runnerLoop(ctx->runner);
+        g->lock();
+        g->_workers_alive--;
+        g->wakeAll();
+        g->unlock();
+        vTaskDelete(nullptr);
+    }
+    void joinWorkers() {
+        lock();
+        while (_workers_alive > 0) waitLocked();
+        unlock();
+    }
+    void lock() { xSemaphoreTake(_mutex, portMAX_DELAY); }
+    void unlock() { xSemaphoreGive(_mutex); }
+    void waitLocked() {
+        unlock();
+        xSemaphoreTake(_wake, pdMS_TO_TICKS(BootGraphConfig::WAIT_POLL_MS));
+        lock();
+    }
+    void wakeAll() {
+        for (size_t i = 0; i <= _workers_alive; i++) xSemaphoreGive(_wake);
+    }
+
+    SemaphoreHandle_t _mutex = nullptr;
+    SemaphoreHandle_t _wake = nullptr;
+#else
+    bool openSync(size_t) { return true; }
+    void closeSync() {}
+    bool startWorker(size_t w) {
+        WorkerCtx* ctx = &_worker_ctx[w];
+        _threads[w] = std::thread([ctx]() {
+            ctx->graph->runnerLoop(ctx->runner);
+        });
+        return true;
+    }
+    void joinWorkers() {
+        for (size_t w = 0; w < _workers_alive; w++) _threads[w].join();
+        _workers_alive = 0;
+    }
+    void lock() { _mutex.lock(); }
+    void unlock() { _mutex.unlock(); }
+    void waitLocked() {
+        std::unique_lock<std::mutex> held(_mutex, std::adopt_lock);
+        _cv.wait_for(held, std::chrono::milliseconds(BootGraphConfig::WAIT_POLL_MS));
+        held.release();
+    }
+    void wakeAll() { _cv.notify_all(); }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _threads[BootGraphConfig::MAX_WORKERS];
+#endif
+
+    Phase _phases[BootGraphConfig::MAX_PHASES];
+    size_t _count = 0;
+    bool _invalid = false;
+    bool _ran = false;
+    uint32_t _epoch_ms = 0;
+    uint32_t _ui_path = 0;    // ANY phases some MAIN phase waits on
+    uint32_t _started = 0;    // Lock held for both
+    uint32_t _done = 0;
+    WorkerCtx _worker_ctx[BootGraphConfig::MAX_WORKERS];
+    size_t _workers_alive = 0;
+};
+
+} // namespace RNS
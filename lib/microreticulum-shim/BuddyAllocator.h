@@ -0,0 +1,299 @@
+#pragma once
+
+/**
+ * BuddyAllocator.h - Power-of-two buddy allocator for multi-KB payloads
+ *
+ * Problem: requests above BytesPool's fixed tiers (resource segments,
+ * bz2-decompressed LXMF content, propagation-sync batches) went to the
+ * general heap as one-off multi-KB blocks. Interleaved with small
+ * long-lived allocations they are the main source of long-term heap
+ * fragmentation on a unit that has been up for days.
+ *
+ * Solution: one PSRAM region reserved at first use and managed as a buddy
+ * system with blocks of 1KB (order 10) to 64KB (order 16). A request takes
+ * the smallest power-of-two block that fits, splitting a larger free block
+ * in halves as needed; a free merges the block with its buddy for as long
+ * as the buddy is free too. Multi-KB churn therefore only ever reshuffles
+ * its own region and always coalesces back to whole 64KB blocks.
+ *
+ * Free lists are intrusive (the links live in the free blocks themselves);
+ * a byte per 1KB unit records each block's order and whether it is free,
+ * so finding a buddy is an XOR and a compare. Operations are O(orders) and
+ * run under a short critical section: these buffers are rare compared to
+ * BytesPool's lock-free small tiers.
+ *
+ * Used by BytesPool as TIER_BUDDY (see BytesPool.h); stats are reported by
+ * MemoryMonitor [BUDDY] and T:POOLSTATS.
+ */
+
+#include "PSRAMAllocator.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#include <esp_heap_caps.h>
+#define BUDDY_ESP32 1
+#else
+#include <mutex>
+#define BUDDY_ESP32 0
+#endif
+
+namespace RNS {
+
+namespace BuddyConfig {
+    static constexpr unsigned MIN_ORDER = 10;                            // 1KB
+    static constexpr unsigned MAX_ORDER = 16;                            // 64KB
+    static constexpr size_t MIN_BLOCK = size_t(1) << MIN_ORDER;
+    static constexpr size_t MAX_BLOCK = size_t(1) << MAX_ORDER;
+    static constexpr size_t REGION_BYTES = 4 * MAX_BLOCK;               // 256KB PSRAM
+    static constexpr size_t ORDER_COUNT = MAX_ORDER - MIN_ORDER + 1;
+    static constexpr size_t UNIT_COUNT = REGION_BYTES / MIN_BLOCK;
+}
+
+/**
+ * Counters for tuning (see MemoryMonitor [BUDDY] and T:POOLSTATS).
+ */
+struct BuddyStats {
+    size_t region_bytes = 0;     // 0 until the region is reserved (or if it failed)
+    size_t allocations = 0;
+    size_t frees = 0;
+    size_t failures = 0;         // No free block large enough
+    size_t splits = 0;           // Blocks halved to serve a smaller request
+    size_t merges = 0;           // Buddy pairs coalesced on free
+    size_t bytes_in_use = 0;     // Sum of handed-out block sizes
+    size_t peak_in_use = 0;
+    size_t free_bytes = 0;
+    size_t largest_free = 0;
+    uint8_t fragmentation = 0;   // External: % of free bytes stranded below MAX_BLOCK
+    size_t free_blocks[BuddyConfig::ORDER_COUNT] = {};   // Free blocks per order, 1KB first
+};
+
+class BuddyAllocator {
+public:
+    static BuddyAllocator& instance() {
+        static BuddyAllocator buddy;
+        return buddy;
+    }
+
+    /**
+     * Smallest block >= bytes, or nullptr if bytes is 0 or above MAX_BLOCK
+     * or no block that size is free. Reserves the region on first call.
+     */
+    void* allocate(size_t bytes) {
+        if (bytes == 0 || bytes > BuddyConfig::MAX_BLOCK) return nullptr;
+        if (!_region && !reserveRegion()) return nullptr;
+        unsigned order = orderFor(bytes);
+
+        lock();
+        unsigned from = order;
+        while (from <= BuddyConfig::MAX_ORDER && !_free[from - BuddyConfig::MIN_ORDER]) from++;
+        if (from > BuddyConfig::MAX_ORDER) {
+            _failures++;
+            unlock();
+            return nullptr;
+        }
+        FreeBlock* block = _free[from - BuddyConfig::MIN_ORDER];
+        unlinkFree(block, from);
+        // Halve until it fits; the upper half of each split goes back free
+        while (from > order) {
+            from--;
+            FreeBlock* upper = reinterpret_cast<FreeBlock*>(
+                reinterpret_cast<uint8_t*>(block) + (size_t(1) << from));
+            pushFree(upper, from);
+            _splits++;
+        }
+        _state[unitOf(block)] = static_cast<uint8_t>(order);
+        _allocations++;
+        _bytes_in_use += size_t(1) << order;
+        if (_bytes_in_use > _peak_in_use) _peak_in_use = _bytes_in_use;
+        unlock();
+        return block;
+    }
+
+    /**
+     * Return a block; merges with its buddy while the buddy is free.
+     * Ignores pointers this allocator doesn't own or that aren't a live
+     * block start (double free).
+     */
+    void free(void* p) {
+        if (!owns(p)) return;
+        size_t unit = unitOf(p);
+
+        lock();
+        uint8_t state = _state[unit];
+        if ((state & FREE_FLAG) || state < BuddyConfig::MIN_ORDER ||
+            (reinterpret_cast<uint8_t*>(p) - _region) % (size_t(1) << state) != 0) {
+            unlock();
+            return;
+        }
+        unsigned order = state;
+        _frees++;
+        _bytes_in_use -= size_t(1) << order;
+
+        uint8_t* block = reinterpret_cast<uint8_t*>(p);
+        while (order < BuddyConfig::MAX_ORDER) {
+            size_t offset = block - _region;
+            uint8_t* buddy = _region + (offset ^ (size_t(1) << order));
+            if (_state[unitOf(buddy)] != (FREE_FLAG | order)) break;
+            unlinkFree(reinterpret_cast<FreeBlock*>(buddy), order);
+            _state[unitOf(buddy)] = 0;
+            if (buddy < block) {
+                _state[unitOf(block)] = 0;
+                block = buddy;
+            }
+            order++;
+            _merges++;
+        }
+        pushFree(reinterpret_cast<FreeBlock*>(block), order);
+        unlock();
+    }
+
+    bool owns(const void* p) const {
+        const uint8_t* b = static_cast<const uint8_t*>(p);
+        return _region && b >= _region && b < _region + BuddyConfig::REGION_BYTES;
+    }
+
+    // Size of the live block at p; 0 if p isn't one
+    size_t blockSize(const void* p) const {
+        if (!owns(p)) return 0;
+        uint8_t state = _state[unitOf(p)];
+        return (state & FREE_FLAG) || state < BuddyConfig::MIN_ORDER ? 0 : size_t(1) << state;
+    }
+
+    BuddyStats stats() const {
+        BuddyStats s;
+        lock();
+        s.region_bytes = _region ? BuddyConfig::REGION_BYTES : 0;
+        s.allocations = _allocations;
+        s.frees = _frees;
+        s.failures = _failures;
+        s.splits = _splits;
+        s.merges = _merges;
+        s.bytes_in_use = _bytes_in_use;
+        s.peak_in_use = _peak_in_use;
+        for (unsigned o = BuddyConfig::MIN_ORDER; o <= BuddyConfig::MAX_ORDER; o++) {
+            size_t n = 0;
+            for (const FreeBlock* b = _free[o - BuddyConfig::MIN_ORDER]; b; b = b->next) n++;
+            s.free_blocks[o - BuddyConfig::MIN_ORDER] = n;
+            s.free_bytes += n << o;
+            if (n) s.largest_free = size_t(1) << o;
+        }
+        unlock();
+        size_t whole = s.free_blocks[BuddyConfig::ORDER_COUNT - 1] * BuddyConfig::MAX_BLOCK;
+        s.fragmentation = s.free_bytes
+            ? static_cast<uint8_t>((s.free_bytes - whole) * 100 / s.free_bytes)
+            : 0;
+        return s;
+    }
+
+    // Clear event counters and restart peak tracking from current usage
+    void resetStats() {
+        lock();
+        _allocations = _frees = _failures = _splits = _merges = 0;
+        _peak_in_use = _bytes_in_use;
+        unlock();
+    }
+
+private:
+    static constexpr uint8_t FREE_FLAG = 0x80;
+
+    struct FreeBlock {
+        FreeBlock* prev;
+        FreeBlock* next;
+    };
+
+    BuddyAllocator() = default;
+    BuddyAllocator(const BuddyAllocator&) = delete;
+    BuddyAllocator& operator=(const BuddyAllocator&) = delete;
+
+    static unsigned orderFor(size_t bytes) {
+        if (bytes <= BuddyConfig::MIN_BLOCK) return BuddyConfig::MIN_ORDER;
+        return 64 - __builtin_clzll(static_cast<unsigned long long>(bytes - 1));
+    }
+
+    size_t unitOf(const void* p) const {
+        return (static_cast<const uint8_t*>(p) - _region) >> BuddyConfig::MIN_ORDER;
+    }
+
+    // Lock held for both
+    void pushFree(FreeBlock* b, unsigned order) {
+        FreeBlock*& head = _free[order - BuddyConfig::MIN_ORDER];
+        b->prev = nullptr;
+        b->next = head;
+        if (head) head->prev = b;
+        head = b;
+        _state[unitOf(b)] = static_cast<uint8_t>(FREE_FLAG | order);
+    }
+    void unlinkFree(FreeBlock* b, unsigned order) {
+        if (b->prev) b->prev->next = b->next;
+        else _free[order - BuddyConfig::MIN_ORDER] = b->next;
+        if (b->next) b->next->prev = b->prev;
+    }
+
+    bool reserveRegion() {
+        lock();
+        if (_region || _reserve_failed) {
+            unlock();
+            return _region != nullptr;
+        }
+        unlock();
+#if BUDDY_ESP32
+        auto* region = static_cast<uint8_t*>(
+            heap_caps_malloc(BuddyConfig::REGION_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+#else
+        auto* region = static_cast<uint8_t*>(std::malloc(BuddyConfig::REGION_BYTES));
+#endif
+        lock();
+        if (_region || !region) {
+            // Lost a race with another first caller, or PSRAM is exhausted
+            if (!region) _reserve_failed = true;
+            unlock();
+#if BUDDY_ESP32
+            if (region) heap_caps_free(region);
+#else
+            if (region) std::free(region);
+#endif
+            return _region != nullptr;
+        }
+        _region = region;
+        for (size_t off = 0; off < BuddyConfig::REGION_BYTES; off += BuddyConfig::MAX_BLOCK) {
+            pushFree(reinterpret_cast<FreeBlock*>(region + off), BuddyConfig::MAX_ORDER);
+        }
+        PSRAMAllocatorHook::buddy_begin.store(reinterpret_cast<uintptr_t>(region),
+                                               std::memory_order_relaxed);
+        PSRAMAllocatorHook::buddy_end.store(
+            reinterpret_cast<uintptr_t>(region + BuddyConfig::REGION_BYTES),
+            std::memory_order_release);
+        unlock();
+        return true;
+    }
+
+#if BUDDY_ESP32
+    void lock() const { portENTER_CRITICAL(&_lock); }
+    void unlock() const { portEXIT_CRITICAL(&_lock); }
+    mutable portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;
+#else
+    void lock() const { _lock.lock(); }
+    void unlock() const { _lock.unlock(); }
+    mutable std::mutex _lock;
+#endif
+
+    std::atomic<uint8_t*> _region{nullptr};   // Read unlocked by owns()
+    bool _reserve_failed = false;
+    FreeBlock* _free[BuddyConfig::ORDER_COUNT] = {};
+    uint8_t _state[BuddyConfig::UNIT_COUNT] = {};   // Order (| FREE_FLAG) at each block start
+
+    size_t _allocations = 0;
+    size_t _frees = 0;
+    size_t _failures = 0;
+    size_t _splits = 0;
+    size_t _merges = 0;
+    size_t _bytes_in_use = 0;
+    size_t _peak_in_use = 0;
+};
+
+} // namespace RNS
@@ -13,16 +13,37 @@
  * refcount hits 0, a custom deleter returns the Data to the pool instead
  * of destroying it.
  *
- * The pool has four tiers sized for Reticulum packet processing:
+ * The pool has six tiers sized for Reticulum packet processing:
  *   - 64 bytes (1024 slots): hashes (16-32 bytes), small fields - highest traffic
  *   - 256 bytes (16 slots): keys, small announces
  *   - 512 bytes (12 slots): standard packets (MTU=500 + margin)
  *   - 1024 bytes (12 slots): resource advertisements, large packets
+ *   - 2048 / 4096 bytes (0 slots at boot): resource segments, LXMF bodies
+ *
+ * Self-tuning: every acquire lands in a log2 size histogram, and each tier
+ * tracks its in-use high-water mark and miss count. A tier that runs dry
+ * grows in place (up to its MAX_SLOTS) by drawing on a shared PSRAM
+ * growth reserve instead of sending the caller to the heap. The learned
+ * mix is exported as a BytesPoolProfile that main.cpp persists to NVS and
+ * re-applies at the next boot, so the pool starts with the slots the last
+ * run actually needed.
  *
  * All storage arrays are dynamically allocated in PSRAM on ESP32 to avoid
- * consuming internal RAM (BSS). Only the pointers (~32 bytes) stay in BSS.
+ * consuming internal RAM (BSS). Only the tier headers stay in BSS.
+ *
+ * Lock-free: each tier's free list is a Treiber stack of slot indices whose
+ * head word carries a generation tag next to the index, so a pop that races
+ * a pop+push of the same slot fails its CAS instead of corrupting the list
+ * (ABA). In front of the high-traffic tiny tier sits a small per-core
+ * magazine; acquire/release try-own it with one atomic exchange and fall
+ * through to the shared stack if another task on the same core holds it.
+ * No path takes a critical section, so the LXST capture, transport and BLE
+ * tasks no longer serialize on one spinlock for every 64-byte hash.
  *
- * Thread-safe via FreeRTOS spinlock (ESP32) or std::mutex (native).
+ * Requests above TIER_LARGE that the XL/XXL tiers can't serve (too big, or
+ * tier dry at its ceiling) take a block from the buddy region
+ * (BuddyAllocator.h, 1KB-64KB) and come back tagged TIER_BUDDY instead of
+ * going to the general heap.
  *
  * Usage (in Bytes.cpp):
  *   auto [data, tier] = BytesPool::instance().acquire(capacity);
@@ -35,24 +56,27 @@
  *   }
  */
 
+#include "BuddyAllocator.h"
 #include "PSRAMAllocator.h"
 #include <microReticulum/Log.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <new>
 #include <utility>
 #include <vector>
 
-// FreeRTOS spinlock support - only on ESP32
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 #include "freertos/FreeRTOS.h"
-#include "freertos/portmacro.h"
+#include "freertos/task.h"
 #include <esp_heap_caps.h>
-#define BYTESPOOL_USE_SPINLOCK 1
+#define BYTESPOOL_ESP32 1
 #else
-// Native build - use std::mutex instead
-#include <mutex>
-#define BYTESPOOL_USE_SPINLOCK 0
+#include <functional>
+#include <thread>
+#define BYTESPOOL_ESP32 0
 #endif
 
 namespace RNS {
@@ -64,9 +88,11 @@ namespace BytesPoolConfig {
     static constexpr size_t TIER_SMALL = 256;     // Small packets, keys
     static constexpr size_t TIER_MEDIUM = 512;    // Standard packets
     static constexpr size_t TIER_LARGE = 1024;    // Large packets, resource ads
+    static constexpr size_t TIER_XL = 2048;       // Resource segments, decompressed LXMF
+    static constexpr size_t TIER_XXL = 4096;      // Propagation-sync batches
 
     // Slot counts per tier — tuned 2026-02-19
-    // Storage arrays now live in PSRAM, so internal RAM cost is only pointers (~32B).
+    // Storage arrays now live in PSRAM, so internal RAM cost is only the tier headers.
     // Tiny tier for transient packet processing only. Known destinations now use
     // fixed buffers (zero pool slots). 1024 provides ample headroom for packet
     // hashes, Transport tables, and burst announce processing.
@@ -74,6 +100,34 @@ namespace BytesPoolConfig {
     static constexpr size_t SMALL_SLOTS = 16;     // Keys, small announces
     static constexpr size_t MEDIUM_SLOTS = 12;    // Standard packets
     static constexpr size_t LARGE_SLOTS = 12;     // Resource ads, large packets
+    static constexpr size_t XL_SLOTS = 0;         // Grown on demand from the reserve
+    static constexpr size_t XXL_SLOTS = 0;        // Grown on demand from the reserve
+
+    // Growth ceilings. Link arrays are sized for these at boot (~14B/slot
+    // PSRAM); the slot buffers themselves are only allocated when a tier
+    // grows, and every grown byte is charged to GROWTH_RESERVE_BYTES.
+    static constexpr size_t TINY_MAX_SLOTS = 2048;
+    static constexpr size_t SMALL_MAX_SLOTS = 64;
+    static constexpr size_t MEDIUM_MAX_SLOTS = 48;
+    static constexpr size_t LARGE_MAX_SLOTS = 48;
+    static constexpr size_t XL_MAX_SLOTS = 16;
+    static constexpr size_t XXL_MAX_SLOTS = 8;
+    static constexpr size_t GROWTH_RESERVE_BYTES = 128 * 1024;
+
+    // Size histogram: bucket b counts requests of (2^(b-1), 2^b] bytes;
+    // bucket 0 is 0-1 bytes and the last bucket is everything over 64KB.
+    static constexpr size_t HISTOGRAM_BUCKETS = 18;
+
+    // Per-core magazine depth. Only tiers with at least MAGAZINE_MIN_SLOTS
+    // get magazines — a 12-slot tier could otherwise strand most of its
+    // slots in the other core's cache and fall back to the heap early.
+#if BYTESPOOL_ESP32
+    static constexpr size_t MAGAZINE_COUNT = portNUM_PROCESSORS;
+#else
+    static constexpr size_t MAGAZINE_COUNT = 4;   // Threads hash onto these
+#endif
+    static constexpr size_t MAGAZINE_SLOTS = 8;
+    static constexpr size_t MAGAZINE_MIN_SLOTS = 256;
 
     // Tier identifiers for deleter
     enum Tier : uint8_t {
@@ -81,30 +135,62 @@ namespace BytesPoolConfig {
         TIER_64 = 1,
         TIER_256 = 2,
         TIER_512 = 3,
-        TIER_1024 = 4
+        TIER_1024 = 4,
+        TIER_2048 = 5,
+        TIER_4096 = 6,
+        TIER_BUDDY = 7   // Served from the BuddyAllocator region, not a pool tier
     };
+
+    static constexpr size_t TIER_COUNT = 6;
 }
 
+/**
+ * Snapshot of one tier for T:POOLSTATS / MemoryMonitor.
+ */
+struct BytesPoolTierStats {
+    size_t capacity = 0;     // Bytes reserved per slot
+    size_t slots = 0;        // Slots currently constructed
+    size_t max_slots = 0;    // Growth ceiling
+    size_t in_use = 0;
+    size_t high_water = 0;   // Peak in_use since boot / last resetStats()
+    size_t misses = 0;       // Requests this tier could not satisfy
+    size_t grown = 0;        // Slots added at runtime
+};
+
+/**
+ * Learned per-tier slot targets, persisted across boots. Plain-old-data so
+ * it can be stored as an NVS blob; bump MAGIC if the layout changes.
+ */
+struct BytesPoolProfile {
+    static constexpr uint32_t MAGIC = 0x42505031;  // "BPP1"
+    uint32_t magic = 0;
+    uint16_t slots[BytesPoolConfig::TIER_COUNT] = {};
+};
+
 // Forward declaration - Data is vector with PSRAMAllocator
 using PooledData = std::vector<uint8_t, PSRAMAllocator<uint8_t>>;
 
 /**
  * Pool for Bytes Data objects (vectors).
  *
- * Each tier maintains a stack of pre-allocated vectors with capacity reserved.
- * Vectors are cleared (size=0) but capacity preserved when returned to pool.
+ * Each tier maintains a lock-free stack of pre-allocated vectors with
+ * capacity reserved. Vectors are cleared (size=0) but capacity preserved
+ * when returned to pool.
  *
  * This eliminates:
  *   - Repeated vector construction/destruction
  *   - Repeated capacity reservation allocations
  *   - shared_ptr control block allocations (via make_shared replacement)
  *
- * Memory footprint (tuned 2026-02-19, all storage in PSRAM):
- *   - Tiny: 1024 slots x 64 bytes = 64KB backing + ~16KB metadata (PSRAM)
- *   - Small: 16 slots x 256 bytes = 4KB backing + ~256B metadata (PSRAM)
- *   - Medium: 12 slots x 512 bytes = 6KB backing + ~192B metadata (PSRAM)
- *   - Large: 12 slots x 1024 bytes = 12KB backing + ~192B metadata (PSRAM)
- *   - Total: ~103KB PSRAM, ~32 bytes internal RAM (pointers only)
+ * Memory footprint at boot (tuned 2026-02-19, all storage in PSRAM):
+ *   - Tiny: 1024 slots x 64 bytes = 64KB backing + ~28KB metadata (PSRAM)
+ *   - Small: 16 slots x 256 bytes = 4KB backing + ~900B metadata (PSRAM)
+ *   - Medium: 12 slots x 512 bytes = 6KB backing + ~670B metadata (PSRAM)
+ *   - Large: 12 slots x 1024 bytes = 12KB backing + ~670B metadata (PSRAM)
+ *   - XL/XXL: no backing until grown, ~340B metadata (PSRAM)
+ *   - Buddy region: 256KB (PSRAM), reserved by the first request it serves
+ *   - Total: ~117KB PSRAM + up to 128KB growth reserve,
+ *     ~600 bytes internal RAM (tier headers, magazines, histogram)
  */
 class BytesPool {
 public:
@@ -120,120 +206,94 @@ public:
      *
      * The returned Data is empty (size=0) but has capacity >= requested.
      * Caller must use the tier value to construct BytesPoolDeleter.
+     * Lock-free; safe from any task on either core.
      */
     std::pair<PooledData*, BytesPoolConfig::Tier> acquire(size_t requested_capacity) {
-        _total_requests++;
-
-#if BYTESPOOL_USE_SPINLOCK
-        portENTER_CRITICAL(&_mux);
-#else
-        std::lock_guard<std::mutex> lock(_mutex);
-#endif
-
-        PooledData* result = nullptr;
-        BytesPoolConfig::Tier tier = BytesPoolConfig::TIER_NONE;
-
-        // Try smallest tier that fits
-        if (requested_capacity <= BytesPoolConfig::TIER_TINY) {
-            if (_tiny_count > 0) {
-                result = _tiny_stack[--_tiny_count];
-                tier = BytesPoolConfig::TIER_64;
-                _pool_hits++;
-            }
-        }
-        else if (requested_capacity <= BytesPoolConfig::TIER_SMALL) {
-            if (_small_count > 0) {
-                result = _small_stack[--_small_count];
-                tier = BytesPoolConfig::TIER_256;
-                _pool_hits++;
-            }
-        }
-        else if (requested_capacity <= BytesPoolConfig::TIER_MEDIUM) {
-            if (_medium_count > 0) {
-                result = _medium_stack[--_medium_count];
-                tier = BytesPoolConfig::TIER_512;
-                _pool_hits++;
+        // Per-core row, plain load/store: no shared cache line and no RMW on
+        // the hot path. A preempted increment can be lost; it's a histogram.
+        std::atomic<uint32_t>& bucket = _histogram[magazineIndex()][bucketFor(requested_capacity)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // Smallest tier that fits. Oversized requests fall through with nullptr.
+        BytesPoolConfig::Tier tier = tierFor(requested_capacity);
+        if (tier != BytesPoolConfig::TIER_NONE) {
+            TierState& t = _tiers[tier - 1];
+            uint16_t slot = popMagazine(t);
+            if (slot == EMPTY_SLOT) {
+                slot = popShared(t);
+                // Tier dry: grow it from the reserve and retry once.
+                if (slot == EMPTY_SLOT && grow(t, t.grow_step)) {
+                    slot = popShared(t);
+                }
+                // Magazine hits recycle this core's own frees and can't
+                // raise the peak, so only the shared path updates it.
+                if (slot != EMPTY_SLOT) {
+                    noteInUse(t);
+                }
             }
-        }
-        else if (requested_capacity <= BytesPoolConfig::TIER_LARGE) {
-            if (_large_count > 0) {
-                result = _large_stack[--_large_count];
-                tier = BytesPoolConfig::TIER_1024;
-                _pool_hits++;
+            if (slot != EMPTY_SLOT) {
+                _pool_hits.fetch_add(1, std::memory_order_relaxed);
+                return {&t.storage[slot], tier};
             }
+            t.misses.fetch_add(1, std::memory_order_relaxed);
         }
-        // Oversized requests fall through with nullptr
 
-        if (!result) {
-            _pool_misses++;
+        // Multi-KB buffers: buddy region before the general heap
+        if (requested_capacity > BytesPoolConfig::TIER_LARGE) {
+            PooledData* data = acquireFromBuddy(requested_capacity);
+            if (data) {
+                _pool_hits.fetch_add(1, std::memory_order_relaxed);
+                return {data, BytesPoolConfig::TIER_BUDDY};
+            }
         }
 
-#if BYTESPOOL_USE_SPINLOCK
-        portEXIT_CRITICAL(&_mux);
-#endif
-
-        return {result, tier};
+        _pool_misses.fetch_add(1, std::memory_order_relaxed);
+        return {nullptr, BytesPoolConfig::TIER_NONE};
     }
 
     /**
      * Release a Data object back to pool.
      * Called by BytesPoolDeleter when shared_ptr refcount hits 0.
      *
-     * The Data is cleared (preserving capacity) and pushed to tier stack.
+     * The Data is cleared (preserving capacity) and pushed to its tier.
+     * Lock-free; safe from any task on either core.
      */
     void release(PooledData* data, BytesPoolConfig::Tier tier) {
-        if (!data || tier == BytesPoolConfig::TIER_NONE) {
+        if (data && tier == BytesPoolConfig::TIER_BUDDY) {
+            data->~PooledData();
+            BuddyAllocator::instance().free(data);
+            return;
+        }
+        if (!data || tier == BytesPoolConfig::TIER_NONE ||
+            tier > BytesPoolConfig::TIER_COUNT) {
             // Not from pool - should not happen, but defensive
             return;
         }
 
+        TierState& t = _tiers[tier - 1];
+        size_t slots = t.slots.load(std::memory_order_acquire);
+        if (!t.storage || data < t.storage || data >= t.storage + slots) {
+            return;  // Not one of this tier's slots
+        }
+        uint16_t slot = static_cast<uint16_t>(data - t.storage);
+
         // Clear but preserve capacity
         data->clear();
 
-#if BYTESPOOL_USE_SPINLOCK
-        portENTER_CRITICAL(&_mux);
-#else
-        std::lock_guard<std::mutex> lock(_mutex);
-#endif
-
-        switch (tier) {
-            case BytesPoolConfig::TIER_64:
-                if (_tiny_count < BytesPoolConfig::TINY_SLOTS) {
-                    _tiny_stack[_tiny_count++] = data;
-                }
-                // else pool full - data leaks (shouldn't happen in normal operation)
-                break;
-            case BytesPoolConfig::TIER_256:
-                if (_small_count < BytesPoolConfig::SMALL_SLOTS) {
-                    _small_stack[_small_count++] = data;
-                }
-                break;
-            case BytesPoolConfig::TIER_512:
-                if (_medium_count < BytesPoolConfig::MEDIUM_SLOTS) {
-                    _medium_stack[_medium_count++] = data;
-                }
-                break;
-            case BytesPoolConfig::TIER_1024:
-                if (_large_count < BytesPoolConfig::LARGE_SLOTS) {
-                    _large_stack[_large_count++] = data;
-                }
-                break;
-            default:
-                break;
+        if (!pushMagazine(t, slot)) {
+            pushShared(t, slot);
         }
-
-#if BYTESPOOL_USE_SPINLOCK
-        portEXIT_CRITICAL(&_mux);
-#endif
     }
 
-    // Instrumentation
-    size_t total_requests() const { return _total_requests; }
-    size_t pool_hits() const { return _pool_hits; }
-    size_t pool_misses() const { return _pool_misses; }
-    size_t fallback_count() const { return _fallback_count; }
+    // Instrumentation. Every request is exactly one hit or one miss, so the
+    // total is derived rather than paying for a third shared counter.
+    size_t total_requests() const { return pool_hits() + pool_misses(); }
+    size_t pool_hits() const { return _pool_hits.load(std::memory_order_relaxed); }
+    size_t pool_misses() const { return _pool_misses.load(std::memory_order_relaxed); }
+    size_t fallback_count() const { return _fallback_count.load(std::memory_order_relaxed); }
     float hit_rate() const {
-        return _total_requests > 0 ? (float)_pool_hits / _total_requests : 0.0f;
+        size_t total = total_requests();
+        return total > 0 ? (float)pool_hits() / total : 0.0f;
     }
 
     /**
@@ -241,142 +301,439 @@ public:
      * Called by Bytes.cpp when pool is exhausted but fallback succeeds.
      */
     void recordFallback(size_t requested_size) {
-        _fallback_count++;
+        _fallback_count.fetch_add(1, std::memory_order_relaxed);
         WARNINGF("BytesPool: exhausted, falling back to heap (requested=%zu bytes, "
-                 "tiny=%zu/%zu small=%zu/%zu med=%zu/%zu large=%zu/%zu)",
+                 "tiny=%zu/%zu small=%zu/%zu med=%zu/%zu large=%zu/%zu "
+                 "xl=%zu/%zu xxl=%zu/%zu reserve=%zu)",
                  requested_size,
-                 tiny_in_use(), BytesPoolConfig::TINY_SLOTS,
-                 small_in_use(), BytesPoolConfig::SMALL_SLOTS,
-                 medium_in_use(), BytesPoolConfig::MEDIUM_SLOTS,
-                 large_in_use(), BytesPoolConfig::LARGE_SLOTS);
+                 tiny_in_use(), slots(BytesPoolConfig::TIER_64),
+                 small_in_use(), slots(BytesPoolConfig::TIER_256),
+                 medium_in_use(), slots(BytesPoolConfig::TIER_512),
+                 large_in_use(), slots(BytesPoolConfig::TIER_1024),
+                 in_use(BytesPoolConfig::TIER_2048), slots(BytesPoolConfig::TIER_2048),
+                 in_use(BytesPoolConfig::TIER_4096), slots(BytesPoolConfig::TIER_4096),
+                 reserve_remaining());
+    }
+
+    // Current pool state (free slots include those parked in magazines)
+    // Free slots = shared stack + every magazine. Exact when the pool is
+    // quiescent; a snapshot taken mid-operation may be off by the in-flight ops.
+    size_t available(BytesPoolConfig::Tier tier) const {
+        const TierState& t = _tiers[tier - 1];
+        size_t n = t.shared_count.load(std::memory_order_relaxed);
+        for (const Magazine& m : t.magazines) {
+            n += m.count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+    size_t slots(BytesPoolConfig::Tier tier) const {
+        return _tiers[tier - 1].slots.load(std::memory_order_relaxed);
+    }
+    size_t in_use(BytesPoolConfig::Tier tier) const {
+        size_t total = slots(tier);
+        size_t free_slots = available(tier);
+        return free_slots < total ? total - free_slots : 0;
+    }
+    size_t tiny_available() const { return available(BytesPoolConfig::TIER_64); }
+    size_t small_available() const { return available(BytesPoolConfig::TIER_256); }
+    size_t medium_available() const { return available(BytesPoolConfig::TIER_512); }
+    size_t large_available() const { return available(BytesPoolConfig::TIER_1024); }
+    size_t tiny_in_use() const { return in_use(BytesPoolConfig::TIER_64); }
+    size_t small_in_use() const { return in_use(BytesPoolConfig::TIER_256); }
+    size_t medium_in_use() const { return in_use(BytesPoolConfig::TIER_512); }
+    size_t large_in_use() const { return in_use(BytesPoolConfig::TIER_1024); }
+
+    // Bytes of growth reserve not yet handed to any tier
+    size_t reserve_remaining() const { return _reserve_left.load(std::memory_order_relaxed); }
+
+    BytesPoolTierStats tierStats(BytesPoolConfig::Tier tier) const {
+        const TierState& t = _tiers[tier - 1];
+        BytesPoolTierStats st;
+        st.capacity = t.capacity;
+        st.slots = slots(tier);
+        st.max_slots = t.max_slots;
+        st.in_use = in_use(tier);
+        st.high_water = t.high_water.load(std::memory_order_relaxed);
+        st.misses = t.misses.load(std::memory_order_relaxed);
+        st.grown = t.grown.load(std::memory_order_relaxed);
+        return st;
+    }
+
+    // Requests whose size fell in log2 bucket `bucket` (see HISTOGRAM_BUCKETS)
+    size_t histogram(size_t bucket) const {
+        if (bucket >= BytesPoolConfig::HISTOGRAM_BUCKETS) return 0;
+        size_t n = 0;
+        for (const auto& row : _histogram) n += row[bucket].load(std::memory_order_relaxed);
+        return n;
+    }
+
+    // Upper size bound of a histogram bucket; 0 for the open-ended last one
+    static size_t histogramBound(size_t bucket) {
+        return bucket + 1 < BytesPoolConfig::HISTOGRAM_BUCKETS ? (size_t)1 << bucket : 0;
     }
 
-    // Current pool state
-    size_t tiny_available() const { return _tiny_count; }
-    size_t small_available() const { return _small_count; }
-    size_t medium_available() const { return _medium_count; }
-    size_t large_available() const { return _large_count; }
-    size_t tiny_in_use() const { return BytesPoolConfig::TINY_SLOTS - _tiny_count; }
-    size_t small_in_use() const { return BytesPoolConfig::SMALL_SLOTS - _small_count; }
-    size_t medium_in_use() const { return BytesPoolConfig::MEDIUM_SLOTS - _medium_count; }
-    size_t large_in_use() const { return BytesPoolConfig::LARGE_SLOTS - _large_count; }
+    /**
+     * Clear the histogram and per-tier miss counts and restart high-water
+     * tracking from the current occupancy. Slots already grown stay.
+     */
+    void resetStats() {
+        for (auto& row : _histogram) {
+            for (auto& bucket : row) bucket.store(0, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < BytesPoolConfig::TIER_COUNT; i++) {
+            TierState& t = _tiers[i];
+            t.misses.store(0, std::memory_order_relaxed);
+            t.high_water.store(in_use(static_cast<BytesPoolConfig::Tier>(i + 1)),
+                               std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Slot targets learned from this run: peak usage plus 25% headroom,
+     * never below the compiled-in base nor above the tier ceiling.
+     */
+    BytesPoolProfile learnedProfile() const {
+        BytesPoolProfile profile;
+        profile.magic = BytesPoolProfile::MAGIC;
+        for (size_t i = 0; i < BytesPoolConfig::TIER_COUNT; i++) {
+            const TierState& t = _tiers[i];
+            size_t peak = t.high_water.load(std::memory_order_relaxed);
+            size_t target = std::max(peak + peak / 4, t.base_slots);
+            profile.slots[i] = static_cast<uint16_t>(std::min(target, t.max_slots));
+        }
+        return profile;
+    }
+
+    /**
+     * Grow tiers up to a persisted profile's targets (never shrinks).
+     * Call early in boot, before packet traffic starts.
+     * Returns false if the profile is missing or from another layout.
+     */
+    bool applyProfile(const BytesPoolProfile& profile) {
+        if (profile.magic != BytesPoolProfile::MAGIC) return false;
+        for (size_t i = 0; i < BytesPoolConfig::TIER_COUNT; i++) {
+            TierState& t = _tiers[i];
+            size_t target = std::min<size_t>(profile.slots[i], t.max_slots);
+            size_t current = t.slots.load(std::memory_order_relaxed);
+            if (target > current) {
+                grow(t, target - current);
+            }
+        }
+        return true;
+    }
 
     // Log statistics for tuning
     void logStats() const {
         INFOF("BytesPool: requests=%zu hits=%zu misses=%zu fallbacks=%zu hit_rate=%d%% "
-              "tiny=%zu/%zu small=%zu/%zu med=%zu/%zu large=%zu/%zu",
-              _total_requests, _pool_hits, _pool_misses, _fallback_count,
+              "tiny=%zu/%zu small=%zu/%zu med=%zu/%zu large=%zu/%zu xl=%zu/%zu xxl=%zu/%zu "
+              "reserve=%zu",
+              total_requests(), pool_hits(), pool_misses(), fallback_count(),
               (int)(hit_rate() * 100),
-              tiny_in_use(), BytesPoolConfig::TINY_SLOTS,
-              small_in_use(), BytesPoolConfig::SMALL_SLOTS,
-              medium_in_use(), BytesPoolConfig::MEDIUM_SLOTS,
-              large_in_use(), BytesPoolConfig::LARGE_SLOTS);
+              tiny_in_use(), slots(BytesPoolConfig::TIER_64),
+              small_in_use(), slots(BytesPoolConfig::TIER_256),
+              medium_in_use(), slots(BytesPoolConfig::TIER_512),
+              large_in_use(), slots(BytesPoolConfig::TIER_1024),
+              in_use(BytesPoolConfig::TIER_2048), slots(BytesPoolConfig::TIER_2048),
+              in_use(BytesPoolConfig::TIER_4096), slots(BytesPoolConfig::TIER_4096),
+              reserve_remaining());
     }
 
 private:
+    // Slot index sentinel; tiers are capped below it.
+    static constexpr uint16_t EMPTY_SLOT = 0xFFFF;
+    static constexpr unsigned TAG_SHIFT = 16;
+
+    static_assert(BytesPoolConfig::TINY_MAX_SLOTS < EMPTY_SLOT &&
+                  BytesPoolConfig::SMALL_MAX_SLOTS < EMPTY_SLOT &&
+                  BytesPoolConfig::MEDIUM_MAX_SLOTS < EMPTY_SLOT &&
+                  BytesPoolConfig::LARGE_MAX_SLOTS < EMPTY_SLOT &&
+                  BytesPoolConfig::XL_MAX_SLOTS < EMPTY_SLOT &&
+                  BytesPoolConfig::XXL_MAX_SLOTS < EMPTY_SLOT,
+                  "slot indices must fit in 16 bits");
+    static_assert(BytesPoolConfig::MAGAZINE_SLOTS <= 255, "magazine count is uint8_t");
+
+    /**
+     * Per-core cache of free slot indices. `busy` is a try-lock taken with
+     * exchange(): a task that finds it held goes straight to the shared
+     * stack instead of waiting, so the magazine never blocks anyone.
+     */
+    struct Magazine {
+        std::atomic<bool> busy{false};
+        std::atomic<uint8_t> count{0};   // Written by the owner only; atomic for stats readers
+        uint16_t slots[BytesPoolConfig::MAGAZINE_SLOTS];
+    };
+
+    /**
+     * One size tier. `head` packs {generation tag : slot index} into one
+     * word — 16-bit tag on ESP32, 48-bit on 64-bit hosts. The tag bumps on
+     * every successful CAS so a stale head never compares equal.
+     *
+     * storage/next are sized for max_slots up front; only [0, slots) are
+     * constructed. Growth constructs the next run, publishes the new count
+     * with release, then pushes the new indices onto the stack.
+     */
+    struct TierState {
+        PooledData* storage = nullptr;
+        std::atomic<uint16_t>* next = nullptr;   // Free-list links, by slot
+        std::atomic<uintptr_t> head{EMPTY_SLOT};
+        std::atomic<size_t> shared_count{0};     // Free slots on the shared stack
+        std::atomic<size_t> slots{0};
+        size_t capacity = 0;
+        size_t base_slots = 0;
+        size_t max_slots = 0;
+        size_t grow_step = 0;
+        size_t magazine_depth = 0;               // 0 = no magazines
+        std::atomic<bool> growing{false};        // Try-lock; losers just miss
+        std::atomic<size_t> high_water{0};
+        std::atomic<size_t> misses{0};
+        std::atomic<size_t> grown{0};
+        Magazine magazines[BytesPoolConfig::MAGAZINE_COUNT];
+    };
+
     BytesPool() {
-#if BYTESPOOL_USE_SPINLOCK
-        portMUX_INITIALIZE(&_mux);
-#endif
-        allocateStorage();
-        initializeTier(_tiny_storage, _tiny_stack, _tiny_count,
-                       BytesPoolConfig::TIER_TINY, BytesPoolConfig::TINY_SLOTS);
-        initializeTier(_small_storage, _small_stack, _small_count,
-                       BytesPoolConfig::TIER_SMALL, BytesPoolConfig::SMALL_SLOTS);
-        initializeTier(_medium_storage, _medium_stack, _medium_count,
-                       BytesPoolConfig::TIER_MEDIUM, BytesPoolConfig::MEDIUM_SLOTS);
-        initializeTier(_large_storage, _large_stack, _large_count,
-                       BytesPoolConfig::TIER_LARGE, BytesPoolConfig::LARGE_SLOTS);
+        initializeTier(_tiers[0], BytesPoolConfig::TIER_TINY,
+                       BytesPoolConfig::TINY_SLOTS, BytesPoolConfig::TINY_MAX_SLOTS);
+        initializeTier(_tiers[1], BytesPoolConfig::TIER_SMALL,
+                       BytesPoolConfig::SMALL_SLOTS, BytesPoolConfig::SMALL_MAX_SLOTS);
+        initializeTier(_tiers[2], BytesPoolConfig::TIER_MEDIUM,
+                       BytesPoolConfig::MEDIUM_SLOTS, BytesPoolConfig::MEDIUM_MAX_SLOTS);
+        initializeTier(_tiers[3], BytesPoolConfig::TIER_LARGE,
+                       BytesPoolConfig::LARGE_SLOTS, BytesPoolConfig::LARGE_MAX_SLOTS);
+        initializeTier(_tiers[4], BytesPoolConfig::TIER_XL,
+                       BytesPoolConfig::XL_SLOTS, BytesPoolConfig::XL_MAX_SLOTS);
+        initializeTier(_tiers[5], BytesPoolConfig::TIER_XXL,
+                       BytesPoolConfig::XXL_SLOTS, BytesPoolConfig::XXL_MAX_SLOTS);
     }
 
     // Non-copyable
     BytesPool(const BytesPool&) = delete;
     BytesPool& operator=(const BytesPool&) = delete;
 
-    // Allocate storage and stack arrays in PSRAM (ESP32) or heap (native)
-    void allocateStorage() {
-#if BYTESPOOL_USE_SPINLOCK
+    static BytesPoolConfig::Tier tierFor(size_t requested_capacity) {
+        if (requested_capacity <= BytesPoolConfig::TIER_TINY) return BytesPoolConfig::TIER_64;
+        if (requested_capacity <= BytesPoolConfig::TIER_SMALL) return BytesPoolConfig::TIER_256;
+        if (requested_capacity <= BytesPoolConfig::TIER_MEDIUM) return BytesPoolConfig::TIER_512;
+        if (requested_capacity <= BytesPoolConfig::TIER_LARGE) return BytesPoolConfig::TIER_1024;
+        if (requested_capacity <= BytesPoolConfig::TIER_XL) return BytesPoolConfig::TIER_2048;
+        if (requested_capacity <= BytesPoolConfig::TIER_XXL) return BytesPoolConfig::TIER_4096;
+        return BytesPoolConfig::TIER_NONE;
+    }
+
+    // Smallest b with size <= 2^b, capped at the overflow bucket
+    static size_t bucketFor(size_t size) {
+        if (size <= 1) return 0;
+        size_t bucket = 64 - __builtin_clzll((unsigned long long)(size - 1));
+        return std::min(bucket, BytesPoolConfig::HISTOGRAM_BUCKETS - 1);
+    }
+
+    // PooledData header and its reserved buffer in one buddy block; the
+    // staged block is what the vector's allocator hands out on reserve().
+    // Requests whose header + buffer exceed the largest block return
+    // nullptr (heap fallback).
+    static PooledData* acquireFromBuddy(size_t capacity) {
+        void* mem = BuddyAllocator::instance().allocate(sizeof(PooledData) + capacity);
+        if (!mem) return nullptr;
+        PooledData* data = new (mem) PooledData();
+        PSRAMAllocatorHook::staged = data + 1;
+        PSRAMAllocatorHook::staged_size = capacity;
+        data->reserve(capacity);
+        PSRAMAllocatorHook::staged = nullptr;
+        return data;
+    }
+
+    // Raise the tier's high-water mark to the current occupancy (CAS-max;
+    // the loop only spins while the peak is actually being raised).
+    void noteInUse(TierState& t) {
+        size_t used = in_use(static_cast<BytesPoolConfig::Tier>(&t - _tiers + 1));
+        size_t peak = t.high_water.load(std::memory_order_relaxed);
+        while (used > peak &&
+               !t.high_water.compare_exchange_weak(peak, used, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * Add up to `want` slots to a tier, charged against the growth reserve.
+     * Allocates, so it only runs when the alternative is a heap fallback
+     * anyway. One grower per tier at a time; a concurrent caller returns
+     * false and takes the normal miss path.
+     */
+    bool grow(TierState& t, size_t want) {
+        if (!t.storage || t.capacity == 0) return false;
+        if (t.growing.exchange(true, std::memory_order_acquire)) return false;
+
+        size_t current = t.slots.load(std::memory_order_relaxed);
+        size_t count = std::min(want, t.max_slots - current);
+
+        // Claim the bytes up front so tiers growing concurrently can't
+        // overdraw the shared reserve.
+        size_t claimed = 0;
+        size_t reserve = _reserve_left.load(std::memory_order_relaxed);
+        do {
+            count = std::min(count, reserve / t.capacity);
+            claimed = count * t.capacity;
+        } while (count > 0 &&
+                 !_reserve_left.compare_exchange_weak(reserve, reserve - claimed,
+                                                      std::memory_order_relaxed));
+
+        size_t added = 0;
+        for (; added < count; added++) {
+            PooledData* data = new (&t.storage[current + added]) PooledData();
+            try {
+                data->reserve(t.capacity);
+            } catch (const std::bad_alloc&) {
+                data->~PooledData();
+                break;
+            }
+            new (&t.next[current + added]) std::atomic<uint16_t>(EMPTY_SLOT);
+        }
+        if (added < count) {
+            _reserve_left.fetch_add((count - added) * t.capacity, std::memory_order_relaxed);
+        }
+
+        if (added > 0) {
+            t.slots.store(current + added, std::memory_order_release);
+            t.grown.fetch_add(added, std::memory_order_relaxed);
+            for (size_t i = 0; i < added; i++) {
+                pushShared(t, static_cast<uint16_t>(current + i));
+            }
+        }
+        t.growing.store(false, std::memory_order_release);
+        return added > 0;
+    }
+
+    // Magazine index for the calling task. On ESP32 this is the core the
+    // task is running on right now; a migration between here and the
+    // exchange() is harmless because the magazine is try-owned, not assumed.
+    static size_t magazineIndex() {
+#if BYTESPOOL_ESP32
+        return (size_t)xPortGetCoreID() % BytesPoolConfig::MAGAZINE_COUNT;
+#else
+        static thread_local const size_t index =
+            std::hash<std::thread::id>{}(std::this_thread::get_id()) %
+            BytesPoolConfig::MAGAZINE_COUNT;
+        return index;
+#endif
+    }
+
+    uint16_t popMagazine(TierState& t) {
+        if (t.magazine_depth == 0) return EMPTY_SLOT;
+        Magazine& m = t.magazines[magazineIndex()];
+        if (m.busy.exchange(true, std::memory_order_acquire)) return EMPTY_SLOT;
+        uint16_t slot = EMPTY_SLOT;
+        uint8_t count = m.count.load(std::memory_order_relaxed);
+        if (count > 0) {
+            slot = m.slots[--count];
+            m.count.store(count, std::memory_order_relaxed);
+        }
+        m.busy.store(false, std::memory_order_release);
+        return slot;
+    }
+
+    bool pushMagazine(TierState& t, uint16_t slot) {
+        if (t.magazine_depth == 0) return false;
+        Magazine& m = t.magazines[magazineIndex()];
+        if (m.busy.exchange(true, std::memory_order_acquire)) return false;
+        bool stored = false;
+        uint8_t count = m.count.load(std::memory_order_relaxed);
+        if (count < t.magazine_depth) {
+            m.slots[count] = slot;
+            m.count.store(count + 1, std::memory_order_relaxed);
+            stored = true;
+        }
+        m.busy.store(false, std::memory_order_release);
+        return stored;
+    }
+
+    static uint16_t popShared(TierState& t) {
+        uintptr_t old_head = t.head.load(std::memory_order_acquire);
+        for (;;) {
+            uint16_t slot = static_cast<uint16_t>(old_head & EMPTY_SLOT);
+            if (slot == EMPTY_SLOT) return EMPTY_SLOT;
+            // May read a link that a concurrent pop+push already rewrote;
+            // the tag makes the CAS below fail in that case.
+            uint16_t next = t.next[slot].load(std::memory_order_relaxed);
+            uintptr_t new_head = (((old_head >> TAG_SHIFT) + 1) << TAG_SHIFT) | next;
+            if (t.head.compare_exchange_weak(old_head, new_head,
+                                             std::memory_order_acq_rel,
+                                             std::memory_order_acquire)) {
+                t.shared_count.fetch_sub(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+    }
+
+    static void pushShared(TierState& t, uint16_t slot) {
+        // Count before publishing so a racing pop can't drive it below zero.
+        t.shared_count.fetch_add(1, std::memory_order_relaxed);
+        uintptr_t old_head = t.head.load(std::memory_order_relaxed);
+        for (;;) {
+            t.next[slot].store(static_cast<uint16_t>(old_head & EMPTY_SLOT),
+                               std::memory_order_relaxed);
+            uintptr_t new_head = (((old_head >> TAG_SHIFT) + 1) << TAG_SHIFT) | slot;
+            if (t.head.compare_exchange_weak(old_head, new_head,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    // Allocate storage and link arrays in PSRAM (ESP32) or heap (native)
+    template <typename T>
+    static T* allocateArray(size_t count) {
+#if BYTESPOOL_ESP32
         // ESP32: allocate in PSRAM to avoid consuming internal RAM (BSS)
-        #define POOL_ALLOC(ptr, type, count) do { \
-            ptr = static_cast<type*>(heap_caps_aligned_alloc( \
-                alignof(type), (count) * sizeof(type), \
-                MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)); \
-            if (!ptr) { \
-                ptr = static_cast<type*>(heap_caps_aligned_alloc( \
-                    alignof(type), (count) * sizeof(type), \
-                    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)); \
-                if (ptr) WARNING("BytesPool: " #ptr " fell back to internal RAM"); \
-            } \
-        } while(0)
-
-        POOL_ALLOC(_tiny_storage,   PooledData,  BytesPoolConfig::TINY_SLOTS);
-        POOL_ALLOC(_tiny_stack,     PooledData*, BytesPoolConfig::TINY_SLOTS);
-        POOL_ALLOC(_small_storage,  PooledData,  BytesPoolConfig::SMALL_SLOTS);
-        POOL_ALLOC(_small_stack,    PooledData*, BytesPoolConfig::SMALL_SLOTS);
-        POOL_ALLOC(_medium_storage, PooledData,  BytesPoolConfig::MEDIUM_SLOTS);
-        POOL_ALLOC(_medium_stack,   PooledData*, BytesPoolConfig::MEDIUM_SLOTS);
-        POOL_ALLOC(_large_storage,  PooledData,  BytesPoolConfig::LARGE_SLOTS);
-        POOL_ALLOC(_large_stack,    PooledData*, BytesPoolConfig::LARGE_SLOTS);
-        #undef POOL_ALLOC
+        T* ptr = static_cast<T*>(heap_caps_aligned_alloc(
+            alignof(T), count * sizeof(T), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (!ptr) {
+            ptr = static_cast<T*>(heap_caps_aligned_alloc(
+                alignof(T), count * sizeof(T), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+            if (ptr) WARNING("BytesPool: tier storage fell back to internal RAM");
+        }
+        return ptr;
 #else
-        // Native: use new[]
-        _tiny_storage   = new PooledData[BytesPoolConfig::TINY_SLOTS];
-        _tiny_stack     = new PooledData*[BytesPoolConfig::TINY_SLOTS];
-        _small_storage  = new PooledData[BytesPoolConfig::SMALL_SLOTS];
-        _small_stack    = new PooledData*[BytesPoolConfig::SMALL_SLOTS];
-        _medium_storage = new PooledData[BytesPoolConfig::MEDIUM_SLOTS];
-        _medium_stack   = new PooledData*[BytesPoolConfig::MEDIUM_SLOTS];
-        _large_storage  = new PooledData[BytesPoolConfig::LARGE_SLOTS];
-        _large_stack    = new PooledData*[BytesPoolConfig::LARGE_SLOTS];
+        return static_cast<T*>(::operator new(count * sizeof(T), std::nothrow));
 #endif
     }
 
-    // Initialize a tier with pre-allocated vectors
-    void initializeTier(PooledData* storage, PooledData** stack, size_t& count,
-                        size_t capacity, size_t slots) {
-        if (!storage || !stack) {
+    // Initialize a tier with pre-allocated vectors, all linked on the shared stack.
+    // Arrays are sized for max_slots so the tier can grow without moving.
+    void initializeTier(TierState& t, size_t capacity, size_t slots, size_t max_slots) {
+        t.capacity = capacity;
+        t.base_slots = slots;
+        t.max_slots = max_slots;
+        t.grow_step = std::max<size_t>(4, slots / 4);
+        t.storage = allocateArray<PooledData>(max_slots);
+        t.next = allocateArray<std::atomic<uint16_t>>(max_slots);
+        if (!t.storage || !t.next) {
             ERROR("BytesPool: allocation failed for tier, pool will be undersized");
-            count = 0;
+            t.storage = nullptr;
+            t.max_slots = 0;
             return;
         }
         for (size_t i = 0; i < slots; i++) {
             // Placement new to construct in allocated storage
-            new (&storage[i]) PooledData();
-            storage[i].reserve(capacity);
-            stack[i] = &storage[i];
+            new (&t.storage[i]) PooledData();
+            t.storage[i].reserve(capacity);
+            new (&t.next[i]) std::atomic<uint16_t>(
+                static_cast<uint16_t>(i + 1 < slots ? i + 1 : EMPTY_SLOT));
         }
-        count = slots;
+        t.slots.store(slots, std::memory_order_relaxed);
+        t.magazine_depth = slots >= BytesPoolConfig::MAGAZINE_MIN_SLOTS
+                               ? BytesPoolConfig::MAGAZINE_SLOTS : 0;
+        t.head.store(slots > 0 ? 0 : EMPTY_SLOT, std::memory_order_relaxed);
+        t.shared_count.store(slots, std::memory_order_relaxed);
     }
 
-    // Storage for pooled vectors — dynamically allocated (PSRAM on ESP32)
-    PooledData* _tiny_storage = nullptr;
-    PooledData* _small_storage = nullptr;
-    PooledData* _medium_storage = nullptr;
-    PooledData* _large_storage = nullptr;
-
-    // Stacks of available vectors (pointers into storage arrays)
-    PooledData** _tiny_stack = nullptr;
-    PooledData** _small_stack = nullptr;
-    PooledData** _medium_stack = nullptr;
-    PooledData** _large_stack = nullptr;
-
-    // Stack counts (how many available in each tier)
-    size_t _tiny_count = 0;
-    size_t _small_count = 0;
-    size_t _medium_count = 0;
-    size_t _large_count = 0;
+    TierState _tiers[BytesPoolConfig::TIER_COUNT];
 
     // Instrumentation counters
-    size_t _total_requests = 0;
-    size_t _pool_hits = 0;
-    size_t _pool_misses = 0;
-    size_t _fallback_count = 0;  // Heap fallbacks due to pool exhaustion
-
-#if BYTESPOOL_USE_SPINLOCK
-    portMUX_TYPE _mux;
-#else
-    std::mutex _mutex;
-#endif
+    std::atomic<size_t> _pool_hits{0};
+    std::atomic<size_t> _pool_misses{0};
+    std::atomic<size_t> _fallback_count{0};  // Heap fallbacks due to pool exhaustion
+    std::atomic<size_t> _reserve_left{BytesPoolConfig::GROWTH_RESERVE_BYTES};
+    std::atomic<uint32_t> _histogram[BytesPoolConfig::MAGAZINE_COUNT]
+                                    [BytesPoolConfig::HISTOGRAM_BUCKETS] = {};
 };
 
 /**
@@ -0,0 +1,144 @@
+#pragma once
+
+/**
+ * FixedHash.h - Inline fixed-capacity hash/identity values
+ *
+ * Problem: lookup tables keyed by identities and packet hashes (AutoInterface
+ * dedup deque, BLE reassembly sessions, BLE peer/identity slot tables) held
+ * their keys as RNS::Bytes. Each key is a shared_ptr to a pooled vector, so
+ * every compare chases two pointers and every copy touches a refcount, and
+ * each one holds a 64-byte BytesPool slot for as long as it is in the table.
+ *
+ * Solution: FixedHash<N> stores up to N bytes inline plus a length. It is
+ * trivially copyable, compares with one memcmp over a constant size (the
+ * compiler turns that into word compares) and hashes by folding words.
+ * Unused tail bytes are kept zero so equality never reads garbage.
+ *
+ *   Hash16 - 16-byte truncated hashes (identity/destination hashes)
+ *   Hash32 - 32-byte full hashes (packet hashes)
+ *
+ * Shorter values fit too: the BLE tables key peers by 6-byte MAC until the
+ * identity is known, and a 6-byte value never equals a 16-byte one.
+ * Input longer than N yields an empty value rather than a silent truncation.
+ *
+ * Usage:
+ *   Hash32 h(Identity::full_hash(packet));
+ *   if (h == other) ...
+ *   Bytes b = h.toBytes();   // At API boundaries only
+ */
+
+#include <microReticulum/Bytes.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+namespace RNS {
+
+template <size_t N>
+class FixedHash {
+    static_assert(N > 0 && N <= 255, "FixedHash length must fit in a byte");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    FixedHash() = default;
+
+    FixedHash(const uint8_t* data, size_t size) { assign(data, size); }
+
+    // Implicit on purpose: callers still pass RNS::Bytes at API boundaries
+    FixedHash(const Bytes& bytes) { assign(bytes.data(), bytes.size()); }
+
+    /**
+     * Replace the value. Returns false (and leaves the value empty) if
+     * size exceeds N.
+     */
+    bool assign(const uint8_t* data, size_t size) {
+        std::memset(_data, 0, N);
+        if (!data || size > N) {
+            _size = 0;
+            return size == 0;
+        }
+        std::memcpy(_data, data, size);
+        _size = static_cast<uint8_t>(size);
+        return true;
+    }
+
+    void clear() {
+        std::memset(_data, 0, N);
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    const uint8_t* data() const { return _data; }
+
+    bool operator==(const FixedHash& other) const {
+        return _size == other._size && std::memcmp(_data, other._data, N) == 0;
+    }
+    bool operator!=(const FixedHash& other) const { return !(*this == other); }
+
+    // Compare against a Bytes key without materialising a FixedHash
+    bool equals(const uint8_t* data, size_t size) const {
+        return size == _size && (size == 0 || std::memcmp(_data, data, size) == 0);
+    }
+    bool operator==(const Bytes& other) const { return equals(other.data(), other.size()); }
+    bool operator!=(const Bytes& other) const { return !(*this == other); }
+
+    /**
+     * Cheap table hash. Values are usually already cryptographic hashes, so
+     * folding the words with a multiply is enough; short keys (MACs) are
+     * still mixed across all of their bytes.
+     */
+    uint32_t hash() const {
+        uint32_t h = 0x9E3779B9u ^ _size;
+        for (size_t i = 0; i < N; i += 4) {
+            uint32_t w = 0;
+            std::memcpy(&w, _data + i, (N - i) < 4 ? (N - i) : 4);
+            h = (h ^ w) * 0x85EBCA6Bu;
+            h ^= h >> 13;
+        }
+        return h;
+    }
+
+    Bytes toBytes() const { return Bytes(_data, _size); }
+
+    std::string toHex() const {
+        static const char digits[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(_size * 2);
+        for (size_t i = 0; i < _size; i++) {
+            out.push_back(digits[_data[i] >> 4]);
+            out.push_back(digits[_data[i] & 0x0F]);
+        }
+        return out;
+    }
+
+private:
+    alignas(4) uint8_t _data[N] = {};
+    uint8_t _size = 0;
+};
+
+template <size_t N>
+inline bool operator==(const Bytes& lhs, const FixedHash<N>& rhs) { return rhs == lhs; }
+template <size_t N>
+inline bool operator!=(const Bytes& lhs, const FixedHash<N>& rhs) { return rhs != lhs; }
+
+using Hash16 = FixedHash<16>;
+using Hash32 = FixedHash<32>;
+
+static_assert(std::is_trivially_copyable<Hash16>::value, "Hash16 must be trivially copyable");
+static_assert(std::is_trivially_copyable<Hash32>::value, "Hash32 must be trivially copyable");
+static_assert(sizeof(Hash16) == 20, "Hash16 should be 16 bytes + length, word aligned");
+
+} // namespace RNS
+
+namespace std {
+template <size_t N>
+struct hash<RNS::FixedHash<N>> {
+    size_t operator()(const RNS::FixedHash<N>& h) const { return h.hash(); }
+};
+} // namespace std
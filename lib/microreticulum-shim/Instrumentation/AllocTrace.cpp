@@ -0,0 +1,235 @@
+/*
+ * AllocTrace - Allocation trace capture for heap fragmentation analysis
+ *
+ * Implementation notes:
+ *   - The allocator entry points are intercepted with GNU ld --wrap (see the
+ *     tdeck-alloctrace env), so every call from the application, Arduino,
+ *     libstdc++ (operator new) and IDF components other than heap itself
+ *     lands in a __wrap_* function below.
+ *   - Recording never allocates and never locks: one fetch_add claims a
+ *     ring slot. The ring itself comes from __real_heap_caps_malloc so
+ *     setting it up is not traced.
+ *   - Everything here may run before static constructors (malloc is called
+ *     early in boot), so all state is constant-initialized and the ring
+ *     pointer stays null until init().
+ */
+
+#include "AllocTrace.h"
+
+#ifdef ALLOC_TRACE_ENABLED
+
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+
+#include <atomic>
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void* __real_heap_caps_malloc(size_t size, uint32_t caps);
+void* __real_heap_caps_calloc(size_t n, size_t size, uint32_t caps);
+void* __real_heap_caps_realloc(void* ptr, size_t size, uint32_t caps);
+void* __real_heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps);
+void __real_heap_caps_free(void* ptr);
+}
+
+namespace RNS { namespace Instrumentation {
+
+// Static member initialization
+AllocTraceRecord* AllocTrace::_ring = nullptr;
+size_t AllocTrace::_capacity = 0;
+
+// Total records ever claimed since the last clear(); the ring holds the
+// newest min(_head, _capacity) of them
+static std::atomic<uint32_t> _head{0};
+static std::atomic<bool> _running{false};
+static uint32_t _internal_free_at_start = 0;
+static uint32_t _spiram_free_at_start = 0;
+
+// Free heap when the records began: taken by init() and clear(), not by a
+// start() that resumes after a dump, so the replay baseline survives
+static void snapshotFreeHeap() {
+    _internal_free_at_start = heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    _spiram_free_at_start = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+}
+
+static uint8_t capsClass(uint32_t caps) {
+    uint8_t cls = 0;
+    if (caps & MALLOC_CAP_SPIRAM) cls |= ALLOC_TRACE_CAPS_SPIRAM;
+    if (caps & MALLOC_CAP_INTERNAL) cls |= ALLOC_TRACE_CAPS_INTERNAL;
+    if (caps & MALLOC_CAP_DMA) cls |= ALLOC_TRACE_CAPS_DMA;
+    return cls ? cls : static_cast<uint8_t>(ALLOC_TRACE_CAPS_DEFAULT);
+}
+
+bool AllocTrace::init(size_t capacity) {
+    if (_ring) return true;
+    if (capacity == 0) return false;
+
+    _ring = static_cast<AllocTraceRecord*>(
+        __real_heap_caps_malloc(capacity * sizeof(AllocTraceRecord),
+                                MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!_ring) return false;
+    _capacity = capacity;
+    snapshotFreeHeap();
+    start();
+    return true;
+}
+
+void AllocTrace::start() {
+    if (!_ring) return;
+    _running.store(true, std::memory_order_release);
+    mark(ALLOC_TRACE_MARK_START);
+}
+
+void AllocTrace::stop() {
+    _running.store(false, std::memory_order_release);
+}
+
+bool AllocTrace::running() {
+    return _running.load(std::memory_order_acquire);
+}
+
+void AllocTrace::clear() {
+    _head.store(0, std::memory_order_release);
+    snapshotFreeHeap();
+}
+
+void AllocTrace::mark(uint32_t id) {
+    record(ALLOC_TRACE_OP_MARK, 0, id, nullptr, nullptr);
+}
+
+void AllocTrace::record(uint8_t op, uint8_t caps, size_t size, const void* ptr, const void* caller) {
+    if (!_ring || !_running.load(std::memory_order_relaxed)) return;
+
+    uint32_t index = _head.fetch_add(1, std::memory_order_relaxed);
+    AllocTraceRecord& r = _ring[index % _capacity];
+    r.time_us = static_cast<uint32_t>(esp_timer_get_time());
+    r.ptr = reinterpret_cast<uintptr_t>(ptr);
+    r.caller = reinterpret_cast<uintptr_t>(caller);
+    r.info = AllocTraceRecord::pack(op, caps, size);
+}
+
+size_t AllocTrace::count() {
+    uint32_t head = _head.load(std::memory_order_acquire);
+    return head < _capacity ? head : _capacity;
+}
+
+size_t AllocTrace::capacity() {
+    return _capacity;
+}
+
+AllocTraceHeader AllocTrace::header() {
+    AllocTraceHeader h;
+    uint32_t head = _head.load(std::memory_order_acquire);
+    h.count = head < _capacity ? head : _capacity;
+    h.dropped = head - h.count;
+    h.internal_free = _internal_free_at_start;
+    h.spiram_free = _spiram_free_at_start;
+    return h;
+}
+
+size_t AllocTrace::copyRecords(size_t first, AllocTraceRecord* out, size_t max) {
+    if (!_ring || !out) return 0;
+    uint32_t head = _head.load(std::memory_order_acquire);
+    size_t held = head < _capacity ? head : _capacity;
+    if (first >= held) return 0;
+
+    size_t n = held - first < max ? held - first : max;
+    uint32_t oldest = head - held;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = _ring[(oldest + first + i) % _capacity];
+    }
+    return n;
+}
+
+}} // namespace RNS::Instrumentation
+
+using namespace RNS::Instrumentation;
+
+// Allocator wrappers. __builtin_return_address(0) must be taken here, in
+// the wrapper, so it names the code that called malloc.
+extern "C" {
+
+void* __wrap_malloc(size_t size) {
+    void* p = __real_malloc(size);
+    AllocTrace::record(ALLOC_TRACE_OP_ALLOC, ALLOC_TRACE_CAPS_DEFAULT, size, p,
+                       __builtin_return_address(0));
+    return p;
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+    void* p = __real_calloc(n, size);
+    AllocTrace::record(ALLOC_TRACE_OP_ALLOC, ALLOC_TRACE_CAPS_DEFAULT, n * size, p,
+                       __builtin_return_address(0));
+    return p;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    void* p = __real_realloc(ptr, size);
+    const void* caller = __builtin_return_address(0);
+    if (ptr && (p || size == 0)) {
+        AllocTrace::record(ALLOC_TRACE_OP_FREE, ALLOC_TRACE_CAPS_DEFAULT, 0, ptr, caller);
+    }
+    if (size != 0) {
+        AllocTrace::record(ALLOC_TRACE_OP_ALLOC, ALLOC_TRACE_CAPS_DEFAULT, size, p, caller);
+    }
+    return p;
+}
+
+// IDF's free() is heap_caps_free(), and that call would land in
+// __wrap_heap_caps_free and record the free a second time. Go straight to
+// the real heap_caps_free so each free is recorded once, with this caller.
+void __wrap_free(void* ptr) {
+    if (ptr) {
+        AllocTrace::record(ALLOC_TRACE_OP_FREE, ALLOC_TRACE_CAPS_DEFAULT, 0, ptr,
+                           __builtin_return_address(0));
+    }
+    __real_heap_caps_free(ptr);
+}
+
+void* __wrap_heap_caps_malloc(size_t size, uint32_t caps) {
+    void* p = __real_heap_caps_malloc(size, caps);
+    AllocTrace::record(ALLOC_TRACE_OP_ALLOC, capsClass(caps), size, p,
+                       __builtin_return_address(0));
+    return p;
+}
+
+void* __wrap_heap_caps_calloc(size_t n, size_t size, uint32_t caps) {
+    void* p = __real_heap_caps_calloc(n, size, caps);
+    AllocTrace::record(ALLOC_TRACE_OP_ALLOC, capsClass(caps), n * size, p,
+                       __builtin_return_address(0));
+    return p;
+}
+
+void* __wrap_heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    void* p = __real_heap_caps_realloc(ptr, size, caps);
+    const void* caller = __builtin_return_address(0);
+    uint8_t cls = capsClass(caps);
+    if (ptr && (p || size == 0)) {
+        AllocTrace::record(ALLOC_TRACE_OP_FREE, cls, 0, ptr, caller);
+    }
+    if (size != 0) {
+        AllocTrace::record(ALLOC_TRACE_OP_ALLOC, cls, size, p, caller);
+    }
+    return p;
+}
+
+void* __wrap_heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    void* p = __real_heap_caps_aligned_alloc(alignment, size, caps);
+    AllocTrace::record(ALLOC_TRACE_OP_ALLOC, capsClass(caps), size, p,
+                       __builtin_return_address(0));
+    return p;
+}
+
+void __wrap_heap_caps_free(void* ptr) {
+    if (ptr) {
+        AllocTrace::record(ALLOC_TRACE_OP_FREE, ALLOC_TRACE_CAPS_DEFAULT, 0, ptr,
+                           __builtin_return_address(0));
+    }
+    __real_heap_caps_free(ptr);
+}
+
+} // extern "C"
+
+#endif // ALLOC_TRACE_ENABLED
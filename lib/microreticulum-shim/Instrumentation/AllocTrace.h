@@ -0,0 +1,110 @@
+#pragma once
+
+/*
+ * AllocTrace - Allocation trace capture for heap fragmentation analysis
+ *
+ * Records every malloc/calloc/realloc/free and heap_caps_* call as a 16-byte
+ * record (size, caps class, caller PC, timestamp; see AllocTraceFormat.h)
+ * into a ring buffer in PSRAM. The ring is dumped over serial or UDP with
+ * T:ALLOCTRACE and replayed on a Linux host by tools/alloc_trace/ against
+ * models of the ESP-IDF TLSF heap, BytesPool and candidate policies, so a
+ * policy change can be judged on a real workload before it is flashed.
+ *
+ * Usage:
+ *   1. Build the tdeck-alloctrace env (defines ALLOC_TRACE_ENABLED and links
+ *      the allocator entry points through -Wl,--wrap)
+ *   2. Call ALLOC_TRACE_INIT() early in setup(); recording starts at once
+ *   3. Use ALLOC_TRACE_MARK(id) to tag application events in the trace
+ *   4. Dump with T:ALLOCTRACE dump (serial) or T:ALLOCTRACE udp
+ *
+ * The ring overwrites its oldest records when full; the dump header reports
+ * how many were dropped. Allocations made inside ESP-IDF's heap component
+ * itself (e.g. by the TLSF pool) are not seen, only calls through the
+ * wrapped entry points.
+ *
+ * When disabled, all API calls compile to no-ops via stub macros.
+ */
+
+#include "AllocTraceFormat.h"
+
+#ifdef ALLOC_TRACE_ENABLED
+
+#include <cstdint>
+#include <cstddef>
+
+namespace RNS { namespace Instrumentation {
+
+/**
+ * AllocTrace - Static class owning the trace ring
+ *
+ * Writers (the wrapped allocator calls, from any task or core) claim a slot
+ * with one atomic increment, so recording never takes a lock and never
+ * allocates. A record being overwritten while it is dumped can come out
+ * torn; stop() before dumping for a clean snapshot.
+ *
+ * All methods are static - no instantiation required.
+ */
+class AllocTrace {
+public:
+    /**
+     * Allocate the ring in PSRAM and start recording
+     *
+     * @param capacity Ring size in records (16 bytes each)
+     * @return true if the ring was allocated (or already was)
+     */
+    static bool init(size_t capacity = ALLOC_TRACE_RECORDS);
+
+    // Start/stop recording. The header's free heap is taken by init() and
+    // clear(), so stopping around a dump keeps the original baseline.
+    static void start();
+    static void stop();
+    static bool running();
+
+    // Drop all recorded records and re-snapshot free heap (recording state
+    // is unchanged)
+    static void clear();
+
+    // Record an application event (see AllocTraceMark)
+    static void mark(uint32_t id);
+
+    // Called by the allocator wrappers
+    static void record(uint8_t op, uint8_t caps, size_t size, const void* ptr, const void* caller);
+
+    // Records currently held (<= capacity)
+    static size_t count();
+    static size_t capacity();
+
+    // Header describing the records count() would return right now
+    static AllocTraceHeader header();
+
+    /**
+     * Copy records out, oldest first
+     *
+     * @param first Index of the first record (0 = oldest held)
+     * @param out Destination
+     * @param max Records to copy at most
+     * @return Records copied
+     */
+    static size_t copyRecords(size_t first, AllocTraceRecord* out, size_t max);
+
+    // Ring size used when init() is called without an argument
+    static constexpr size_t ALLOC_TRACE_RECORDS = 32768;   // 512KB PSRAM
+
+private:
+    static AllocTraceRecord* _ring;
+    static size_t _capacity;
+};
+
+}} // namespace RNS::Instrumentation
+
+// Convenience macros for conditional compilation
+#define ALLOC_TRACE_INIT() RNS::Instrumentation::AllocTrace::init()
+#define ALLOC_TRACE_MARK(id) RNS::Instrumentation::AllocTrace::mark(id)
+
+#else // ALLOC_TRACE_ENABLED not defined
+
+// Stub macros - compile to nothing when tracing disabled
+#define ALLOC_TRACE_INIT() ((void)0)
+#define ALLOC_TRACE_MARK(id) ((void)0)
+
+#endif // ALLOC_TRACE_ENABLED
@@ -0,0 +1,86 @@
+#pragma once
+
+/*
+ * AllocTraceFormat - Binary layout of allocation trace records
+ *
+ * Shared by the firmware recorder (AllocTrace.h) and the host-side replayer
+ * (tools/alloc_trace/alloc_replay.cpp). Plain C++ with no ESP dependencies.
+ *
+ * A dump is a header followed by `count` records, oldest first, all
+ * little-endian (both ends are little-endian; no byte swapping is done).
+ *
+ * Record (16 bytes):
+ *   time_us  - esp_timer_get_time() truncated to 32 bits (wraps ~71 min;
+ *              the replayer unwraps it)
+ *   ptr      - returned/freed pointer (0 for a failed allocation)
+ *   caller   - return address into the caller of the allocator; resolve
+ *              with xtensa-esp32s3-elf-addr2line -e firmware.elf
+ *   info     - op (bits 28-31), caps class (bits 24-27), size (bits 0-23)
+ *
+ * realloc() is recorded as FREE(old) followed by ALLOC(new); a realloc that
+ * fails records only the failed ALLOC. MARK records carry an event id in
+ * the size field (see AllocTraceMark) so heap state can be lined up with
+ * application events such as a skipped announce.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RNS { namespace Instrumentation {
+
+static constexpr uint32_t ALLOC_TRACE_MAGIC = 0x43525441;   // "ATRC"
+static constexpr uint16_t ALLOC_TRACE_VERSION = 1;
+
+enum AllocTraceOp : uint8_t {
+    ALLOC_TRACE_OP_ALLOC = 1,
+    ALLOC_TRACE_OP_FREE = 2,
+    ALLOC_TRACE_OP_MARK = 3
+};
+
+// Caps class bits: which heap the caller asked for
+enum AllocTraceCaps : uint8_t {
+    ALLOC_TRACE_CAPS_DEFAULT = 0x1,     // malloc/calloc/realloc/new (IDF default caps)
+    ALLOC_TRACE_CAPS_INTERNAL = 0x2,
+    ALLOC_TRACE_CAPS_SPIRAM = 0x4,
+    ALLOC_TRACE_CAPS_DMA = 0x8
+};
+
+// Application events worth lining up with heap state
+enum AllocTraceMark : uint32_t {
+    ALLOC_TRACE_MARK_START = 1,                 // Recording (re)started
+    ALLOC_TRACE_MARK_ANNOUNCE_SKIPPED = 2,      // AutoInterface low-memory skip
+    ALLOC_TRACE_MARK_USER = 100                 // T:ALLOCTRACE mark <n> adds this + n
+};
+
+struct AllocTraceRecord {
+    uint32_t time_us;
+    uint32_t ptr;
+    uint32_t caller;
+    uint32_t info;
+
+    static constexpr uint32_t SIZE_MASK = 0x00FFFFFF;
+
+    static uint32_t pack(uint8_t op, uint8_t caps, size_t size) {
+        uint32_t s = size > SIZE_MASK ? SIZE_MASK : static_cast<uint32_t>(size);
+        return (static_cast<uint32_t>(op & 0xF) << 28) |
+               (static_cast<uint32_t>(caps & 0xF) << 24) | s;
+    }
+    uint8_t op() const { return static_cast<uint8_t>(info >> 28); }
+    uint8_t caps() const { return static_cast<uint8_t>((info >> 24) & 0xF); }
+    uint32_t size() const { return info & SIZE_MASK; }
+};
+
+struct AllocTraceHeader {
+    uint32_t magic = ALLOC_TRACE_MAGIC;
+    uint16_t version = ALLOC_TRACE_VERSION;
+    uint16_t record_size = sizeof(AllocTraceRecord);
+    uint32_t count = 0;         // Records that follow
+    uint32_t dropped = 0;       // Older records overwritten by the ring
+    uint32_t internal_free = 0; // Free bytes when recording started; the
+    uint32_t spiram_free = 0;   // replayer sizes its heap models from these
+};
+
+static_assert(sizeof(AllocTraceRecord) == 16, "trace record layout is part of the dump format");
+static_assert(sizeof(AllocTraceHeader) == 24, "trace header layout is part of the dump format");
+
+}} // namespace RNS::Instrumentation
@@ -9,12 +9,16 @@
  *   - Phase timing tracks both individual duration and cumulative total
  *   - Wait time is tracked separately to distinguish I/O from CPU work
  *   - bootComplete() logs final summary for analysis
+ *   - Marks live in small per-name slot tables under a spinlock, so BootGraph
+ *     phases on both cores can be open at the same time
  */
 
 #include "BootProfiler.h"
 
 #ifdef BOOT_PROFILING_ENABLED
 
+#include "../BootGraph.h"
+
 #include <microReticulum/Log.h>
 
 #include <Arduino.h>
@@ -26,14 +30,52 @@ namespace RNS { namespace Instrumentation {
 // Static member initialization
 uint32_t BootProfiler::_boot_start_ms = 0;
 uint32_t BootProfiler::_cumulative_ms = 0;
-char BootProfiler::_current_phase[32] = {0};
-uint32_t BootProfiler::_phase_start_ms = 0;
-char BootProfiler::_current_wait[32] = {0};
-uint32_t BootProfiler::_wait_start_ms = 0;
+BootProfiler::OpenMark BootProfiler::_open_phases[MAX_OPEN] = {};
+BootProfiler::OpenMark BootProfiler::_open_waits[MAX_OPEN] = {};
 uint32_t BootProfiler::_total_wait_ms = 0;
+BootProfiler::GraphPhase BootProfiler::_graph_phases[MAX_GRAPH_PHASES] = {};
+uint8_t BootProfiler::_graph_phase_count = 0;
+uint32_t BootProfiler::_graph_wall_ms = 0;
+uint32_t BootProfiler::_graph_busy_ms = 0;
+uint32_t BootProfiler::_graph_critical_ms = 0;
 char BootProfiler::_log_buffer[256] = {0};
 bool BootProfiler::_fs_ready = false;
 
+// Guards the open-mark tables and totals; BootGraph marks from two tasks
+static portMUX_TYPE s_profiler_lock = portMUX_INITIALIZER_UNLOCKED;
+
+
+uint32_t BootProfiler::openMark(OpenMark* marks, const char* name) {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&s_profiler_lock);
+    for (uint8_t i = 0; i < MAX_OPEN; i++) {
+        if (marks[i].name[0] == '\0') {
+            strncpy(marks[i].name, name, sizeof(marks[i].name) - 1);
+            marks[i].name[sizeof(marks[i].name) - 1] = '\0';
+            marks[i].start_ms = now;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_profiler_lock);
+    return now;
+}
+
+
+uint32_t BootProfiler::closeMark(OpenMark* marks, const char* name, uint32_t now) {
+    uint32_t duration = 0;
+    portENTER_CRITICAL(&s_profiler_lock);
+    for (uint8_t i = 0; i < MAX_OPEN; i++) {
+        if (marks[i].name[0] != '\0' &&
+            strncmp(marks[i].name, name, sizeof(marks[i].name) - 1) == 0) {
+            duration = now - marks[i].start_ms;
+            marks[i].name[0] = '\0';
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_profiler_lock);
+    return duration;
+}
+
 
 void BootProfiler::setFilesystemReady(bool ready) {
     _fs_ready = ready;
@@ -44,77 +86,70 @@ void BootProfiler::setFilesystemReady(bool ready) {
 
 
 void BootProfiler::markStart(const char* phase) {
-    uint32_t now = millis();
-
     // First call establishes boot start time
+    uint32_t now = millis();
+    bool first = false;
+    portENTER_CRITICAL(&s_profiler_lock);
     if (_boot_start_ms == 0) {
         _boot_start_ms = now;
+        first = true;
+    }
+    portEXIT_CRITICAL(&s_profiler_lock);
+    if (first) {
         NOTICE("[BOOT] Profiling started");
     }
 
-    // Store current phase info
-    strncpy(_current_phase, phase, sizeof(_current_phase) - 1);
-    _current_phase[sizeof(_current_phase) - 1] = '\0';
-    _phase_start_ms = now;
+    now = openMark(_open_phases, phase);
 
-    snprintf(_log_buffer, sizeof(_log_buffer),
+    // Per-call buffer: phases can start on both cores at once
+    char buf[96];
+    snprintf(buf, sizeof(buf),
              "[BOOT] START: %s (at %ums)",
              phase, now - _boot_start_ms);
-    NOTICE(_log_buffer);
+    NOTICE(buf);
 }
 
 
 void BootProfiler::markEnd(const char* phase) {
     uint32_t now = millis();
-
-    // Calculate phase duration
-    uint32_t duration = 0;
-    if (_phase_start_ms > 0) {
-        duration = now - _phase_start_ms;
-    }
+    uint32_t duration = closeMark(_open_phases, phase, now);
 
     // Update cumulative time
-    _cumulative_ms = now - _boot_start_ms;
+    portENTER_CRITICAL(&s_profiler_lock);
+    if (now - _boot_start_ms > _cumulative_ms) {
+        _cumulative_ms = now - _boot_start_ms;
+    }
+    uint32_t cumulative = _cumulative_ms;
+    portEXIT_CRITICAL(&s_profiler_lock);
 
-    snprintf(_log_buffer, sizeof(_log_buffer),
+    char buf[96];
+    snprintf(buf, sizeof(buf),
              "[BOOT] END: %s (%ums, cumulative: %ums)",
-             phase, duration, _cumulative_ms);
-    NOTICE(_log_buffer);
-
-    // Clear current phase
-    _current_phase[0] = '\0';
-    _phase_start_ms = 0;
+             phase, duration, cumulative);
+    NOTICE(buf);
 }
 
 
 void BootProfiler::markWaitStart(const char* phase) {
-    // Store wait info
-    strncpy(_current_wait, phase, sizeof(_current_wait) - 1);
-    _current_wait[sizeof(_current_wait) - 1] = '\0';
-    _wait_start_ms = millis();
+    openMark(_open_waits, phase);
 }
 
 
 void BootProfiler::markWaitEnd(const char* phase) {
     uint32_t now = millis();
-
-    // Calculate wait duration
-    uint32_t duration = 0;
-    if (_wait_start_ms > 0) {
-        duration = now - _wait_start_ms;
-    }
+    uint32_t duration = closeMark(_open_waits, phase, now);
 
     // Accumulate wait time
+    portENTER_CRITICAL(&s_profiler_lock);
     _total_wait_ms += duration;
+    uint32_t total_wait = _total_wait_ms;
+    portEXIT_CRITICAL(&s_profiler_lock);
 
-    snprintf(_log_buffer, sizeof(_log_buffer),
+    char buf[96];
+    snprintf(buf, sizeof(buf),
              "[BOOT] WAIT: %s (%ums, total wait: %ums)",
-             phase, duration, _total_wait_ms);
-    NOTICE(_log_buffer);
-
-    // Clear current wait
-    _current_wait[0] = '\0';
-    _wait_start_ms = 0;
+             phase, duration, total_wait);
+    NOTICE(buf);
 }
 
 
@@ -127,7 +162,8 @@ void BootProfiler::bootComplete() {
         total_ms = now - _boot_start_ms;
     }
 
-    uint32_t init_ms = total_ms - _total_wait_ms;
+    // Waits on both cores can add up to more than the wall time
+    uint32_t init_ms = total_ms > _total_wait_ms ? total_ms - _total_wait_ms : 0;
 
     snprintf(_log_buffer, sizeof(_log_buffer),
              "[BOOT] COMPLETE: total=%ums, init=%ums, wait=%ums",
@@ -135,8 +171,8 @@ void BootProfiler::bootComplete() {
     NOTICE(_log_buffer);
 
     // Additional detail if wait time is significant
-    if (_total_wait_ms > 0) {
-        uint8_t wait_pct = (uint8_t)((_total_wait_ms * 100) / total_ms);
+    if (_total_wait_ms > 0 && total_ms > 0) {
+        uint32_t wait_pct = (_total_wait_ms * 100) / total_ms;
         snprintf(_log_buffer, sizeof(_log_buffer),
                  "[BOOT] Wait time: %u%% of boot",
                  wait_pct);
@@ -167,6 +203,54 @@ uint32_t BootProfiler::getWaitMs() {
 }
 
 
+void BootProfiler::reportGraph(const RNS::BootGraph& graph) {
+    uint8_t path[MAX_GRAPH_PHASES];
+    uint32_t critical_ms = 0;
+    size_t path_len = graph.criticalPath(path, MAX_GRAPH_PHASES, &critical_ms);
+
+    _graph_wall_ms = graph.wallMs();
+    _graph_busy_ms = graph.busyMs();
+    _graph_critical_ms = critical_ms;
+    _graph_phase_count = 0;
+    for (size_t i = 0; i < graph.size() && i < MAX_GRAPH_PHASES; i++) {
+        GraphPhase& gp = _graph_phases[_graph_phase_count++];
+        gp.name = graph.phase(i).name;
+        gp.start_ms = graph.startMs(i);
+        gp.duration_ms = graph.durationMs(i);
+        gp.overlap_ms = graph.overlapMs(i);
+        gp.runner = graph.phase(i).runner;
+        gp.critical = false;
+        for (size_t j = 0; j < path_len; j++) {
+            if (path[j] == i) gp.critical = true;
+        }
+    }
+
+    snprintf(_log_buffer, sizeof(_log_buffer),
+             "[BOOT] GRAPH: wall=%ums, phases=%ums (%u.%02ux), critical path=%ums",
+             _graph_wall_ms, _graph_busy_ms,
+             _graph_wall_ms ? _graph_busy_ms / _graph_wall_ms : 0,
+             _graph_wall_ms ? (_graph_busy_ms * 100 / _graph_wall_ms) % 100 : 0,
+             _graph_critical_ms);
+    NOTICE(_log_buffer);
+
+    for (uint8_t i = 0; i < _graph_phase_count; i++) {
+        const GraphPhase& gp = _graph_phases[i];
+        snprintf(_log_buffer, sizeof(_log_buffer),
+                 "[BOOT] %c %-14s at=%5ums dur=%5ums overlap=%5ums runner=%u",
+                 gp.critical ? '*' : ' ', gp.name, gp.start_ms, gp.duration_ms,
+                 gp.overlap_ms, gp.runner);
+        NOTICE(_log_buffer);
+    }
+
+    size_t len = snprintf(_log_buffer, sizeof(_log_buffer), "[BOOT] CRITICAL:");
+    for (size_t j = 0; j < path_len && len < sizeof(_log_buffer); j++) {
+        len += snprintf(_log_buffer + len, sizeof(_log_buffer) - len, "%s%s",
+                        j ? " > " : " ", graph.phase(path[j]).name);
+    }
+    NOTICE(_log_buffer);
+}
+
+
 bool BootProfiler::saveToFile() {
     if (!_fs_ready) {
         WARNING("[BOOT] Cannot save profile - filesystem not ready");
@@ -212,6 +296,17 @@ bool BootProfiler::saveToFile() {
     file.printf("Init:  %u ms\n", init_ms);
     file.printf("Wait:  %u ms\n", wait_ms);
 
+    if (_graph_phase_count > 0) {
+        file.printf("Graph: wall %u ms, phases %u ms, critical path %u ms\n",
+                    _graph_wall_ms, _graph_busy_ms, _graph_critical_ms);
+        for (uint8_t i = 0; i < _graph_phase_count; i++) {
+            const GraphPhase& gp = _graph_phases[i];
+            file.printf("  %c %-14s at %5u  dur %5u  overlap %5u  runner %u\n",
+                        gp.critical ? '*' : ' ', gp.name, gp.start_ms,
+                        gp.duration_ms, gp.overlap_ms, gp.runner);
+        }
+    }
+
     // Add timestamp if available
     time_t now = time(nullptr);
     if (now > 1704067200) {  // After 2024-01-01
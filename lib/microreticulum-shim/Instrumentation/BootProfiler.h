@@ -17,6 +17,10 @@
  *   - Per-phase duration and cumulative time
  *   - Separate tracking of init vs wait time
  *   - Final summary with breakdown
+ *   - Critical path and per-phase overlap when boot runs as a BootGraph
+ *
+ * Phases and waits may be open on several tasks at once (BootGraph runs
+ * independent phases on both cores); wait time is then summed across tasks.
  *
  * When disabled, all API calls compile to no-ops via stub macros.
  */
@@ -26,6 +30,8 @@
 #include <cstdint>
 #include <cstddef>
 
+namespace RNS { class BootGraph; }
+
 namespace RNS { namespace Instrumentation {
 
 /**
@@ -106,6 +112,17 @@ public:
      */
     static uint32_t getWaitMs();
 
+    /**
+     * Log the schedule of a finished BootGraph
+     *
+     * Logs wall vs summed phase time, each phase's start, duration, runner
+     * and overlap with other phases, and the critical path. The table is
+     * kept for saveToFile().
+     *
+     * @param graph Graph after run() returned
+     */
+    static void reportGraph(const RNS::BootGraph& graph);
+
     /**
      * Set filesystem ready state
      *
@@ -128,20 +145,50 @@ public:
 private:
     // Maximum number of boot log files to retain
     static const uint8_t MAX_BOOT_LOGS = 5;
+    // Phases (and waits) that can be open at once, one per task
+    static const uint8_t MAX_OPEN = 4;
+    // Graph phases kept for saveToFile()
+    static const uint8_t MAX_GRAPH_PHASES = 16;
+
+    struct OpenMark {
+        char name[32];
+        uint32_t start_ms;
+    };
+
+    struct GraphPhase {
+        const char* name;
+        uint32_t start_ms;
+        uint32_t duration_ms;
+        uint32_t overlap_ms;
+        uint8_t runner;
+        bool critical;
+    };
+
+    // Open a mark in the first free slot; returns its start time
+    static uint32_t openMark(OpenMark* marks, const char* name);
+    // Close the named mark; returns its duration, 0 if it wasn't open
+    static uint32_t closeMark(OpenMark* marks, const char* name, uint32_t now);
+
     // Boot timing
     static uint32_t _boot_start_ms;
     static uint32_t _cumulative_ms;
 
-    // Current phase tracking
-    static char _current_phase[32];
-    static uint32_t _phase_start_ms;
+    // Open phase tracking
+    static OpenMark _open_phases[MAX_OPEN];
 
     // Wait time tracking
-    static char _current_wait[32];
-    static uint32_t _wait_start_ms;
+    static OpenMark _open_waits[MAX_OPEN];
     static uint32_t _total_wait_ms;
 
-    // Static buffer for log formatting (avoid stack allocation)
+    // Last reported BootGraph
+    static GraphPhase _graph_phases[MAX_GRAPH_PHASES];
+    static uint8_t _graph_phase_count;
+    static uint32_t _graph_wall_ms;
+    static uint32_t _graph_busy_ms;
+    static uint32_t _graph_critical_ms;
+
+    // Static buffer for log formatting (avoid stack allocation); only used
+    // by the summary calls, which run on one task after the graph finishes
     static char _log_buffer[256];
 
     // Filesystem ready flag
@@ -0,0 +1,190 @@
+/*
+ * CpuMonitor - Per-task and per-core CPU utilisation for ESP32-S3
+ *
+ * Reads every task's run-time counter with uxTaskGetSystemState() and hands
+ * the snapshot to CpuStats. The IDLE task of each core (looked up by
+ * handle, not name) gives that core's idle time; xTaskGetAffinity() gives
+ * the core a task is pinned to.
+ *
+ * Key design decisions:
+ *   - Buffers allocated once in PSRAM (~4KB; internal RAM is the scarce one)
+ *   - Sampled from MemoryMonitor::poll() on loopTask, never from the timer
+ *     daemon (uxTaskGetSystemState suspends the scheduler briefly)
+ */
+
+#include "CpuMonitor.h"
+
+#ifdef MEMORY_INSTRUMENTATION_ENABLED
+
+#include "CpuStats.h"
+#include "Metrics.h"
+
+#include <microReticulum/Log.h>
+
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <cstdio>
+#include <new>
+
+#if (configUSE_TRACE_FACILITY == 1) && (configGENERATE_RUN_TIME_STATS == 1)
+#define CPU_MONITOR_HAVE_RUNTIME_STATS 1
+#else
+#define CPU_MONITOR_HAVE_RUNTIME_STATS 0
+#endif
+
+namespace RNS { namespace Instrumentation {
+
+// Run-time clock rate: esp_timer (1MHz) unless configured for the CPU clock
+#ifdef CONFIG_FREERTOS_RUN_TIME_STATS_USING_CPU_CLK
+static constexpr uint32_t RUNTIME_TICKS_PER_MS = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ * 1000;
+#else
+static constexpr uint32_t RUNTIME_TICKS_PER_MS = 1000;
+#endif
+
+// Room for every task; uxTaskGetSystemState() fails outright if the array is short
+static constexpr size_t MAX_STATUS = CpuStatsConfig::MAX_TASKS + 8;
+
+CpuStats* CpuMonitor::_stats = nullptr;
+bool CpuMonitor::_unavailable_logged = false;
+
+#if CPU_MONITOR_HAVE_RUNTIME_STATS
+static TaskStatus_t* _status = nullptr;
+static CpuTaskSample* _samples = nullptr;
+#endif
+
+// Static buffer for log formatting (avoid large stack frames on loopTask)
+static char _cpu_buffer[256];
+
+
+bool CpuMonitor::sample() {
+#if CPU_MONITOR_HAVE_RUNTIME_STATS
+    if (_stats == nullptr) {
+        void* mem = heap_caps_malloc(sizeof(CpuStats), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        _status = static_cast<TaskStatus_t*>(
+            heap_caps_malloc(sizeof(TaskStatus_t) * MAX_STATUS, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        _samples = static_cast<CpuTaskSample*>(
+            heap_caps_malloc(sizeof(CpuTaskSample) * MAX_STATUS, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (mem == nullptr || _status == nullptr || _samples == nullptr) {
+            ERROR("[CPU] Failed to allocate sample buffers");
+            heap_caps_free(mem);
+            heap_caps_free(_status);
+            heap_caps_free(_samples);
+            _status = nullptr;
+            _samples = nullptr;
+            return false;
+        }
+        _stats = new (mem) CpuStats();
+    }
+
+    uint32_t total_runtime = 0;
+    UBaseType_t n = uxTaskGetSystemState(_status, MAX_STATUS, &total_runtime);
+    if (n == 0) {
+        WARNINGF("[CPU] More than %u tasks, skipping sample", (unsigned)MAX_STATUS);
+        return false;
+    }
+
+    TaskHandle_t idle[CpuStatsConfig::CORES];
+    for (uint8_t c = 0; c < CpuStatsConfig::CORES; c++) {
+        idle[c] = xTaskGetIdleTaskHandleForCPU(c);
+    }
+
+    for (UBaseType_t i = 0; i < n; i++) {
+        const TaskStatus_t& t = _status[i];
+        CpuTaskSample& s = _samples[i];
+        s = CpuTaskSample();
+        s.id = reinterpret_cast<uintptr_t>(t.xHandle);
+        s.name = t.pcTaskName;
+        s.runtime = t.ulRunTimeCounter;
+        BaseType_t affinity = xTaskGetAffinity(t.xHandle);
+        s.core = affinity == tskNO_AFFINITY ? CpuStatsConfig::NO_CORE : static_cast<int8_t>(affinity);
+        for (uint8_t c = 0; c < CpuStatsConfig::CORES; c++) {
+            if (t.xHandle == idle[c]) s.idle_core = c;
+        }
+    }
+
+    // Names are copied, so the status array can be reused next time
+    _stats->update(_samples, n, total_runtime);
+    if (_stats->intervals() == 0) {
+        return false;
+    }
+
+    Metrics::set(METRIC_CPU_CORE0_LOAD, _stats->coreLoadTenths(0));
+    Metrics::set(METRIC_CPU_CORE1_LOAD, _stats->coreLoadTenths(1));
+    return true;
+#else
+    if (!_unavailable_logged) {
+        WARNING("[CPU] FreeRTOS run-time stats not compiled in; CPU monitor disabled");
+        _unavailable_logged = true;
+    }
+    return false;
+#endif
+}
+
+
+void CpuMonitor::log() {
+    if (_stats == nullptr || _stats->intervals() == 0) {
+        return;
+    }
+    const CpuStats& st = *_stats;
+
+    uint32_t idle0_ms = st.coreIdle(0) / RUNTIME_TICKS_PER_MS;
+    uint32_t idle1_ms = st.coreIdle(1) / RUNTIME_TICKS_PER_MS;
+    uint32_t interval_ms = st.elapsed() / RUNTIME_TICKS_PER_MS;
+    NOTICEF("[CPU] core0=%u.%u%% idle0=%u.%us core1=%u.%u%% idle1=%u.%us interval=%u.%us",
+            st.coreLoadTenths(0) / 10, st.coreLoadTenths(0) % 10,
+            idle0_ms / 1000, (idle0_ms % 1000) / 100,
+            st.coreLoadTenths(1) / 10, st.coreLoadTenths(1) % 10,
+            idle1_ms / 1000, (idle1_ms % 1000) / 100,
+            interval_ms / 1000, (interval_ms % 1000) / 100);
+
+    // Busiest first (insertion sort over at most MAX_TASKS indices)
+    uint8_t order[CpuStatsConfig::MAX_TASKS];
+    size_t count = 0;
+    for (size_t i = 0; i < st.size(); i++) {
+        if (st.task(i).idle_core != CpuStatsConfig::NO_CORE) continue;
+        size_t j = count++;
+        while (j > 0 && st.task(order[j - 1]).load_tenths < st.task(i).load_tenths) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = static_cast<uint8_t>(i);
+    }
+
+    // Build compact report: "task=N.N%@core ..." ('*' = either core)
+    size_t offset = snprintf(_cpu_buffer, sizeof(_cpu_buffer), "[CPU] ");
+    for (size_t k = 0; k < count && offset < sizeof(_cpu_buffer) - 40; k++) {
+        const CpuTaskLoad& t = st.task(order[k]);
+        if (t.core == CpuStatsConfig::NO_CORE) {
+            offset += snprintf(_cpu_buffer + offset, sizeof(_cpu_buffer) - offset, "%s=%u.%u%%@* ",
+                               t.name, t.load_tenths / 10, t.load_tenths % 10);
+        } else {
+            offset += snprintf(_cpu_buffer + offset, sizeof(_cpu_buffer) - offset, "%s=%u.%u%%@%d ",
+                               t.name, t.load_tenths / 10, t.load_tenths % 10, t.core);
+        }
+    }
+    NOTICE(_cpu_buffer);
+
+    // Warn about tasks whose share jumped since the previous interval
+    for (size_t i = 0; i < st.size() && st.jumps() > 0; i++) {
+        const CpuTaskLoad& t = st.task(i);
+        if (t.jumped) {
+            WARNINGF("[CPU] Task '%s' jumped %u.%u%% -> %u.%u%%", t.name,
+                     t.prev_tenths / 10, t.prev_tenths % 10, t.load_tenths / 10, t.load_tenths % 10);
+        }
+    }
+    if (st.dropped() > 0) {
+        WARNINGF("[CPU] %u tasks not tracked (limit %u)",
+                 (unsigned)st.dropped(), (unsigned)CpuStatsConfig::MAX_TASKS);
+    }
+}
+
+
+const CpuStats* CpuMonitor::stats() {
+    return _stats;
+}
+
+}} // namespace RNS::Instrumentation
+
+#endif // MEMORY_INSTRUMENTATION_ENABLED
@@ -0,0 +1,76 @@
+#pragma once
+
+/*
+ * CpuMonitor - Per-task and per-core CPU utilisation for ESP32-S3
+ *
+ * Sibling of MemoryMonitor: each MemoryMonitor interval also takes a CPU
+ * sample, so the [CPU] lines land next to [HEAP]/[STACK]. Every task is
+ * covered (from uxTaskGetSystemState(), not MemoryMonitor's registry),
+ * including lxst_cap, lvgl and the NimBLE host.
+ *
+ * Log format (shares of one core, busiest tasks first):
+ *   [CPU] core0=41.2% idle0=17.6s core1=88.0% idle1=3.6s interval=30.0s
+ *   [CPU] lxst_cap=52.1%@1 lvgl=30.4%@1 loopTask=22.0%@1 nimble_host=9.8%@0 ...
+ *   [CPU] Task 'lvgl' jumped 4.0% -> 61.3%
+ * Core loads are also exported as cpu.core<n>_load_permille gauges
+ * (T:METRICS). The arithmetic lives in CpuStats.h.
+ *
+ * Needs FreeRTOS run-time stats (configGENERATE_RUN_TIME_STATS and
+ * configUSE_TRACE_FACILITY); without them sample() logs one warning and
+ * does nothing. Guarded by MEMORY_INSTRUMENTATION_ENABLED like
+ * MemoryMonitor.
+ */
+
+#ifdef MEMORY_INSTRUMENTATION_ENABLED
+
+#include <cstdint>
+#include <cstddef>
+
+namespace RNS { namespace Instrumentation {
+
+class CpuStats;
+
+/**
+ * CpuMonitor - Static class for CPU utilisation sampling
+ *
+ * All methods are static - no instantiation required. Call from one task
+ * only (MemoryMonitor::poll() on loopTask).
+ */
+class CpuMonitor {
+public:
+    /**
+     * Snapshot every task's run-time counter and close the interval since
+     * the previous sample. The first call only sets the baseline. Buffers
+     * are allocated in PSRAM on the first call.
+     *
+     * @return true if a complete interval is available
+     */
+    static bool sample();
+
+    /**
+     * Log per-core load and idle time, the busiest tasks, and any task
+     * whose share jumped. No-op until sample() has returned true.
+     */
+    static void log();
+
+    /**
+     * Last computed statistics, or nullptr before the first sample
+     */
+    static const CpuStats* stats();
+
+private:
+    static CpuStats* _stats;
+    static bool _unavailable_logged;
+};
+
+}} // namespace RNS::Instrumentation
+
+#define CPU_MONITOR_SAMPLE() RNS::Instrumentation::CpuMonitor::sample()
+#define CPU_MONITOR_LOG() RNS::Instrumentation::CpuMonitor::log()
+
+#else // MEMORY_INSTRUMENTATION_ENABLED not defined
+
+#define CPU_MONITOR_SAMPLE() ((void)0)
+#define CPU_MONITOR_LOG() ((void)0)
+
+#endif // MEMORY_INSTRUMENTATION_ENABLED
@@ -0,0 +1,178 @@
+#pragma once
+
+/*
+ * CpuStats - Per-task and per-core CPU utilisation from run-time counters
+ *
+ * FreeRTOS keeps a cumulative run-time counter per task. CpuStats turns two
+ * successive snapshots of those counters into shares of the interval:
+ *
+ *   task load  = task delta / elapsed, as a share of one core (a task only
+ *                ever runs on one core at a time)
+ *   core idle  = delta of that core's IDLE task
+ *   core load  = 100% - idle share
+ *
+ * Counters are 32-bit and wrap; deltas are taken modulo 2^32, so an
+ * interval must be shorter than one wrap (~71 minutes with the 1MHz
+ * esp_timer run-time clock).
+ *
+ * A task whose load rises by JUMP_TENTHS or more between two intervals is
+ * flagged, so a task that suddenly starts eating a core shows up without
+ * reading every line. Tasks seen for the first time have no previous
+ * interval and are never flagged.
+ *
+ * Platform-free: CpuMonitor feeds it from uxTaskGetSystemState(), tests
+ * feed it directly. Loads are in tenths of a percent. Fixed storage, no
+ * allocation; not thread-safe (one sampler at a time).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace RNS { namespace Instrumentation {
+
+namespace CpuStatsConfig {
+    static constexpr size_t MAX_TASKS = 32;
+    static constexpr size_t NAME_LEN = 16;             // configMAX_TASK_NAME_LEN on ESP32
+    static constexpr uint8_t CORES = 2;
+    static constexpr int8_t NO_CORE = -1;              // Unpinned (tskNO_AFFINITY)
+    static constexpr uint16_t JUMP_TENTHS = 250;       // +25 points between intervals
+}
+
+// One task's counter as read from the kernel
+struct CpuTaskSample {
+    uintptr_t id = 0;                                  // TaskHandle_t
+    const char* name = "";
+    uint32_t runtime = 0;                              // Cumulative run-time counter
+    int8_t core = CpuStatsConfig::NO_CORE;             // Pinned core
+    int8_t idle_core = CpuStatsConfig::NO_CORE;        // IDLE task of this core, else NO_CORE
+};
+
+// One task's share of the last interval
+struct CpuTaskLoad {
+    char name[CpuStatsConfig::NAME_LEN] = {};
+    int8_t core = CpuStatsConfig::NO_CORE;
+    int8_t idle_core = CpuStatsConfig::NO_CORE;
+    uint16_t load_tenths = 0;                          // Of one core
+    uint16_t prev_tenths = 0;
+    bool is_new = false;                               // No previous interval
+    bool jumped = false;
+};
+
+class CpuStats {
+public:
+    /**
+     * Take a snapshot. total_runtime is the run-time clock at the same
+     * moment (uxTaskGetSystemState's pulTotalRunTime). The first call only
+     * primes the baseline; loads are valid once intervals() > 0. Tasks past
+     * MAX_TASKS are ignored and counted in dropped().
+     */
+    void update(const CpuTaskSample* samples, size_t n, uint32_t total_runtime) {
+        const bool primed = _have_baseline;
+        const uint32_t elapsed = total_runtime - _last_total;
+        if (primed && elapsed == 0) return;           // Same instant; keep the last interval
+        _dropped = n > CpuStatsConfig::MAX_TASKS ? n - CpuStatsConfig::MAX_TASKS : 0;
+        if (n > CpuStatsConfig::MAX_TASKS) n = CpuStatsConfig::MAX_TASKS;
+
+        Entry* next = _scratch;
+        for (uint8_t c = 0; c < CpuStatsConfig::CORES; c++) _idle_delta[c] = 0;
+        _jumps = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            const CpuTaskSample& s = samples[i];
+            Entry& e = next[i];
+            e = Entry();
+            e.id = s.id;
+            e.runtime = s.runtime;
+            e.load.core = s.core;
+            e.load.idle_core = s.idle_core;
+            strncpy(e.load.name, s.name ? s.name : "", CpuStatsConfig::NAME_LEN - 1);
+            e.load.name[CpuStatsConfig::NAME_LEN - 1] = '\0';
+
+            const Entry* prev = find(s.id);
+            if (!primed || prev == nullptr) {
+                e.load.is_new = primed && prev == nullptr;
+                continue;
+            }
+            const uint32_t delta = s.runtime - prev->runtime;
+            e.load.load_tenths = tenths(delta, elapsed);
+            e.load.prev_tenths = prev->load.load_tenths;
+            e.measured = true;
+            e.load.jumped = prev->measured &&
+                            e.load.load_tenths >= e.load.prev_tenths + CpuStatsConfig::JUMP_TENTHS;
+            if (e.load.jumped) _jumps++;
+            if (s.idle_core >= 0 && s.idle_core < CpuStatsConfig::CORES) {
+                _idle_delta[s.idle_core] = delta;
+            }
+        }
+
+        memcpy(_entries, next, n * sizeof(Entry));
+        _count = n;
+        if (primed) {
+            _elapsed = elapsed;
+            _intervals++;
+        }
+        _last_total = total_runtime;
+        _have_baseline = true;
+    }
+
+    size_t size() const { return _count; }
+    const CpuTaskLoad& task(size_t i) const { return _entries[i].load; }
+
+    // Completed intervals (loads are meaningful once this is non-zero)
+    uint32_t intervals() const { return _intervals; }
+    // Length of the last interval in run-time clock units
+    uint32_t elapsed() const { return _elapsed; }
+    // Tasks flagged in the last interval
+    size_t jumps() const { return _jumps; }
+    // Tasks left out of the last snapshot (over MAX_TASKS)
+    size_t dropped() const { return _dropped; }
+
+    uint32_t coreIdle(uint8_t core) const {
+        return core < CpuStatsConfig::CORES ? _idle_delta[core] : 0;
+    }
+    uint16_t coreIdleTenths(uint8_t core) const {
+        return _intervals > 0 ? tenths(coreIdle(core), _elapsed) : 0;
+    }
+    uint16_t coreLoadTenths(uint8_t core) const {
+        return _intervals > 0 ? 1000 - coreIdleTenths(core) : 0;
+    }
+
+    void reset() { *this = CpuStats(); }
+
+private:
+    struct Entry {
+        uintptr_t id = 0;
+        uint32_t runtime = 0;
+        bool measured = false;                         // load covers a full interval
+        CpuTaskLoad load;
+    };
+
+    const Entry* find(uintptr_t id) const {
+        for (size_t i = 0; i < _count; i++) {
+            if (_entries[i].id == id) return &_entries[i];
+        }
+        return nullptr;
+    }
+
+    // Clamped: counters are sampled one task at a time, so a delta can
+    // slightly exceed the interval
+    static uint16_t tenths(uint32_t delta, uint32_t elapsed) {
+        if (elapsed == 0) return 0;
+        uint64_t t = (static_cast<uint64_t>(delta) * 1000 + elapsed / 2) / elapsed;
+        return t > 1000 ? 1000 : static_cast<uint16_t>(t);
+    }
+
+    Entry _entries[CpuStatsConfig::MAX_TASKS];
+    Entry _scratch[CpuStatsConfig::MAX_TASKS];         // Next snapshot, built against _entries
+    size_t _count = 0;
+    uint32_t _last_total = 0;
+    uint32_t _elapsed = 0;
+    uint32_t _idle_delta[CpuStatsConfig::CORES] = {};
+    uint32_t _intervals = 0;
+    size_t _jumps = 0;
+    size_t _dropped = 0;
+    bool _have_baseline = false;
+};
+
+}} // namespace RNS::Instrumentation
@@ -0,0 +1,292 @@
+/*
+ * EventTrace - Cross-task timeline tracing
+ *
+ * Implementation notes:
+ *   - A ring's owner field is the only thing tasks contend on, and only on
+ *     their first event: claiming is a compare-exchange, so two tasks can
+ *     never end up writing the same ring. After that the owner is the sole
+ *     writer of records and head; dump() reads head with acquire ordering.
+ *   - A task that exits hands its ring back with releaseThread(). The next
+ *     task with the same name picks it up and keeps appending (so the audio
+ *     capture task stays one track across calls); otherwise a never-used
+ *     ring is preferred, and only then a released ring of another task is
+ *     cleared and reused.
+ *   - Each core has its own cycle counter, started at a different moment.
+ *     init() measures the difference once with an IPC handshake so the host
+ *     can put events from both cores on one timebase.
+ */
+
+#include "EventTrace.h"
+
+#ifdef EVENT_TRACE_ENABLED
+
+#include <cstdlib>
+#include <cstring>
+
+#if EVENT_TRACE_ESP32
+#include <esp_heap_caps.h>
+#include <esp_ipc.h>
+#include <esp_rom_sys.h>
+#endif
+
+namespace RNS { namespace Instrumentation {
+
+// Static member initialization
+EventTrace::Ring EventTrace::_rings[EVENT_TRACE_RINGS] = {};
+uint32_t EventTrace::_mask = 0;
+std::atomic<bool> EventTrace::_running{false};
+
+// Owner value of a ring whose task has exited
+static const void* const RING_RELEASED = reinterpret_cast<const void*>(1);
+
+static EventTraceRecord* _records = nullptr;
+static uint32_t _ring_events = 0;
+static std::atomic<uint32_t> _name_hash[EVENT_TRACE_RINGS];
+static std::atomic<uint32_t> _lost{0};
+static uint32_t _cpu_mhz = 0;
+static int32_t _core_offset[2] = {0, 0};
+
+static uint32_t nameHash(const char* name) {
+    uint32_t h = 2166136261u;   // FNV-1a
+    for (; *name; name++) {
+        h ^= static_cast<uint8_t>(*name);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static const void* currentTask() {
+#if EVENT_TRACE_ESP32
+    return xTaskGetCurrentTaskHandle();
+#else
+    static thread_local char native_task_id;
+    return &native_task_id;
+#endif
+}
+
+static const char* currentTaskName() {
+#if EVENT_TRACE_ESP32
+    const char* name = pcTaskGetName(nullptr);
+    return name ? name : "?";
+#else
+    return "thread";
+#endif
+}
+
+#if EVENT_TRACE_ESP32 && !CONFIG_FREERTOS_UNICORE
+// Handshake state for measuring the cross-core cycle counter offset
+static volatile uint32_t _sync_state = 0;
+static volatile uint32_t _sync_remote_cycles = 0;
+
+static void syncRemote(void*) {
+    _sync_state = 1;
+    while (_sync_state != 2) {}
+    _sync_remote_cycles = static_cast<uint32_t>(esp_cpu_get_cycle_count());
+    _sync_state = 3;
+}
+
+// Offset to add to the other core's cycles to get this core's timebase.
+// Takes the round with the shortest round trip; error is half of it.
+static int32_t measureRemoteOffset() {
+    int32_t best_offset = 0;
+    uint32_t best_rtt = UINT32_MAX;
+    uint32_t other = 1 - static_cast<uint32_t>(esp_cpu_get_core_id());
+    for (int round = 0; round < 8; round++) {
+        _sync_state = 0;
+        if (esp_ipc_call(other, syncRemote, nullptr) != ESP_OK) break;
+        while (_sync_state != 1) {}
+        uint32_t t0 = static_cast<uint32_t>(esp_cpu_get_cycle_count());
+        _sync_state = 2;
+        while (_sync_state != 3) {}
+        uint32_t t1 = static_cast<uint32_t>(esp_cpu_get_cycle_count());
+        uint32_t rtt = t1 - t0;
+        if (rtt < best_rtt) {
+            best_rtt = rtt;
+            best_offset = static_cast<int32_t>(t0 + rtt / 2 - _sync_remote_cycles);
+        }
+    }
+    return best_offset;
+}
+#endif
+
+bool EventTrace::init(size_t ring_events) {
+    if (_records) return true;
+    if (ring_events < 2) return false;
+
+    // Round down to a power of two so the hot path can mask
+    uint32_t events = 1;
+    while (static_cast<size_t>(events) * 2 <= ring_events) events *= 2;
+
+    size_t bytes = static_cast<size_t>(events) * EVENT_TRACE_RINGS * sizeof(EventTraceRecord);
+#if EVENT_TRACE_ESP32
+    _records = static_cast<EventTraceRecord*>(heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+#else
+    _records = static_cast<EventTraceRecord*>(malloc(bytes));
+#endif
+    if (!_records) return false;
+
+    _ring_events = events;
+    _mask = events - 1;
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        _rings[i].records = _records + i * events;
+    }
+
+#if EVENT_TRACE_ESP32
+    _cpu_mhz = esp_rom_get_cpu_ticks_per_us();
+#if !CONFIG_FREERTOS_UNICORE
+    int32_t remote = measureRemoteOffset();
+    _core_offset[1] = esp_cpu_get_core_id() == 0 ? remote : -remote;
+#endif
+#else
+    _cpu_mhz = 1000;   // Native "cycles" are nanoseconds
+#endif
+
+    start();
+    return true;
+}
+
+void EventTrace::start() {
+    if (!_records) return;
+    _running.store(true, std::memory_order_release);
+}
+
+void EventTrace::stop() {
+    _running.store(false, std::memory_order_release);
+}
+
+void EventTrace::clear() {
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        _rings[i].head.store(0, std::memory_order_release);
+    }
+    _lost.store(0, std::memory_order_relaxed);
+}
+
+EventTrace::Ring* EventTrace::claimRing() {
+    if (!_records) return nullptr;
+
+    const void* self = currentTask();
+    const char* name = currentTaskName();
+    uint32_t hash = nameHash(name);
+
+    auto take = [&](size_t i, const void* expected, bool reset) -> Ring* {
+        Ring& ring = _rings[i];
+        if (!ring.owner.compare_exchange_strong(expected, self, std::memory_order_acq_rel)) {
+            return nullptr;
+        }
+        if (reset) {
+            ring.head.store(0, std::memory_order_relaxed);
+            strncpy(ring.task, name, sizeof(ring.task) - 1);
+            ring.task[sizeof(ring.task) - 1] = '\0';
+            _name_hash[i].store(hash, std::memory_order_relaxed);
+        }
+        _thread_ring = &ring;
+        return &ring;
+    };
+
+    // Same task name coming back (e.g. a new capture task for the next call)
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        if (_rings[i].owner.load(std::memory_order_relaxed) == RING_RELEASED &&
+            _name_hash[i].load(std::memory_order_relaxed) == hash) {
+            if (Ring* ring = take(i, RING_RELEASED, false)) return ring;
+        }
+    }
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        if (_rings[i].owner.load(std::memory_order_relaxed) == nullptr) {
+            if (Ring* ring = take(i, nullptr, true)) return ring;
+        }
+    }
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        if (_rings[i].owner.load(std::memory_order_relaxed) == RING_RELEASED) {
+            if (Ring* ring = take(i, RING_RELEASED, true)) return ring;
+        }
+    }
+
+    _lost.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+void EventTrace::releaseThread() {
+    Ring* ring = _thread_ring;
+    if (!ring) return;
+    _thread_ring = nullptr;
+    ring->owner.store(RING_RELEASED, std::memory_order_release);
+}
+
+size_t EventTrace::ringCount() {
+    size_t n = 0;
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        if (_rings[i].owner.load(std::memory_order_acquire) != nullptr) n++;
+    }
+    return n;
+}
+
+EventTraceHeader EventTrace::header() {
+    EventTraceHeader h;
+    h.cpu_mhz = _cpu_mhz;
+    h.core_offset[0] = _core_offset[0];
+    h.core_offset[1] = _core_offset[1];
+    h.ring_count = static_cast<uint16_t>(ringCount());
+    h.lost = _lost.load(std::memory_order_relaxed);
+    return h;
+}
+
+static size_t nameTableSize() {
+    size_t n = 0;
+    for (size_t i = 0; i < TRACE_NAME_COUNT; i++) {
+        n += 1 + strlen(EVENT_TRACE_NAMES[i]);
+    }
+    return n;
+}
+
+size_t EventTrace::dumpSize() {
+    size_t n = sizeof(EventTraceHeader) + nameTableSize();
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        if (_rings[i].owner.load(std::memory_order_acquire) == nullptr) continue;
+        uint32_t head = _rings[i].head.load(std::memory_order_acquire);
+        uint32_t count = head < _ring_events ? head : _ring_events;
+        n += sizeof(EventTraceRingHeader) + count * sizeof(EventTraceRecord);
+    }
+    return n;
+}
+
+size_t EventTrace::dump(Writer out, void* ctx) {
+    size_t written = 0;
+    auto emit = [&](const void* data, size_t len) {
+        if (len == 0) return;
+        out(static_cast<const uint8_t*>(data), len, ctx);
+        written += len;
+    };
+
+    EventTraceHeader h = header();
+    emit(&h, sizeof(h));
+
+    for (size_t i = 0; i < TRACE_NAME_COUNT; i++) {
+        uint8_t len = static_cast<uint8_t>(strlen(EVENT_TRACE_NAMES[i]));
+        emit(&len, 1);
+        emit(EVENT_TRACE_NAMES[i], len);
+    }
+
+    for (size_t i = 0; i < EVENT_TRACE_RINGS; i++) {
+        const Ring& ring = _rings[i];
+        if (ring.owner.load(std::memory_order_acquire) == nullptr) continue;
+        uint32_t head = ring.head.load(std::memory_order_acquire);
+
+        EventTraceRingHeader rh;
+        memcpy(rh.task, ring.task, sizeof(rh.task));
+        rh.count = head < _ring_events ? head : _ring_events;
+        rh.dropped = head - rh.count;
+        emit(&rh, sizeof(rh));
+
+        // Oldest first: from head (mod size) to the end, then the start
+        uint32_t first = (head - rh.count) & _mask;
+        uint32_t tail_len = _ring_events - first;
+        if (tail_len > rh.count) tail_len = rh.count;
+        emit(ring.records + first, tail_len * sizeof(EventTraceRecord));
+        emit(ring.records, (rh.count - tail_len) * sizeof(EventTraceRecord));
+    }
+    return written;
+}
+
+}} // namespace RNS::Instrumentation
+
+#endif // EVENT_TRACE_ENABLED
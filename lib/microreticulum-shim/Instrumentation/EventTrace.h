@@ -0,0 +1,208 @@
+#pragma once
+
+/*
+ * EventTrace - Cross-task timeline tracing (spans, instants, counters)
+ *
+ * Records compact 16-byte events (see EventTraceFormat.h) stamped with the
+ * CPU cycle counter into a ring per task, so the timeline of loopTask, the
+ * LVGL task, the audio tasks and the interface tasks on both cores can be
+ * laid side by side. T:TRACE dump streams the rings as binary;
+ * tools/trace/trace_to_perfetto.py turns them into Chrome/Perfetto JSON.
+ *
+ * Usage:
+ *   1. Build the tdeck-trace env (defines EVENT_TRACE_ENABLED)
+ *   2. Call EVENT_TRACE_INIT() early in setup(); recording starts at once
+ *   3. Instrument with EVENT_TRACE_SCOPE(NAME) / EVENT_TRACE_SCOPE_V(NAME, v)
+ *      (span for the enclosing block), EVENT_TRACE_INSTANT(NAME, v) and
+ *      EVENT_TRACE_COUNTER(NAME, v); NAME is an EventTraceName without its
+ *      TRACE_NAME_ prefix
+ *   4. Tasks that exit call EVENT_TRACE_THREAD_EXIT() so their ring can be
+ *      reused by the next task (e.g. the per-call audio capture task)
+ *
+ * Each task claims a ring on its first event and is its only writer, so
+ * recording is a thread-local load, a few stores and one release store: no
+ * lock, no atomic read-modify-write, no allocation (~20-30 cycles). Rings
+ * overwrite their oldest events when full. Stop recording before dumping;
+ * an event being written while its ring is copied can come out torn.
+ *
+ * When disabled, all API calls compile to no-ops via stub macros.
+ */
+
+#include "EventTraceFormat.h"
+
+#ifdef EVENT_TRACE_ENABLED
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <esp_cpu.h>
+#define EVENT_TRACE_ESP32 1
+#else
+#include <chrono>
+#define EVENT_TRACE_ESP32 0
+#endif
+
+#ifndef EVENT_TRACE_RINGS
+#define EVENT_TRACE_RINGS 10
+#endif
+#ifndef EVENT_TRACE_RING_EVENTS
+#define EVENT_TRACE_RING_EVENTS 4096      // 64KB PSRAM per ring
+#endif
+
+namespace RNS { namespace Instrumentation {
+
+/**
+ * EventTrace - Static class owning the per-task rings
+ *
+ * All methods are static - no instantiation required.
+ */
+class EventTrace {
+public:
+    struct Ring {
+        char task[16];
+        std::atomic<const void*> owner;     // Task handle; null = free to claim
+        std::atomic<uint32_t> head;         // Events ever written (owner only)
+        EventTraceRecord* records;
+    };
+
+    // Stream sink for dump()
+    using Writer = void (*)(const uint8_t* data, size_t len, void* ctx);
+
+    /**
+     * Allocate the rings in PSRAM, measure the cross-core cycle offset and
+     * start recording
+     *
+     * @param ring_events Events per ring; rounded down to a power of two
+     * @return true if the rings were allocated (or already were)
+     */
+    static bool init(size_t ring_events = EVENT_TRACE_RING_EVENTS);
+
+    static void start();
+    static void stop();
+    static bool running() { return _running.load(std::memory_order_relaxed); }
+
+    // Drop all recorded events; rings stay with their tasks
+    static void clear();
+
+    // Record one event on the calling task's ring
+    static inline void record(uint16_t name, uint8_t type, int32_t value = 0) {
+        if (!_running.load(std::memory_order_relaxed)) return;
+        Ring* ring = _thread_ring;
+        if (!ring) {
+            ring = claimRing();
+            if (!ring) return;
+        }
+        uint32_t head = ring->head.load(std::memory_order_relaxed);
+        EventTraceRecord& rec = ring->records[head & _mask];
+        uint32_t ms;
+        rec.cycles = cycles(ms);
+        rec.tick_ms = ms;
+        rec.name = name;
+        rec.type = type;
+        rec.core = core();
+        rec.value = value;
+        ring->head.store(head + 1, std::memory_order_release);
+    }
+
+    // Give the calling task's ring back (call before the task deletes itself)
+    static void releaseThread();
+
+    // Rings claimed so far (each holds one task's events)
+    static size_t ringCount();
+
+    // Header describing what dump() would write right now
+    static EventTraceHeader header();
+
+    // Exact byte size of dump() right now
+    static size_t dumpSize();
+
+    /**
+     * Write the dump (header, name table, rings oldest first) to `out`.
+     * Call stop() first for a consistent snapshot.
+     *
+     * @return Bytes written
+     */
+    static size_t dump(Writer out, void* ctx);
+
+private:
+    static Ring* claimRing();
+
+    static inline uint32_t cycles(uint32_t& tick_ms) {
+#if EVENT_TRACE_ESP32
+        tick_ms = static_cast<uint32_t>(xTaskGetTickCount() * portTICK_PERIOD_MS);
+        return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#else
+        // Native "cycles" are nanoseconds (cpu_mhz = 1000)
+        uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        tick_ms = static_cast<uint32_t>(ns / 1000000);
+        return static_cast<uint32_t>(ns);
+#endif
+    }
+
+    static inline uint8_t core() {
+#if EVENT_TRACE_ESP32
+        return static_cast<uint8_t>(esp_cpu_get_core_id());
+#else
+        return 0;
+#endif
+    }
+
+    static Ring _rings[EVENT_TRACE_RINGS];
+    static uint32_t _mask;
+    static std::atomic<bool> _running;
+    static inline thread_local Ring* _thread_ring = nullptr;
+};
+
+/**
+ * EventTraceScope - BEGIN on construction, END on destruction
+ */
+class EventTraceScope {
+public:
+    explicit EventTraceScope(uint16_t name, int32_t value = 0) : _name(name) {
+        EventTrace::record(name, EVENT_TRACE_BEGIN, value);
+    }
+    ~EventTraceScope() { EventTrace::record(_name, EVENT_TRACE_END); }
+    EventTraceScope(const EventTraceScope&) = delete;
+    EventTraceScope& operator=(const EventTraceScope&) = delete;
+
+private:
+    uint16_t _name;
+};
+
+}} // namespace RNS::Instrumentation
+
+#define EVENT_TRACE_CONCAT_(a, b) a##b
+#define EVENT_TRACE_CONCAT(a, b) EVENT_TRACE_CONCAT_(a, b)
+
+// Convenience macros for conditional compilation
+#define EVENT_TRACE_INIT() RNS::Instrumentation::EventTrace::init()
+#define EVENT_TRACE_SCOPE(id) \
+    RNS::Instrumentation::EventTraceScope EVENT_TRACE_CONCAT(_event_trace_scope_, __LINE__)( \
+        RNS::Instrumentation::TRACE_NAME_##id)
+#define EVENT_TRACE_SCOPE_V(id, value) \
+    RNS::Instrumentation::EventTraceScope EVENT_TRACE_CONCAT(_event_trace_scope_, __LINE__)( \
+        RNS::Instrumentation::TRACE_NAME_##id, static_cast<int32_t>(value))
+#define EVENT_TRACE_INSTANT(id, value) \
+    RNS::Instrumentation::EventTrace::record(RNS::Instrumentation::TRACE_NAME_##id, \
+        RNS::Instrumentation::EVENT_TRACE_INSTANT, static_cast<int32_t>(value))
+#define EVENT_TRACE_COUNTER(id, value) \
+    RNS::Instrumentation::EventTrace::record(RNS::Instrumentation::TRACE_NAME_##id, \
+        RNS::Instrumentation::EVENT_TRACE_COUNTER, static_cast<int32_t>(value))
+#define EVENT_TRACE_THREAD_EXIT() RNS::Instrumentation::EventTrace::releaseThread()
+
+#else // EVENT_TRACE_ENABLED not defined
+
+// Stub macros - compile to nothing when tracing disabled
+#define EVENT_TRACE_INIT() ((void)0)
+#define EVENT_TRACE_SCOPE(id) ((void)0)
+#define EVENT_TRACE_SCOPE_V(id, value) ((void)0)
+#define EVENT_TRACE_INSTANT(id, value) ((void)0)
+#define EVENT_TRACE_COUNTER(id, value) ((void)0)
+#define EVENT_TRACE_THREAD_EXIT() ((void)0)
+
+#endif // EVENT_TRACE_ENABLED
@@ -0,0 +1,112 @@
+#pragma once
+
+/*
+ * EventTraceFormat - Event ids and binary layout of T:TRACE dumps
+ *
+ * Shared by the firmware recorder (EventTrace.h) and documented for the
+ * host-side converter (tools/trace/trace_to_perfetto.py). Plain C++ with no
+ * ESP dependencies. Everything is little-endian.
+ *
+ * Dump layout:
+ *   EventTraceHeader
+ *   name table: name_count x { uint8 len, len bytes }, indexed by EventTraceName
+ *   ring_count x { EventTraceRingHeader, count x EventTraceRecord }
+ *
+ * Record (16 bytes):
+ *   cycles   - CPU cycle counter of the core that recorded it. Each core has
+ *              its own counter; add header.core_offset[core] to put both on
+ *              core 0's timebase. Wraps every 2^32 cycles (~17.9s at 240MHz).
+ *   tick_ms  - FreeRTOS tick count in ms, coarse but wrap-free: the host uses
+ *              it to pick the right cycle-counter wrap
+ *   name     - EventTraceName
+ *   type     - EventTraceType
+ *   core     - core the event was recorded on
+ *   value    - span/instant argument (bytes, samples...) or counter value
+ *
+ * Records in one ring come from one task, in the order they were recorded.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RNS { namespace Instrumentation {
+
+static constexpr uint32_t EVENT_TRACE_MAGIC = 0x43525445;   // "ETRC"
+static constexpr uint16_t EVENT_TRACE_VERSION = 1;
+
+enum EventTraceType : uint8_t {
+    EVENT_TRACE_BEGIN = 1,      // Span opens
+    EVENT_TRACE_END = 2,        // Span closes (innermost open span of this name)
+    EVENT_TRACE_INSTANT = 3,
+    EVENT_TRACE_COUNTER = 4
+};
+
+// Instrumentation points; keep EVENT_TRACE_NAMES in the same order
+enum EventTraceName : uint16_t {
+    TRACE_NAME_RETICULUM_LOOP = 0,
+    TRACE_NAME_PUMP_CALL_TX,
+    TRACE_NAME_CAPTURE_FRAME,
+    TRACE_NAME_PLAYBACK_FRAME,
+    TRACE_NAME_LVGL_FLUSH,
+    TRACE_NAME_AUTO_TX,
+    TRACE_NAME_AUTO_RX,
+    TRACE_NAME_TCP_TX,
+    TRACE_NAME_TCP_RX,
+    TRACE_NAME_LORA_TX,
+    TRACE_NAME_LORA_RX,
+    TRACE_NAME_BLE_TX,
+    TRACE_NAME_BLE_RX,
+    TRACE_NAME_CAPTURE_RING_DROPS,
+    TRACE_NAME_USER,            // T:TRACE mark <n>
+    TRACE_NAME_COUNT
+};
+
+static constexpr const char* EVENT_TRACE_NAMES[TRACE_NAME_COUNT] = {
+    "reticulum.loop",
+    "ui.pump_call_tx",
+    "audio.capture_frame",
+    "audio.playback_frame",
+    "lvgl.flush",
+    "auto.send_outgoing",
+    "auto.handle_incoming",
+    "tcp.send_outgoing",
+    "tcp.handle_incoming",
+    "lora.send_outgoing",
+    "lora.handle_incoming",
+    "ble.send_outgoing",
+    "ble.handle_incoming",
+    "audio.capture_ring_drops",
+    "user.mark",
+};
+
+struct EventTraceRecord {
+    uint32_t cycles;
+    uint32_t tick_ms;
+    uint16_t name;
+    uint8_t type;
+    uint8_t core;
+    int32_t value;
+};
+
+struct EventTraceHeader {
+    uint32_t magic = EVENT_TRACE_MAGIC;
+    uint16_t version = EVENT_TRACE_VERSION;
+    uint16_t record_size = sizeof(EventTraceRecord);
+    uint32_t cpu_mhz = 0;           // Cycles per microsecond
+    int32_t core_offset[2] = {};    // Add to a core's cycles for core 0's timebase
+    uint16_t name_count = TRACE_NAME_COUNT;
+    uint16_t ring_count = 0;
+    uint32_t lost = 0;              // Events from tasks that found no free ring
+};
+
+struct EventTraceRingHeader {
+    char task[16] = {};             // Task name when the ring was claimed
+    uint32_t count = 0;             // Records that follow
+    uint32_t dropped = 0;           // Older records overwritten by the ring
+};
+
+static_assert(sizeof(EventTraceRecord) == 16, "trace record layout is part of the dump format");
+static_assert(sizeof(EventTraceHeader) == 28, "trace header layout is part of the dump format");
+static_assert(sizeof(EventTraceRingHeader) == 24, "ring header layout is part of the dump format");
+
+}} // namespace RNS::Instrumentation
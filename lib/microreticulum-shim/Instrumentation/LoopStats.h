@@ -0,0 +1,235 @@
+#pragma once
+
+/*
+ * LoopStats - Per-step latency histograms for the main loop
+ *
+ * LOOP_STEP(n) in main.cpp marks which part of loop() is running. Each call
+ * also closes the previous step: its duration goes into that step's
+ * histogram, so every step gets count, p50, p99 and max without any
+ * per-sample storage.
+ *
+ * Histograms are log-bucketed in microseconds, two buckets per power of two
+ * (percentiles are within ~25%); max is exact. Durations come from the CPU
+ * cycle counter. It wraps every ~17.9s at 240MHz, so steps of 4s or more
+ * are measured with the tick count instead.
+ *
+ * A step longer than the budget (LOOP_STEP_BUDGET_MS, changeable at
+ * runtime) logs a warning, at most one per second; every overrun is still
+ * counted. The warning is logged before the next step's clock starts so it
+ * isn't charged to that step.
+ *
+ * Cost per LOOP_STEP is a cycle-count read, a tick read, a divide and a few
+ * increments (well under 1us). Footprint is MAX_STEPS x BUCKETS x 4 bytes
+ * (~2.8KB). Not thread-safe: step(), stats() and reset() all belong to
+ * loopTask (T:LOOPSTATS runs from loop()).
+ */
+
+#include <microReticulum/Log.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <esp_cpu.h>
+#include <esp_rom_sys.h>
+#define LOOP_STATS_ESP32 1
+#else
+#include <chrono>
+#define LOOP_STATS_ESP32 0
+#endif
+
+#ifndef LOOP_STEP_BUDGET_MS
+#define LOOP_STEP_BUDGET_MS 1000
+#endif
+
+namespace RNS { namespace Instrumentation {
+
+namespace LoopStatsConfig {
+    static constexpr uint8_t MAX_STEPS = 14;              // LOOP_STEP(0..13)
+    static constexpr uint8_t OCTAVES = 25;                // 1us .. ~33s
+    static constexpr uint8_t BUCKETS = 2 * OCTAVES;
+    static constexpr uint32_t CYCLE_WRAP_GUARD_MS = 4000; // Use ticks at or above this
+    static constexpr uint32_t WARN_INTERVAL_MS = 1000;
+}
+
+struct LoopStepStats {
+    uint32_t count = 0;
+    uint32_t p50_us = 0;
+    uint32_t p99_us = 0;
+    uint32_t max_us = 0;
+    uint64_t total_us = 0;
+    uint32_t over_budget = 0;
+};
+
+class LoopStats {
+public:
+    using OverBudgetHandler = void (*)(uint8_t step, uint32_t us);
+
+    static LoopStats& instance() {
+        static LoopStats stats;
+        return stats;
+    }
+
+    /**
+     * Close the running step and start step n. A step number outside
+     * MAX_STEPS only closes the running one.
+     */
+    void step(uint8_t n) {
+        const uint32_t now_cycles = cycles();
+        const uint32_t now_ms = ticksMs();
+        if (_current < LoopStatsConfig::MAX_STEPS) {
+            uint32_t elapsed_ms = now_ms - _start_ms;
+            uint32_t us = elapsed_ms >= LoopStatsConfig::CYCLE_WRAP_GUARD_MS
+                ? elapsed_ms * 1000
+                : (now_cycles - _start_cycles) / _cycles_per_us;
+            if (record(_current, us)) {
+                overBudget(_current, us, now_ms);
+                _current = n;
+                _start_cycles = cycles();
+                _start_ms = ticksMs();
+                return;
+            }
+        }
+        _current = n;
+        _start_cycles = now_cycles;
+        _start_ms = now_ms;
+    }
+
+    /**
+     * Add one sample to a step's histogram. Returns true if it was over
+     * budget (and counted as such). step() uses this; tests feed it directly.
+     */
+    bool record(uint8_t n, uint32_t us) {
+        if (n >= LoopStatsConfig::MAX_STEPS) return false;
+        Step& s = _steps[n];
+        s.buckets[bucketOf(us)]++;
+        s.count++;
+        s.total_us += us;
+        if (us > s.max_us) s.max_us = us;
+        if (us > _budget_us) {
+            s.over_budget++;
+            return true;
+        }
+        return false;
+    }
+
+    LoopStepStats stats(uint8_t n) const {
+        LoopStepStats out;
+        if (n >= LoopStatsConfig::MAX_STEPS) return out;
+        const Step& s = _steps[n];
+        out.count = s.count;
+        out.max_us = s.max_us;
+        out.total_us = s.total_us;
+        out.over_budget = s.over_budget;
+        out.p50_us = percentile(s, 50);
+        out.p99_us = percentile(s, 99);
+        return out;
+    }
+
+    // Clear every histogram; the running step keeps its start time
+    void reset() {
+        memset(_steps, 0, sizeof(_steps));
+    }
+
+    void setBudgetMs(uint32_t ms) { _budget_us = ms * 1000; }
+    uint32_t budgetMs() const { return _budget_us / 1000; }
+
+    // Replaces the default WARNING line (tests, or routing to the UI)
+    void setOverBudgetHandler(OverBudgetHandler handler) { _handler = handler; }
+
+    // Lowest duration that lands in bucket i; bucket i covers [lower(i), lower(i+1))
+    static uint32_t bucketLowerUs(uint8_t i) {
+        if (i == 0) return 0;
+        uint8_t msb = (i + 1) / 2;
+        uint32_t half = (i + 1) % 2;
+        return (2 | half) << (msb - 1);
+    }
+
+    static uint8_t bucketOf(uint32_t us) {
+        if (us < 2) return 0;
+        uint8_t msb = static_cast<uint8_t>(31 - __builtin_clz(us));
+        uint8_t i = static_cast<uint8_t>(2 * msb - 1 + ((us >> (msb - 1)) & 1));
+        return i < LoopStatsConfig::BUCKETS ? i : LoopStatsConfig::BUCKETS - 1;
+    }
+
+private:
+    struct Step {
+        uint32_t buckets[LoopStatsConfig::BUCKETS];
+        uint32_t count;
+        uint32_t max_us;
+        uint64_t total_us;
+        uint32_t over_budget;
+    };
+
+    LoopStats() {
+#if LOOP_STATS_ESP32
+        _cycles_per_us = esp_rom_get_cpu_ticks_per_us();
+        if (_cycles_per_us == 0) _cycles_per_us = 240;
+#else
+        _cycles_per_us = 1000;   // Native "cycles" are nanoseconds
+#endif
+        reset();
+    }
+    LoopStats(const LoopStats&) = delete;
+    LoopStats& operator=(const LoopStats&) = delete;
+
+    static uint32_t cycles() {
+#if LOOP_STATS_ESP32
+        return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static uint32_t ticksMs() {
+#if LOOP_STATS_ESP32
+        return static_cast<uint32_t>(xTaskGetTickCount() * portTICK_PERIOD_MS);
+#else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Upper edge of the bucket holding the pct-th sample, capped at max
+    static uint32_t percentile(const Step& s, uint32_t pct) {
+        if (s.count == 0) return 0;
+        uint64_t rank = (static_cast<uint64_t>(s.count) * pct + 99) / 100;
+        uint64_t seen = 0;
+        for (uint8_t i = 0; i < LoopStatsConfig::BUCKETS; i++) {
+            seen += s.buckets[i];
+            if (seen >= rank) {
+                if (i + 1 >= LoopStatsConfig::BUCKETS) return s.max_us;
+                uint32_t upper = bucketLowerUs(i + 1) - 1;
+                return upper < s.max_us ? upper : s.max_us;
+            }
+        }
+        return s.max_us;
+    }
+
+    void overBudget(uint8_t n, uint32_t us, uint32_t now_ms) {
+        if (_handler) {
+            _handler(n, us);
+            return;
+        }
+        if (_warned_ms != 0 && now_ms - _warned_ms < LoopStatsConfig::WARN_INTERVAL_MS) return;
+        _warned_ms = now_ms ? now_ms : 1;
+        WARNINGF("[LOOP] step %u took %ums (budget %ums, %u overruns)",
+                 (unsigned)n, (unsigned)(us / 1000), (unsigned)budgetMs(),
+                 (unsigned)_steps[n].over_budget);
+    }
+
+    Step _steps[LoopStatsConfig::MAX_STEPS];
+    uint8_t _current = LoopStatsConfig::MAX_STEPS;   // None running yet
+    uint32_t _start_cycles = 0;
+    uint32_t _start_ms = 0;
+    uint32_t _cycles_per_us = 1;
+    uint32_t _budget_us = LOOP_STEP_BUDGET_MS * 1000;
+    uint32_t _warned_ms = 0;
+    OverBudgetHandler _handler = nullptr;
+};
+
+}} // namespace RNS::Instrumentation
@@ -15,6 +15,8 @@
 
 #ifdef MEMORY_INSTRUMENTATION_ENABLED
 
+#include "CpuMonitor.h"
+
 #include <microReticulum/Log.h>
 #include <BytesPool.h>
 
@@ -76,8 +78,9 @@ bool MemoryMonitor::init(uint32_t interval_ms) {
 
     NOTICEF("[MEM_MON] Started (interval=%ums)", interval_ms);
 
-    // Log initial state immediately
+    // Log initial state immediately; the first CPU sample is the baseline
     logHeapStats();
+    CpuMonitor::sample();
 
     return true;
 }
@@ -150,6 +153,9 @@ void MemoryMonitor::logNow() {
     if (_task_count > 0) {
         logTaskStacks();
     }
+    if (CpuMonitor::sample()) {
+        CpuMonitor::log();
+    }
 }
 
 
@@ -161,6 +167,9 @@ void MemoryMonitor::poll() {
     if (_task_count > 0) {
         logTaskStacks();
     }
+    if (CpuMonitor::sample()) {
+        CpuMonitor::log();
+    }
 }
 
 
@@ -226,12 +235,23 @@ void MemoryMonitor::logHeapStats() {
     // BytesPool stats - shows actual pool usage
     auto& pool = BytesPool::instance();
     NOTICEF("[POOL] tiny=%zu/%zu small=%zu/%zu med=%zu/%zu large=%zu/%zu "
-            "hits=%zu misses=%zu fallbacks=%zu",
-            pool.tiny_in_use(), BytesPoolConfig::TINY_SLOTS,
-            pool.small_in_use(), BytesPoolConfig::SMALL_SLOTS,
-            pool.medium_in_use(), BytesPoolConfig::MEDIUM_SLOTS,
-            pool.large_in_use(), BytesPoolConfig::LARGE_SLOTS,
-            pool.pool_hits(), pool.pool_misses(), pool.fallback_count());
+            "xl=%zu/%zu xxl=%zu/%zu hits=%zu misses=%zu fallbacks=%zu reserve=%zu",
+            pool.tiny_in_use(), pool.slots(BytesPoolConfig::TIER_64),
+            pool.small_in_use(), pool.slots(BytesPoolConfig::TIER_256),
+            pool.medium_in_use(), pool.slots(BytesPoolConfig::TIER_512),
+            pool.large_in_use(), pool.slots(BytesPoolConfig::TIER_1024),
+            pool.in_use(BytesPoolConfig::TIER_2048), pool.slots(BytesPoolConfig::TIER_2048),
+            pool.in_use(BytesPoolConfig::TIER_4096), pool.slots(BytesPoolConfig::TIER_4096),
+            pool.pool_hits(), pool.pool_misses(), pool.fallback_count(),
+            pool.reserve_remaining());
+
+    // Buddy region stats - multi-KB buffers; frag is free space stranded below 64KB
+    BuddyStats buddy = BuddyAllocator::instance().stats();
+    NOTICEF("[BUDDY] used=%zu/%zu peak=%zu largest=%zu frag=%u%% allocs=%zu fails=%zu "
+            "splits=%zu merges=%zu",
+            buddy.bytes_in_use, buddy.region_bytes, buddy.peak_in_use, buddy.largest_free,
+            (unsigned)buddy.fragmentation, buddy.allocations, buddy.failures,
+            buddy.splits, buddy.merges);
 }
 
 
@@ -34,6 +34,7 @@ namespace RNS { namespace Instrumentation {
  *   - Internal RAM: free, largest block, minimum free (watermark), fragmentation %
  *   - PSRAM: free, largest block
  *   - Task stack high water marks for registered tasks
+ *   - Per-task and per-core CPU load, via CpuMonitor (every task)
  *
  * All methods are static - no instantiation required.
  */
@@ -0,0 +1,285 @@
+#pragma once
+
+/*
+ * Metrics - Static registry of counters, gauges and latency histograms
+ *
+ * Every metric is declared once in PYXIS_METRICS below; the list expands
+ * into one enum per kind and a name table, so the set is fixed at compile
+ * time and storage is plain static arrays. Recording is one relaxed atomic
+ * op (histograms: a bucket search plus three), never allocates and is safe
+ * from any task.
+ *
+ * Each interface exports the same set under "iface.<name>.":
+ *   rx_packets / rx_bytes  - frames handed to Transport
+ *   rx_drops               - frames read but not handed over (duplicates,
+ *                            runts, framing garbage, radio errors, overflow)
+ *   tx_packets / tx_bytes  - frames accepted by the medium
+ *   tx_drops               - send_outgoing() calls that did not send
+ *   queue_depth            - frames waiting inside the interface itself
+ *   rx_latency_us          - frame read off the medium -> Transport done
+ *                            with it (handle_incoming() returned)
+ *
+ * LXST call audio has per-stage latency histograms (see
+ * lib/lxst_audio/audio_latency.h):
+ *   lxst.tx.capture_us - i2s_read() done -> filtered PCM queued
+ *   lxst.tx.queue_us   - EncodedRingBuffer residency
+ *   lxst.tx.encode_us  - Codec2 encode
+ *   lxst.tx.send_us    - encode done -> Packet::send() returned
+ *   lxst.tx.total_us   - i2s_read() done -> sent
+ *   lxst.rx.decode_us  - packet arrival -> decoded frames queued
+ *   lxst.rx.queue_us   - PacketRingBuffer residency (includes prebuffer)
+ *   lxst.rx.output_us  - ring read -> i2s_write() returned
+ *   lxst.rx.total_us   - packet arrival -> i2s_write() returned
+ *   lxst.mouth_to_ear_us - sender TX age (in-band) + rx.total, only for
+ *                        packets carrying the timing extension
+ *
+ * T:METRICS prints every metric, one per line, in registry order:
+ *   T:METRICS v1 count=<n> uptime_ms=<ms>
+ *   T:M <name> counter <value>
+ *   T:M <name> gauge <value>
+ *   T:M <name> histogram count=<n> sum=<us> le_100=<n> ... le_inf=<n>
+ *   T:OK metrics=<n>
+ * Histogram buckets are cumulative (Prometheus-style). Counters and sums are
+ * 32-bit and wrap; scrapers should take deltas modulo 2^32. Names are
+ * stable: add new metrics at the end of their group, never rename.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(ESP_PLATFORM) || defined(ARDUINO)
+#include <esp_timer.h>
+#define METRICS_ESP32 1
+#else
+#include <chrono>
+#define METRICS_ESP32 0
+#endif
+
+// Per-interface metric set; ID prefixes the enum names, NAME the dump names
+#define PYXIS_METRICS_IFACE(COUNTER, GAUGE, HISTOGRAM, ID, NAME) \
+    COUNTER(ID##_RX_PACKETS, NAME ".rx_packets")                 \
+    COUNTER(ID##_RX_BYTES, NAME ".rx_bytes")                     \
+    COUNTER(ID##_RX_DROPS, NAME ".rx_drops")                     \
+    COUNTER(ID##_TX_PACKETS, NAME ".tx_packets")                 \
+    COUNTER(ID##_TX_BYTES, NAME ".tx_bytes")                     \
+    COUNTER(ID##_TX_DROPS, NAME ".tx_drops")                     \
+    GAUGE(ID##_QUEUE_DEPTH, NAME ".queue_depth")                 \
+    HISTOGRAM(ID##_RX_LATENCY, NAME ".rx_latency_us")
+
+#define PYXIS_METRICS(COUNTER, GAUGE, HISTOGRAM)                                  \
+    PYXIS_METRICS_IFACE(COUNTER, GAUGE, HISTOGRAM, AUTO, "iface.auto")            \
+    PYXIS_METRICS_IFACE(COUNTER, GAUGE, HISTOGRAM, TCP, "iface.tcp")              \
+    PYXIS_METRICS_IFACE(COUNTER, GAUGE, HISTOGRAM, LORA, "iface.lora")            \
+    PYXIS_METRICS_IFACE(COUNTER, GAUGE, HISTOGRAM, BLE, "iface.ble")              \
+    COUNTER(AUTO_ANNOUNCE_TX, "auto.announce_tx")                                 \
+    COUNTER(AUTO_ANNOUNCE_TX_FAIL, "auto.announce_tx_fail")                       \
+    COUNTER(AUTO_DISCOVERY_RX, "auto.discovery_rx")                               \
+    COUNTER(AUTO_DISCOVERY_RX_SELF, "auto.discovery_rx_self")                     \
+    GAUGE(AUTO_PEERS, "auto.peers")                                               \
+    COUNTER(AUTO_PEER_EVICTIONS, "auto.peer_evictions")                           \
+    COUNTER(TCP_TX_WRITES, "tcp.tx_writes")                                       \
+    COUNTER(TCP_TX_PARTIAL_WRITES, "tcp.tx_partial_writes")                       \
+    COUNTER(TCP_TX_BACKPRESSURE, "tcp.tx_backpressure")                           \
+    GAUGE(TCP_TX_QUEUE_BYTES, "tcp.tx_queue_bytes")                               \
+    COUNTER(TCP_FAILOVERS, "tcp.failovers")                                       \
+    GAUGE(TCP_UPSTREAM, "tcp.upstream")                                           \
+    GAUGE(TCP_CONNECT_RTT, "tcp.connect_rtt_ms")                                  \
+    GAUGE(HEAP_INTERNAL_FREE, "heap.internal_free")                               \
+    GAUGE(HEAP_INTERNAL_LARGEST, "heap.internal_largest")                         \
+    GAUGE(HEAP_PSRAM_FREE, "heap.psram_free")                                     \
+    GAUGE(POOL_HITS, "pool.hits")                                                 \
+    GAUGE(POOL_MISSES, "pool.misses")                                             \
+    GAUGE(POOL_FALLBACKS, "pool.fallbacks")                                       \
+    GAUGE(CPU_CORE0_LOAD, "cpu.core0_load_permille")                              \
+    GAUGE(CPU_CORE1_LOAD, "cpu.core1_load_permille")                              \
+    HISTOGRAM(LXST_TX_CAPTURE, "lxst.tx.capture_us")                              \
+    HISTOGRAM(LXST_TX_QUEUE, "lxst.tx.queue_us")                                  \
+    HISTOGRAM(LXST_TX_ENCODE, "lxst.tx.encode_us")                                \
+    HISTOGRAM(LXST_TX_SEND, "lxst.tx.send_us")                                    \
+    HISTOGRAM(LXST_TX_TOTAL, "lxst.tx.total_us")                                  \
+    HISTOGRAM(LXST_RX_DECODE, "lxst.rx.decode_us")                                \
+    HISTOGRAM(LXST_RX_QUEUE, "lxst.rx.queue_us")                                  \
+    HISTOGRAM(LXST_RX_OUTPUT, "lxst.rx.output_us")                                \
+    HISTOGRAM(LXST_RX_TOTAL, "lxst.rx.total_us")                                  \
+    HISTOGRAM(LXST_MOUTH_TO_EAR, "lxst.mouth_to_ear_us")
+
+namespace RNS { namespace Instrumentation {
+
+#define METRICS_IGNORE(...)
+#define METRICS_ENUM(id, name) METRIC_##id,
+#define METRICS_NAME(id, name) name,
+
+enum MetricCounter : uint16_t {
+    PYXIS_METRICS(METRICS_ENUM, METRICS_IGNORE, METRICS_IGNORE)
+    METRIC_COUNTER_COUNT
+};
+enum MetricGauge : uint16_t {
+    PYXIS_METRICS(METRICS_IGNORE, METRICS_ENUM, METRICS_IGNORE)
+    METRIC_GAUGE_COUNT
+};
+enum MetricHistogram : uint16_t {
+    PYXIS_METRICS(METRICS_IGNORE, METRICS_IGNORE, METRICS_ENUM)
+    METRIC_HISTOGRAM_COUNT
+};
+
+namespace MetricsConfig {
+    // Histogram bucket upper bounds in microseconds; one more bucket catches the rest
+    static constexpr uint32_t BOUNDS_US[] = {
+        100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000
+    };
+    static constexpr size_t BOUNDS = sizeof(BOUNDS_US) / sizeof(BOUNDS_US[0]);
+    static constexpr size_t BUCKETS = BOUNDS + 1;
+    static constexpr size_t LINE_MAX = 384;        // Fits a histogram with every bucket at 2^32-1
+}
+
+struct MetricHistogramSnapshot {
+    uint32_t count = 0;
+    uint32_t sum_us = 0;
+    uint32_t buckets[MetricsConfig::BUCKETS] = {};   // Not cumulative
+};
+
+/**
+ * Metrics - Static registry
+ *
+ * All methods are static - no instantiation required.
+ */
+class Metrics {
+public:
+    // Line sink for dump(); lines carry no newline
+    using LineWriter = void (*)(const char* line, void* ctx);
+
+    static inline void add(MetricCounter id, uint32_t n = 1) {
+        _counters[id].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    static inline void set(MetricGauge id, int32_t value) {
+        _gauges[id].store(value, std::memory_order_relaxed);
+    }
+
+    static inline void observe(MetricHistogram id, uint32_t us) {
+        Histogram& h = _histograms[id];
+        size_t b = 0;
+        while (b < MetricsConfig::BOUNDS && us > MetricsConfig::BOUNDS_US[b]) b++;
+        h.buckets[b].fetch_add(1, std::memory_order_relaxed);
+        h.sum_us.fetch_add(us, std::memory_order_relaxed);
+        h.count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Microsecond clock for latency start/end stamps
+    static inline uint32_t nowUs() {
+#if METRICS_ESP32
+        return static_cast<uint32_t>(esp_timer_get_time());
+#else
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    // Observe the time since a nowUs() stamp
+    static inline void observeSince(MetricHistogram id, uint32_t start_us) {
+        observe(id, nowUs() - start_us);
+    }
+
+    static uint32_t counter(MetricCounter id) { return _counters[id].load(std::memory_order_relaxed); }
+    static int32_t gauge(MetricGauge id) { return _gauges[id].load(std::memory_order_relaxed); }
+
+    static MetricHistogramSnapshot histogram(MetricHistogram id) {
+        MetricHistogramSnapshot s;
+        const Histogram& h = _histograms[id];
+        s.count = h.count.load(std::memory_order_relaxed);
+        s.sum_us = h.sum_us.load(std::memory_order_relaxed);
+        for (size_t b = 0; b < MetricsConfig::BUCKETS; b++) {
+            s.buckets[b] = h.buckets[b].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+
+    static const char* name(MetricCounter id) { return COUNTER_NAMES[id]; }
+    static const char* name(MetricGauge id) { return GAUGE_NAMES[id]; }
+    static const char* name(MetricHistogram id) { return HISTOGRAM_NAMES[id]; }
+
+    static constexpr size_t count() {
+        return METRIC_COUNTER_COUNT + METRIC_GAUGE_COUNT + METRIC_HISTOGRAM_COUNT;
+    }
+
+    // Zero everything (tests and soak-run baselines; gauges too)
+    static void reset() {
+        for (auto& c : _counters) c.store(0, std::memory_order_relaxed);
+        for (auto& g : _gauges) g.store(0, std::memory_order_relaxed);
+        for (auto& h : _histograms) {
+            h.count.store(0, std::memory_order_relaxed);
+            h.sum_us.store(0, std::memory_order_relaxed);
+            for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Write the T:METRICS body (header, one line per metric, footer) to
+     * `out`, formatting into a stack buffer. Values are read one at a time,
+     * so a dump taken under traffic is not an atomic snapshot.
+     */
+    static void dump(LineWriter out, void* ctx, uint32_t uptime_ms) {
+        char line[MetricsConfig::LINE_MAX];
+        snprintf(line, sizeof(line), "T:METRICS v1 count=%u uptime_ms=%lu",
+                 (unsigned)count(), (unsigned long)uptime_ms);
+        out(line, ctx);
+        for (size_t i = 0; i < METRIC_COUNTER_COUNT; i++) {
+            snprintf(line, sizeof(line), "T:M %s counter %lu", COUNTER_NAMES[i],
+                     (unsigned long)counter(static_cast<MetricCounter>(i)));
+            out(line, ctx);
+        }
+        for (size_t i = 0; i < METRIC_GAUGE_COUNT; i++) {
+            snprintf(line, sizeof(line), "T:M %s gauge %ld", GAUGE_NAMES[i],
+                     (long)gauge(static_cast<MetricGauge>(i)));
+            out(line, ctx);
+        }
+        for (size_t i = 0; i < METRIC_HISTOGRAM_COUNT; i++) {
+            MetricHistogramSnapshot s = histogram(static_cast<MetricHistogram>(i));
+            int p = snprintf(line, sizeof(line), "T:M %s histogram count=%lu sum=%lu",
+                             HISTOGRAM_NAMES[i], (unsigned long)s.count, (unsigned long)s.sum_us);
+            uint32_t cumulative = 0;
+            for (size_t b = 0; b < MetricsConfig::BUCKETS && p > 0 && (size_t)p < sizeof(line); b++) {
+                cumulative += s.buckets[b];
+                if (b < MetricsConfig::BOUNDS) {
+                    p += snprintf(line + p, sizeof(line) - p, " le_%lu=%lu",
+                                  (unsigned long)MetricsConfig::BOUNDS_US[b], (unsigned long)cumulative);
+                } else {
+                    p += snprintf(line + p, sizeof(line) - p, " le_inf=%lu", (unsigned long)cumulative);
+                }
+            }
+            out(line, ctx);
+        }
+        snprintf(line, sizeof(line), "T:OK metrics=%u", (unsigned)count());
+        out(line, ctx);
+    }
+
+private:
+    // No initialisers: only instantiated in static storage, which is zeroed
+    struct Histogram {
+        std::atomic<uint32_t> count;
+        std::atomic<uint32_t> sum_us;
+        std::atomic<uint32_t> buckets[MetricsConfig::BUCKETS];
+    };
+
+    static constexpr const char* COUNTER_NAMES[] = {
+        PYXIS_METRICS(METRICS_NAME, METRICS_IGNORE, METRICS_IGNORE)
+    };
+    static constexpr const char* GAUGE_NAMES[] = {
+        PYXIS_METRICS(METRICS_IGNORE, METRICS_NAME, METRICS_IGNORE)
+    };
+    static constexpr const char* HISTOGRAM_NAMES[] = {
+        PYXIS_METRICS(METRICS_IGNORE, METRICS_IGNORE, METRICS_NAME)
+    };
+
+    static inline std::atomic<uint32_t> _counters[METRIC_COUNTER_COUNT] = {};
+    static inline std::atomic<int32_t> _gauges[METRIC_GAUGE_COUNT] = {};
+    static inline Histogram _histograms[METRIC_HISTOGRAM_COUNT];
+};
+
+#undef METRICS_IGNORE
+#undef METRICS_ENUM
+#undef METRICS_NAME
+
+}} // namespace RNS::Instrumentation
@@ -5,6 +5,8 @@
 #include <new>
 #include <utility>
 
+#include "PSRAMAllocator.h"
+
 // FreeRTOS spinlock support - only on ESP32
 #if defined(ESP_PLATFORM) || defined(ARDUINO)
 #include "freertos/FreeRTOS.h"
@@ -157,4 +159,321 @@ private:
 #endif
 };
 
+/**
+ * Growable object pool built from fixed-size slabs.
+ * Slabs of SLAB_SLOTS objects are allocated on demand via PSRAMAllocator
+ * (PSRAM first, internal heap fallback), up to MAX_SLABS. Nothing is
+ * reserved at construction, so the owning object stays small and the
+ * worst case is only paid for while a burst is actually happening.
+ * Thread-safe via spinlock (ESP32) or mutex (native).
+ *
+ * Template parameters:
+ *   T          - Object type to pool
+ *   SLAB_SLOTS - Objects per slab
+ *   MAX_SLABS  - Slab ceiling; allocate() returns nullptr beyond
+ *                SLAB_SLOTS * MAX_SLABS live objects
+ *
+ * Usage:
+ *   SegmentedObjectPool<MyClass, 4, 8> pool;
+ *   MyClass* obj = pool.allocate();  // nullptr only at the ceiling / OOM
+ *   ...
+ *   pool.deallocate(obj);
+ *   pool.trim(now, 30.0);            // from a periodic maintenance tick
+ *
+ * Design notes:
+ *   - Each slab keeps its own in-place freelist and live count
+ *   - Slabs with free slots sit on a partial list; allocate pops from its
+ *     head, and a slab that drains completely moves to the tail so the
+ *     others fill first and empty slabs stay empty
+ *   - deallocate finds the owning slab by address range over at most
+ *     MAX_SLABS entries, so both operations are O(1) in the pool size
+ *   - Slab allocation and freeing happen outside the critical section
+ *   - trim() returns slabs that have stayed empty for a quiet period,
+ *     keeping min_slabs; the empty timestamp is taken by trim() itself so
+ *     the hot path never reads the clock
+ */
+template <typename T, size_t SLAB_SLOTS, size_t MAX_SLABS>
+class SegmentedObjectPool {
+public:
+    explicit SegmentedObjectPool(size_t min_slabs = 1) : _min_slabs(min_slabs) {
+#if OBJECTPOOL_USE_SPINLOCK
+        portMUX_INITIALIZE(&_mux);
+#endif
+        for (size_t i = 0; i < MAX_SLABS; i++) {
+            _slabs[i] = nullptr;
+        }
+    }
+
+    // Objects still allocated at destruction are not destroyed.
+    ~SegmentedObjectPool() {
+        for (size_t i = 0; i < MAX_SLABS; i++) {
+            if (_slabs[i]) {
+                PSRAMAllocator<Slab>().deallocate(_slabs[i], 1);
+            }
+        }
+    }
+
+    SegmentedObjectPool(const SegmentedObjectPool&) = delete;
+    SegmentedObjectPool& operator=(const SegmentedObjectPool&) = delete;
+
+    /**
+     * Allocate object from pool, adding a slab if every slab is full.
+     * Returns nullptr at MAX_SLABS or if the slab allocation fails.
+     * Thread-safe.
+     */
+    template<typename... Args>
+    T* allocate(Args&&... args) {
+        Slot* slot = popSlot();
+        while (!slot) {
+            if (!addSlab()) {
+                lock();
+                _exhausted++;
+                unlock();
+                return nullptr;
+            }
+            // Another thread may drain the new slab first; retry until the
+            // ceiling is reached.
+            slot = popSlot();
+        }
+        return new (&slot->storage) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Return object to pool.
+     * Pointers not from this pool are ignored (caller's responsibility).
+     * Thread-safe.
+     */
+    void deallocate(T* ptr) {
+        if (!ptr) return;
+        Slot* slot = reinterpret_cast<Slot*>(ptr);
+
+        lock();
+        Slab* slab = findSlab(slot);
+        unlock();
+        if (!slab) return;
+
+        // Explicit destructor call
+        ptr->~T();
+
+        lock();
+        slot->next_free = slab->free;
+        slab->free = slot;
+        if (slab->used == SLAB_SLOTS) {
+            pushPartialFront(slab);
+        }
+        slab->used--;
+        _allocated--;
+        if (slab->used == 0) {
+            unlinkPartial(slab);
+            pushPartialBack(slab);
+        }
+        unlock();
+    }
+
+    /**
+     * Free slabs that have been empty for at least quiet_seconds.
+     * Call periodically with a monotonic clock (e.g. OS::time()).
+     * Returns the number of slabs freed.
+     */
+    size_t trim(double now, double quiet_seconds) {
+        Slab* victims[MAX_SLABS];
+        size_t victim_count = 0;
+
+        lock();
+        for (size_t i = 0; i < MAX_SLABS && _slab_count > _min_slabs; i++) {
+            Slab* slab = _slabs[i];
+            if (!slab || slab->used != 0) continue;
+            if (slab->empty_since < 0) {
+                slab->empty_since = now;
+            } else if (now - slab->empty_since >= quiet_seconds) {
+                unlinkPartial(slab);
+                _slabs[i] = nullptr;
+                _slab_count--;
+                victims[victim_count++] = slab;
+            }
+        }
+        _slabs_freed += victim_count;
+        unlock();
+
+        for (size_t i = 0; i < victim_count; i++) {
+            PSRAMAllocator<Slab>().deallocate(victims[i], 1);
+        }
+        return victim_count;
+    }
+
+    /**
+     * Check if pointer was allocated from this pool.
+     */
+    bool owns(T* ptr) {
+        lock();
+        bool found = findSlab(reinterpret_cast<Slot*>(ptr)) != nullptr;
+        unlock();
+        return found;
+    }
+
+    size_t allocated() const { return _allocated; }
+    size_t capacity() const { return _slab_count * SLAB_SLOTS; }
+    size_t available() const { return capacity() - _allocated; }
+    size_t slabs() const { return _slab_count; }
+    size_t peak_slabs() const { return _peak_slabs; }
+    size_t slabs_freed() const { return _slabs_freed; }
+    size_t exhausted() const { return _exhausted; }       // allocate() returned nullptr
+    static constexpr size_t max_capacity() { return SLAB_SLOTS * MAX_SLABS; }
+    static constexpr size_t slab_bytes() { return sizeof(Slab); }
+
+private:
+    static_assert(SLAB_SLOTS > 0 && MAX_SLABS > 0, "pool needs at least one slot");
+
+    struct Slot {
+        union {
+            alignas(T) char storage[sizeof(T)];
+            Slot* next_free;
+        };
+    };
+
+    struct Slab {
+        Slot slots[SLAB_SLOTS];
+        Slot* free;
+        Slab* prev;             // Partial list links
+        Slab* next;
+        size_t used;
+        double empty_since;     // < 0 while in use or not yet seen empty by trim()
+        bool on_partial;
+    };
+
+    void lock() {
+#if OBJECTPOOL_USE_SPINLOCK
+        portENTER_CRITICAL(&_mux);
+#else
+        _mutex.lock();
+#endif
+    }
+
+    void unlock() {
+#if OBJECTPOOL_USE_SPINLOCK
+        portEXIT_CRITICAL(&_mux);
+#else
+        _mutex.unlock();
+#endif
+    }
+
+    Slot* popSlot() {
+        lock();
+        Slab* slab = _partial_head;
+        if (!slab) {
+            unlock();
+            return nullptr;
+        }
+        Slot* slot = slab->free;
+        slab->free = slot->next_free;
+        slab->used++;
+        slab->empty_since = -1.0;
+        if (slab->used == SLAB_SLOTS) {
+            unlinkPartial(slab);
+        }
+        _allocated++;
+        unlock();
+        return slot;
+    }
+
+    bool addSlab() {
+        lock();
+        if (_slab_count + _growing >= MAX_SLABS) {
+            unlock();
+            return false;
+        }
+        _growing++;
+        unlock();
+
+        Slab* slab = nullptr;
+        try {
+            slab = PSRAMAllocator<Slab>().allocate(1);
+        } catch (const std::bad_alloc&) {
+            slab = nullptr;
+        }
+        if (slab) {
+            for (size_t i = 0; i < SLAB_SLOTS - 1; i++) {
+                slab->slots[i].next_free = &slab->slots[i + 1];
+            }
+            slab->slots[SLAB_SLOTS - 1].next_free = nullptr;
+            slab->free = &slab->slots[0];
+            slab->prev = slab->next = nullptr;
+            slab->used = 0;
+            slab->empty_since = -1.0;
+            slab->on_partial = false;
+        }
+
+        lock();
+        _growing--;
+        if (slab) {
+            for (size_t i = 0; i < MAX_SLABS; i++) {
+                if (!_slabs[i]) {
+                    _slabs[i] = slab;
+                    break;
+                }
+            }
+            _slab_count++;
+            if (_slab_count > _peak_slabs) _peak_slabs = _slab_count;
+            pushPartialFront(slab);
+        }
+        unlock();
+        return slab != nullptr;
+    }
+
+    // Caller holds the lock
+    Slab* findSlab(const Slot* slot) const {
+        for (size_t i = 0; i < MAX_SLABS; i++) {
+            Slab* slab = _slabs[i];
+            if (slab && slot >= slab->slots && slot < slab->slots + SLAB_SLOTS) {
+                return slab;
+            }
+        }
+        return nullptr;
+    }
+
+    void pushPartialFront(Slab* slab) {
+        slab->prev = nullptr;
+        slab->next = _partial_head;
+        if (_partial_head) _partial_head->prev = slab;
+        else _partial_tail = slab;
+        _partial_head = slab;
+        slab->on_partial = true;
+    }
+
+    void pushPartialBack(Slab* slab) {
+        slab->next = nullptr;
+        slab->prev = _partial_tail;
+        if (_partial_tail) _partial_tail->next = slab;
+        else _partial_head = slab;
+        _partial_tail = slab;
+        slab->on_partial = true;
+    }
+
+    void unlinkPartial(Slab* slab) {
+        if (!slab->on_partial) return;
+        if (slab->prev) slab->prev->next = slab->next;
+        else _partial_head = slab->next;
+        if (slab->next) slab->next->prev = slab->prev;
+        else _partial_tail = slab->prev;
+        slab->prev = slab->next = nullptr;
+        slab->on_partial = false;
+    }
+
+    Slab* _slabs[MAX_SLABS];
+    Slab* _partial_head = nullptr;
+    Slab* _partial_tail = nullptr;
+    size_t _slab_count = 0;
+    size_t _growing = 0;          // Slab allocations in flight (outside the lock)
+    size_t _min_slabs;
+    size_t _allocated = 0;
+    size_t _peak_slabs = 0;
+    size_t _slabs_freed = 0;
+    size_t _exhausted = 0;
+#if OBJECTPOOL_USE_SPINLOCK
+    portMUX_TYPE _mux;
+#else
+    std::mutex _mutex;
+#endif
+};
+
 } // namespace RNS
@@ -11,7 +11,9 @@
  */
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <new>
 
 #ifdef ARDUINO
@@ -21,6 +23,28 @@
 #include <cstdlib>
 #endif
 
+/*
+ * Hook for BytesPool's buddy tier (BuddyAllocator.h). BytesPool stages a
+ * buddy block on the calling task right before reserving a PooledData
+ * buffer, and the next allocate() that fits hands that block out instead of
+ * touching the heap. deallocate() ignores anything inside the registered
+ * buddy region; BuddyAllocator reclaims that memory.
+ */
+struct PSRAMAllocatorHook
+{
+    static inline thread_local void* staged = nullptr;
+    static inline thread_local std::size_t staged_size = 0;
+    static inline std::atomic<std::uintptr_t> buddy_begin{0};
+    static inline std::atomic<std::uintptr_t> buddy_end{0};
+
+    static bool owns(const void* p) noexcept
+    {
+        auto addr = reinterpret_cast<std::uintptr_t>(p);
+        return addr >= buddy_begin.load(std::memory_order_relaxed) &&
+               addr < buddy_end.load(std::memory_order_relaxed);
+    }
+};
+
 template <class T>
 class PSRAMAllocator
 {
@@ -34,6 +58,13 @@ public:
 
     [[nodiscard]] value_type* allocate(std::size_t n)
     {
+        if (PSRAMAllocatorHook::staged && n * sizeof(value_type) <= PSRAMAllocatorHook::staged_size)
+        {
+            auto p = static_cast<value_type*>(PSRAMAllocatorHook::staged);
+            PSRAMAllocatorHook::staged = nullptr;
+            return p;
+        }
+
 #ifdef ARDUINO
 #if CONFIG_SPIRAM || defined(BOARD_HAS_PSRAM)
         // Attempt to allocate in PSRAM first
@@ -66,6 +97,10 @@ public:
 
     void deallocate(value_type* p, std::size_t) noexcept
     {
+        if (PSRAMAllocatorHook::owns(p))
+        {
+            return;
+        }
 #ifdef ARDUINO
         heap_caps_free(p);
 #else
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef BOARD_HAS_PSRAM
+#include <esp_heap_caps.h>
+#endif
+
+namespace RNS {
+
+/**
+ * SPSCPacketQueue - lock-free single-producer/single-consumer packet queue.
+ *
+ * Hands whole packets between two threads: the main loop and the
+ * TCPClientInterface or AutoInterface socket task. Fixed slots of
+ * max_packet bytes, each carrying its length and a Metrics::nowUs() stamp;
+ * same index protocol as PacketRingBuffer (each side publishes its own
+ * index with release and loads the other's with acquire, one spare slot
+ * tells full from empty). The consumer reads a packet in place with front()
+ * and releases the slot with pop(), so a packet is copied once on each
+ * side.
+ */
+class SPSCPacketQueue {
+public:
+    SPSCPacketQueue(size_t slots, size_t max_packet)
+        : _slots(slots + 1), _max_packet(max_packet), _slot_size(sizeof(Header) + max_packet) {
+#ifdef BOARD_HAS_PSRAM
+        _buffer = static_cast<uint8_t*>(heap_caps_malloc(_slots * _slot_size, MALLOC_CAP_SPIRAM));
+#else
+        _buffer = static_cast<uint8_t*>(malloc(_slots * _slot_size));
+#endif
+    }
+
+    ~SPSCPacketQueue() { free(_buffer); }
+
+    SPSCPacketQueue(const SPSCPacketQueue&) = delete;
+    SPSCPacketQueue& operator=(const SPSCPacketQueue&) = delete;
+
+    bool valid() const { return _buffer != nullptr; }
+    size_t max_packet() const { return _max_packet; }
+
+    /** Producer: copy a packet in. False if full or len > max_packet. */
+    bool push(const uint8_t* data, size_t len, uint32_t stamp_us = 0) {
+        if (!_buffer || len > _max_packet) return false;
+        size_t w = _write.load(std::memory_order_relaxed);
+        size_t next = (w + 1) % _slots;
+        if (next == _read.load(std::memory_order_acquire)) return false;
+
+        uint8_t* slot = _buffer + w * _slot_size;
+        Header h{static_cast<uint32_t>(len), stamp_us};
+        memcpy(slot, &h, sizeof(h));
+        memcpy(slot + sizeof(Header), data, len);
+        _write.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer: the oldest packet, in place. Stays valid until pop().
+     * False if empty.
+     */
+    bool front(const uint8_t** data, size_t* len, uint32_t* stamp_us = nullptr) const {
+        size_t r = _read.load(std::memory_order_relaxed);
+        if (r == _write.load(std::memory_order_acquire)) return false;
+
+        const uint8_t* slot = _buffer + r * _slot_size;
+        Header h;
+        memcpy(&h, slot, sizeof(h));
+        *data = slot + sizeof(Header);
+        *len = h.len;
+        if (stamp_us) *stamp_us = h.stamp_us;
+        return true;
+    }
+
+    /** Consumer: release the packet returned by front(). */
+    void pop() {
+        size_t r = _read.load(std::memory_order_relaxed);
+        if (r == _write.load(std::memory_order_acquire)) return;
+        _read.store((r + 1) % _slots, std::memory_order_release);
+    }
+
+    /** Packets queued; exact only from the producer or consumer thread. */
+    size_t size() const {
+        size_t w = _write.load(std::memory_order_acquire);
+        size_t r = _read.load(std::memory_order_acquire);
+        return (w + _slots - r) % _slots;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /** Drop everything. Only while neither side is running. */
+    void reset() {
+        _write.store(0, std::memory_order_relaxed);
+        _read.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct Header {
+        uint32_t len;
+        uint32_t stamp_us;
+    };
+
+    const size_t _slots;
+    const size_t _max_packet;
+    const size_t _slot_size;
+    uint8_t* _buffer = nullptr;
+
+    std::atomic<size_t> _write{0};
+    std::atomic<size_t> _read{0};
+};
+
+}  // namespace RNS
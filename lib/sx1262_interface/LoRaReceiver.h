@@ -0,0 +1,148 @@
+// Copyright (c) 2024 microReticulum contributors
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <SPSCPacketQueue.h>
+#include <Instrumentation/Metrics.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * LoRaReceiver - SX1262 receive path, driven by DIO1.
+ *
+ * The radio raises DIO1 for the IRQs startReceive() maps to it (RX done,
+ * CRC/header error, timeout) and for TX done. The DIO1 ISR only wakes the
+ * LoRa task, which calls service() with the SPI mutex held: one status
+ * read, and when a packet is waiting, the packet, its RSSI and SNR, RX
+ * re-armed and the payload queued. The main loop takes payloads with
+ * deliver() and never touches the bus.
+ *
+ * Radio is RadioLib's SX1262 on the device and FakeLoRaRadio in native
+ * tests; service() uses getIrqStatus(), readData(), getPacketLength(),
+ * getRSSI(), getSNR() and startReceive().
+ *
+ * Queued records are [rssi][snr][payload] in an SPSCPacketQueue (PSRAM
+ * when available): the LoRa task produces, the main loop consumes.
+ */
+template <size_t MAX_PACKET>
+class LoRaReceiver {
+public:
+    // RadioLib codes service() acts on (RADIOLIB_ERR_NONE, RADIOLIB_ERR_RX_TIMEOUT,
+    // RADIOLIB_SX126X_IRQ_RX_DONE); kept here so this builds without RadioLib
+    static const int16_t ERR_NONE = 0;
+    static const int16_t ERR_RX_TIMEOUT = -6;
+    static const uint16_t IRQ_RX_DONE = 0x0002;
+
+    enum class Result : uint8_t {
+        IDLE,       // no IRQ pending (TX done, already re-armed by the sender)
+        REARMED,    // an IRQ other than RX done (header error, timeout): cleared
+        QUEUED,
+        DROPPED,    // read failed, header-only runt, or queue full
+    };
+
+    explicit LoRaReceiver(size_t slots) : _queue(slots, RECORD_HEADER + MAX_PACKET - 1) {}
+
+    LoRaReceiver(const LoRaReceiver&) = delete;
+    LoRaReceiver& operator=(const LoRaReceiver&) = delete;
+
+    bool valid() const { return _queue.valid(); }
+
+    /**
+     * LoRa task, SPI mutex held, after DIO1. rx_us is the Metrics::nowUs()
+     * stamp carried to deliver(). On DROPPED or a failed re-arm,
+     * last_state() has the RadioLib code.
+     */
+    template <typename Radio>
+    Result service(Radio& radio, uint32_t rx_us) {
+        _last_state = ERR_NONE;
+        uint16_t irq = radio.getIrqStatus();
+        if (irq == 0) return Result::IDLE;
+        if (!(irq & IRQ_RX_DONE)) {
+            // DIO1 stays high until the flags are cleared, and a high DIO1
+            // gives no edge for the next packet
+            _last_state = radio.startReceive();
+            return Result::REARMED;
+        }
+
+        // Read straight into the record: the RNode header byte lands in the
+        // last byte of the [rssi][snr] prefix, which then overwrites it
+        uint8_t* frame = _record + RECORD_HEADER - 1;
+        int16_t state = radio.readData(frame, MAX_PACKET);
+        size_t len = 0;
+        float rssi = 0.0f;
+        float snr = 0.0f;
+        if (state == ERR_NONE) {
+            len = radio.getPacketLength();
+            if (len > MAX_PACKET) len = MAX_PACKET;
+            rssi = radio.getRSSI();
+            snr = radio.getSNR();
+        }
+
+        // Re-arm before queueing so the radio is listening again as soon
+        // as possible
+        int16_t rearm = radio.startReceive();
+
+        if (state != ERR_NONE) {
+            _last_state = state;
+            if (state == ERR_RX_TIMEOUT) return Result::REARMED;
+            RNS::Instrumentation::Metrics::add(RNS::Instrumentation::METRIC_LORA_RX_DROPS);
+            return Result::DROPPED;
+        }
+        _last_state = rearm;
+        if (len <= 1) {
+            // Header-only runt
+            RNS::Instrumentation::Metrics::add(RNS::Instrumentation::METRIC_LORA_RX_DROPS);
+            return Result::DROPPED;
+        }
+
+        memcpy(_record, &rssi, sizeof(rssi));
+        memcpy(_record + sizeof(rssi), &snr, sizeof(snr));
+        if (!_queue.push(_record, RECORD_HEADER + len - 1, rx_us)) {
+            RNS::Instrumentation::Metrics::add(RNS::Instrumentation::METRIC_LORA_RX_DROPS);
+            return Result::DROPPED;
+        }
+        RNS::Instrumentation::Metrics::set(RNS::Instrumentation::METRIC_LORA_QUEUE_DEPTH,
+                                           static_cast<int32_t>(_queue.size()));
+        return Result::QUEUED;
+    }
+
+    int16_t last_state() const { return _last_state; }
+
+    /**
+     * Main loop: pass up to budget queued payloads, oldest first, to
+     * fn(const uint8_t* payload, size_t len, float rssi, float snr,
+     * uint32_t rx_us). The payload is valid during the call only. Returns
+     * how many.
+     */
+    template <typename Fn>
+    size_t deliver(size_t budget, Fn fn) {
+        size_t delivered = 0;
+        const uint8_t* record;
+        size_t record_len;
+        uint32_t rx_us;
+        while (delivered < budget && _queue.front(&record, &record_len, &rx_us)) {
+            float rssi, snr;
+            memcpy(&rssi, record, sizeof(rssi));
+            memcpy(&snr, record + sizeof(rssi), sizeof(snr));
+            fn(record + RECORD_HEADER, record_len - RECORD_HEADER, rssi, snr, rx_us);
+            _queue.pop();
+            delivered++;
+        }
+        return delivered;
+    }
+
+    size_t queued() const { return _queue.size(); }
+
+    /** Drop everything. Only while the LoRa task is not running. */
+    void reset() { _queue.reset(); }
+
+private:
+    static const size_t RECORD_HEADER = 2 * sizeof(float);
+
+    RNS::SPSCPacketQueue _queue;
+    uint8_t _record[RECORD_HEADER - 1 + MAX_PACKET];   // LoRa task only
+    int16_t _last_state = ERR_NONE;
+};
@@ -4,18 +4,24 @@
 #include "SX1262Interface.h"
 #include <microReticulum/Log.h>
 #include <microReticulum/Utilities/OS.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
 #ifdef ARDUINO
 #include <SPI.h>
 #endif
 
 using namespace RNS;
+using namespace RNS::Instrumentation;
 
 #ifdef ARDUINO
 // Static members for SPI mutex (shared with display and SD card)
 SemaphoreHandle_t SX1262Interface::_spi_mutex = nullptr;
 bool SX1262Interface::_mutex_initialized = false;
 
+// Task dio1_isr() notifies (one radio, so one interface at a time)
+TaskHandle_t SX1262Interface::_dio1_task = nullptr;
+
 void SX1262Interface::set_spi_mutex(SemaphoreHandle_t mutex) {
     _spi_mutex = mutex;
     _mutex_initialized = (mutex != nullptr);
@@ -56,9 +62,19 @@ std::string SX1262Interface::toString() const {
 }
 
 bool SX1262Interface::start() {
+#ifdef ARDUINO
+    if (_task_running) {
+        return true;
+    }
+#endif
     _online = false;
 
 #ifdef ARDUINO
+    if (!_receiver.valid()) {
+        ERROR("SX1262Interface: Failed to allocate RX queue");
+        return false;
+    }
+
     INFO("SX1262Interface: Initializing...");
     INFO("  Frequency: " + std::to_string(_config.frequency) + " MHz");
     INFO("  Bandwidth: " + std::to_string(_config.bandwidth) + " kHz");
@@ -131,6 +147,19 @@ bool SX1262Interface::start() {
 
     xSemaphoreGive(_spi_mutex);
 
+    // lora_task first, so DIO1 has somewhere to go once the ISR is attached
+    if (!start_task()) {
+        delete _radio;
+        delete _module;
+        _radio = nullptr;
+        _module = nullptr;
+        return false;
+    }
+    if (xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+        _radio->setDio1Action(dio1_isr);
+        xSemaphoreGive(_spi_mutex);
+    }
+
     // Start listening for packets
     start_receive();
 
@@ -149,15 +178,21 @@ void SX1262Interface::stop() {
 #ifdef ARDUINO
     if (_radio != nullptr) {
         if (_spi_mutex != nullptr && xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+            _radio->clearDio1Action();
             _radio->standby();
             xSemaphoreGive(_spi_mutex);
         }
 
+        // lora_task may be inside service(): join it before the radio goes
+        stop_task();
+
         delete _radio;
         delete _module;
         _radio = nullptr;
         _module = nullptr;
     }
+    // The task is gone; both ends of the queue are ours now
+    _receiver.reset();
 #endif
 
     _online = false;
@@ -181,69 +216,118 @@ void SX1262Interface::start_receive() {
 #endif
 }
 
+// Main loop: hand packets lora_task read to Transport. Never touches the
+// SPI bus.
 void SX1262Interface::loop() {
     if (!_online) return;
 
-#ifdef ARDUINO
-    if (_radio == nullptr) return;
+    // Bounded so a burst can't hold the main loop; the rest wait for the
+    // next pass
+    _receiver.deliver(RX_PACKET_SLOTS, [this](const uint8_t* payload, size_t len,
+                                              float rssi, float snr, uint32_t rx_us) {
+        _last_rssi = rssi;
+        _last_snr = snr;
+
+        DEBUG("SX1262Interface: Received " + std::to_string(len + 1) + " bytes, " +
+              "RSSI=" + std::to_string((int)_last_rssi) + " dBm, " +
+              "SNR=" + std::to_string((int)_last_snr) + " dB");
+
+        // RNode packet format: [1-byte random header][payload]; the
+        // header is already stripped
+        on_incoming(Bytes(payload, len), rx_us);
+    });
+}
 
-    // Try to acquire SPI mutex (non-blocking to avoid stalling display)
-    if (xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(5)) != pdTRUE) {
-        return;  // Display is using SPI, try again later
+#ifdef ARDUINO
+bool SX1262Interface::start_task() {
+    _task_running = true;
+    _task_done = false;
+    // Above loopTask and LVGL (priority 1 on core 1) so a packet is read
+    // as soon as DIO1 fires, not after the current frame; it blocks on the
+    // SPI mutex if the display holds the bus
+    BaseType_t r = xTaskCreatePinnedToCore(lora_task, "lora", 4096, this, 2, &_task_handle, 1);
+    if (r != pdPASS) {
+        ERROR("SX1262Interface: Failed to create LoRa task");
+        _task_running = false;
+        _task_handle = nullptr;
+        return false;
     }
+    _dio1_task = _task_handle;
+    return true;
+}
 
-    // Check IRQ status to see if a packet was actually received
-    uint16_t irqStatus = _radio->getIrqStatus();
-
-    // Only process if RX_DONE flag is set (0x0002 for SX126x)
-    if (!(irqStatus & 0x0002)) {
-        xSemaphoreGive(_spi_mutex);
-        return;  // No new packet
+void SX1262Interface::stop_task() {
+    if (_task_handle == nullptr) return;
+    _task_running = false;
+    xTaskNotifyGive(_task_handle);
+    // Wait for the task to leave task_loop() and set _task_done; after that
+    // it only calls vTaskDelete(nullptr). service() is bounded by the SPI
+    // mutex timeout, so the deadline is generous.
+    uint32_t deadline = millis() + 2000;
+    while (!_task_done && (int32_t)(millis() - deadline) < 0) {
+        vTaskDelay(pdMS_TO_TICKS(10));
     }
+    if (!_task_done) {
+        vTaskDelete(_task_handle);
+    }
+    if (_dio1_task == _task_handle) {
+        _dio1_task = nullptr;
+    }
+    _task_handle = nullptr;
+}
 
-    // Read the received packet (this also clears IRQ internally)
-    int16_t state = _radio->readData(_rx_buffer.writable(HW_MTU), HW_MTU);
-
-    // Immediately restart receive to clear IRQ flags and prepare for next packet
-    _radio->startReceive();
-
-    if (state == RADIOLIB_ERR_NONE) {
-        // Got a packet
-        size_t len = _radio->getPacketLength();
-        if (len > 1) {  // Must have at least header + data
-            _rx_buffer.resize(len);
-
-            // Get signal quality
-            _last_rssi = _radio->getRSSI();
-            _last_snr = _radio->getSNR();
-
-            xSemaphoreGive(_spi_mutex);
+void IRAM_ATTR SX1262Interface::dio1_isr() {
+    TaskHandle_t task = _dio1_task;
+    if (task == nullptr) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
 
-            // RNode packet format: [1-byte random header][payload]
-            // Skip header byte, pass payload to transport
-            Bytes payload = _rx_buffer.mid(1);
+/*static*/ void SX1262Interface::lora_task(void* arg) {
+    auto* self = static_cast<SX1262Interface*>(arg);
+    self->task_loop();
+    self->_task_done = true;   // let stop() join before the object is freed
+    vTaskDelete(nullptr);
+}
 
-            DEBUG("SX1262Interface: Received " + std::to_string(len) + " bytes, " +
-                  "RSSI=" + std::to_string((int)_last_rssi) + " dBm, " +
-                  "SNR=" + std::to_string((int)_last_snr) + " dB");
+// Sleeps until DIO1 (or stop()). Each wake is one IRQ status read under the
+// SPI mutex, plus the packet reads when one arrived; DIO1 going high after
+// send_outgoing()'s TX done finds the flags already cleared.
+void SX1262Interface::task_loop() {
+    while (_task_running) {
+        uint32_t notified = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DIO1_BACKSTOP_MS));
+        if (!_task_running) break;
+        if (notified == 0 && digitalRead(SX1262Pins::DIO1) == LOW) continue;
+
+        // A busy bus leaves DIO1 high, so the backstop retries
+        if (xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(100)) != pdTRUE) continue;
+        using Result = LoRaReceiver<HW_MTU>::Result;
+        Result result = _receiver.service(*_radio, Metrics::nowUs());
+        xSemaphoreGive(_spi_mutex);
 
-            on_incoming(payload);
-            return;
+        int16_t state = _receiver.last_state();
+        if (result == Result::DROPPED && state != RADIOLIB_ERR_NONE) {
+            ERROR("SX1262Interface: Receive error, code " + std::to_string(state));
+        } else if (state != RADIOLIB_ERR_NONE && state != RADIOLIB_ERR_RX_TIMEOUT) {
+            ERROR("SX1262Interface: Failed to restart receive, code " + std::to_string(state));
         }
-    } else if (state != RADIOLIB_ERR_RX_TIMEOUT) {
-        // An error occurred (not just timeout)
-        ERROR("SX1262Interface: Receive error, code " + std::to_string(state));
     }
-
-    xSemaphoreGive(_spi_mutex);
-#endif
 }
+#endif
 
 bool SX1262Interface::send_outgoing(const Bytes& data) {
-    if (!_online) return false;
+    EVENT_TRACE_SCOPE_V(LORA_TX, data.size());
+    if (!_online) {
+        Metrics::add(METRIC_LORA_TX_DROPS);
+        return false;
+    }
 
 #ifdef ARDUINO
-    if (_radio == nullptr) return false;
+    if (_radio == nullptr) {
+        Metrics::add(METRIC_LORA_TX_DROPS);
+        return false;
+    }
 
     DEBUG(toString() + ": Sending " + std::to_string(data.size()) + " bytes");
 
@@ -254,6 +338,7 @@ bool SX1262Interface::send_outgoing(const Bytes& data) {
     size_t len = 1 + data.size();
     if (len > HW_MTU) {
         ERROR("SX1262Interface: Packet too large (" + std::to_string(len) + " > " + std::to_string(HW_MTU) + ")");
+        Metrics::add(METRIC_LORA_TX_DROPS);
         return false;
     }
 
@@ -265,6 +350,7 @@ bool SX1262Interface::send_outgoing(const Bytes& data) {
     if (xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
         ERROR("SX1262Interface: Failed to acquire SPI mutex for TX");
         delete[] buf;
+        Metrics::add(METRIC_LORA_TX_DROPS);
         return false;
     }
 
@@ -287,19 +373,28 @@ bool SX1262Interface::send_outgoing(const Bytes& data) {
 
     if (state == RADIOLIB_ERR_NONE) {
         DEBUG("SX1262Interface: Sent " + std::to_string(len) + " bytes");
+        Metrics::add(METRIC_LORA_TX_PACKETS);
+        Metrics::add(METRIC_LORA_TX_BYTES, static_cast<uint32_t>(data.size()));
         // Perform post-send housekeeping
         InterfaceImpl::handle_outgoing(data);
         return true;
     } else {
         ERROR("SX1262Interface: Transmit failed, code " + std::to_string(state));
+        Metrics::add(METRIC_LORA_TX_DROPS);
         return false;
     }
 #endif
     return false;
 }
 
-void SX1262Interface::on_incoming(const Bytes& data) {
+void SX1262Interface::on_incoming(const Bytes& data, uint32_t rx_us) {
     DEBUG(toString() + ": Incoming " + std::to_string(data.size()) + " bytes");
     // Pass received data to transport
-    InterfaceImpl::handle_incoming(data);
+    {
+        EVENT_TRACE_SCOPE_V(LORA_RX, data.size());
+        InterfaceImpl::handle_incoming(data);
+    }
+    Metrics::add(METRIC_LORA_RX_PACKETS);
+    Metrics::add(METRIC_LORA_RX_BYTES, static_cast<uint32_t>(data.size()));
+    Metrics::observeSince(METRIC_LORA_RX_LATENCY, rx_us);
 }
@@ -7,18 +7,27 @@
 #include <microReticulum/Bytes.h>
 #include <microReticulum/Type.h>
 #include <microReticulum/Cryptography/Random.h>
+#include "LoRaReceiver.h"
 
 #ifdef ARDUINO
 #include <RadioLib.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
+#include <freertos/task.h>
 #endif
 
+#include <atomic>
+
 /**
  * SX1262 LoRa Interface for T-Deck Plus
  *
  * Air-compatible with RNode devices using same modulation and packet framing.
  * Uses RadioLib for SX1262 support with DIO1+BUSY pin model.
+ *
+ * Receive is interrupt-driven: DIO1's ISR wakes lora_task, which reads the
+ * packet under the SPI mutex (LoRaReceiver) and queues it; loop() only hands
+ * queued packets to Transport, so the shared bus is touched only when a
+ * packet (or another radio IRQ) is actually there.
  */
 
 // T-Deck Plus SX1262 pins (from Hardware::TDeck::Radio)
@@ -47,6 +56,13 @@ struct SX1262Config {
 
 class SX1262Interface : public RNS::InterfaceImpl {
 public:
+    // Received packets waiting for loop() (PSRAM, HW_MTU slots)
+    static const size_t RX_PACKET_SLOTS = 16;
+
+    // lora_task also checks the DIO1 level this often, without SPI, in case
+    // an edge was missed while DIO1 was already high
+    static const uint32_t DIO1_BACKSTOP_MS = 100;
+
     SX1262Interface(const char* name = "LoRa");
     virtual ~SX1262Interface();
 
@@ -84,10 +100,22 @@ protected:
     virtual bool send_outgoing(const RNS::Bytes& data) override;
 
 private:
-    void on_incoming(const RNS::Bytes& data);
+    void on_incoming(const RNS::Bytes& data, uint32_t rx_us);
     void start_receive();
 
 #ifdef ARDUINO
+    // DIO1 -> dio1_isr() -> lora_task -> _receiver -> loop(). RadioLib's
+    // DIO1 action takes no argument, hence the static task handle.
+    static void dio1_isr();
+    static void lora_task(void* arg);
+    void task_loop();
+    bool start_task();
+    void stop_task();
+    static TaskHandle_t _dio1_task;
+    TaskHandle_t _task_handle = nullptr;
+    std::atomic<bool> _task_running{false};
+    std::atomic<bool> _task_done{false};   // task sets this right before exit; stop() joins on it
+
     // RadioLib objects
     SX1262* _radio = nullptr;
     Module* _module = nullptr;
@@ -105,13 +133,13 @@ private:
 
     // State
     bool _transmitting = false;
-    float _last_rssi = 0.0f;
+    float _last_rssi = 0.0f;   // of the last packet loop() delivered
     float _last_snr = 0.0f;
 
-    // Receive buffer
-    RNS::Bytes _rx_buffer;
-
     // Hardware MTU: SX1262 max packet size is 255 bytes
     // (RNode uses 508 because it fragments over serial HDLC, but we drive the radio directly)
     static constexpr uint16_t HW_MTU = 255;
+
+    // Packets lora_task read, with RSSI/SNR, for loop()
+    LoRaReceiver<HW_MTU> _receiver{RX_PACKET_SLOTS};
 };
@@ -7,6 +7,7 @@
 #ifdef ARDUINO
 
 #include <microReticulum/Log.h>
+#include <Instrumentation/EventTrace.h>
 #include <esp_heap_caps.h>
 
 #if __has_include("SplashImage.h")
@@ -270,6 +271,8 @@ void Display::draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t col
 }
 
 void Display::lvgl_flush_cb(lv_disp_drv_t* drv, const lv_area_t* area, lv_color_t* color_p) {
+    // Span includes the SPI mutex wait; value is the area in pixels
+    EVENT_TRACE_SCOPE_V(LVGL_FLUSH, (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1));
     if (_spi_mutex && xSemaphoreTake(_spi_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
         // Skip this frame — LVGL will retry next tick
         lv_disp_flush_ready(drv);
@@ -8,6 +8,7 @@
 #include "esp_task_wdt.h"
 
 #include <microReticulum/Log.h>
+#include <lv_mem_slab.h>
 #include "../../Hardware/TDeck/Display.h"
 #include "../../Hardware/TDeck/Keyboard.h"
 #include "../../Hardware/TDeck/Touch.h"
@@ -43,6 +44,11 @@ bool LVGLInit::init() {
         return false;
     }
 
+    // Reserve the small-object slab region before lv_init() allocates
+    if (!lv_mem_slab_init()) {
+        WARNING("  LVGL slab region unavailable, small objects go to PSRAM");
+    }
+
     // Initialize LVGL library
     lv_init();
 
@@ -114,6 +120,11 @@ bool LVGLInit::init_display_only() {
 
     INFO("Initializing LVGL (display only)");
 
+    // Reserve the small-object slab region before lv_init() allocates
+    if (!lv_mem_slab_init()) {
+        WARNING("  LVGL slab region unavailable, small objects go to PSRAM");
+    }
+
     // Initialize LVGL library
     lv_init();
 
@@ -8,18 +8,22 @@
 #include <lvgl.h>
 #include <Preferences.h>
 #include <microReticulum/Log.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 #ifdef PYXIS_TEST_HOOKS
 #include "pyxis_test_hooks.h"
 #endif
 #include "Tone.h"
 #include "../LVGL/LVGLLock.h"
 #include "lxst_audio.h"
+#include "audio_latency.h"
 #include <microReticulum/Packet.h>
 #include <microReticulum/Transport.h>
 #include <microReticulum/Destination.h>
 #include <esp_heap_caps.h>
 
 using namespace RNS;
+using RNS::Instrumentation::Metrics;
 
 // Arm/disarm the decoded-PCM dump used by the audio-loopback test mode.
 // Defined in src/main.cpp (owns the UDP multicast socket).
@@ -55,6 +59,7 @@ static std::shared_ptr<LXSTAnnounceHandler> s_lxst_announce_handler;
 // hook). TODO: auto-select per active interface (WiFi->LBW/3200, LoRa-only->ULBW/700C).
 // See the LXST voice audit (2026-06-23).
 int UIManager::_preferred_profile = UIManager::LXST_PROFILE_VLBW;
+bool UIManager::_call_timing_ext = false;
 
 int UIManager::profile_to_codec2_mode(int profile) {
     switch (profile) {
@@ -1210,7 +1215,8 @@ void UIManager::call_send_signal(int signal) {
 }
 
 void UIManager::call_send_audio_batch(const uint8_t* batch_data, int batch_len,
-                                      int batch_count, int total_frames) {
+                                      int batch_count, int total_frames,
+                                      uint32_t capture_us, uint32_t encoded_us) {
     // Loopback test mode has no link — skip the link guard and route the
     // built wire packet back through the RX parser instead of sending it.
     if (!_call_loopback && (!_call_link || _call_link.status() != Type::Link::ACTIVE)) {
@@ -1238,7 +1244,13 @@ void UIManager::call_send_audio_batch(const uint8_t* batch_data, int batch_len,
     uint8_t packet_buf[256];
     int pos = 0;
 
-    packet_buf[pos++] = 0x81;  // fixmap(1)
+    if (_call_timing_ext && capture_us) {
+        // {0x70: capture->send age, 0x01: frames} — pyxis peers and loopback only
+        packet_buf[pos++] = 0x82;  // fixmap(2)
+        pos += LxstTimingExt::write(packet_buf + pos, Metrics::nowUs() - capture_us);
+    } else {
+        packet_buf[pos++] = 0x81;  // fixmap(1)
+    }
     packet_buf[pos++] = 0x01;  // key: FIELD_FRAMES
 
     if (batch_count == 1) {
@@ -1278,6 +1290,10 @@ void UIManager::call_send_audio_batch(const uint8_t* batch_data, int batch_len,
         // RX parser so the real framing + parse + decode path runs locally.
         // call_on_packet() does NOT re-enter pump_call_tx(), so this is a
         // bounded synchronous chain (no infinite loop, all on core 1).
+        if (capture_us) {
+            Metrics::observeSince(Instrumentation::METRIC_LXST_TX_SEND, encoded_us);
+            Metrics::observeSince(Instrumentation::METRIC_LXST_TX_TOTAL, capture_us);
+        }
         call_on_packet(Bytes(packet_buf, pos));
         return;
     }
@@ -1286,6 +1302,10 @@ void UIManager::call_send_audio_batch(const uint8_t* batch_data, int batch_len,
         Bytes audio_data(packet_buf, pos);
         Packet packet(_call_link, audio_data);
         packet.send();
+        if (capture_us) {
+            Metrics::observeSince(Instrumentation::METRIC_LXST_TX_SEND, encoded_us);
+            Metrics::observeSince(Instrumentation::METRIC_LXST_TX_TOTAL, capture_us);
+        }
     } catch (const std::exception& e) {
         char dbg[128];
         snprintf(dbg, sizeof(dbg), "LXST: TX send exception: %s", e.what());
@@ -1293,7 +1313,7 @@ void UIManager::call_send_audio_batch(const uint8_t* batch_data, int batch_len,
     }
 }
 
-void UIManager::call_rx_audio_frame(const uint8_t* frame, size_t frame_len) {
+void UIManager::call_rx_audio_frame(const uint8_t* frame, size_t frame_len, const AudioStamp& stamp) {
     // Guard: packets can arrive after hangup from the network pipeline.
     // In loopback mode _call_state stays IDLE, so bypass the IDLE guard.
     if (!_lxst_audio || (!_call_loopback && _call_state == CallState::IDLE)) return;
@@ -1316,7 +1336,7 @@ void UIManager::call_rx_audio_frame(const uint8_t* frame, size_t frame_len) {
     }
 
     if (_lxst_audio && _lxst_audio->isPlaying()) {
-        _lxst_audio->writeEncodedPacket(codec_data, codec_data_len);
+        _lxst_audio->writeEncodedPacket(codec_data, codec_data_len, &stamp);
         _call_audio_rx_count++;
         if (_call_audio_rx_count <= 3) {
             char dbg[80];
@@ -1333,6 +1353,7 @@ void UIManager::call_on_packet(const Bytes& data) {
     // NOTE: This runs on the Reticulum transport thread (during reticulum->loop()),
     // NOT under the LVGL lock. Do NOT touch LVGL objects here.
     // Signals are queued and processed in call_update() under the LVGL lock.
+    const uint32_t arrival_us = Metrics::nowUs();  // lxst.rx.* latency origin
     {
         char dbg[64];
         snprintf(dbg, sizeof(dbg), "LXST: call_on_packet len=%d state=%d", (int)data.size(), (int)_call_state);
@@ -1341,9 +1362,19 @@ void UIManager::call_on_packet(const Bytes& data) {
     if (data.size() < 4) return;
 
     const uint8_t* buf = data.data();
-
-    // Expect msgpack fixmap(1): 0x81
-    if (buf[0] != 0x81) {
+    size_t len = data.size();
+
+    AudioStamp stamp;
+    stamp.origin_us = arrival_us;
+
+    // Expect msgpack fixmap(1): 0x81. A fixmap(2) led by the pyxis timing
+    // extension is accepted too: the extension is consumed here and buf is
+    // advanced so the remaining key sits at buf[1], as in the fixmap(1) case.
+    if (buf[0] == 0x82 && LxstTimingExt::read(buf + 1, len - 1, &stamp.upstream_us)) {
+        buf += LxstTimingExt::SIZE;
+        len -= LxstTimingExt::SIZE;
+        if (len < 4) return;
+    } else if (buf[0] != 0x81) {
         char dbg[64];
         snprintf(dbg, sizeof(dbg), "LXST: Invalid packet (0x%02X, expected fixmap)", buf[0]);
         DEBUG(dbg);
@@ -1364,17 +1395,17 @@ void UIManager::call_on_packet(const Bytes& data) {
         if (buf[3] <= 0x7F) {
             // fixint: value is the byte itself
             signal = buf[3];
-        } else if (buf[3] == 0xCC && data.size() >= 5) {
+        } else if (buf[3] == 0xCC && len >= 5) {
             // uint8
             signal = buf[4];
-        } else if (buf[3] == 0xCD && data.size() >= 6) {
+        } else if (buf[3] == 0xCD && len >= 6) {
             // uint16 (big-endian)
             signal = ((int)buf[4] << 8) | buf[5];
         }
 
         if (signal < 0) {
             char dbg[64];
-            snprintf(dbg, sizeof(dbg), "LXST: Unparseable signal (0x%02X), %d bytes", buf[3], (int)data.size());
+            snprintf(dbg, sizeof(dbg), "LXST: Unparseable signal (0x%02X), %d bytes", buf[3], (int)len);
             WARNING(dbg);
             return;
         }
@@ -1429,19 +1460,19 @@ void UIManager::call_on_packet(const Bytes& data) {
             size_t pos = 3;  // start after fixarray byte
 
             for (int i = 0; i < array_len; i++) {
-                if (pos >= data.size()) break;
+                if (pos >= len) break;
 
                 size_t frame_len;
                 size_t frame_start;
 
                 if (buf[pos] == 0xC4) {
                     // bin8
-                    if (pos + 1 >= data.size()) break;
+                    if (pos + 1 >= len) break;
                     frame_len = buf[pos + 1];
                     frame_start = pos + 2;
                 } else if (buf[pos] == 0xC5) {
                     // bin16
-                    if (pos + 2 >= data.size()) break;
+                    if (pos + 2 >= len) break;
                     frame_len = ((size_t)buf[pos + 1] << 8) | buf[pos + 2];
                     frame_start = pos + 3;
                 } else {
@@ -1449,23 +1480,23 @@ void UIManager::call_on_packet(const Bytes& data) {
                     break;
                 }
 
-                if (frame_start + frame_len > data.size() || frame_len < 2) break;
+                if (frame_start + frame_len > len || frame_len < 2) break;
 
-                call_rx_audio_frame(buf + frame_start, frame_len);
+                call_rx_audio_frame(buf + frame_start, frame_len, stamp);
                 pos = frame_start + frame_len;
             }
         } else if (fmt == 0xC4) {
             // bin8: single frame
-            if (data.size() < 5) return;
+            if (len < 5) return;
             size_t frame_len = buf[3];
-            if (data.size() < 4 + frame_len || frame_len < 2) return;
-            call_rx_audio_frame(buf + 4, frame_len);
+            if (len < 4 + frame_len || frame_len < 2) return;
+            call_rx_audio_frame(buf + 4, frame_len, stamp);
         } else if (fmt == 0xC5) {
             // bin16: single frame
-            if (data.size() < 6) return;
+            if (len < 6) return;
             size_t frame_len = ((size_t)buf[3] << 8) | buf[4];
-            if (data.size() < 5 + frame_len || frame_len < 2) return;
-            call_rx_audio_frame(buf + 5, frame_len);
+            if (len < 5 + frame_len || frame_len < 2) return;
+            call_rx_audio_frame(buf + 5, frame_len, stamp);
         }
     }
 }
@@ -1629,15 +1660,18 @@ void UIManager::pump_call_tx() {
     if (!_call_loopback && (!_call_link || _call_link.status() != Type::Link::ACTIVE)) return;
 
     int available = _lxst_audio->capturePacketsAvailable();
+    EVENT_TRACE_SCOPE_V(PUMP_CALL_TX, available);
 
     // Drain all available batches — this runs on loopTask (core 1)
     // and doesn't touch LVGL, so no lock needed.
     while (available > 0) {
         uint8_t encoded_buf[128];
         int encoded_len = 0;
-        if (!_lxst_audio->readEncodedPacket(encoded_buf, sizeof(encoded_buf), &encoded_len)) {
+        AudioStamp stamp;
+        if (!_lxst_audio->readEncodedPacket(encoded_buf, sizeof(encoded_buf), &encoded_len, &stamp)) {
             break;
         }
+        const uint32_t encoded_us = Metrics::nowUs();
         if (encoded_len < 2) { available--; continue; }
 
         // Prepend codec type byte: [0x02] + [encoded: mode_header + 10*8 raw]
@@ -1646,7 +1680,8 @@ void UIManager::pump_call_tx() {
         memcpy(batch_data + 1, encoded_buf, encoded_len);
         int batch_len = 1 + encoded_len;
 
-        call_send_audio_batch(batch_data, batch_len, 1, encoded_len / 8);
+        call_send_audio_batch(batch_data, batch_len, 1, encoded_len / 8,
+                              stamp.origin_us, encoded_us);
         _call_audio_tx_count++;
         available--;
 
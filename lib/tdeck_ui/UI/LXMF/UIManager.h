@@ -25,6 +25,7 @@
 #include <microReticulum/Link.h>
 
 class LXSTAudio;
+struct AudioStamp;
 
 namespace UI {
 namespace LXMF {
@@ -266,6 +267,15 @@ public:
      */
     int test_call_get_profile() const { return _preferred_profile; }
     bool test_call_set_profile(int profile);
+
+    /**
+     * Get/set whether outgoing audio carries the in-band timing
+     * extension (LxstTimingExt in audio_latency.h). Only for
+     * pyxis-to-pyxis and loopback calls; other LXST peers don't
+     * expect the extra map key. Receiving always accepts it.
+     */
+    bool test_call_get_timing_ext() const { return _call_timing_ext; }
+    void test_call_set_timing_ext(bool enabled) { _call_timing_ext = enabled; }
 #endif
 
 private:
@@ -369,6 +379,9 @@ private:
     // (CODEC2_MODE_*). Returns -1 for unknown profiles.
     static int profile_to_codec2_mode(int profile);
 
+    // Add the in-band timing extension to outgoing audio (T:CALL_LATENCY ext)
+    static bool _call_timing_ext;
+
     enum class CallState {
         IDLE,
         PATH_REQUESTING,    // Outgoing: waiting for path to resolve
@@ -430,11 +443,14 @@ private:
     // Send a signalling byte over the call link
     void call_send_signal(int signal);
 
-    // Send batched audio frames over the call link (10 sub-frames per batch)
-    void call_send_audio_batch(const uint8_t* batch_data, int batch_len, int batch_count, int total_frames);
+    // Send batched audio frames over the call link (10 sub-frames per batch).
+    // capture_us/encoded_us (0 = unknown) feed the lxst.tx.send/total histograms
+    // and the in-band timing extension.
+    void call_send_audio_batch(const uint8_t* batch_data, int batch_len, int batch_count, int total_frames,
+                               uint32_t capture_us = 0, uint32_t encoded_us = 0);
 
     // Process a single received audio frame (codec_header + data)
-    void call_rx_audio_frame(const uint8_t* frame, size_t frame_len);
+    void call_rx_audio_frame(const uint8_t* frame, size_t frame_len, const AudioStamp& stamp);
 
     // Handle received packet on call link (queues signals for call_update)
     void call_on_packet(const RNS::Bytes& data);
@@ -3,6 +3,7 @@
 #include <microReticulum/Bytes.h>
 
 #include <stdint.h>
+#include <string.h>
 
 namespace RNS {
 
@@ -19,6 +20,12 @@ namespace RNS {
  * Escape sequences:
  *   0x7E in payload -> 0x7D 0x5E
  *   0x7D in payload -> 0x7D 0x5D
+ *
+ * Payloads are scanned a machine word at a time (SWAR: 4 bytes on the
+ * ESP32-S3, 8 on 64-bit hosts) for FLAG/ESC, and the runs between hits are
+ * copied with memcpy. Most packets contain neither byte; escape() and
+ * unescape() then return the input itself (RNS::Bytes shares the buffer)
+ * and frame_into() is a single memcpy.
  */
 class HDLC {
 public:
@@ -26,31 +33,89 @@ public:
     static constexpr uint8_t ESC = 0x7D;
     static constexpr uint8_t ESC_MASK = 0x20;
 
+    /**
+     * Escaped length of a payload (without FLAG bytes): len plus one per
+     * FLAG/ESC byte.
+     */
+    static size_t escaped_size(const uint8_t* data, size_t len) {
+        size_t specials = 0;
+        size_t i = 0;
+        for (; i + sizeof(Word) <= len; i += sizeof(Word)) {
+            Word m = special_mask(load(data + i));
+            while (m) {
+                m &= m - 1;
+                specials++;
+            }
+        }
+        for (; i < len; ++i) {
+            if (data[i] == FLAG || data[i] == ESC) specials++;
+        }
+        return len + specials;
+    }
+
+    /**
+     * Escape into out, which must hold escaped_size(data, len) bytes.
+     * Order matches Python RNS: escape ESC first, then FLAG (the result is
+     * the same byte-for-byte).
+     *
+     * @return Bytes written
+     */
+    static size_t escape_into(const uint8_t* data, size_t len, uint8_t* out) {
+        uint8_t* o = out;
+        size_t run = 0;  // start of the pending clean run
+        size_t i = 0;
+        for (; i + sizeof(Word) <= len; i += sizeof(Word)) {
+            if (!special_mask(load(data + i))) continue;
+            o = copy_run(o, data + run, i - run);
+            for (size_t k = i; k < i + sizeof(Word); ++k) o = put_escaped(o, data[k]);
+            run = i + sizeof(Word);
+        }
+        o = copy_run(o, data + run, i - run);
+        for (; i < len; ++i) o = put_escaped(o, data[i]);
+        return static_cast<size_t>(o - out);
+    }
+
+    /** Framed length of a payload: escaped_size() plus the two FLAGs. */
+    static size_t frame_size(const uint8_t* data, size_t len) {
+        return escaped_size(data, len) + 2;
+    }
+
+    /**
+     * Frame directly into a caller-supplied buffer: [FLAG][escaped][FLAG].
+     *
+     * @return Bytes written, or 0 if out_capacity < frame_size(data, len)
+     */
+    static size_t frame_into(const uint8_t* data, size_t len, uint8_t* out, size_t out_capacity) {
+        size_t escaped = escaped_size(data, len);
+        if (out_capacity < escaped + 2) {
+            return 0;
+        }
+        out[0] = FLAG;
+        if (escaped == len) {
+            if (len > 0) memcpy(out + 1, data, len);
+        } else {
+            escape_into(data, len, out + 1);
+        }
+        out[escaped + 1] = FLAG;
+        return escaped + 2;
+    }
+
     /**
      * Escape data for transmission.
-     * Order matches Python RNS: escape ESC first, then FLAG.
      *
      * @param data Raw payload data
-     * @return Escaped data (without FLAG bytes)
+     * @return Escaped data (without FLAG bytes); data itself if nothing
+     *         needed escaping
      */
     static Bytes escape(const Bytes& data) {
-        Bytes result;
-        result.reserve(data.size() * 2);  // worst case: every byte needs escaping
-
-        for (size_t i = 0; i < data.size(); ++i) {
-            uint8_t byte = data.data()[i];
-            if (byte == ESC) {
-                // Escape ESC byte: 0x7D -> 0x7D 0x5D
-                result.append(ESC);
-                result.append(static_cast<uint8_t>(ESC ^ ESC_MASK));
-            } else if (byte == FLAG) {
-                // Escape FLAG byte: 0x7E -> 0x7D 0x5E
-                result.append(ESC);
-                result.append(static_cast<uint8_t>(FLAG ^ ESC_MASK));
-            } else {
-                result.append(byte);
-            }
+        size_t escaped = escaped_size(data.data(), data.size());
+        if (escaped == data.size()) {
+            return data;
         }
+        Bytes result(escaped);
+        uint8_t* out = result.writable(escaped);
+        result.resize(escaped);
+        escape_into(data.data(), data.size(), out);
         return result;
     }
 
@@ -58,30 +123,36 @@ public:
      * Unescape received data.
      *
      * @param data Escaped payload data (without FLAG bytes)
-     * @return Unescaped data, or empty Bytes on error
+     * @return Unescaped data (data itself if it holds no ESC), or empty
+     *         Bytes on error
      */
     static Bytes unescape(const Bytes& data) {
-        Bytes result;
-        result.reserve(data.size());
+        const uint8_t* in = data.data();
+        size_t len = data.size();
+        if (find_byte(in, 0, len, ESC) == len) {
+            return data;
+        }
 
+        Bytes result(len);
+        uint8_t* out = result.writable(len);
+        uint8_t* o = out;
         bool in_escape = false;
-        for (size_t i = 0; i < data.size(); ++i) {
-            uint8_t byte = data.data()[i];
-            if (in_escape) {
-                // XOR with ESC_MASK to restore original byte
-                result.append(static_cast<uint8_t>(byte ^ ESC_MASK));
-                in_escape = false;
-            } else if (byte == ESC) {
-                in_escape = true;
-            } else {
-                result.append(byte);
-            }
+        size_t run = 0;
+        size_t i = 0;
+        for (; i + sizeof(Word) <= len; i += sizeof(Word)) {
+            if (!in_escape && !byte_mask(load(in + i), ESC)) continue;
+            o = copy_run(o, in + run, i - run);
+            for (size_t k = i; k < i + sizeof(Word); ++k) o = put_unescaped(o, in[k], in_escape);
+            run = i + sizeof(Word);
         }
+        o = copy_run(o, in + run, i - run);
+        for (; i < len; ++i) o = put_unescaped(o, in[i], in_escape);
 
         // If we ended mid-escape, that's an error
         if (in_escape) {
             return Bytes();  // empty = error
         }
+        result.resize(static_cast<size_t>(o - out));
         return result;
     }
 
@@ -92,14 +163,225 @@ public:
      * @return Framed data: [FLAG][escaped_data][FLAG]
      */
     static Bytes frame(const Bytes& data) {
-        Bytes escaped = escape(data);
-        Bytes framed;
-        framed.reserve(escaped.size() + 2);
-        framed.append(FLAG);
-        framed.append(escaped);
-        framed.append(FLAG);
+        size_t size = frame_size(data.data(), data.size());
+        Bytes framed(size);
+        uint8_t* out = framed.writable(size);
+        framed.resize(size);
+        frame_into(data.data(), data.size(), out, size);
         return framed;
     }
+
+private:
+    template <size_t> friend class HDLCDecoder;
+
+    // SWAR word; the byte-index math below assumes little-endian (ESP32-S3,
+    // x86, arm64)
+    using Word = uintptr_t;
+    static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "HDLC SWAR scan assumes little-endian");
+    static constexpr Word ONES = ~Word(0) / 0xFF;  // 0x0101...01
+    static constexpr Word LOW7 = ONES * 0x7F;      // 0x7F7F...7F
+
+    static inline Word load(const uint8_t* p) {
+        Word w;
+        memcpy(&w, p, sizeof(w));
+        return w;
+    }
+
+    // High bit set in exactly the bytes of w equal to b. The
+    // (x & 0x7F..) + 0x7F.. form cannot carry between bytes, so unlike the
+    // classic (x - 0x01..) & ~x trick there are no false positives.
+    static inline Word byte_mask(Word w, uint8_t b) {
+        Word x = w ^ (ONES * b);
+        return ~(((x & LOW7) + LOW7) | x | LOW7);
+    }
+
+    static inline Word special_mask(Word w) {
+        return byte_mask(w, FLAG) | byte_mask(w, ESC);
+    }
+
+    static inline uint8_t* copy_run(uint8_t* o, const uint8_t* src, size_t n) {
+        if (n > 0) memcpy(o, src, n);
+        return o + n;
+    }
+
+    static inline uint8_t* put_escaped(uint8_t* o, uint8_t byte) {
+        if (byte == ESC || byte == FLAG) {
+            *o++ = ESC;
+            *o++ = static_cast<uint8_t>(byte ^ ESC_MASK);
+        } else {
+            *o++ = byte;
+        }
+        return o;
+    }
+
+    static inline uint8_t* put_unescaped(uint8_t* o, uint8_t byte, bool& in_escape) {
+        if (in_escape) {
+            // XOR with ESC_MASK to restore original byte
+            *o++ = static_cast<uint8_t>(byte ^ ESC_MASK);
+            in_escape = false;
+        } else if (byte == ESC) {
+            in_escape = true;
+        } else {
+            *o++ = byte;
+        }
+        return o;
+    }
+
+    static inline size_t lowest_byte(Word m) {
+        if (sizeof(Word) == 8) {
+            return static_cast<size_t>(__builtin_ctzll(static_cast<unsigned long long>(m))) / 8;
+        }
+        return static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(m))) / 8;
+    }
+
+    // Index of the first FLAG or ESC in data[from, len), or len
+    static size_t find_special(const uint8_t* data, size_t from, size_t len) {
+        size_t i = from;
+        for (; i + sizeof(Word) <= len; i += sizeof(Word)) {
+            Word m = special_mask(load(data + i));
+            if (m) return i + lowest_byte(m);
+        }
+        for (; i < len; ++i) {
+            if (data[i] == FLAG || data[i] == ESC) return i;
+        }
+        return len;
+    }
+
+    // Index of the first b in data[from, len), or len
+    static size_t find_byte(const uint8_t* data, size_t from, size_t len, uint8_t b) {
+        size_t i = from;
+        for (; i + sizeof(Word) <= len; i += sizeof(Word)) {
+            Word m = byte_mask(load(data + i), b);
+            if (m) return i + lowest_byte(m);
+        }
+        for (; i < len; ++i) {
+            if (data[i] == b) return i;
+        }
+        return len;
+    }
+};
+
+/**
+ * Resumable HDLC receive decoder: feed bytes as they arrive from the
+ * socket, get each unescaped frame the moment its closing FLAG is seen.
+ *
+ * Bytes are unescaped once, straight into a fixed MAX_FRAME buffer; there
+ * is no receive buffer to rescan or trim. Output matches scanning a buffer
+ * for FLAG pairs and calling HDLC::unescape on what lies between:
+ *   - bytes before the first FLAG are discarded (one drop per run)
+ *   - a FLAG both closes a frame and opens the next; empty frames are
+ *     skipped silently
+ *   - a frame whose last byte is a bare ESC is dropped
+ *   - anything after ESC is XORed with ESC_MASK, canonical or not
+ * Frames that unescape to more than MAX_FRAME bytes are dropped whole.
+ *
+ * Not thread-safe; one reader.
+ */
+template <size_t MAX_FRAME>
+class HDLCDecoder {
+public:
+    /**
+     * Decode len bytes. on_frame(const uint8_t* frame, size_t len) is
+     * called for each completed non-empty frame; the pointer is only valid
+     * during the call.
+     */
+    template <typename OnFrame>
+    void feed(const uint8_t* data, size_t len, OnFrame&& on_frame) {
+        size_t i = 0;
+        while (i < len) {
+            if (!_in_frame) {
+                // Hunt for the opening FLAG
+                const void* flag = memchr(data + i, HDLC::FLAG, len - i);
+                if (flag == nullptr) {
+                    _hunting_bytes += len - i;
+                    return;
+                }
+                size_t at = static_cast<size_t>(static_cast<const uint8_t*>(flag) - data);
+                _hunting_bytes += at - i;
+                if (_hunting_bytes > 0) {
+                    _discarded_bytes += _hunting_bytes;
+                    _dropped++;
+                    _hunting_bytes = 0;
+                }
+                _in_frame = true;
+                i = at + 1;
+                continue;
+            }
+
+            uint8_t byte = data[i];
+            if (byte == HDLC::FLAG) {
+                if (_overflow || _in_escape) {
+                    _dropped++;
+                } else if (_len > 0) {
+                    _frames++;
+                    on_frame(static_cast<const uint8_t*>(_buf), _len);
+                }
+                _len = 0;
+                _in_escape = false;
+                _overflow = false;
+                i++;
+            } else if (_in_escape) {
+                // XOR with ESC_MASK to restore original byte
+                put(static_cast<uint8_t>(byte ^ HDLC::ESC_MASK));
+                _in_escape = false;
+                i++;
+            } else if (byte == HDLC::ESC) {
+                _in_escape = true;
+                i++;
+            } else {
+                // Plain run up to the next FLAG/ESC: one bounded memcpy
+                size_t end = HDLC::find_special(data, i, len);
+                size_t n = end - i;
+                if (n > MAX_FRAME - _len) {
+                    _overflow = true;
+                    n = MAX_FRAME - _len;
+                }
+                memcpy(_buf + _len, data + i, n);
+                _len += n;
+                i = end;
+            }
+        }
+    }
+
+    /** Drop any partial frame and hunt for a FLAG again (new connection). */
+    void reset() {
+        _in_frame = false;
+        _in_escape = false;
+        _overflow = false;
+        _len = 0;
+        _hunting_bytes = 0;
+    }
+
+    /** Bytes of the frame in progress (unescaped so far). */
+    size_t pending() const { return _len; }
+
+    /** Frames delivered to on_frame. */
+    uint32_t frames() const { return _frames; }
+
+    /** Garbage runs before a FLAG, bare-ESC frames and oversize frames. */
+    uint32_t dropped() const { return _dropped; }
+
+    /** Bytes discarded while hunting for a FLAG. */
+    uint32_t discarded_bytes() const { return _discarded_bytes; }
+
+private:
+    inline void put(uint8_t byte) {
+        if (_len < MAX_FRAME) {
+            _buf[_len++] = byte;
+        } else {
+            _overflow = true;
+        }
+    }
+
+    uint8_t _buf[MAX_FRAME];
+    size_t _len = 0;
+    bool _in_frame = false;
+    bool _in_escape = false;
+    bool _overflow = false;
+    size_t _hunting_bytes = 0;  // Garbage seen since the last FLAG hunt began
+    uint32_t _frames = 0;
+    uint32_t _dropped = 0;
+    uint32_t _discarded_bytes = 0;
 };
 
 }  // namespace RNS
@@ -3,15 +3,26 @@
 
 #include <microReticulum/Transport.h>
 #include <microReticulum/Log.h>
+#include <microReticulum/Utilities/OS.h>
+#include <Instrumentation/EventTrace.h>
+#include <Instrumentation/Metrics.h>
 
+#include <cstring>
 #include <memory>
 
 #ifdef ARDUINO
 // ESP32 lwIP socket headers
 #include <lwip/sockets.h>
 #include <lwip/netdb.h>
+#include <fcntl.h>
+// VFS eventfd; the VFS select() waits on it and lwIP sockets together
+#include <esp_vfs_eventfd.h>
+#include <sys/select.h>
+#include <unistd.h>
 #else
 #include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/eventfd.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -19,9 +30,39 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <chrono>
 #endif
 
 using namespace RNS;
+using namespace RNS::Instrumentation;
+
+static uint32_t now_ms() {
+#ifdef ARDUINO
+    return millis();
+#else
+    return static_cast<uint32_t>(Utilities::OS::time() * 1000);
+#endif
+}
+
+static void sleep_ms(uint32_t ms) {
+#ifdef ARDUINO
+    vTaskDelay(pdMS_TO_TICKS(ms));
+#else
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+#endif
+}
+
+static int create_wake_fd() {
+#ifdef ARDUINO
+    // Registering twice (a second interface, or start() after stop()) is fine
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+    esp_err_t err = esp_vfs_eventfd_register(&config);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return -1;
+    }
+#endif
+    return eventfd(0, 0);
+}
 
 TCPClientInterface::TCPClientInterface(const char* name /*= "TCPClientInterface"*/)
     : RNS::InterfaceImpl(name) {
@@ -34,6 +75,10 @@ TCPClientInterface::TCPClientInterface(const char* name /*= "TCPClientInterface"
 
 /*virtual*/ TCPClientInterface::~TCPClientInterface() {
     stop();
+    if (_wake_fd >= 0) {
+        close(_wake_fd);
+        _wake_fd = -1;
+    }
 }
 
 /*virtual*/ bool TCPClientInterface::start() {
@@ -42,187 +87,235 @@ TCPClientInterface::TCPClientInterface(const char* name /*= "TCPClientInterface"
     TRACE("TCPClientInterface: target host: " + _target_host);
     TRACE("TCPClientInterface: target port: " + std::to_string(_target_port));
 
-    if (_target_host.empty()) {
+    if (_task_running) {
+        return true;
+    }
+    if (_upstreams.parse(_target_host, static_cast<uint16_t>(_target_port)) == 0) {
         ERROR("TCPClientInterface: No target host configured");
         return false;
     }
+    _active_upstream.store(NO_UPSTREAM);
+    if (!_rx_packets.valid() || !_tx_packets.valid() || !_tx_queue.valid()) {
+        ERROR("TCPClientInterface: Failed to allocate packet queues");
+        return false;
+    }
+    if (_wake_fd < 0) {
+        _wake_fd = create_wake_fd();
+        if (_wake_fd < 0) {
+            ERROR("TCPClientInterface: Failed to create wake eventfd");
+            return false;
+        }
+    }
 
-#ifdef ARDUINO
-    // The blocking connect() runs on its own task so it never stalls the main
-    // loop. read/write/frame stay on the main loop (see loop()).
+    // All socket work (connect, DNS, read, write, framing) runs on tcp_task so
+    // it never stalls the main loop; see loop() and send_outgoing().
     // Seed _last_connect_attempt so the task's first reconnect-wait check passes
     // immediately; otherwise the initial connect could be delayed up to
     // RECONNECT_WAIT_MS. Unsigned wraparound keeps this correct when
-    // millis() < RECONNECT_WAIT_MS.
-    _last_connect_attempt = millis() - RECONNECT_WAIT_MS;
+    // now_ms() < RECONNECT_WAIT_MS.
+    _last_connect_attempt = now_ms() - RECONNECT_WAIT_MS;
     _task_running = true;
+#ifdef ARDUINO
+    _task_done = false;
     BaseType_t r = xTaskCreatePinnedToCore(tcp_task, "tcp", 6144, this, 1, &_task_handle, 0);
     if (r != pdPASS) {
-        ERROR("TCPClientInterface: Failed to create connect task");
+        ERROR("TCPClientInterface: Failed to create socket task");
         _task_running = false;
         return false;
     }
-    INFO("TCPClientInterface: connect worker running");
-    return true;
 #else
     // WiFi connection is handled externally (in main.cpp)
-    // Attempt initial connection
-    if (!connect()) {
-        INFO("TCPClientInterface: Initial connection failed, will retry in background");
-        // Don't return false - we'll reconnect in loop()
-    }
-
-    return true;
+    _task_thread = std::thread([this]() { task_loop(); });
 #endif
+    INFO("TCPClientInterface: socket worker running");
+    return true;
 }
 
-bool TCPClientInterface::connect() {
-    TRACE("TCPClientInterface: Connecting to " + _target_host + ":" + std::to_string(_target_port));
-
-#ifdef ARDUINO
-    _client.setTimeout(CONNECT_TIMEOUT_MS);
-
-    // 3-arg connect bounds the blocking time (the 2-arg form ignores it and can
-    // block ~18.5s on an unreachable host). Runs on tcp_task, off the main loop.
-    if (!_client.connect(_target_host.c_str(), _target_port, CONNECT_TIMEOUT_MS)) {
-        DEBUG("TCPClientInterface: Connection failed");
-        return false;
+// Resolve upstream i to an IPv4 address (network order), from the DNS cache
+// while it is fresh. Blocking lwIP/libc DNS; tcp_task only.
+bool TCPClientInterface::resolve(size_t i, uint32_t* addr) {
+    uint32_t now = now_ms();
+    if (_upstreams.cached_address(i, now, addr)) {
+        return true;
     }
-
-    // Configure socket options
-    configure_socket();
-
-    INFO("TCPClientInterface: Connected to " + _target_host + ":" + std::to_string(_target_port));
-    // task_loop() publishes the link state (_conn_state / _online / _reconnected)
-    // after this returns; nothing else is touched here.
-    return true;
-
-#else
-    // Resolve target host
-    struct in_addr target_addr;
-    if (inet_aton(_target_host.c_str(), &target_addr) == 0) {
-        struct hostent* host_ent = gethostbyname(_target_host.c_str());
+    const std::string& host = _upstreams[i].host;
+    struct in_addr literal;
+    if (inet_aton(host.c_str(), &literal) != 0) {
+        *addr = literal.s_addr;
+    } else {
+        struct hostent* host_ent = gethostbyname(host.c_str());
         if (host_ent == nullptr || host_ent->h_addr_list[0] == nullptr) {
-            ERROR("TCPClientInterface: Unable to resolve host " + _target_host);
+            ERROR("TCPClientInterface: Unable to resolve host " + host);
             return false;
         }
-        _target_address = *((in_addr_t*)(host_ent->h_addr_list[0]));
-    } else {
-        _target_address = target_addr.s_addr;
+        memcpy(addr, host_ent->h_addr_list[0], sizeof(*addr));
     }
+    _upstreams.store_address(i, *addr, now);
+    return true;
+}
 
-    // Create TCP socket
-    _socket = socket(PF_INET, SOCK_STREAM, 0);
-    if (_socket < 0) {
+// Start a non-blocking connect to upstream i at addr. Returns the socket, or -1.
+int TCPClientInterface::dial(size_t i, uint32_t addr) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
         ERROR("TCPClientInterface: Unable to create socket, error " + std::to_string(errno));
-        return false;
+        return -1;
     }
+    // Stays non-blocking: all I/O is select() + MSG_DONTWAIT
+    int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
 
-    // Set non-blocking for connect timeout
-    int flags = fcntl(_socket, F_GETFL, 0);
-    fcntl(_socket, F_SETFL, flags | O_NONBLOCK);
-
-    // Connect to server
-    sockaddr_in server_addr;
+    sockaddr_in server_addr = {};
     server_addr.sin_family = AF_INET;
-    server_addr.sin_addr.s_addr = _target_address;
-    server_addr.sin_port = htons(_target_port);
+    server_addr.sin_addr.s_addr = addr;
+    server_addr.sin_port = htons(_upstreams[i].port);
 
-    int result = ::connect(_socket, (struct sockaddr*)&server_addr, sizeof(server_addr));
+    int result = ::connect(fd, (struct sockaddr*)&server_addr, sizeof(server_addr));
     if (result < 0 && errno != EINPROGRESS) {
-        close(_socket);
-        _socket = -1;
-        ERROR("TCPClientInterface: Connect failed, error " + std::to_string(errno));
-        return false;
-    }
-
-    // Wait for connection with timeout
-    fd_set write_fds;
-    FD_ZERO(&write_fds);
-    FD_SET(_socket, &write_fds);
-    struct timeval timeout;
-    timeout.tv_sec = CONNECT_TIMEOUT_MS / 1000;
-    timeout.tv_usec = (CONNECT_TIMEOUT_MS % 1000) * 1000;
-
-    result = select(_socket + 1, nullptr, &write_fds, nullptr, &timeout);
-    if (result <= 0) {
-        close(_socket);
-        _socket = -1;
-        DEBUG("TCPClientInterface: Connection timeout");
-        return false;
+        DEBUG("TCPClientInterface: Connect to " + _upstreams[i].host + " failed, error " + std::to_string(errno));
+        close(fd);
+        return -1;
     }
+    TRACE("TCPClientInterface: Connecting to " + _upstreams[i].host + ":" + std::to_string(_upstreams[i].port));
+    return fd;
+}
 
-    // Check if connection succeeded
-    int sock_error = 0;
-    socklen_t len = sizeof(sock_error);
-    getsockopt(_socket, SOL_SOCKET, SO_ERROR, &sock_error, &len);
-    if (sock_error != 0) {
-        close(_socket);
-        _socket = -1;
-        DEBUG("TCPClientInterface: Connection failed, error " + std::to_string(sock_error));
-        return false;
+// Dial the upstreams in rank order, CONNECT_STAGGER_MS apart, keeping every
+// attempt in flight: the first handshake to complete wins and the others are
+// closed. The best-ranked upstream gets a head start, a slow one can't hold
+// up a fast one, and a dead one costs at most CONNECT_TIMEOUT_MS. Every
+// upstream is resolved before the first dial, so a blocking DNS lookup can't
+// stall the attempts already in flight. Runs on tcp_task; returns with
+// _socket connected, or false.
+bool TCPClientInterface::connect() {
+    struct Attempt {
+        int fd;
+        size_t upstream;
+        uint32_t started_ms;
+    };
+    size_t order[TCPUpstreams::MAX_UPSTREAMS];
+    uint32_t addrs[TCPUpstreams::MAX_UPSTREAMS];
+    Attempt attempts[TCPUpstreams::MAX_UPSTREAMS];
+    size_t ranked = _upstreams.rank(order);
+    size_t count = 0;
+    for (size_t r = 0; r < ranked && _task_running; ++r) {
+        if (!resolve(order[r], &addrs[count])) {
+            _upstreams.on_failed(order[r], true);
+            continue;
+        }
+        order[count++] = order[r];
     }
+    size_t dialed = 0;
+    size_t live = 0;
+    uint32_t next_dial = now_ms();
+
+    while (_task_running && (dialed < count || live > 0)) {
+        uint32_t now = now_ms();
+        if (live == 0) next_dial = now;     // the stagger only waits on a live attempt
+        if (dialed < count && (int32_t)(now - next_dial) >= 0) {
+            size_t u = order[dialed];
+            int fd = dial(u, addrs[dialed++]);
+            if (fd < 0) {
+                _upstreams.on_failed(u, true);
+                continue;                    // next one right away
+            }
+            attempts[live++] = {fd, u, now};
+            next_dial = now + CONNECT_STAGGER_MS;
+            continue;
+        }
 
-    // Restore blocking mode for normal operation
-    fcntl(_socket, F_SETFL, flags);
+        // Expire attempts past their timeout, and find the next deadline
+        uint32_t wait_ms = CONNECT_TIMEOUT_MS;
+        if (dialed < count) wait_ms = next_dial - now;
+        for (size_t a = 0; a < live;) {
+            uint32_t age = now - attempts[a].started_ms;
+            if (age >= CONNECT_TIMEOUT_MS) {
+                DEBUG("TCPClientInterface: Connect to " + _upstreams[attempts[a].upstream].host + " timed out");
+                close(attempts[a].fd);
+                _upstreams.on_failed(attempts[a].upstream, true);
+                attempts[a] = attempts[--live];
+                continue;
+            }
+            if (CONNECT_TIMEOUT_MS - age < wait_ms) wait_ms = CONNECT_TIMEOUT_MS - age;
+            ++a;
+        }
+        if (live == 0) continue;
+
+        fd_set write_fds;
+        FD_ZERO(&write_fds);
+        int max_fd = -1;
+        for (size_t a = 0; a < live; ++a) {
+            FD_SET(attempts[a].fd, &write_fds);
+            if (attempts[a].fd > max_fd) max_fd = attempts[a].fd;
+        }
+        struct timeval timeout;
+        timeout.tv_sec = wait_ms / 1000;
+        timeout.tv_usec = (wait_ms % 1000) * 1000;
+        if (select(max_fd + 1, nullptr, &write_fds, nullptr, &timeout) <= 0) continue;
+
+        now = now_ms();
+        for (size_t a = 0; a < live;) {
+            if (!FD_ISSET(attempts[a].fd, &write_fds)) {
+                ++a;
+                continue;
+            }
+            const TCPUpstreams::Upstream& up = _upstreams[attempts[a].upstream];
+            int sock_error = 0;
+            socklen_t len = sizeof(sock_error);
+            getsockopt(attempts[a].fd, SOL_SOCKET, SO_ERROR, &sock_error, &len);
+            if (sock_error != 0) {
+                DEBUG("TCPClientInterface: Connect to " + up.host + " failed, error " + std::to_string(sock_error));
+                close(attempts[a].fd);
+                _upstreams.on_failed(attempts[a].upstream, true);
+                attempts[a] = attempts[--live];
+                continue;
+            }
 
-    // Configure socket options
-    configure_socket();
+            // Winner: abandon the rest (not a failure, they were just slower)
+            for (size_t b = 0; b < live; ++b) {
+                if (b != a) close(attempts[b].fd);
+            }
+            uint32_t rtt_ms = now - attempts[a].started_ms;
+            _upstreams.on_connected(attempts[a].upstream, rtt_ms);
+            _socket = attempts[a].fd;
+            _active_upstream.store(attempts[a].upstream);
+            configure_socket();
+            Metrics::set(METRIC_TCP_CONNECT_RTT, static_cast<int32_t>(rtt_ms));
+            Metrics::set(METRIC_TCP_UPSTREAM, static_cast<int32_t>(attempts[a].upstream));
+            INFO("TCPClientInterface: Connected to " + up.host + ":" + std::to_string(up.port) +
+                 " (" + std::to_string(rtt_ms) + " ms)");
+            return true;
+        }
+    }
 
-    INFO("TCPClientInterface: Connected to " + _target_host + ":" + std::to_string(_target_port));
-    _online = true;
-    _frame_buffer.clear();
-    return true;
-#endif
+    // stop() during connect
+    for (size_t a = 0; a < live; ++a) {
+        close(attempts[a].fd);
+    }
+    return false;
 }
 
 void TCPClientInterface::configure_socket() {
-#ifdef ARDUINO
-    // Get underlying socket fd for setsockopt
-    int fd = _client.fd();
-    if (fd < 0) {
-        DEBUG("TCPClientInterface: Could not get socket fd for configuration");
-        return;
-    }
-
     // TCP_NODELAY - disable Nagle's algorithm
     int flag = 1;
-    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+    setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
 
     // Enable TCP keepalive
-    setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag));
+    setsockopt(_socket, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag));
 
     // Keepalive parameters (may not all be available on ESP32 lwIP)
 #ifdef TCP_KEEPIDLE
     int keepidle = TCP_KEEPIDLE_SEC;
-    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle));
+    setsockopt(_socket, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle));
 #endif
 #ifdef TCP_KEEPINTVL
     int keepintvl = TCP_KEEPINTVL_SEC;
-    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl));
+    setsockopt(_socket, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl));
 #endif
 #ifdef TCP_KEEPCNT
     int keepcnt = TCP_KEEPCNT_PROBES;
-    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &keepcnt, sizeof(keepcnt));
-#endif
-
-    TRACE("TCPClientInterface: Socket configured with TCP_NODELAY and keepalive");
-
-#else
-    // TCP_NODELAY
-    int flag = 1;
-    setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
-
-    // Enable TCP keepalive
-    setsockopt(_socket, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(flag));
-
-    // Keepalive parameters
-    int keepidle = TCP_KEEPIDLE_SEC;
-    int keepintvl = TCP_KEEPINTVL_SEC;
-    int keepcnt = TCP_KEEPCNT_PROBES;
-    setsockopt(_socket, IPPROTO_TCP, TCP_KEEPIDLE, &keepidle, sizeof(keepidle));
-    setsockopt(_socket, IPPROTO_TCP, TCP_KEEPINTVL, &keepintvl, sizeof(keepintvl));
     setsockopt(_socket, IPPROTO_TCP, TCP_KEEPCNT, &keepcnt, sizeof(keepcnt));
+#endif
 
     // TCP_USER_TIMEOUT (Linux 2.6.37+)
 #ifdef TCP_USER_TIMEOUT
@@ -230,42 +323,29 @@ void TCPClientInterface::configure_socket() {
     setsockopt(_socket, IPPROTO_TCP, TCP_USER_TIMEOUT, &user_timeout, sizeof(user_timeout));
 #endif
 
-    TRACE("TCPClientInterface: Socket configured with TCP_NODELAY, keepalive, and timeouts");
-#endif
+    TRACE("TCPClientInterface: Socket configured with TCP_NODELAY and keepalive");
 }
 
 void TCPClientInterface::disconnect() {
     DEBUG("TCPClientInterface: Disconnecting");
 
-#ifdef ARDUINO
-    _client.stop();
-#else
     if (_socket >= 0) {
         close(_socket);
         _socket = -1;
     }
-#endif
 
-    _online = false;
-    _frame_buffer.clear();
+    _connected.store(false);
+    _rx_decoder.reset();
+    // Anything still queued (including a partly written frame) belonged to
+    // the old stream; Reticulum retransmits what matters
+    discard_tx();
 }
 
-void TCPClientInterface::handle_disconnect() {
-#ifdef ARDUINO
-    // Called on the main loop while CONNECTED. Close the socket and hand it back
-    // to tcp_task (DISCONNECTED) for a fresh connect.
-    INFO("TCPClientInterface: Connection lost, will attempt reconnection");
-    disconnect();                     // _client.stop(), _online=false, clear buffer
-    _last_connect_attempt = millis();
-    _conn_state.store(DISCONNECTED);
-#else
-    if (_online) {
-        INFO("TCPClientInterface: Connection lost, will attempt reconnection");
-        disconnect();
-        // Reset connect attempt timer to enforce wait before reconnection
-        _last_connect_attempt = millis();
+void TCPClientInterface::wake_task() {
+    if (_wake_fd >= 0) {
+        uint64_t one = 1;
+        (void)!write(_wake_fd, &one, sizeof(one));
     }
-#endif
 }
 
 #ifdef ARDUINO
@@ -275,49 +355,71 @@ void TCPClientInterface::handle_disconnect() {
     self->_task_done = true;   // let stop() join before the object is freed
     vTaskDelete(nullptr);
 }
+#endif
 
-// Owns _client ONLY while connecting. When the link is down it runs the blocking
-// connect() here (off the main loop); on success it publishes CONNECTED and the
-// main loop takes over all socket I/O. It never touches _client while CONNECTED.
+// Owns the socket. While the link is down it runs connect() (off the main
+// loop) every RECONNECT_WAIT_MS; while it is up, service_socket() waits in
+// select() for data, outgoing packets or stop(). With several upstreams a
+// dropped or stalled one is failed over at once: connect() re-ranks it last
+// and the wait only applies once every upstream has failed.
 void TCPClientInterface::task_loop() {
     while (_task_running) {
-        if (_conn_state.load() == DISCONNECTED) {
-            uint32_t now = millis();
-            if (now - _last_connect_attempt >= RECONNECT_WAIT_MS) {
+        if (!_connected.load()) {
+            uint32_t now = now_ms();
+            bool attempt = now - _last_connect_attempt >= RECONNECT_WAIT_MS;
+#ifdef ARDUINO
+            attempt = attempt && ESP.getMaxAllocHeap() >= 20000;  // skip under heap pressure
+#endif
+            if (attempt) {
                 _last_connect_attempt = now;
-                if (ESP.getMaxAllocHeap() >= 20000) {  // skip under heap pressure
-                    _conn_state.store(CONNECTING);      // claim _client
-                    if (connect()) {
-                        _frame_buffer.clear();
-                        _last_data_received = millis();
-                        // _online is owned by the main loop (it sets it on
-                        // observing CONNECTED); writing it here would race with
-                        // loop()'s `_online = false` during the CONNECTING window.
-                        // Publish CONNECTED BEFORE _reconnected: seq-cst then
-                        // guarantees that whenever the main loop observes
-                        // _reconnected==true the interface is already CONNECTED,
-                        // so check_reconnected() can't fire the announce on an
-                        // offline interface (which would drop it).
-                        _conn_state.store(CONNECTED);   // hand _client to main loop
-                        _reconnected.store(true);       // main loop announces
-                    } else {
-                        _conn_state.store(DISCONNECTED);
-                    }
+                if (connect()) {
+                    _rx_decoder.reset();
+                    _last_data_received = now_ms();
+                    // Publish _connected BEFORE _reconnected: seq-cst then
+                    // guarantees that whenever the main loop observes
+                    // _reconnected==true the interface is already connected,
+                    // so check_reconnected() can't fire the announce on an
+                    // offline interface (which would drop it).
+                    _connected.store(true);
+                    _reconnected.store(true);
+                    continue;
                 }
             }
+            discard_tx();   // sent while the link went down
+            sleep_ms(100);
+            continue;
+        }
+
+        if (!service_socket()) {
+            size_t lost = _active_upstream.exchange(NO_UPSTREAM);
+            disconnect();
+            if (lost < _upstreams.size()) {
+                _upstreams.on_failed(lost, false);
+            }
+            if (_upstreams.size() > 1 && _task_running) {
+                INFO("TCPClientInterface: Connection lost, failing over");
+                Metrics::add(METRIC_TCP_FAILOVERS);
+                _last_connect_attempt = now_ms() - RECONNECT_WAIT_MS;
+            } else {
+                INFO("TCPClientInterface: Connection lost, will attempt reconnection");
+                // Enforce the wait before reconnecting
+                _last_connect_attempt = now_ms();
+            }
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+    if (_connected.load()) {
+        disconnect();
     }
 }
-#endif
 
 /*virtual*/ void TCPClientInterface::stop() {
+    _task_running = false;
+    wake_task();
 #ifdef ARDUINO
     // Join the task: signal it, then wait until it has actually left task_loop()
     // before tearing anything down. An in-flight connect() can overrun
     // CONNECT_TIMEOUT_MS on a slow DNS server, and ~TCPClientInterface() calls
     // stop() — returning early would risk a use-after-free on `this`.
-    _task_running = false;
     if (_task_handle != nullptr) {
         // Wait for the task to leave task_loop() and set _task_done — after that
         // it only calls vTaskDelete(nullptr) and never touches `this` again, so
@@ -336,307 +438,305 @@ void TCPClientInterface::task_loop() {
         }
         _task_handle = nullptr;
     }
-    _conn_state.store(DISCONNECTED);
+#else
+    if (_task_thread.joinable()) {
+        _task_thread.join();
+    }
 #endif
+    // The task is gone; both ends of the queues are ours now
     disconnect();
+    _online = false;
+    _rx_packets.reset();
 }
 
+// Main loop: hand packets tcp_task decoded to Transport. Never touches the
+// socket.
 /*virtual*/ void TCPClientInterface::loop() {
-#ifdef ARDUINO
-    // tcp_task owns _client while (re)connecting; the main loop only touches the
-    // socket once CONNECTED. read/write/frame all happen here (same low-latency
-    // path as before the task split). The legacy body below is unreachable on
-    // ARDUINO.
-    if (_conn_state.load() != CONNECTED) {
-        _online = false;
-        return;
-    }
-    _online = true;
-    // ESP32 WiFiClient.connected() can momentarily read false; only treat it as a
-    // drop when there is also no buffered data.
-    if (!_client.connected() && _client.available() == 0) {
-        handle_disconnect();
-        return;
-    }
-    if (_client.available() > 0) {
-        _last_data_received = millis();
-        while (_client.available() > 0) {
-            uint8_t byte = _client.read();
-            _frame_buffer.append(byte);
-        }
+    _online = _connected.load();
+
+    // Bounded so a flood can't hold the main loop; the rest wait for the
+    // next pass
+    for (size_t budget = RX_PACKET_SLOTS; budget > 0; --budget) {
+        const uint8_t* frame;
+        size_t frame_len;
+        uint32_t rx_us;
+        if (!_rx_packets.front(&frame, &frame_len, &rx_us)) break;
+
+        Bytes packet(frame, frame_len);
+        _rx_packets.pop();
+
+        DEBUG(toString() + ": Received frame, " + std::to_string(frame_len) + " bytes");
+        EVENT_TRACE_SCOPE_V(TCP_RX, frame_len);
+        InterfaceImpl::handle_incoming(packet);
+        Metrics::add(METRIC_TCP_RX_PACKETS);
+        Metrics::add(METRIC_TCP_RX_BYTES, static_cast<uint32_t>(frame_len));
+        Metrics::observeSince(METRIC_TCP_RX_LATENCY, rx_us);
     }
-    extract_and_process_frames();
-    return;
-#endif
-    // Periodic status logging
-    static uint32_t last_status_log = 0;
-    static uint32_t loop_count = 0;
-    static uint32_t total_rx = 0;
-    loop_count++;
-    uint32_t now = millis();
-    // [TCP] connection-status heartbeat — protocol-debug only. Was at
-    // INFO level firing every 5s; combined with the per-frame [TCP] /
-    // [HDLC] / [ustore] prints below, this saturated USB CDC during
-    // active LXST calls and starved T:CALL_QOS responses (#75).
-    if (now - last_status_log >= 5000) {
-        last_status_log = now;
-        if (RNS::loglevel() >= RNS::LOG_DEBUG) {
-            int avail = _client.available();
-            Serial.printf("[TCP] connected=%d online=%d avail=%d loops=%u rx=%u buf=%d\n",
-                          _client.connected(), _online, avail, loop_count, total_rx, (int)_frame_buffer.size());
-        }
-        loop_count = 0;
+    if (_rx_paused.load() && rx_room()) {
+        _rx_paused.store(false);
+        wake_task();
     }
+}
 
-    // Handle reconnection if not connected
-    if (!_online) {
-        if (_initiator) {
-#ifdef ARDUINO
-            uint32_t now = millis();
-#else
-            uint32_t now = static_cast<uint32_t>(Utilities::OS::time() * 1000);
-#endif
-            if (now - _last_connect_attempt >= RECONNECT_WAIT_MS) {
-                _last_connect_attempt = now;
-                // Skip reconnection if memory is too low - prevents fragmentation
-                uint32_t max_block = ESP.getMaxAllocHeap();
-                if (max_block < 20000) {
-                    Serial.printf("[TCP] Skipping reconnect - low memory (max_block=%u)\n", max_block);
-                } else {
-                    DEBUG("TCPClientInterface: Attempting reconnection...");
-                    connect();
-                }
-            }
-        }
-        return;
+// One round of socket work: queue and write outgoing frames, then wait for
+// the socket (or _wake_fd) and read. Returns false when the connection is
+// gone.
+bool TCPClientInterface::service_socket() {
+    int fd = _socket;
+    if (fd < 0) return false;
+
+    if (_tx_queue.queued_bytes() == 0) {
+        _last_tx_progress = now_ms();
+    }
+    drain_tx_packets();
+    if (!flush_tx()) return false;
+
+    // Stalled: the hub has taken none of our queued bytes for a keepalive
+    // period. Only worth acting on with somewhere else to go; silence alone
+    // is not a stall (an idle hub sends nothing).
+    if (_upstreams.size() > 1 && _tx_queue.queued_bytes() > 0 &&
+        now_ms() - _last_tx_progress >= STALE_CONNECTION_MS) {
+        WARNING("TCPClientInterface: Upstream stalled, " + std::to_string(_tx_queue.queued_bytes()) +
+                " bytes unsent");
+        return false;
     }
 
-    // Check connection status
-    // Note: ESP32 WiFiClient.connected() has known bugs where it returns false incorrectly
-    // See: https://github.com/espressif/arduino-esp32/issues/1714
-    // Workaround: only disconnect if connected() is false AND no data available
-#ifdef ARDUINO
-    if (!_client.connected() && _client.available() == 0) {
-        Serial.printf("[TCP] Connection closed (connected=false, available=0)\n");
-        handle_disconnect();
-        return;
-    }
-
-    // Stale connection detection disabled - was causing frequent reconnects
-    // TODO: investigate why this triggers even when receiving data
-    // if (_last_data_received > 0 && (now - _last_data_received) > STALE_CONNECTION_MS) {
-    //     WARNING("TCPClientInterface: Connection appears stale, forcing reconnection");
-    //     handle_disconnect();
-    //     return;
-    // }
-
-    // Read available data
-    int avail = _client.available();
-    if (avail > 0) {
-        bool dbg = RNS::loglevel() >= RNS::LOG_DEBUG;
-        if (dbg) Serial.printf("[TCP] Reading %d bytes\n", avail);
-        total_rx += avail;
-        _last_data_received = now;  // Update stale timer on any data receipt
-        size_t start_pos = _frame_buffer.size();
-        while (_client.available() > 0) {
-            uint8_t byte = _client.read();
-            _frame_buffer.append(byte);
-        }
-        if (dbg) {
-            Serial.printf("[TCP] First bytes: ");
-            size_t dump_len = (_frame_buffer.size() - start_pos);
-            if (dump_len > 20) dump_len = 20;
-            for (size_t i = 0; i < dump_len; ++i) {
-                Serial.printf("%02x ", _frame_buffer.data()[start_pos + i]);
-            }
-            Serial.printf("\n");
-        }
+    fd_set read_fds;
+    fd_set write_fds;
+    FD_ZERO(&read_fds);
+    FD_ZERO(&write_fds);
+    FD_SET(_wake_fd, &read_fds);
+    // Stop reading while the main loop is behind, so the hub sees TCP flow
+    // control instead of us dropping frames. Publish the pause before the
+    // re-check: loop() wakes us if it drains in between.
+    bool can_read = rx_room();
+    if (!can_read) {
+        _rx_paused.store(true);
+        can_read = rx_room();
     }
-#else
-    // Non-blocking read
-    uint8_t buf[4096];
-    ssize_t len = recv(_socket, buf, sizeof(buf), MSG_DONTWAIT);
-    if (len > 0) {
-        DEBUG("TCPClientInterface: Received " + std::to_string(len) + " bytes");
-        _frame_buffer.append(buf, len);
-    } else if (len == 0) {
-        // Connection closed by peer
-        DEBUG("TCPClientInterface: recv returned 0 - connection closed");
-        handle_disconnect();
-        return;
-    } else {
-        int err = errno;
-        if (err != EAGAIN && err != EWOULDBLOCK) {
-            // Socket error
-            ERROR("TCPClientInterface: recv error " + std::to_string(err));
-            handle_disconnect();
-            return;
-        }
-        // EAGAIN/EWOULDBLOCK - normal for non-blocking, just no data yet
+    if (can_read) {
+        _rx_paused.store(false);
+        FD_SET(fd, &read_fds);
     }
-#endif
+    // Wait for writability only while a write is pending, or select()
+    // returns at once on an idle connection
+    bool tx_pending = _tx_queue.queued_bytes() > 0;
+    if (tx_pending) FD_SET(fd, &write_fds);
 
-    // Process any complete frames
-    extract_and_process_frames();
+    struct timeval timeout;
+    timeout.tv_sec = IO_POLL_MS / 1000;
+    timeout.tv_usec = (IO_POLL_MS % 1000) * 1000;
+    int max_fd = fd > _wake_fd ? fd : _wake_fd;
+    int ready = select(max_fd + 1, &read_fds, tx_pending ? &write_fds : nullptr, nullptr, &timeout);
+    if (ready < 0) {
+        if (errno == EINTR) return true;
+        ERROR("TCPClientInterface: select error " + std::to_string(errno));
+        return false;
+    }
+    if (ready > 0 && FD_ISSET(_wake_fd, &read_fds)) {
+        uint64_t count;
+        (void)!read(_wake_fd, &count, sizeof(count));
+    }
+    if (ready > 0 && FD_ISSET(fd, &read_fds)) {
+        return receive(fd);
+    }
+    // Writable: flushed at the top of the next round
+    return true;
 }
 
-void TCPClientInterface::extract_and_process_frames() {
-    // Find and process complete HDLC frames: [FLAG][data][FLAG]
-    static uint32_t frame_count = 0;
-
-    while (true) {
-        if (_frame_buffer.size() == 0) break;
-
-        // Find first FLAG byte
-        int start = -1;
-        for (size_t i = 0; i < _frame_buffer.size(); ++i) {
-            if (_frame_buffer.data()[i] == HDLC::FLAG) {
-                start = static_cast<int>(i);
-                break;
-            }
-        }
-
-        if (start < 0) {
-            // No FLAG found, discard buffer (garbage data before any frame)
-            Serial.printf("[HDLC] No FLAG in %d bytes, clearing\n", (int)_frame_buffer.size());
-            _frame_buffer.clear();
-            break;
-        }
-
-        // Discard data before first FLAG
-        if (start > 0) {
-            Serial.printf("[HDLC] Discarding %d bytes before FLAG\n", start);
-            _frame_buffer = _frame_buffer.mid(start);
-        }
-
-        // Find end FLAG (skip the start FLAG at position 0)
-        int end = -1;
-        for (size_t i = 1; i < _frame_buffer.size(); ++i) {
-            if (_frame_buffer.data()[i] == HDLC::FLAG) {
-                end = static_cast<int>(i);
-                break;
-            }
-        }
-
-        if (end < 0) {
-            // Incomplete frame, wait for more data
-            break;
-        }
-
-        // Extract frame content between FLAGS (excluding the FLAGS)
-        Bytes frame_content = _frame_buffer.mid(1, end - 1);
-        frame_count++;
-        if (RNS::loglevel() >= RNS::LOG_DEBUG) {
-            Serial.printf("[HDLC] Frame #%u: %d escaped bytes\n", frame_count, (int)frame_content.size());
-        }
-
-        // Remove processed frame from buffer (keep data after end FLAG)
-        _frame_buffer = _frame_buffer.mid(end);
+// Whether _rx_packets can take every frame one RX_CHUNK could complete
+bool TCPClientInterface::rx_room() const {
+    // A frame needs HEADER_MINSIZE bytes plus its closing FLAG
+    static const size_t MAX_FRAMES_PER_CHUNK = RX_CHUNK / (Type::Reticulum::HEADER_MINSIZE + 1) + 1;
+    return RX_PACKET_SLOTS - _rx_packets.size() >= MAX_FRAMES_PER_CHUNK;
+}
 
-        // Skip empty frames (consecutive FLAGs)
-        if (frame_content.size() == 0) {
-            if (RNS::loglevel() >= RNS::LOG_DEBUG) Serial.printf("[HDLC] Empty frame, skipping\n");
+// Read what the socket has (bounded, so a flood can't starve TX) and decode it
+bool TCPClientInterface::receive(int fd) {
+    uint8_t chunk[RX_CHUNK];
+    for (int reads = 0; reads < 8 && rx_room(); ++reads) {
+        ssize_t len = recv(fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+        if (len > 0) {
+            _last_data_received = now_ms();
+            process_received(chunk, static_cast<size_t>(len));
+            if (static_cast<size_t>(len) < sizeof(chunk)) return true;
             continue;
         }
-
-        // Unescape frame
-        Bytes unescaped = HDLC::unescape(frame_content);
-        if (unescaped.size() == 0) {
-            if (RNS::loglevel() >= RNS::LOG_DEBUG) Serial.printf("[HDLC] Unescape failed!\n");
-            DEBUG("TCPClientInterface: HDLC unescape error, discarding frame");
-            continue;
+        if (len == 0) {
+            // Connection closed by peer
+            DEBUG("TCPClientInterface: recv returned 0 - connection closed");
+            return false;
         }
+        int err = errno;
+        if (err == EINTR) continue;
+        if (err == EAGAIN || err == EWOULDBLOCK) return true;
+        ERROR("TCPClientInterface: recv error " + std::to_string(err));
+        return false;
+    }
+    return true;
+}
+
+// tcp_task: decode received bytes and queue whole packets for the main loop
+void TCPClientInterface::process_received(const uint8_t* data, size_t len) {
+    // Frames completed by this read count their latency from here
+    const uint32_t rx_us = Metrics::nowUs();
+    const uint32_t dropped_before = _rx_decoder.dropped();
 
+    _rx_decoder.feed(data, len, [&](const uint8_t* frame, size_t frame_len) {
         // Validate minimum frame size (matches Python RNS HEADER_MINSIZE check)
-        if (unescaped.size() < Type::Reticulum::HEADER_MINSIZE) {
-            TRACE("TCPClientInterface: Frame too small (" + std::to_string(unescaped.size()) + " bytes), discarding");
-            continue;
+        if (frame_len < Type::Reticulum::HEADER_MINSIZE) {
+            TRACE("TCPClientInterface: Frame too small (" + std::to_string(frame_len) + " bytes), discarding");
+            Metrics::add(METRIC_TCP_RX_DROPS);
+            return;
         }
-
-        // Pass to transport layer
-        if (RNS::loglevel() >= RNS::LOG_DEBUG) {
-            Serial.printf("[TCP] Processing frame: %d bytes\n", (int)unescaped.size());
+        if (!_rx_packets.push(frame, frame_len, rx_us)) {
+            // Not expected: receive() only reads while rx_room()
+            DEBUG("TCPClientInterface: RX packet queue full, dropping frame");
+            Metrics::add(METRIC_TCP_RX_DROPS);
         }
-        DEBUG(toString() + ": Received frame, " + std::to_string(unescaped.size()) + " bytes");
-        InterfaceImpl::handle_incoming(unescaped);
+    });
+
+    // Garbage before a FLAG, bare-ESC and oversize frames
+    uint32_t dropped = _rx_decoder.dropped() - dropped_before;
+    if (dropped > 0) {
+        DEBUG("TCPClientInterface: HDLC decoder dropped " + std::to_string(dropped) + " frame(s)/runs");
+        Metrics::add(METRIC_TCP_RX_DROPS, dropped);
     }
 }
 
+// Main loop: hand the packet to tcp_task. Never blocks.
 /*virtual*/ bool TCPClientInterface::send_outgoing(const Bytes& data) {
+    EVENT_TRACE_SCOPE_V(TCP_TX, data.size());
     DEBUG(toString() + ".send_outgoing: data: " + std::to_string(data.size()) + " bytes");
 
-    if (!_online) {
+    // _connected rather than _online: it is set before _reconnected, so the
+    // post-reconnect announce is never refused
+    if (!_connected.load()) {
         DEBUG("TCPClientInterface: Not connected, cannot send");
-        return false;
+        Metrics::add(METRIC_TCP_TX_DROPS);
+        return false;  // not connected; Reticulum will retry/route
     }
 
-    try {
-        // Frame with HDLC
-        Bytes framed = HDLC::frame(data);
-
-        // Wire-format dumps are protocol-debug only — re-enable by
-        // raising RNS log level to DEBUG. At INFO they fired ~10×/s
-        // during voice calls (pre + post HDLC, per packet) and
-        // saturated USB CDC, starving T:CALL_QOS responses.
-        if (RNS::loglevel() >= RNS::LOG_DEBUG) {
-            std::string hex_preview;
-            size_t preview_len = (data.size() < 50) ? data.size() : 50;
-            for (size_t i = 0; i < preview_len; ++i) {
-                char buf[4];
-                snprintf(buf, sizeof(buf), "%02x", data.data()[i]);
-                hex_preview += buf;
-            }
-            if (data.size() > 50) hex_preview += "...";
-            DEBUG("WIRE TX raw (" + std::to_string(data.size()) + " bytes): " + hex_preview);
-
-            std::string framed_hex;
-            size_t flen = (framed.size() < 30) ? framed.size() : 30;
-            for (size_t i = 0; i < flen; ++i) {
-                char buf[4];
-                snprintf(buf, sizeof(buf), "%02x", framed.data()[i]);
-                framed_hex += buf;
-            }
-            if (framed.size() > 30) framed_hex += "...";
-            DEBUG("WIRE TX framed (" + std::to_string(framed.size()) + " bytes): " + framed_hex);
+    // Wire-format dumps are protocol-debug only — re-enable by
+    // raising RNS log level to DEBUG. At INFO they fired ~10×/s
+    // during voice calls (per packet) and saturated USB CDC,
+    // starving T:CALL_QOS responses.
+    if (RNS::loglevel() >= RNS::LOG_DEBUG) {
+        std::string hex_preview;
+        size_t preview_len = (data.size() < 50) ? data.size() : 50;
+        for (size_t i = 0; i < preview_len; ++i) {
+            char buf[4];
+            snprintf(buf, sizeof(buf), "%02x", data.data()[i]);
+            hex_preview += buf;
         }
+        if (data.size() > 50) hex_preview += "...";
+        DEBUG("WIRE TX raw (" + std::to_string(data.size()) + " bytes): " + hex_preview);
+    }
 
-#ifdef ARDUINO
-        // Only write when CONNECTED — while (re)connecting, _client belongs to
-        // tcp_task. send_outgoing() runs on the main loop (same thread as loop()),
-        // so no lock is needed once CONNECTED.
-        if (_conn_state.load() != CONNECTED) {
-            return false;  // not connected; Reticulum will retry/route
+    // Backpressure: refuse non-link traffic until the hub catches up. Link
+    // packets (LXST audio) still go, and tcp_task queues them ahead.
+    if (_tx_congested.load(std::memory_order_relaxed) &&
+        TCPTxQueue::classify(data.data(), data.size()) == TCPTxQueue::BULK) {
+        DEBUG("TCPClientInterface: TX queue congested, refusing packet");
+        Metrics::add(METRIC_TCP_TX_BACKPRESSURE);
+        Metrics::add(METRIC_TCP_TX_DROPS);
+        return false;
+    }
+    if (!_tx_packets.push(data.data(), data.size())) {
+        WARNING("TCPClientInterface: TX packet queue full, dropping " + std::to_string(data.size()) + " byte packet");
+        Metrics::add(METRIC_TCP_TX_DROPS);
+        return false;
+    }
+    wake_task();
+
+    // Perform post-send housekeeping
+    InterfaceImpl::handle_outgoing(data);
+    return true;
+}
+
+// tcp_task: frame packets from send_outgoing() into the TX queue
+void TCPClientInterface::drain_tx_packets() {
+    const uint8_t* data;
+    size_t len;
+    while (_tx_packets.front(&data, &len)) {
+        // Frame with HDLC straight into the TX queue; link packets go ahead of
+        // anything bulk that is still waiting for the socket. send_outgoing()
+        // already applied the watermark, so only a full ring refuses it.
+        TCPTxQueue::Push pushed = _tx_queue.push(data, len, TCPTxQueue::classify(data, len), true);
+        if (pushed == TCPTxQueue::Push::FULL) {
+            // Leave it queued; once _tx_packets fills too, send_outgoing()
+            // refuses instead
+            break;
         }
-        size_t written = _client.write(framed.data(), framed.size());
-        if (written != framed.size()) {
-            ERROR("TCPClientInterface: Write incomplete, " + std::to_string(written) +
-                  " of " + std::to_string(framed.size()) + " bytes");
-            handle_disconnect();
-            return false;
+        if (pushed != TCPTxQueue::Push::QUEUED) {
+            Metrics::add(METRIC_TCP_TX_DROPS);
         }
-        _client.flush();
+        _tx_packets.pop();
+    }
+}
+
+// tcp_task: write queued frames until the queue is empty or the socket buffer
+// is full. Never blocks: a short write leaves the rest of the frame for the
+// next round. Returns false if the connection failed.
+bool TCPClientInterface::flush_tx() {
+    int fd = _socket;
+#ifdef ARDUINO
+    const int flags = MSG_DONTWAIT;
 #else
-        ssize_t written = send(_socket, framed.data(), framed.size(), MSG_NOSIGNAL);
+    const int flags = MSG_DONTWAIT | MSG_NOSIGNAL;
+#endif
+    if (fd < 0) return false;
+
+    uint32_t frames = 0;
+    uint32_t payload_bytes = 0;
+    bool ok = true;
+    const uint8_t* pending;
+    size_t len;
+    while ((len = _tx_queue.peek(&pending)) > 0) {
+        ssize_t written = send(fd, pending, len, flags);
         if (written < 0) {
-            ERROR("TCPClientInterface: send error " + std::to_string(errno));
-            handle_disconnect();
-            return false;
+            int err = errno;
+            if (err == EINTR) continue;
+            if (err != EAGAIN && err != EWOULDBLOCK) {
+                ERROR("TCPClientInterface: send error " + std::to_string(err));
+                ok = false;
+            }
+            break;  // EAGAIN: socket buffer full, select() waits for room
         }
-        if (static_cast<size_t>(written) != framed.size()) {
-            ERROR("TCPClientInterface: Write incomplete, " + std::to_string(written) +
-                  " of " + std::to_string(framed.size()) + " bytes");
-            handle_disconnect();
-            return false;
+        Metrics::add(METRIC_TCP_TX_WRITES);
+        if (written > 0) _last_tx_progress = now_ms();
+        _tx_queue.consume(static_cast<size_t>(written), &frames, &payload_bytes);
+        if (static_cast<size_t>(written) < len) {
+            Metrics::add(METRIC_TCP_TX_PARTIAL_WRITES);
+            break;
         }
-#endif
+    }
 
-        // Perform post-send housekeeping
-        InterfaceImpl::handle_outgoing(data);
-        return true;
+    if (frames > 0) {
+        Metrics::add(METRIC_TCP_TX_PACKETS, frames);
+        Metrics::add(METRIC_TCP_TX_BYTES, payload_bytes);
+    }
+    _tx_congested.store(_tx_queue.congested(), std::memory_order_relaxed);
+    Metrics::set(METRIC_TCP_QUEUE_DEPTH, static_cast<int32_t>(_tx_queue.queued_frames() + _tx_packets.size()));
+    Metrics::set(METRIC_TCP_TX_QUEUE_BYTES, static_cast<int32_t>(_tx_queue.queued_bytes()));
+    return ok;
+}
 
-    } catch (std::exception& e) {
-        ERROR("TCPClientInterface: Exception during send: " + std::string(e.what()));
-        handle_disconnect();
+// tcp_task (or stop() after the join): drop everything waiting to be sent
+void TCPClientInterface::discard_tx() {
+    const uint8_t* data;
+    size_t len;
+    uint32_t discarded = 0;
+    while (_tx_packets.front(&data, &len)) {
+        _tx_packets.pop();
+        ++discarded;
     }
-    return false;
+    discarded += static_cast<uint32_t>(_tx_queue.queued_frames());
+    if (discarded > 0) {
+        Metrics::add(METRIC_TCP_TX_DROPS, discarded);
+    }
+    _tx_queue.clear();
+    _tx_congested.store(false, std::memory_order_relaxed);
+    Metrics::set(METRIC_TCP_QUEUE_DEPTH, 0);
+    Metrics::set(METRIC_TCP_TX_QUEUE_BYTES, 0);
 }
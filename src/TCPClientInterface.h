@@ -3,17 +3,20 @@
 #include <microReticulum/Interface.h>
 #include <microReticulum/Bytes.h>
 #include <microReticulum/Type.h>
+#include "HDLC.h"
+#include <SPSCPacketQueue.h>
+#include "TCPTxQueue.h"
+#include "TCPUpstreams.h"
 
 #ifdef ARDUINO
-#include <WiFi.h>
-#include <WiFiClient.h>
+#include <Arduino.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
-#include <atomic>
 #else
-#include <netinet/in.h>
+#include <thread>
 #endif
 
+#include <atomic>
 #include <stdint.h>
 #include <string>
 
@@ -27,12 +30,20 @@
  *
  * Features:
  * - Automatic reconnection with configurable retry interval
+ * - Several upstream hubs ("host[:port],host[:port]"): staggered parallel
+ *   connects ranked by measured connect RTT, immediate failover when the
+ *   active one drops or stalls, cached DNS (TCPUpstreams)
  * - TCP keepalive for connection health monitoring
  * - HDLC framing (0x7E flags with byte stuffing)
+ * - All socket I/O on tcp_task: the main loop only exchanges whole packets
+ *   with it through two SPSC queues and never waits on lwIP
+ * - Non-blocking TX: frames queue in TCPTxQueue and are flushed several per
+ *   send(), link packets ahead of announces; past the queue's high
+ *   watermark non-link packets are refused (tx_congested())
  *
  * Usage:
  *   TCPClientInterface* tcp = new TCPClientInterface("tcp0");
- *   tcp->set_target_host("192.168.1.100");
+ *   tcp->set_target_host("192.168.1.100");   // or "hub-a,hub-b:4242"
  *   tcp->set_target_port(4965);
  *   Interface interface(tcp);
  *   interface.start();
@@ -49,17 +60,41 @@ public:
     // but still bound the timeout and back off so a dead host doesn't busy-retry.
     static const uint32_t RECONNECT_WAIT_MS = 15000; // 15s between reconnect attempts
     static const uint32_t CONNECT_TIMEOUT_MS = 3000;  // 3s connect timeout (task-side)
+    static const uint32_t CONNECT_STAGGER_MS = 250;   // head start per rank (RFC 8305's attempt delay)
 
     // TCP keepalive parameters (match Python RNS)
     static const int TCP_KEEPIDLE_SEC = 5;
     static const int TCP_KEEPINTVL_SEC = 2;
     static const int TCP_KEEPCNT_PROBES = 12;
 
+    // One keepalive period (idle + every probe, 29s). An upstream that has
+    // taken none of our queued bytes for this long is stalled; with more than
+    // one upstream the interface fails over.
+    static const uint32_t STALE_CONNECTION_MS =
+        (TCP_KEEPIDLE_SEC + TCP_KEEPINTVL_SEC * TCP_KEEPCNT_PROBES) * 1000;
+
+    // TX queue (PSRAM). Urgent holds link traffic (LXST audio); bulk fills
+    // with announces and is what backs up behind a slow hub.
+    static const size_t TX_URGENT_BYTES = 8 * 1024;
+    static const size_t TX_BULK_BYTES = 16 * 1024;
+    static const size_t TX_MAX_FRAMES = 64;           // per priority
+
+    // Packets in flight between the main loop and tcp_task (PSRAM, HW_MTU slots)
+    static const size_t RX_PACKET_SLOTS = 64;
+    static const size_t RX_CHUNK = 512;               // recv() size on tcp_task
+    static const size_t TX_PACKET_SLOTS = 32;
+
+    // tcp_task's select() timeout; it is woken early for outgoing packets
+    // and stop(), so this only paces the idle loop
+    static const uint32_t IO_POLL_MS = 1000;
+
 public:
     TCPClientInterface(const char* name = "TCPClient");
     virtual ~TCPClientInterface();
 
-    // Configuration (call before start())
+    // Configuration (call before start()). host may be a comma-separated
+    // list of upstreams in preference order, each optionally host:port;
+    // port is the default for entries without one.
     void set_target_host(const std::string& host) { _target_host = host; }
     void set_target_port(int port) { _target_port = port; }
 
@@ -68,7 +103,18 @@ public:
     virtual void stop();
     virtual void loop();
 
+    // Bulk TX queue is above its high watermark (until it drains to the low
+    // one): non-link packets are refused, so callers can hold off announces
+    bool tx_congested() const { return _tx_congested.load(std::memory_order_relaxed); }
+
     virtual inline std::string toString() const {
+        // The upstream list is fixed while the task runs, so this is safe
+        // from the main loop
+        size_t active = _active_upstream.load();
+        if (active < _upstreams.size()) {
+            return "TCPClientInterface[" + _name + "/" + _upstreams[active].host + ":" +
+                   std::to_string(_upstreams[active].port) + "]";
+        }
         return "TCPClientInterface[" + _name + "/" + _target_host + ":" + std::to_string(_target_port) + "]";
     }
 
@@ -76,82 +122,78 @@ protected:
     virtual bool send_outgoing(const RNS::Bytes& data);
 
 private:
-    // Connection management
-    bool connect();
-    void disconnect();
-    void configure_socket();
-    void handle_disconnect();
-
+    // tcp_task owns the socket for its whole life: connect, select(), recv +
+    // HDLC decode, framing + send. The main loop only touches the two packet
+    // queues and the atomics below:
+    //   _rx_packets  tcp_task -> main loop   decoded packets for handle_incoming()
+    //   _tx_packets  main loop -> tcp_task   packets from send_outgoing(), which
+    //                                        then rings _wake_fd
+    // ARDUINO runs it as a FreeRTOS task on core 0, POSIX as a std::thread.
 #ifdef ARDUINO
-    // Only the blocking connect()/DNS runs on tcp_task so it can't stall the
-    // main loop (which froze the UI). read/write/frame all stay on the main loop
-    // (low latency, unchanged data path). _conn_state hands _client ownership
-    // between the two so they never touch the socket concurrently:
-    //   DISCONNECTED -> CONNECTING (task owns _client) -> CONNECTED (main loop
-    //   owns _client); main loop flips CONNECTED -> DISCONNECTED on a drop.
-    enum ConnState : uint8_t { DISCONNECTED = 0, CONNECTING = 1, CONNECTED = 2 };
     static void tcp_task(void* arg);
-    void task_loop();
     TaskHandle_t _task_handle = nullptr;
-    std::atomic<bool> _task_running{false};
     std::atomic<bool> _task_done{false};   // task sets this right before exit; stop() joins on it
-    std::atomic<uint8_t> _conn_state{DISCONNECTED};
+#else
+    std::thread _task_thread;
 #endif
+    void task_loop();
+    std::atomic<bool> _task_running{false};
 
-    // HDLC frame processing
-    void process_incoming();
-    void extract_and_process_frames();
-
-    // Target server
+    // tcp_task side
+    bool resolve(size_t upstream, uint32_t* addr);
+    int dial(size_t upstream, uint32_t addr);
+    bool connect();
+    void disconnect();
+    void configure_socket();
+    bool service_socket();
+    bool receive(int fd);
+    bool rx_room() const;
+    void process_received(const uint8_t* data, size_t len);
+    void drain_tx_packets();
+    bool flush_tx();
+    void discard_tx();
+
+    // Either side: wake tcp_task out of select()
+    void wake_task();
+
+    // Target server(s): the configured spec, parsed into _upstreams by start()
     std::string _target_host;
     int _target_port = DEFAULT_TCP_PORT;
+    RNS::TCPUpstreams _upstreams;
+    static const size_t NO_UPSTREAM = RNS::TCPUpstreams::MAX_UPSTREAMS;
+    std::atomic<size_t> _active_upstream{NO_UPSTREAM};  // set by tcp_task, read by toString()
 
-    // Connection state
-    bool _initiator = true;
-#ifdef ARDUINO
-    // Touched by both task_loop() (core 0) and handle_disconnect() (core 1).
-    std::atomic<uint32_t> _last_connect_attempt{0};
-#else
-    uint32_t _last_connect_attempt = 0;
-#endif
-#ifdef ARDUINO
+    // Connection state (tcp_task only, except where atomic)
+    std::atomic<bool> _connected{false};    // published by tcp_task; loop() mirrors it into _online
     std::atomic<bool> _reconnected{false};  // re-established after offline (task-set)
-#else
-    bool _reconnected = false;  // Set when connection re-established after being offline
-#endif
-    uint32_t _last_data_received = 0;  // Track last data receipt for stale connection detection
-    static const uint32_t STALE_CONNECTION_MS = 120000;  // Consider connection stale after 2 min no data
+    std::atomic<bool> _tx_congested{false}; // _tx_queue.congested(), published by tcp_task
+    std::atomic<bool> _rx_paused{false};    // tcp_task stopped reading; loop() wakes it
+    uint32_t _last_connect_attempt = 0;
+    uint32_t _last_data_received = 0;  // Track last data receipt
+    uint32_t _last_tx_progress = 0;    // Last time the TX queue was empty or the socket took bytes
 
 public:
     // Check and clear reconnection flag (for announcing after reconnect)
     bool check_reconnected() {
-#ifdef ARDUINO
         return _reconnected.exchange(false);
-#else
-        if (_reconnected) {
-            _reconnected = false;
-            return true;
-        }
-        return false;
-#endif
     }
 
 private:
 
-    // HDLC frame buffer for partial frame reassembly
-    RNS::Bytes _frame_buffer;
+    // Streaming HDLC decoder: unescapes received bytes into its own
+    // HW_MTU packet buffer as they arrive (tcp_task)
+    RNS::HDLCDecoder<HW_MTU> _rx_decoder;
 
-    // Read buffer for incoming data
-    RNS::Bytes _read_buffer;
+    // HDLC-framed packets waiting for the socket (tcp_task)
+    RNS::TCPTxQueue _tx_queue{TX_URGENT_BYTES, TX_BULK_BYTES, HW_MTU, TX_MAX_FRAMES};
 
-    // Platform-specific socket
-#ifdef ARDUINO
-    WiFiClient _client;
-    // WiFi credentials (for ESP32 WiFi connection)
-    std::string _wifi_ssid;
-    std::string _wifi_password;
-#else
+    // Packet hand-off between tcp_task and the main loop
+    RNS::SPSCPacketQueue _rx_packets{RX_PACKET_SLOTS, HW_MTU};
+    RNS::SPSCPacketQueue _tx_packets{TX_PACKET_SLOTS, HW_MTU};
+
+    // eventfd that send_outgoing()/stop() write to wake tcp_task's select()
+    int _wake_fd = -1;
+
+    // Connected socket (lwIP on ESP32), owned by tcp_task
     int _socket = -1;
-    in_addr_t _target_address = INADDR_NONE;
-#endif
 };
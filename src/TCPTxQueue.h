@@ -0,0 +1,203 @@
+#pragma once
+
+#include "HDLC.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef BOARD_HAS_PSRAM
+#include <esp_heap_caps.h>
+#endif
+
+namespace RNS {
+
+/**
+ * TCPTxQueue - bounded queue of HDLC-framed packets awaiting a TCP write.
+ *
+ * Packets are framed straight into one of two byte rings: URGENT (link
+ * traffic, e.g. LXST audio) and BULK (announces, path requests, everything
+ * else). peek() hands out as many whole frames as sit contiguously in the
+ * ring so one non-blocking send() can carry several; consume() takes however
+ * many bytes the socket accepted, so a short write resumes mid-frame on the
+ * next flush. Urgent frames go first, but never into the middle of a frame
+ * already partly on the wire: while urgent frames wait, a BULK peek stops at
+ * the end of the frame it is in.
+ *
+ * BULK has high/low watermarks (3/4 and 1/4 of its ring). Once it fills past
+ * the high mark, congested() is set and BULK pushes are refused until it
+ * drains below the low mark; URGENT pushes are only refused when their ring
+ * is full. Each ring keeps one maximum frame of slack past its end so a frame
+ * is always written contiguously and then wrapped.
+ *
+ * Single-threaded: push, peek and consume all run on the caller's loop.
+ */
+class TCPTxQueue {
+public:
+    enum Priority : uint8_t { URGENT = 0, BULK = 1 };
+
+    enum class Push : uint8_t {
+        QUEUED,
+        FULL,          // ring (or its frame slots) has no room
+        CONGESTED,     // BULK refused above the high watermark
+        TOO_BIG,       // payload larger than max_payload
+    };
+
+    TCPTxQueue(size_t urgent_bytes, size_t bulk_bytes, size_t max_payload, size_t max_frames)
+        : _max_frame(2 * max_payload + 2) {
+        init(_rings[URGENT], urgent_bytes, max_frames);
+        init(_rings[BULK], bulk_bytes, max_frames);
+        _bulk_high = bulk_bytes - bulk_bytes / 4;
+        _bulk_low = bulk_bytes / 4;
+    }
+
+    ~TCPTxQueue() {
+        for (Ring& r : _rings) {
+            free(r.buf);
+            free(r.frames);
+        }
+    }
+
+    TCPTxQueue(const TCPTxQueue&) = delete;
+    TCPTxQueue& operator=(const TCPTxQueue&) = delete;
+
+    bool valid() const {
+        return _rings[URGENT].buf && _rings[URGENT].frames && _rings[BULK].buf && _rings[BULK].frames;
+    }
+
+    /**
+     * URGENT for packets on an established link (destination type LINK),
+     * BULK otherwise. IFAC-masked headers can't be read, so they are BULK.
+     */
+    static Priority classify(const uint8_t* packet, size_t len) {
+        if (len < 1 || (packet[0] & 0x80)) return BULK;
+        return ((packet[0] >> 2) & 0x03) == 0x03 ? URGENT : BULK;
+    }
+
+    /**
+     * HDLC-frame payload into the ring for priority p. admitted: the packet
+     * was already accepted while the queue looked uncongested (a producer
+     * checking congested() on another thread), so only a full ring refuses it.
+     */
+    Push push(const uint8_t* payload, size_t len, Priority p, bool admitted = false) {
+        if (!valid()) return Push::FULL;
+        size_t frame_len = HDLC::frame_size(payload, len);
+        if (frame_len > _max_frame) return Push::TOO_BIG;
+
+        Ring& r = _rings[p];
+        if (p == BULK && _congested && !admitted) return Push::CONGESTED;
+        if (r.used + frame_len > r.capacity || r.count == r.max_frames) return Push::FULL;
+
+        size_t tail = (r.head + r.used) % r.capacity;
+        HDLC::frame_into(payload, len, r.buf + tail, frame_len);
+        if (tail + frame_len > r.capacity) {
+            // Written into the slack; move the overhang to the ring start
+            memcpy(r.buf, r.buf + r.capacity, tail + frame_len - r.capacity);
+        }
+        Frame& f = r.frames[(r.first + r.count) % r.max_frames];
+        f.wire = static_cast<uint16_t>(frame_len);
+        f.payload = static_cast<uint16_t>(len);
+        r.count++;
+        r.used += frame_len;
+        if (p == BULK && r.used >= _bulk_high) _congested = true;
+        return Push::QUEUED;
+    }
+
+    /**
+     * Next run of bytes to write: the rest of a partly written frame, then
+     * whole frames up to the ring's wrap point. Returns 0 when empty.
+     */
+    size_t peek(const uint8_t** data) {
+        if (_sent_in_frame == 0) {
+            _active = _rings[URGENT].count > 0 ? URGENT : BULK;
+        }
+        const Ring& r = _rings[_active];
+        if (r.count == 0) return 0;
+        size_t n = r.used < r.capacity - r.head ? r.used : r.capacity - r.head;
+        if (_active == BULK && _rings[URGENT].count > 0) {
+            size_t rest = r.frames[r.first].wire - _sent_in_frame;
+            if (rest < n) n = rest;
+        }
+        *data = r.buf + r.head;
+        return n;
+    }
+
+    /**
+     * Drop n bytes written from the last peek(). Adds the frames that are now
+     * completely written (and their payload bytes) to *frames / *payload_bytes.
+     */
+    void consume(size_t n, uint32_t* frames = nullptr, uint32_t* payload_bytes = nullptr) {
+        Ring& r = _rings[_active];
+        r.head = (r.head + n) % r.capacity;
+        r.used -= n;
+        while (n > 0) {
+            const Frame& f = r.frames[r.first];
+            size_t take = f.wire - _sent_in_frame;
+            if (take > n) take = n;
+            _sent_in_frame += take;
+            n -= take;
+            if (_sent_in_frame == f.wire) {
+                if (frames) (*frames)++;
+                if (payload_bytes) *payload_bytes += f.payload;
+                r.first = (r.first + 1) % r.max_frames;
+                r.count--;
+                _sent_in_frame = 0;
+            }
+        }
+        if (_active == BULK && _congested && r.used <= _bulk_low) _congested = false;
+    }
+
+    /** Drop everything, including a partly written frame (the link is gone). */
+    void clear() {
+        for (Ring& r : _rings) {
+            r.head = r.used = r.first = r.count = 0;
+        }
+        _sent_in_frame = 0;
+        _congested = false;
+    }
+
+    size_t queued_bytes() const { return _rings[URGENT].used + _rings[BULK].used; }
+    size_t queued_frames() const { return _rings[URGENT].count + _rings[BULK].count; }
+    size_t queued_frames(Priority p) const { return _rings[p].count; }
+    bool congested() const { return _congested; }
+
+private:
+    struct Frame {
+        uint16_t wire;       // framed length on the wire
+        uint16_t payload;    // packet length before framing
+    };
+
+    struct Ring {
+        uint8_t* buf = nullptr;     // capacity + one max frame of slack
+        size_t capacity = 0;
+        size_t head = 0;            // offset of the next byte to write
+        size_t used = 0;
+        Frame* frames = nullptr;    // lengths of queued frames, oldest first
+        size_t max_frames = 0;
+        size_t first = 0;
+        size_t count = 0;
+    };
+
+    void init(Ring& r, size_t bytes, size_t max_frames) {
+        r.capacity = bytes;
+        r.max_frames = max_frames;
+#ifdef BOARD_HAS_PSRAM
+        r.buf = static_cast<uint8_t*>(heap_caps_malloc(bytes + _max_frame, MALLOC_CAP_SPIRAM));
+        r.frames = static_cast<Frame*>(heap_caps_malloc(sizeof(Frame) * max_frames, MALLOC_CAP_SPIRAM));
+#else
+        r.buf = static_cast<uint8_t*>(malloc(bytes + _max_frame));
+        r.frames = static_cast<Frame*>(malloc(sizeof(Frame) * max_frames));
+#endif
+    }
+
+    const size_t _max_frame;
+    Ring _rings[2];
+    size_t _bulk_high = 0;
+    size_t _bulk_low = 0;
+    bool _congested = false;
+    Priority _active = URGENT;
+    size_t _sent_in_frame = 0;   // bytes of _active's oldest frame already written
+};
+
+}  // namespace RNS
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+namespace RNS {
+
+/**
+ * TCPUpstreams - ordered list of TCP hubs for TCPClientInterface failover.
+ *
+ * Configured as "host[:port][,host[:port]...]" (a plain host is a list of
+ * one). Each upstream keeps a smoothed connect RTT, a count of consecutive
+ * failures and a cached IPv4 address. rank() gives the dial order for the
+ * next (re)connect: fewest recent failures first, then lowest RTT; an
+ * upstream not measured yet goes ahead of measured ones with the same
+ * failure count so every hub gets measured, and ties keep list order.
+ *
+ * The RTT is the TCP handshake time seen by tcp_task: Reticulum's TCP
+ * framing has no echo, so it is the closest application-visible round
+ * trip to the hub. Times are caller-supplied milliseconds (millis()).
+ *
+ * Not thread-safe: configured before start(), then owned by tcp_task.
+ */
+class TCPUpstreams {
+public:
+    static const size_t MAX_UPSTREAMS = 4;
+    static const uint32_t DNS_TTL_MS = 5 * 60 * 1000;   // lwIP does not report record TTLs
+    static const uint8_t MAX_FAILURES = 8;              // saturates, ranking only
+
+    struct Upstream {
+        std::string host;
+        uint16_t port = 0;
+        uint32_t addr = 0;          // IPv4, network order; valid while resolved
+        uint32_t resolved_ms = 0;
+        bool resolved = false;
+        uint32_t srtt_ms = 0;       // smoothed connect RTT; 0 = not measured
+        uint8_t failures = 0;       // consecutive failed or stalled connections
+    };
+
+    /**
+     * Replace the list from spec. Entries without a port use default_port;
+     * empty entries, bad ports and entries past MAX_UPSTREAMS are skipped.
+     * Returns the number of upstreams.
+     */
+    size_t parse(const std::string& spec, uint16_t default_port) {
+        _count = 0;
+        size_t start = 0;
+        while (start <= spec.size() && _count < MAX_UPSTREAMS) {
+            size_t end = spec.find(',', start);
+            if (end == std::string::npos) end = spec.size();
+            std::string entry = trim(spec.substr(start, end - start));
+            start = end + 1;
+            if (entry.empty()) continue;
+
+            uint16_t port = default_port;
+            size_t colon = entry.rfind(':');
+            if (colon != std::string::npos) {
+                char* tail = nullptr;
+                long p = strtol(entry.c_str() + colon + 1, &tail, 10);
+                if (colon + 1 == entry.size() || *tail != '\0' || p <= 0 || p > 65535) continue;
+                port = static_cast<uint16_t>(p);
+                entry = trim(entry.substr(0, colon));
+                if (entry.empty()) continue;
+            }
+            _list[_count] = Upstream();
+            _list[_count].host = entry;
+            _list[_count].port = port;
+            _count++;
+        }
+        return _count;
+    }
+
+    size_t size() const { return _count; }
+    const Upstream& operator[](size_t i) const { return _list[i]; }
+
+    /** Cached address for upstream i if resolved less than DNS_TTL_MS ago. */
+    bool cached_address(size_t i, uint32_t now_ms, uint32_t* addr) const {
+        const Upstream& u = _list[i];
+        if (!u.resolved || now_ms - u.resolved_ms >= DNS_TTL_MS) return false;
+        *addr = u.addr;
+        return true;
+    }
+
+    void store_address(size_t i, uint32_t addr, uint32_t now_ms) {
+        _list[i].addr = addr;
+        _list[i].resolved_ms = now_ms;
+        _list[i].resolved = true;
+    }
+
+    /** Connected in rtt_ms: fold into the smoothed RTT (RFC 6298, alpha 1/8). */
+    void on_connected(size_t i, uint32_t rtt_ms) {
+        Upstream& u = _list[i];
+        if (rtt_ms == 0) rtt_ms = 1;   // 0 means unmeasured
+        u.srtt_ms = u.srtt_ms == 0 ? rtt_ms : u.srtt_ms - u.srtt_ms / 8 + rtt_ms / 8;
+        if (u.srtt_ms == 0) u.srtt_ms = 1;
+        u.failures = 0;
+    }
+
+    /**
+     * Connect failed, or the connection errored or stalled. forget_address
+     * drops the cached address (the connect itself failed, so DNS may have
+     * moved).
+     */
+    void on_failed(size_t i, bool forget_address) {
+        Upstream& u = _list[i];
+        if (u.failures < MAX_FAILURES) u.failures++;
+        if (forget_address) u.resolved = false;
+    }
+
+    /** Fill order[0..size()) with upstream indices in dial order. */
+    size_t rank(size_t* order) const {
+        for (size_t i = 0; i < _count; ++i) order[i] = i;
+        // Insertion sort: stable, and there are at most MAX_UPSTREAMS
+        for (size_t i = 1; i < _count; ++i) {
+            size_t v = order[i];
+            size_t j = i;
+            while (j > 0 && before(v, order[j - 1])) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = v;
+        }
+        return _count;
+    }
+
+private:
+    bool before(size_t a, size_t b) const {
+        const Upstream& x = _list[a];
+        const Upstream& y = _list[b];
+        if (x.failures != y.failures) return x.failures < y.failures;
+        return x.srtt_ms < y.srtt_ms;
+    }
+
+    static std::string trim(const std::string& s) {
+        size_t b = s.find_first_not_of(" \t");
+        if (b == std::string::npos) return std::string();
+        size_t e = s.find_last_not_of(" \t");
+        return s.substr(b, e - b + 1);
+    }
+
+    Upstream _list[MAX_UPSTREAMS];
+    size_t _count = 0;
+};
+
+}  // namespace RNS
@@ -77,6 +77,9 @@
 
 // Logging
 #include <microReticulum/Log.h>
+#include <BytesPool.h>
+#include <lv_mem_slab.h>
+#include <BootGraph.h>
 
 // SD Card access and logging
 #include <Hardware/TDeck/SDAccess.h>
@@ -102,6 +105,18 @@
 #include <Instrumentation/BootProfiler.h>
 #endif
 
+// Allocation trace capture (tdeck-alloctrace env; macros are no-ops otherwise)
+#include <Instrumentation/AllocTrace.h>
+
+// Loop step latency histograms (LOOP_STEP)
+#include <Instrumentation/LoopStats.h>
+
+// Cross-task timeline tracing (tdeck-trace env; macros are no-ops otherwise)
+#include <Instrumentation/EventTrace.h>
+
+// Counters/gauges/histograms registry (T:METRICS)
+#include <Instrumentation/Metrics.h>
+
 // Firmware version for web flasher detection
 #ifndef FIRMWARE_VERSION
 #define FIRMWARE_VERSION "dev"
@@ -698,6 +713,53 @@ void load_app_settings() {
     INFO(msg.c_str());
 }
 
+// BytesPool tier profile: slot counts learned from previous runs, applied
+// before Reticulum starts so the pool boots sized for this node's traffic
+// instead of growing under load. Grow-only across boots (element-wise max
+// with what was loaded); erase the "bytespool" NVS namespace to relearn.
+static RNS::BytesPoolProfile bytes_pool_profile;
+static const uint32_t BYTES_POOL_PROFILE_SAVE_INTERVAL = 600000;  // 10 minutes
+
+void load_bytes_pool_profile() {
+    Preferences prefs;
+    prefs.begin("bytespool", true);  // Read-only
+    RNS::BytesPoolProfile profile;
+    size_t len = prefs.getBytes("profile", &profile, sizeof(profile));
+    prefs.end();
+
+    if (len != sizeof(profile) || !RNS::BytesPool::instance().applyProfile(profile)) {
+        INFO("BytesPool: no learned profile, using compiled-in tier sizes");
+        return;
+    }
+    bytes_pool_profile = profile;
+    char buf[128];
+    snprintf(buf, sizeof(buf), "BytesPool: applied learned profile (slots %u/%u/%u/%u/%u/%u)",
+             profile.slots[0], profile.slots[1], profile.slots[2],
+             profile.slots[3], profile.slots[4], profile.slots[5]);
+    INFO(buf);
+}
+
+// Persist the learned profile if it grew. Returns true if NVS was written.
+bool save_bytes_pool_profile() {
+    RNS::BytesPoolProfile learned = RNS::BytesPool::instance().learnedProfile();
+    bool changed = bytes_pool_profile.magic != RNS::BytesPoolProfile::MAGIC;
+    for (size_t i = 0; i < RNS::BytesPoolConfig::TIER_COUNT; i++) {
+        if (learned.slots[i] > bytes_pool_profile.slots[i]) {
+            changed = true;
+        } else {
+            learned.slots[i] = bytes_pool_profile.slots[i];
+        }
+    }
+    if (!changed) return false;
+
+    Preferences prefs;
+    prefs.begin("bytespool", false);
+    bool ok = prefs.putBytes("profile", &learned, sizeof(learned)) == sizeof(learned);
+    prefs.end();
+    if (ok) bytes_pool_profile = learned;
+    return ok;
+}
+
 void setup_wifi() {
     // Check if WiFi credentials are configured
     if (app_settings.wifi_ssid.length() == 0) {
@@ -1198,6 +1260,14 @@ void setup_lxmf() {
         router->set_display_name(app_settings.display_name.c_str());
     }
 
+    std::string dest_hash = router->delivery_destination().hash().toHex();
+    std::string msg = "  Delivery destination: " + dest_hash;
+    INFO(msg.c_str());
+}
+
+// Boot-time announce, split out of setup_lxmf so the UI doesn't wait
+// behind the TCP settle delay (runs as its own BootGraph phase).
+void setup_lxmf_announce() {
     // Only do network stuff if TCP interface exists
     if (tcp_interface) {
         // Wait for TCP connection to stabilize before announcing
@@ -1219,10 +1289,6 @@ void setup_lxmf() {
     } else {
         WARNING("No TCP interface - network features disabled until WiFi configured");
     }
-
-    std::string dest_hash = router->delivery_destination().hash().toHex();
-    std::string msg = "  Delivery destination: " + dest_hash;
-    INFO(msg.c_str());
 }
 
 void setup_ui_manager() {
@@ -1409,6 +1475,7 @@ void setup_ui_manager() {
                     if (!auto_interface_impl) {
                         INFO("Creating new AutoInterface...");
                         auto_interface_impl = new AutoInterface("Auto");
+                        auto_interface_impl->set_socket_task(true);
                         auto_interface = new Interface(auto_interface_impl);
                     }
 
@@ -1506,6 +1573,9 @@ void start_auto_interface() {
     if (!auto_interface_impl) {
         INFO("Initializing AutoInterface (IPv6 peer discovery)...");
         auto_interface_impl = new AutoInterface("Auto");
+        // Sockets on their own task, so LVGL/persistence stalls in the
+        // main loop don't leave datagrams to overflow lwIP's buffers
+        auto_interface_impl->set_socket_task(true);
         auto_interface = new Interface(auto_interface_impl);
         if (!auto_interface->start()) {
             ERROR("Failed to initialize AutoInterface!");
@@ -1552,6 +1622,10 @@ void start_tcp_interface() {
 }
 
 void setup() {
+    // Start allocation tracing first so the trace covers boot-time heap layout
+    ALLOC_TRACE_INIT();
+    EVENT_TRACE_INIT();
+
     // Initialize serial
     Serial.begin(115200);
     delay(100);
@@ -1606,41 +1680,47 @@ void setup() {
         _dbg2.end();
     }
 
-    // Initialize hardware
-    BOOT_PROFILE_START("hardware");
-    setup_hardware();
-    BOOT_PROFILE_END("hardware");
+    // Create shared SPI bus mutex (display, LoRa, SD card all share SPI).
+    // Static so the boot phases below can reach it.
+    static SemaphoreHandle_t spi_mutex = xSemaphoreCreateMutex();
+    if (!spi_mutex) {
+        ERROR("Failed to create SPI bus mutex!");
+    }
 
-    // Initialize audio for notifications
-    BOOT_PROFILE_START("audio");
-    Notification::tone_init();
-    BOOT_PROFILE_END("audio");
+    // Boot runs as a dependency graph (BootGraph.h): independent phases run
+    // on both cores, and a phase starts as soon as the phases it depends on
+    // are done. LVGL phases are MAIN (loopTask only); the UI comes up as soon
+    // as LVGL and LXMF are ready, while GPS probing, the TCP settle before
+    // the first announce and other waits carry on on core 0.
+    RNS::BootGraph boot;
 
-    // Load application settings from NVS (before WiFi/GPS)
-    BOOT_PROFILE_START("settings");
-    load_app_settings();
-    BOOT_PROFILE_END("settings");
+    // LittleFS mount + I2C
+    const int hardware = boot.add("hardware", setup_hardware);
 
-    // Initialize GPS but DON'T block boot waiting for a fix. The 15s
-    // synchronous wait was 31% of boot on this hardware; GPS rarely
-    // cold-starts in 15s anyway, so we'd usually just eat the full
-    // timeout. Keep a small (500ms) opportunistic check in case GPS
-    // already has a fix from before the boot (warm restart). After
-    // boot, the main loop's per-tick gps.encode + a periodic
-    // try_gps_sync retry will pick up the time the moment it lands.
-    BOOT_PROFILE_START("gps");
-    setup_gps();
-    if (app_settings.gps_time_sync) {
-        INFO("\n=== Time Synchronization ===");
-        BOOT_PROFILE_WAIT_START("gps_sync");
-        if (!sync_time_from_gps(500)) {  // brief warm-restart check only
-            INFO("GPS time sync deferred (will retry async)");
-        }
-        BOOT_PROFILE_WAIT_END("gps_sync");
-    } else {
-        INFO("GPS time sync disabled in settings");
-    }
-    BOOT_PROFILE_END("gps");
+    // Application settings from NVS (before WiFi/GPS)
+    const int settings = boot.add("settings", []() {
+        load_app_settings();
+        load_bytes_pool_profile();
+    });
+
+    // Try SD card FIRST, before display claims pins — matches LilyGo init order.
+    // Uses global SPI (FSPI) with no competing peripheral on the bus.
+    const int sd_card = boot.add("sd_card", []() {
+        if (spi_mutex) {
+            if (Hardware::TDeck::SDAccess::init(spi_mutex)) {
+                INFO("SD card initialized on shared SPI bus");
+            } else {
+                INFO("SD card not available (no card inserted?)");
+            }
+        }
+    });
+
+    // LVGL and hardware drivers (keyboard/touch need I2C)
+    const int lvgl = boot.add("lvgl", []() {
+        // Set SPI mutex on Display before init (null-safe if mutex creation failed)
+        Hardware::TDeck::Display::set_spi_mutex(spi_mutex);
+        setup_lvgl_and_ui();
+    }, {hardware, sd_card}, RNS::BootGraph::MAIN);
 
     // Initialize WiFi non-blocking. Previously we'd block boot up to
     // 30s waiting for association; with a wrong password the device
@@ -1649,9 +1729,96 @@ void setup() {
     // last_wifi_connected -> wifi_connected transition (sets up TCP
     // interface and does NTP sync at that point), so blocking here
     // adds nothing except boot latency.
-    BOOT_PROFILE_START("wifi");
-    setup_wifi();
-    BOOT_PROFILE_END("wifi");
+    const int wifi = boot.add("wifi", setup_wifi, {settings});
+
+    // Reticulum (LoRa on the shared SPI bus; TCP/Auto start now if WiFi
+    // associated within setup_wifi's window). After lvgl: Display's panel
+    // init writes the bus without the SPI mutex, and without an SD card it
+    // is what calls SPI.begin()
+    const int reticulum = boot.add("reticulum", []() {
+        // Set SPI mutex on LoRa interface (before setup_reticulum creates it)
+        if (spi_mutex) {
+            SX1262Interface::set_spi_mutex(spi_mutex);
+        }
+        setup_reticulum();
+    }, {hardware, settings, sd_card, wifi, lvgl});
+
+    // Message store and router (SD archive tier needs the card)
+    const int lxmf = boot.add("lxmf", setup_lxmf, {reticulum, sd_card});
+
+    // UI manager builds the conversation list, then the LVGL render task
+    // takes over the display
+    const int ui = boot.add("ui_manager", []() {
+        setup_ui_manager();
+
+        // Now that UIManager has built screens and configured the active
+        // one, start the LVGL render task. Doing this any earlier means
+        // the LVGL task refreshes its empty default screen on top of the
+        // boot splash (visible flash to black), then later refreshes the
+        // real UI. Deferring keeps the splash on-screen until the first
+        // real frame.
+        //
+        // Core 1, priority 1 (same as loopTask — round-robin scheduling).
+        // Previously priority 2, but that starved loopTask of CPU time
+        // during heavy rendering, causing 30s WDT timeouts on loopTask.
+        if (!UI::LVGL::LVGLInit::start_task(1, 1)) {
+            ERROR("Failed to start LVGL task!");
+            while (1) delay(1000);
+        }
+        INFO("LVGL task started on core 1");
+
+        // Send initial LXST voice destination announce
+        if (ui_manager) {
+            ui_manager->announce_lxst();
+        }
+    }, {lxmf, lvgl}, RNS::BootGraph::MAIN);
+
+    // LXMF announce after the TCP settle delay; nothing waits on it. After
+    // ui_manager, whose LXST announce also goes through Transport
+    boot.add("lxmf_announce", setup_lxmf_announce, {lxmf, ui});
+
+    // Initialize GPS but DON'T block boot waiting for a fix. The 15s
+    // synchronous wait was 31% of boot on this hardware; GPS rarely
+    // cold-starts in 15s anyway, so we'd usually just eat the full
+    // timeout. Keep a small (500ms) opportunistic check in case GPS
+    // already has a fix from before the boot (warm restart). After
+    // boot, the main loop's per-tick gps.encode + a periodic
+    // try_gps_sync retry will pick up the time the moment it lands.
+    // Nothing depends on it: if WiFi associates first, on_wifi_connected
+    // starts NTP and a later GPS fix still sets the clock.
+    boot.add("gps", []() {
+        setup_gps();
+        if (app_settings.gps_time_sync) {
+            INFO("\n=== Time Synchronization ===");
+            BOOT_PROFILE_WAIT_START("gps_sync");
+            if (!sync_time_from_gps(500)) {  // brief warm-restart check only
+                INFO("GPS time sync deferred (will retry async)");
+            }
+            BOOT_PROFILE_WAIT_END("gps_sync");
+        } else {
+            INFO("GPS time sync disabled in settings");
+        }
+    }, {settings});
+
+    // Initialize audio for notifications
+    boot.add("audio", Notification::tone_init);
+
+    // Initialize SD logging (SDAccess already initialized above)
+    boot.add("sd_logging", []() {
+        if (Hardware::TDeck::SDAccess::is_ready()) {
+            if (Hardware::TDeck::SDLogger::init()) {
+                INFO("SD card logging active");
+            }
+        }
+    }, {sd_card});
+
+    if (!boot.run()) {
+        ERROR("Boot graph rejected (bad dependency)!");
+        while (1) delay(1000);
+    }
+#ifdef BOOT_PROFILING_ENABLED
+    RNS::Instrumentation::BootProfiler::reportGraph(boot);
+#endif
 
     // Log ESP reset reason after WiFi so it reaches UDP logs
     {
@@ -1675,80 +1842,6 @@ void setup() {
         }
     }
 
-    // Create shared SPI bus mutex (display, LoRa, SD card all share SPI)
-    SemaphoreHandle_t spi_mutex = xSemaphoreCreateMutex();
-    if (!spi_mutex) {
-        ERROR("Failed to create SPI bus mutex!");
-    }
-
-    // Try SD card FIRST, before display claims pins — matches LilyGo init order.
-    // Uses global SPI (FSPI) with no competing peripheral on the bus.
-    BOOT_PROFILE_START("sd_card");
-    if (spi_mutex) {
-        if (Hardware::TDeck::SDAccess::init(spi_mutex)) {
-            INFO("SD card initialized on shared SPI bus");
-        } else {
-            INFO("SD card not available (no card inserted?)");
-        }
-    }
-    BOOT_PROFILE_END("sd_card");
-
-    // Set SPI mutex on Display before init (null-safe if mutex creation failed)
-    Hardware::TDeck::Display::set_spi_mutex(spi_mutex);
-
-    // Initialize LVGL and hardware drivers
-    BOOT_PROFILE_START("lvgl");
-    setup_lvgl_and_ui();
-    BOOT_PROFILE_END("lvgl");
-
-    // Set SPI mutex on LoRa interface (before setup_reticulum creates it)
-    if (spi_mutex) {
-        SX1262Interface::set_spi_mutex(spi_mutex);
-    }
-
-    // Initialize Reticulum (includes LoRa on shared SPI bus)
-    BOOT_PROFILE_START("reticulum");
-    setup_reticulum();
-    BOOT_PROFILE_END("reticulum");
-
-    // Initialize SD logging (SDAccess already initialized above)
-    if (Hardware::TDeck::SDAccess::is_ready()) {
-        if (Hardware::TDeck::SDLogger::init()) {
-            INFO("SD card logging active");
-        }
-    }
-
-    // Initialize LXMF
-    BOOT_PROFILE_START("lxmf");
-    setup_lxmf();
-    BOOT_PROFILE_END("lxmf");
-
-    // Initialize UI manager
-    BOOT_PROFILE_START("ui_manager");
-    setup_ui_manager();
-    BOOT_PROFILE_END("ui_manager");
-
-    // Now that UIManager has built screens and configured the active
-    // one, start the LVGL render task. Doing this any earlier means
-    // the LVGL task refreshes its empty default screen on top of the
-    // boot splash (visible flash to black), then later refreshes the
-    // real UI. Deferring keeps the splash on-screen until the first
-    // real frame.
-    //
-    // Core 1, priority 1 (same as loopTask — round-robin scheduling).
-    // Previously priority 2, but that starved loopTask of CPU time
-    // during heavy rendering, causing 30s WDT timeouts on loopTask.
-    if (!UI::LVGL::LVGLInit::start_task(1, 1)) {
-        ERROR("Failed to start LVGL task!");
-        while (1) delay(1000);
-    }
-    INFO("LVGL task started on core 1");
-
-    // Send initial LXST voice destination announce
-    if (ui_manager) {
-        ui_manager->announce_lxst();
-    }
-
     // Register delivered callback to update message status in storage and UI
     router->register_delivered_callback([](LXMF::LXMessage& msg) {
         INFO(">>> APP DELIVERED CALLBACK ENTRY");
@@ -1841,8 +1934,17 @@ static String serial_cmd_buffer = "";
 // Written every loop iteration, printed in 5s heap diagnostic
 static volatile uint8_t loop_step = 0;
 
-// Feed WDT and advance loop step tracker
-#define LOOP_STEP(n) do { loop_step = (n); esp_task_wdt_reset(); } while(0)
+// Per-step latency histograms (T:LOOPSTATS); each LOOP_STEP closes the
+// previous step's timing. Step 0 is the loop head: OTA, serial commands
+// and the time between loop() calls.
+static RNS::Instrumentation::LoopStats& loop_stats = RNS::Instrumentation::LoopStats::instance();
+static const char* const LOOP_STEP_NAMES[RNS::Instrumentation::LoopStatsConfig::MAX_STEPS] = {
+    "head", "lvgl", "display", "wifi_reconnect", "reticulum", "persist", "tcp",
+    "lora", "ble", "router", "ui_manager", "memmon", "periodic", "screen",
+};
+
+// Feed WDT, advance loop step tracker and time the step just finished
+#define LOOP_STEP(n) do { loop_step = (n); loop_stats.step(n); esp_task_wdt_reset(); } while(0)
 
 #ifdef PYXIS_TEST_HOOKS
 // Test-hook serial command interface for the Mac-side harness. All
@@ -1865,6 +1967,29 @@ static volatile uint8_t loop_step = 0;
 //   T:SENDPROP <hex> <text>      — queue an outbound PROPAGATED message
 //   T:SYNCPROP                   — request_messages_from_propagation_node
 //   T:SYNCSTATE                  — print current PR_* sync state
+//   T:POOLSTATS [reset|save]     — BytesPool hit/miss totals, per-tier
+//                                  slots/high-water/growth, size histogram,
+//                                  buddy region split/merge/fragmentation
+//   T:LVMEM [reset]              — LVGL slab region: per-class pages/occupancy/
+//                                  peak/PSRAM fallbacks, fragmentation
+//   T:LOOPSTATS [reset|budget <ms>]
+//                                — per-LOOP_STEP count/p50/p99/max/overruns;
+//                                  reset histograms or set the stall budget
+//   T:CALL_LATENCY [ext on|off]  — per-stage LXST audio latency (count/mean
+//                                  of the lxst.* histograms); ext toggles
+//                                  the in-band TX-age extension
+//   T:METRICS [reset]            — every registered metric, one T:M line each
+//                                  (format in Instrumentation/Metrics.h);
+//                                  reset zeroes them for a soak baseline
+//   T:ALLOCTRACE [start|stop|clear|mark <n>|dump|udp]
+//                                — allocation trace ring (tdeck-alloctrace
+//                                  builds): status, control, or dump over
+//                                  serial hex / UDP :9997 for
+//                                  tools/alloc_trace/
+//   T:TRACE [start|stop|clear|mark <n>|dump]
+//                                — timeline trace rings (tdeck-trace builds):
+//                                  status, control, or binary dump for
+//                                  tools/trace/trace_to_perfetto.py
 static String hex_byte_to_string(const RNS::Bytes& b) { return String(b.toHex().c_str()); }
 
 static RNS::Bytes parse_hex_arg(const String& hex) {
@@ -2273,6 +2398,30 @@ static void handle_test_hook_command(const String& line) {
         if (profile < 16) Serial.print("0");
         Serial.println(String(profile, HEX));
     }
+    else if (cmd == "T:CALL_LATENCY") {
+        // T:CALL_LATENCY [ext on|off] — per-stage LXST audio latency from
+        // the lxst.* metrics histograms (T:METRICS has the buckets). One
+        // T:LAT line per stage; mean is sum/count. "ext on" makes pyxis
+        // send its TX age in-band so a pyxis (or loopback) receiver can
+        // fill lxst.mouth_to_ear_us. Zero with T:METRICS reset.
+        using namespace RNS::Instrumentation;
+        if (!ui_manager) { Serial.println("T:ERR no ui_manager"); return; }
+        String a = args; a.trim();
+        if (a == "ext on" || a == "ext off") {
+            ui_manager->test_call_set_timing_ext(a == "ext on");
+            Serial.println(a == "ext on" ? "T:OK ext=on" : "T:OK ext=off");
+            return;
+        }
+        if (a.length() > 0) { Serial.println("T:ERR usage: T:CALL_LATENCY [ext on|off]"); return; }
+        Serial.printf("T:OK ext=%s state=%s\n", ui_manager->test_call_get_timing_ext() ? "on" : "off",
+                      ui_manager->test_call_state_name());
+        for (int i = METRIC_LXST_TX_CAPTURE; i <= METRIC_LXST_MOUTH_TO_EAR; i++) {
+            MetricHistogramSnapshot st = Metrics::histogram(static_cast<MetricHistogram>(i));
+            Serial.printf("T:LAT %s n=%lu mean=%luus\n", Metrics::name(static_cast<MetricHistogram>(i)),
+                          (unsigned long)st.count,
+                          (unsigned long)(st.count ? st.sum_us / st.count : 0));
+        }
+    }
     else if (cmd == "T:SHOW") {
         // T:SHOW <name> — switch the UI to a named screen. Used by
         // scripts/screenshot.py --all to drive a full doc capture.
@@ -2553,6 +2702,261 @@ static void handle_test_hook_command(const String& line) {
         }
         Serial.println("REC_END");
     }
+    else if (cmd == "T:POOLSTATS") {
+        // T:POOLSTATS [reset|save] — dump BytesPool tuning state. `reset` clears the
+        // histogram/misses and restarts high-water tracking; `save` persists the
+        // learned profile now instead of waiting for the 10-minute save.
+        auto& pool = RNS::BytesPool::instance();
+        String a = args; a.trim();
+        if (a == "reset") {
+            pool.resetStats();
+            RNS::BuddyAllocator::instance().resetStats();
+            Serial.println("T:OK reset");
+            return;
+        }
+        if (a == "save") {
+            bool wrote = save_bytes_pool_profile();
+            Serial.println(wrote ? "T:OK saved" : "T:OK unchanged");
+            return;
+        }
+        Serial.printf("T:OK requests=%u hits=%u misses=%u fallbacks=%u reserve_left=%u\n",
+                      (unsigned)pool.total_requests(), (unsigned)pool.pool_hits(),
+                      (unsigned)pool.pool_misses(), (unsigned)pool.fallback_count(),
+                      (unsigned)pool.reserve_remaining());
+        RNS::BytesPoolProfile learned = pool.learnedProfile();
+        for (size_t i = 1; i <= RNS::BytesPoolConfig::TIER_COUNT; i++) {
+            auto st = pool.tierStats(static_cast<RNS::BytesPoolConfig::Tier>(i));
+            Serial.printf("T:POOL tier=%u slots=%u/%u in_use=%u hwm=%u misses=%u grown=%u learned=%u\n",
+                          (unsigned)st.capacity, (unsigned)st.slots, (unsigned)st.max_slots,
+                          (unsigned)st.in_use, (unsigned)st.high_water, (unsigned)st.misses,
+                          (unsigned)st.grown, (unsigned)learned.slots[i - 1]);
+        }
+        // Non-empty log2 buckets only: "<=N:count", ">64K" for the last
+        Serial.print("T:HIST");
+        for (size_t b = 0; b < RNS::BytesPoolConfig::HISTOGRAM_BUCKETS; b++) {
+            size_t n = pool.histogram(b);
+            if (n == 0) continue;
+            size_t bound = RNS::BytesPool::histogramBound(b);
+            if (bound) Serial.printf(" <=%u:%u", (unsigned)bound, (unsigned)n);
+            else Serial.printf(" >%u:%u",
+                               (unsigned)RNS::BytesPool::histogramBound(b - 1), (unsigned)n);
+        }
+        Serial.println();
+        RNS::BuddyStats buddy = RNS::BuddyAllocator::instance().stats();
+        Serial.printf("T:BUDDY region=%u used=%u peak=%u free=%u largest=%u frag=%u%% "
+                      "allocs=%u frees=%u fails=%u splits=%u merges=%u\n",
+                      (unsigned)buddy.region_bytes, (unsigned)buddy.bytes_in_use,
+                      (unsigned)buddy.peak_in_use, (unsigned)buddy.free_bytes,
+                      (unsigned)buddy.largest_free, (unsigned)buddy.fragmentation,
+                      (unsigned)buddy.allocations, (unsigned)buddy.frees,
+                      (unsigned)buddy.failures, (unsigned)buddy.splits, (unsigned)buddy.merges);
+    }
+    else if (cmd == "T:LVMEM") {
+        // T:LVMEM [reset] — LVGL slab allocator state. `reset` restarts peak
+        // tracking and clears fallback counters (e.g. before a UI churn run).
+        String a = args; a.trim();
+        if (a == "reset") {
+            lv_mem_slab_reset_peaks();
+            Serial.println("T:OK reset");
+            return;
+        }
+        lv_mem_slab_stats_t st;
+        lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT];
+        lv_mem_slab_get_stats(&st, classes);
+        Serial.printf("T:OK region=%u pages_free=%u/%u frag=%u%% large=%u\n",
+                      (unsigned)st.region_bytes, (unsigned)st.pages_free,
+                      (unsigned)st.pages_total, (unsigned)st.fragmentation,
+                      (unsigned)st.large_allocs);
+        for (size_t i = 0; i < LV_MEM_SLAB_CLASS_COUNT; i++) {
+            Serial.printf("T:LVMEM class=%u pages=%u in_use=%u/%u peak=%u fallbacks=%u\n",
+                          (unsigned)classes[i].block_size, (unsigned)classes[i].pages,
+                          (unsigned)classes[i].in_use, (unsigned)classes[i].blocks,
+                          (unsigned)classes[i].peak, (unsigned)classes[i].fallbacks);
+        }
+    }
+    else if (cmd == "T:LOOPSTATS") {
+        // T:LOOPSTATS [reset|budget <ms>] — loop step latency histograms.
+        // Percentiles are bucket upper edges (within ~25%); max is exact.
+        using RNS::Instrumentation::LoopStatsConfig;
+        String a = args; a.trim();
+        if (a == "reset") {
+            loop_stats.reset();
+            Serial.println("T:OK reset");
+            return;
+        }
+        if (a.startsWith("budget")) {
+            long ms = a.substring(6).toInt();
+            if (ms <= 0) {
+                Serial.println("T:ERR budget <ms>");
+                return;
+            }
+            loop_stats.setBudgetMs((uint32_t)ms);
+            Serial.printf("T:OK budget=%u\n", (unsigned)loop_stats.budgetMs());
+            return;
+        }
+        Serial.printf("T:OK budget=%ums\n", (unsigned)loop_stats.budgetMs());
+        for (uint8_t i = 0; i < LoopStatsConfig::MAX_STEPS; i++) {
+            auto st = loop_stats.stats(i);
+            if (st.count == 0) continue;
+            Serial.printf("T:LOOP step=%u name=%s n=%u p50=%uus p99=%uus max=%uus mean=%uus over=%u\n",
+                          (unsigned)i, LOOP_STEP_NAMES[i], (unsigned)st.count,
+                          (unsigned)st.p50_us, (unsigned)st.p99_us, (unsigned)st.max_us,
+                          (unsigned)(st.total_us / st.count), (unsigned)st.over_budget);
+        }
+    }
+    else if (cmd == "T:METRICS") {
+        // T:METRICS [reset] — dump the metrics registry. Sampled gauges (heap,
+        // BytesPool) are refreshed first; event-driven ones are already current.
+        using namespace RNS::Instrumentation;
+        String a = args; a.trim();
+        if (a == "reset") {
+            Metrics::reset();
+            Serial.println("T:OK reset");
+            return;
+        }
+        auto& pool = RNS::BytesPool::instance();
+        Metrics::set(METRIC_HEAP_INTERNAL_FREE,
+                     (int32_t)heap_caps_get_free_size(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+        Metrics::set(METRIC_HEAP_INTERNAL_LARGEST,
+                     (int32_t)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT));
+        Metrics::set(METRIC_HEAP_PSRAM_FREE, (int32_t)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+        Metrics::set(METRIC_POOL_HITS, (int32_t)pool.pool_hits());
+        Metrics::set(METRIC_POOL_MISSES, (int32_t)pool.pool_misses());
+        Metrics::set(METRIC_POOL_FALLBACKS, (int32_t)pool.fallback_count());
+        Metrics::dump([](const char* line, void*) { Serial.println(line); }, nullptr, millis());
+    }
+    else if (cmd == "T:ALLOCTRACE") {
+#ifdef ALLOC_TRACE_ENABLED
+        // T:ALLOCTRACE [start|stop|clear|mark <n>|dump|udp] — allocation trace ring.
+        // `dump` prints ATRACE_BEGIN <count> <dropped> <internal_free> <spiram_free>
+        // <byte_sum>, hex lines of 4 records, ATRACE_END. `udp` sends the same bytes
+        // (header + records) as [uint32 LE offset][<=1280 bytes] datagrams to :9997.
+        // Recording pauses while dumping so the snapshot isn't overwritten.
+        using RNS::Instrumentation::AllocTrace;
+        String a = args; a.trim();
+        if (a == "start") { AllocTrace::start(); Serial.println("T:OK started"); return; }
+        if (a == "stop") { AllocTrace::stop(); Serial.println("T:OK stopped"); return; }
+        if (a == "clear") { AllocTrace::clear(); Serial.println("T:OK cleared"); return; }
+        if (a.startsWith("mark")) {
+            uint32_t id = (uint32_t)a.substring(4).toInt();
+            AllocTrace::mark(RNS::Instrumentation::ALLOC_TRACE_MARK_USER + id);
+            Serial.println("T:OK marked");
+            return;
+        }
+        if (a == "dump" || a == "udp") {
+            bool was_running = AllocTrace::running();
+            AllocTrace::stop();
+            RNS::Instrumentation::AllocTraceHeader h = AllocTrace::header();
+            static RNS::Instrumentation::AllocTraceRecord chunk[80];   // 1280 bytes
+            if (a == "dump") {
+                uint32_t sum = 0;
+                for (size_t i = 0; i < h.count; ) {
+                    size_t n = AllocTrace::copyRecords(i, chunk, 80);
+                    if (n == 0) break;
+                    const uint8_t* b = (const uint8_t*)chunk;
+                    for (size_t k = 0; k < n * sizeof(chunk[0]); k++) sum += b[k];
+                    i += n;
+                }
+                Serial.printf("ATRACE_BEGIN %u %u %u %u %u\n", (unsigned)h.count,
+                              (unsigned)h.dropped, (unsigned)h.internal_free,
+                              (unsigned)h.spiram_free, (unsigned)sum);
+                static char line[4 * sizeof(chunk[0]) * 2 + 1];
+                for (size_t i = 0; i < h.count; ) {
+                    size_t n = AllocTrace::copyRecords(i, chunk, 4);
+                    if (n == 0) break;
+                    const uint8_t* b = (const uint8_t*)chunk;
+                    int p = 0;
+                    for (size_t k = 0; k < n * sizeof(chunk[0]); k++) p += sprintf(line + p, "%02X", b[k]);
+                    line[p] = 0; Serial.println(line);
+                    i += n;
+                }
+                Serial.println("ATRACE_END");
+            } else {
+                if (udp_log_sock < 0 || !udp_log_ready || WiFi.status() != WL_CONNECTED) {
+                    if (was_running) AllocTrace::start();
+                    Serial.println("T:ERR no UDP");
+                    return;
+                }
+                // Same host as the log stream (harness host or multicast group)
+                struct sockaddr_in dest = udp_log_dest;
+                dest.sin_port = htons(9997);
+                uint8_t dgram[4 + sizeof(chunk)];
+                uint32_t off = 0;
+                memcpy(dgram + 4, &h, sizeof(h));
+                size_t fill = sizeof(h);
+                size_t i = 0;
+                unsigned sent = 0;
+                while (true) {
+                    size_t room = (sizeof(dgram) - 4 - fill) / sizeof(chunk[0]);
+                    size_t n = AllocTrace::copyRecords(i, chunk, room);
+                    memcpy(dgram + 4 + fill, chunk, n * sizeof(chunk[0]));
+                    i += n;
+                    fill += n * sizeof(chunk[0]);
+                    if (fill == 0) break;
+                    memcpy(dgram, &off, 4);
+                    sendto(udp_log_sock, dgram, fill + 4, 0, (struct sockaddr*)&dest, sizeof(dest));
+                    off += fill;
+                    fill = 0;
+                    sent++;
+                    // Non-blocking socket: pace so lwIP's queue doesn't drop the tail
+                    delay(2);
+                    esp_task_wdt_reset();
+                }
+                Serial.printf("T:OK sent=%u bytes=%u\n", sent, (unsigned)off);
+            }
+            if (was_running) AllocTrace::start();
+            return;
+        }
+        RNS::Instrumentation::AllocTraceHeader h = AllocTrace::header();
+        Serial.printf("T:OK running=%u records=%u/%u dropped=%u\n",
+                      (unsigned)AllocTrace::running(), (unsigned)h.count,
+                      (unsigned)AllocTrace::capacity(), (unsigned)h.dropped);
+#else
+        Serial.println("T:ERR alloc trace not built (use env:tdeck-alloctrace)");
+#endif
+    }
+    else if (cmd == "T:TRACE") {
+#ifdef EVENT_TRACE_ENABLED
+        // T:TRACE [start|stop|clear|mark <n>|dump] — timeline trace rings.
+        // `dump` prints ETRACE_BEGIN <bytes> <byte_sum>, then exactly <bytes> of
+        // raw dump (EventTraceFormat.h), then a newline and ETRACE_END.
+        // Recording pauses while dumping so the rings hold still.
+        using RNS::Instrumentation::EventTrace;
+        String a = args; a.trim();
+        if (a == "start") { EventTrace::start(); Serial.println("T:OK started"); return; }
+        if (a == "stop") { EventTrace::stop(); Serial.println("T:OK stopped"); return; }
+        if (a == "clear") { EventTrace::clear(); Serial.println("T:OK cleared"); return; }
+        if (a.startsWith("mark")) {
+            EVENT_TRACE_INSTANT(USER, a.substring(4).toInt());
+            Serial.println("T:OK marked");
+            return;
+        }
+        if (a == "dump") {
+            bool was_running = EventTrace::running();
+            EventTrace::stop();
+            uint32_t sum = 0;
+            size_t bytes = EventTrace::dump([](const uint8_t* data, size_t len, void* ctx) {
+                uint32_t* s = static_cast<uint32_t*>(ctx);
+                for (size_t k = 0; k < len; k++) *s += data[k];
+            }, &sum);
+            Serial.printf("ETRACE_BEGIN %u %u\n", (unsigned)bytes, (unsigned)sum);
+            EventTrace::dump([](const uint8_t* data, size_t len, void*) {
+                Serial.write(data, len);
+                esp_task_wdt_reset();
+            }, nullptr);
+            Serial.println();
+            Serial.println("ETRACE_END");
+            if (was_running) EventTrace::start();
+            return;
+        }
+        RNS::Instrumentation::EventTraceHeader h = EventTrace::header();
+        Serial.printf("T:OK running=%u rings=%u bytes=%u lost=%u\n",
+                      (unsigned)EventTrace::running(), (unsigned)h.ring_count,
+                      (unsigned)EventTrace::dumpSize(), (unsigned)h.lost);
+#else
+        Serial.println("T:ERR event trace not built (use env:tdeck-trace)");
+#endif
+    }
     else {
         Serial.print("T:ERR unknown cmd ");
         Serial.println(cmd);
@@ -2560,8 +2964,19 @@ static void handle_test_hook_command(const String& line) {
 }
 #endif // PYXIS_TEST_HOOKS
 
+// Past the TCP TX queue's watermark, send_outgoing() already refuses
+// non-link packets itself, so the router and the other interfaces keep
+// running. Only an announce whose sole way out is TCP would be thrown away
+// whole; hold that one until the queue drains.
+static bool tcp_only_and_congested() {
+    if (!tcp_interface_impl || !tcp_interface_impl->tx_congested()) return false;
+    return !(lora_interface && lora_interface->online()) &&
+           !(ble_interface && ble_interface->online()) &&
+           !(auto_interface && auto_interface->online());
+}
+
 void loop() {
-    esp_task_wdt_reset();
+    LOOP_STEP(0);  // Loop head (OTA, serial commands)
 
     // Handle OTA updates (must be called frequently)
     ArduinoOTA.handle();
@@ -2631,7 +3046,10 @@ void loop() {
 
     // Process Reticulum
     LOOP_STEP(4);  // reticulum->loop()
-    reticulum->loop();
+    {
+        EVENT_TRACE_SCOPE(RETICULUM_LOOP);
+        reticulum->loop();
+    }
 
     // Pump TX audio immediately after Reticulum — low-latency path that
     // bypasses LVGL lock and all other loop steps.  No-ops when not in a call.
@@ -2702,7 +3120,7 @@ void loop() {
             bool has_online_interface = (tcp_interface && tcp_interface->online()) ||
                                         (lora_interface && lora_interface->online()) ||
                                         (ble_interface && ble_interface->online());
-            if (router && has_online_interface) {
+            if (router && has_online_interface && !tcp_only_and_congested()) {
                 router->announce();
                 if (ui_manager) {
                     ui_manager->announce_lxst();
@@ -2956,6 +3374,24 @@ void loop() {
             Serial.println(diag);
             udp_send(diag, n);
         }
+        // LVGL slab region (small UI objects); fallbacks = PSRAM spill
+        {
+            lv_mem_slab_stats_t st;
+            lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT];
+            lv_mem_slab_get_stats(&st, classes);
+            uint32_t in_use = 0, fallbacks = 0;
+            for (size_t i = 0; i < LV_MEM_SLAB_CLASS_COUNT; i++) {
+                in_use += classes[i].in_use;
+                fallbacks += classes[i].fallbacks;
+            }
+            char diag[128];
+            int n = snprintf(diag, sizeof(diag),
+                "[LVMEM] blocks=%u pages_free=%u/%u frag=%u%% fallbacks=%u",
+                (unsigned)in_use, (unsigned)st.pages_free, (unsigned)st.pages_total,
+                (unsigned)st.fragmentation, (unsigned)fallbacks);
+            Serial.println(diag);
+            udp_send(diag, n);
+        }
         Serial.flush();
 
         // Threshold warnings
@@ -3010,6 +3446,15 @@ void loop() {
         last_free_heap = free_heap;
     }
 
+    // Persist the BytesPool profile once it has learned something new
+    static uint32_t last_pool_profile_save = 0;
+    if (millis() - last_pool_profile_save > BYTES_POOL_PROFILE_SAVE_INTERVAL) {
+        last_pool_profile_save = millis();
+        if (save_bytes_pool_profile()) {
+            INFO("BytesPool: learned profile saved");
+        }
+    }
+
     // Small delay to prevent tight loop
     delay(5);
 }
@@ -0,0 +1,125 @@
+// Minimal micro-benchmark harness for tests/bench.
+//
+// Each bench_<suite>.cpp defines bench_body() and calls bench(...) once per
+// case; the shared main() times them and prints one JSON object on stdout:
+//
+//   {"suite": "hdlc", "results": {
+//     "calibrate.lcg": {"ns_per_op": 1.21, "iters": 16777216},
+//     "hdlc.escape_500b": {"ns_per_op": 812.4, "iters": 32768}, ...}}
+//
+// A case runs its body `iters` times per sample. iters doubles until one
+// sample takes TARGET_NS, then the fastest of REPEATS samples is reported
+// (the minimum is the least noisy estimator on a shared machine).
+//
+// Every suite also reports calibrate.lcg, a fixed integer workload timed
+// before and after the suite (the faster run is kept).
+// run_bench.py divides each case by its own binary's calibration so the
+// checked-in baseline survives a faster or slower host.
+//
+// Usage: bench_<suite> [--quick]    (--quick: 1 short sample per case,
+//                                    for the pytest smoke run)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace bench_detail {
+
+struct Result {
+    std::string name;
+    double ns_per_op;
+    uint64_t iters;
+};
+
+inline std::vector<Result>& results() {
+    static std::vector<Result> r;
+    return r;
+}
+
+inline bool& quick() {
+    static bool q = false;
+    return q;
+}
+
+inline double now_ns() {
+    return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // namespace bench_detail
+
+// Keep a value (or the memory behind a pointer) observable so the
+// optimiser cannot delete the work that produced it.
+template <typename T>
+inline void bench_keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+/**
+ * Time fn(iters) and record ns per iteration under `name`. fn must run its
+ * body exactly iters times; per-op setup belongs outside the loop.
+ */
+template <typename Fn>
+inline void bench(const char* name, Fn&& fn) {
+    using namespace bench_detail;
+    const double target_ns = quick() ? 2e6 : 50e6;
+    const int repeats = quick() ? 1 : 5;
+
+    uint64_t iters = 1;
+    double elapsed = 0;
+    for (;;) {
+        double t0 = now_ns();
+        fn(iters);
+        elapsed = now_ns() - t0;
+        if (elapsed >= target_ns || iters >= (1ull << 32)) break;
+        iters *= 2;
+    }
+    double best = elapsed;
+    for (int r = 1; r < repeats; r++) {
+        double t0 = now_ns();
+        fn(iters);
+        double e = now_ns() - t0;
+        if (e < best) best = e;
+    }
+    results().push_back({name, best / (double)iters, iters});
+}
+
+// Defined by each bench_<suite>.cpp
+extern const char* const BENCH_SUITE;
+void bench_body();
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--quick") == 0) bench_detail::quick() = true;
+    }
+
+    // Calibrate before and after the suite and keep the faster, so a burst
+    // of host load during one of them does not skew every ratio
+    auto calibrate = [](uint64_t iters) {
+        uint32_t x = 1;
+        for (uint64_t i = 0; i < iters; i++) {
+            x = x * 1664525u + 1013904223u;
+            bench_keep(x);
+        }
+    };
+    bench("calibrate.lcg", calibrate);
+    bench_body();
+    bench("calibrate.lcg", calibrate);
+    auto& all = bench_detail::results();
+    if (all.back().ns_per_op < all.front().ns_per_op) all.front() = all.back();
+    all.pop_back();
+
+    const auto& r = bench_detail::results();
+    std::printf("{\"suite\": \"%s\", \"results\": {", BENCH_SUITE);
+    for (size_t i = 0; i < r.size(); i++) {
+        std::printf("%s\n  \"%s\": {\"ns_per_op\": %.3f, \"iters\": %llu}", i ? "," : "",
+                    r[i].name.c_str(), r[i].ns_per_op, (unsigned long long)r[i].iters);
+    }
+    std::printf("}}\n");
+    return 0;
+}
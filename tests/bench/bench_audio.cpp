@@ -0,0 +1,64 @@
+// LXST audio hot paths that run per capture batch / playback frame:
+// VoiceFilterChain on the capture task, the encoded (PCM batch) ring
+// between capture and loopTask, and the PCM ring feeding I2S playback.
+//
+// Sizes match the call pipeline at Codec2 1600: 160-sample frames,
+// FRAMES_PER_BATCH=10 frames per capture batch (1600 samples).
+
+#include "../../lib/lxst_audio/audio_filters.h"
+#include "../../lib/lxst_audio/encoded_ring_buffer.h"
+#include "../../lib/lxst_audio/packet_ring_buffer.h"
+#include "bench.h"
+
+#include <cmath>
+
+const char* const BENCH_SUITE = "audio";
+
+static constexpr int FRAME_SAMPLES = 160;
+static constexpr int BATCH_SAMPLES = FRAME_SAMPLES * 10;
+
+void bench_body() {
+    // Speech-band tone plus low-frequency hum, around -12 dBFS
+    std::vector<int16_t> source(BATCH_SAMPLES);
+    for (int i = 0; i < BATCH_SAMPLES; i++) {
+        double t = i / 8000.0;
+        source[i] = (int16_t)(6000 * std::sin(2 * M_PI * 700 * t) + 2000 * std::sin(2 * M_PI * 60 * t));
+    }
+    std::vector<int16_t> work(BATCH_SAMPLES);
+
+    VoiceFilterChain chain(1, 300.0f, 3400.0f, -12.0f, 12.0f);
+    bench("audio.filter_chain_1600_samples", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            std::memcpy(work.data(), source.data(), sizeof(int16_t) * BATCH_SAMPLES);
+            chain.process(work.data(), BATCH_SAMPLES, 8000);
+            bench_keep(work[0]);
+        }
+    });
+
+    // One write + one read per op, so the ring never fills
+    EncodedRingBuffer encoded(8, BATCH_SAMPLES * (int)sizeof(int16_t));
+    const uint8_t* batch_bytes = reinterpret_cast<const uint8_t*>(source.data());
+    std::vector<uint8_t> batch_out(BATCH_SAMPLES * sizeof(int16_t));
+    bench("audio.encoded_ring_write_read_3200b", [&](uint64_t n) {
+        AudioStamp stamp;
+        int actual = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            stamp.origin_us = (uint32_t)i;
+            encoded.write(batch_bytes, BATCH_SAMPLES * (int)sizeof(int16_t), &stamp);
+            encoded.read(batch_out.data(), (int)batch_out.size(), &actual, &stamp);
+            bench_keep(batch_out[0]);
+        }
+    });
+
+    PacketRingBuffer pcm(50, FRAME_SAMPLES);
+    int16_t frame_out[FRAME_SAMPLES];
+    bench("audio.pcm_ring_write_read_160_samples", [&](uint64_t n) {
+        AudioStamp stamp;
+        for (uint64_t i = 0; i < n; i++) {
+            stamp.origin_us = (uint32_t)i;
+            pcm.write(source.data(), FRAME_SAMPLES, &stamp);
+            pcm.read(frame_out, FRAME_SAMPLES, &stamp);
+            bench_keep(frame_out[0]);
+        }
+    });
+}
@@ -0,0 +1,67 @@
+// BLE fragmentation hot path: every Reticulum packet over BLE is split into
+// MTU-sized fragments on TX and reassembled per peer on RX.
+//
+// A 500-byte packet at the default negotiated MTU (185) is 3 fragments, at
+// the minimum MTU (23) it is 25.
+
+#include "../../lib/ble_interface/BLEFragmenter.h"
+#include "../../lib/ble_interface/BLEReassembler.h"
+#include "Utilities/OS.h"
+#include "bench.h"
+
+using RNS::Bytes;
+using RNS::BLE::BLEFragmenter;
+using RNS::BLE::BLEReassembler;
+
+const char* const BENCH_SUITE = "ble_fragmenter";
+
+static Bytes make_payload(size_t n) {
+    Bytes b;
+    for (size_t i = 0; i < n; ++i) b.append((uint8_t)(i * 31));
+    return b;
+}
+
+static Bytes make_peer(uint8_t tag) {
+    Bytes id;
+    for (int i = 0; i < 16; ++i) id.append(tag);
+    return id;
+}
+
+void bench_body() {
+    const Bytes packet = make_payload(500);
+    BLEFragmenter frag185(185);
+    BLEFragmenter frag23(23);
+
+    bench("ble.fragment_500b_mtu185", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            auto frags = frag185.fragment(packet, (uint16_t)i);
+            bench_keep(frags);
+        }
+    });
+    bench("ble.fragment_500b_mtu23", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            auto frags = frag23.fragment(packet, (uint16_t)i);
+            bench_keep(frags);
+        }
+    });
+
+    // Reassembly: feed pre-built fragments; the callback fires once per packet
+    const auto frags185 = frag185.fragment(packet);
+    const auto frags23 = frag23.fragment(packet);
+    const Bytes peer = make_peer(0xA5);
+    BLEReassembler reassembler;
+    size_t delivered = 0;
+    reassembler.setReassemblyCallback([&](const Bytes&, const Bytes& pkt) { delivered += pkt.size(); });
+
+    bench("ble.reassemble_500b_mtu185", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            for (const auto& f : frags185) reassembler.processFragment(peer, f);
+        }
+    });
+    bench("ble.reassemble_500b_mtu23", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            for (const auto& f : frags23) reassembler.processFragment(peer, f);
+        }
+    });
+    bench_keep(delivered);
+}
@@ -0,0 +1,35 @@
+// BytesPool acquire/release: every RNS::Bytes allocation on the packet
+// path goes through it. Single-threaded; the 8-thread stress in
+// tests/native/test_bytes_pool.cpp covers contention.
+//
+// Each op holds a window of 4 buffers, matching the hash churn of a packet
+// walking through Transport.
+
+#include "../../lib/microreticulum-shim/BytesPool.h"
+#include "bench.h"
+
+using RNS::BytesPool;
+using RNS::PooledData;
+namespace Cfg = RNS::BytesPoolConfig;
+
+const char* const BENCH_SUITE = "bytes_pool";
+
+static void bench_size(const char* name, size_t size) {
+    auto& pool = BytesPool::instance();
+    bench(name, [&](uint64_t n) {
+        std::pair<PooledData*, Cfg::Tier> window[4] = {};
+        for (uint64_t i = 0; i < n; i++) {
+            auto& slot = window[i & 3];
+            if (slot.first) pool.release(slot.first, slot.second);
+            slot = pool.acquire(size);
+            bench_keep(slot.first);
+        }
+        for (auto& s : window) if (s.first) pool.release(s.first, s.second);
+    });
+}
+
+void bench_body() {
+    bench_size("bytes_pool.acquire_release_32b", 32);
+    bench_size("bytes_pool.acquire_release_500b", 500);
+    bench_size("bytes_pool.acquire_release_1500b", 1500);
+}
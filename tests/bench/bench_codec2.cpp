@@ -0,0 +1,49 @@
+// Codec2Wrapper encode/decode against the host codec2 library: the per-batch
+// CPU cost pump_call_tx and the playback decode path pay on loopTask.
+//
+// Host codec2 is the reference C build, not sh123/esp32_codec2, so this
+// tracks the wrapper and relative mode cost rather than T-Deck cycles.
+// Only built when run_bench.py finds codec2 (pkg-config or CODEC2_DIR).
+
+#include "../../lib/lxst_audio/codec_wrapper.h"
+#include "bench.h"
+
+#include <cmath>
+
+const char* const BENCH_SUITE = "codec2";
+
+static void bench_mode(const char* encode_name, const char* decode_name, int library_mode) {
+    Codec2Wrapper codec;
+    if (!codec.create(library_mode)) {
+        std::fprintf(stderr, "codec2 mode %d unavailable\n", library_mode);
+        return;
+    }
+    // One capture batch: FRAMES_PER_BATCH=10 codec frames
+    const int samples = codec.samplesPerFrame() * 10;
+    std::vector<int16_t> pcm(samples);
+    for (int i = 0; i < samples; i++) {
+        pcm[i] = (int16_t)(6000 * std::sin(2 * M_PI * 700 * i / 8000.0));
+    }
+    std::vector<uint8_t> encoded(1 + codec.bytesPerFrame() * 10);
+    std::vector<int16_t> decoded(samples);
+    const int encoded_len = codec.encode(pcm.data(), samples, encoded.data(), (int)encoded.size());
+
+    bench(encode_name, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            int len = codec.encode(pcm.data(), samples, encoded.data(), (int)encoded.size());
+            bench_keep(len);
+        }
+    });
+    bench(decode_name, [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            int len = codec.decode(encoded.data(), encoded_len, decoded.data(), samples);
+            bench_keep(len);
+        }
+    });
+}
+
+void bench_body() {
+    bench_mode("codec2.encode_3200_batch", "codec2.decode_3200_batch", 0);
+    bench_mode("codec2.encode_1600_batch", "codec2.decode_1600_batch", 2);
+    bench_mode("codec2.encode_700c_batch", "codec2.decode_700c_batch", 8);
+}
@@ -0,0 +1,161 @@
+// AutoInterface datagram I/O over IPv6 loopback: the old per-datagram
+// calls vs PeerFanout / DatagramBatch.
+//
+// TX: one 200-byte packet to each of 8 peers. per_datagram is the previous
+// send_outgoing(): a sockaddr_in6 built per peer and one sendto() each;
+// fanout is PeerFanout (one sendmmsg() from the prebuilt table on Linux).
+// The peers are real sockets on [::1], drained every 32 packets so sends
+// never land in a full buffer; both impls pay the same draining.
+//
+// RX: a socket is filled with 32 datagrams, then drained. per_datagram is
+// one recvfrom() each, batch is DatagramBatch. The fill is part of every
+// op for both impls.
+//
+// Prints "no IPv6 loopback" and exits 1 when [::1] is unavailable;
+// run_bench.py then skips the suite.
+
+#include "../../lib/auto_interface/DatagramBatch.h"
+#include "bench.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+
+const char* const BENCH_SUITE = "datagram";
+
+static const size_t PEERS = 8;
+static const size_t PACKET = 200;
+static const size_t ROUND = 32;       // packets between drains, datagrams per RX fill
+static const size_t MTU = 1196;
+
+static int bound_socket(uint16_t* port) {
+    int fd = socket(AF_INET6, SOCK_DGRAM, 0);
+    if (fd < 0) return -1;
+    int rcvbuf = 4 << 20;
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    struct sockaddr_in6 sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin6_family = AF_INET6;
+    sa.sin6_addr = in6addr_loopback;
+    socklen_t len = sizeof(sa);
+    if (bind(fd, (struct sockaddr*)&sa, sizeof(sa)) < 0 ||
+        getsockname(fd, (struct sockaddr*)&sa, &len) < 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    *port = ntohs(sa.sin6_port);
+    return fd;
+}
+
+static void drain(int fd) {
+    char buf[2048];
+    while (recv(fd, buf, sizeof(buf), MSG_DONTWAIT) >= 0) {}
+}
+
+// The previous send_outgoing() loop
+static size_t send_per_datagram(int fd, const std::vector<uint16_t>& ports, const uint8_t* data, size_t len) {
+    size_t sent = 0;
+    for (uint16_t port : ports) {
+        struct sockaddr_in6 peer_addr;
+        memset(&peer_addr, 0, sizeof(peer_addr));
+        peer_addr.sin6_family = AF_INET6;
+        peer_addr.sin6_port = htons(port);
+        peer_addr.sin6_addr = in6addr_loopback;
+        if (sendto(fd, data, len, 0, (struct sockaddr*)&peer_addr, sizeof(peer_addr)) >= 0) sent++;
+    }
+    return sent;
+}
+
+// The previous process_data() loop
+static size_t receive_per_datagram(int fd, uint8_t* buf, size_t cap) {
+    size_t n = 0;
+    struct sockaddr_in6 src;
+    for (;;) {
+        socklen_t src_len = sizeof(src);
+        if (recvfrom(fd, buf, cap, 0, (struct sockaddr*)&src, &src_len) <= 0) break;
+        n++;
+    }
+    return n;
+}
+
+void bench_body() {
+    std::vector<int> fds;
+    std::vector<uint16_t> ports;
+    for (size_t i = 0; i < PEERS + 1; i++) {
+        uint16_t port = 0;
+        int fd = bound_socket(&port);
+        if (fd < 0) {
+            std::printf("no IPv6 loopback\n");
+            std::exit(1);
+        }
+        fds.push_back(fd);
+        ports.push_back(port);
+    }
+    const int tx_fd = fds[PEERS];
+    const std::vector<uint16_t> peer_ports(ports.begin(), ports.begin() + PEERS);
+    const std::vector<uint8_t> payload(PACKET, 0x5A);
+
+    PeerFanout fanout;
+    for (uint16_t port : peer_ports) fanout.add((const uint8_t*)&in6addr_loopback, port, 0);
+
+    auto drain_peers = [&] {
+        for (size_t i = 0; i < PEERS; i++) drain(fds[i]);
+    };
+
+    bench("datagram.tx_per_datagram_8x200b", [&](uint64_t iters) {
+        size_t sent = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            sent += send_per_datagram(tx_fd, peer_ports, payload.data(), payload.size());
+            if (i % ROUND == ROUND - 1) drain_peers();
+        }
+        bench_keep(sent);
+        drain_peers();
+    });
+
+    bench("datagram.tx_fanout_8x200b", [&](uint64_t iters) {
+        size_t sent = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            sent += fanout.send(tx_fd, payload.data(), payload.size());
+            if (i % ROUND == ROUND - 1) drain_peers();
+        }
+        bench_keep(sent);
+        drain_peers();
+    });
+
+    struct sockaddr_in6 dst;
+    memset(&dst, 0, sizeof(dst));
+    dst.sin6_family = AF_INET6;
+    dst.sin6_addr = in6addr_loopback;
+    dst.sin6_port = htons(peer_ports[0]);
+    auto fill = [&] {
+        for (size_t p = 0; p < ROUND; p++) {
+            sendto(tx_fd, payload.data(), payload.size(), 0, (struct sockaddr*)&dst, sizeof(dst));
+        }
+    };
+
+    std::vector<uint8_t> rx_buf(MTU);
+    bench("datagram.rx_per_datagram_32x200b", [&](uint64_t iters) {
+        size_t got = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            fill();
+            got += receive_per_datagram(fds[0], rx_buf.data(), rx_buf.size());
+        }
+        bench_keep(got);
+    });
+
+    DatagramBatch batch(MTU);
+    bench("datagram.rx_batch_32x200b", [&](uint64_t iters) {
+        size_t got = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            fill();
+            size_t n;
+            while ((n = batch.receive(fds[0])) > 0) got += n;
+        }
+        bench_keep(got);
+    });
+
+    for (int fd : fds) close(fd);
+}
@@ -0,0 +1,101 @@
+// AutoInterface duplicate filter: every received datagram is checked
+// against the last 48 packet hashes seen within 0.75 s.
+//
+// Streams arrive at 4000 packets/s of clock time (a busy LAN with several
+// rnsd peers), so the window stays full and entries are displaced rather
+// than expired. "pairs" sends every packet twice, as when it reaches us over
+// two interfaces. deque_reference is the filter this replaced (Hash32
+// entries in a std::deque, linear scan, then a separate add). The SHA-256
+// itself is not included; the old path computed it twice per packet, the
+// new one once.
+
+#include "../../lib/auto_interface/PacketDedupWindow.h"
+#include "FixedHash.h"
+#include "bench.h"
+
+#include <deque>
+
+using RNS::Hash32;
+
+const char* const BENCH_SUITE = "dedup";
+
+static const size_t WINDOW = 48;
+static const double TTL = 0.75;
+static const double PACKET_SPACING = 1.0 / 4000;
+static const size_t STREAM = 4096;
+
+static std::vector<Hash32> make_hashes() {
+    std::vector<Hash32> hashes;
+    uint64_t x = 0x243F6A8885A308D3ull;
+    uint8_t h[32];
+    for (size_t i = 0; i < STREAM; i++) {
+        for (size_t b = 0; b < sizeof(h); b++) {
+            x = x * 6364136223846793005ull + 1442695040888963407ull;
+            h[b] = (uint8_t)(x >> 56);
+        }
+        hashes.emplace_back(h, sizeof(h));
+    }
+    return hashes;
+}
+
+// The old AutoInterface filter
+struct DequeReference {
+    struct Entry {
+        Hash32 hash;
+        double timestamp;
+    };
+    std::deque<Entry> entries;
+
+    bool check_and_add(const Hash32& hash, double now) {
+        while (!entries.empty() && now - entries.front().timestamp > TTL) entries.pop_front();
+        for (const auto& e : entries) {
+            if (e.hash == hash) return true;
+        }
+        entries.push_back({hash, now});
+        while (entries.size() > WINDOW) entries.pop_front();
+        return false;
+    }
+};
+
+void bench_body() {
+    const std::vector<Hash32> hashes = make_hashes();
+
+    bench("dedup.window_unique", [&](uint64_t n) {
+        PacketDedupWindow<WINDOW> w(TTL);
+        double now = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            const Hash32& h = hashes[i % STREAM];
+            bool dup = w.check_and_add(h.data(), h.size(), now);
+            bench_keep(dup);
+            now += PACKET_SPACING;
+        }
+    });
+    bench("dedup.window_pairs", [&](uint64_t n) {
+        PacketDedupWindow<WINDOW> w(TTL);
+        double now = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            const Hash32& h = hashes[(i / 2) % STREAM];
+            bool dup = w.check_and_add(h.data(), h.size(), now);
+            bench_keep(dup);
+            now += PACKET_SPACING;
+        }
+    });
+    bench("dedup.deque_reference_unique", [&](uint64_t n) {
+        DequeReference d;
+        double now = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            bool dup = d.check_and_add(hashes[i % STREAM], now);
+            bench_keep(dup);
+            now += PACKET_SPACING;
+        }
+    });
+    bench("dedup.deque_reference_pairs", [&](uint64_t n) {
+        DequeReference d;
+        double now = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            bool dup = d.check_and_add(hashes[(i / 2) % STREAM], now);
+            bench_keep(dup);
+            now += PACKET_SPACING;
+        }
+    });
+}
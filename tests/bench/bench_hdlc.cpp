@@ -0,0 +1,84 @@
+// HDLC framing hot path: every TCP and serial packet is escaped and framed
+// on TX and unescaped on RX.
+//
+// Payloads are pseudo-random bytes with ~1 in 128 needing an escape, a
+// clean one with none (the common case), and a worst case where every byte
+// does. Uses the tests/native Bytes shim, so
+// absolute numbers include std::vector appends rather than RNS::Bytes.
+
+#include "../../src/HDLC.h"
+#include "bench.h"
+
+using RNS::Bytes;
+using RNS::HDLC;
+using RNS::HDLCDecoder;
+
+const char* const BENCH_SUITE = "hdlc";
+
+static Bytes make_payload(size_t n, bool all_escapes) {
+    Bytes b;
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < n; i++) {
+        x = x * 1664525u + 1013904223u;
+        uint8_t v = (uint8_t)(x >> 24);
+        if (all_escapes) v = (i & 1) ? HDLC::FLAG : HDLC::ESC;
+        else if (v == HDLC::FLAG || v == HDLC::ESC) v ^= 0x01;
+        if (!all_escapes && (x & 0x7F) == 0) v = HDLC::FLAG;
+        b.append(v);
+    }
+    return b;
+}
+
+void bench_body() {
+    const Bytes mtu = make_payload(500, false);
+    const Bytes small = make_payload(64, false);
+    const Bytes worst = make_payload(500, true);
+    Bytes clean;
+    for (size_t i = 0; i < 500; i++) clean.append((uint8_t)(i % 0x70));
+    const Bytes mtu_escaped = HDLC::escape(mtu);
+
+    bench("hdlc.escape_64b", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::escape(small); bench_keep(out); }
+    });
+    bench("hdlc.escape_500b", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::escape(mtu); bench_keep(out); }
+    });
+    bench("hdlc.escape_500b_all_escaped", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::escape(worst); bench_keep(out); }
+    });
+    bench("hdlc.escape_500b_clean", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::escape(clean); bench_keep(out); }
+    });
+    bench("hdlc.unescape_500b", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::unescape(mtu_escaped); bench_keep(out); }
+    });
+    bench("hdlc.frame_500b", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) { Bytes out = HDLC::frame(mtu); bench_keep(out); }
+    });
+    // TCPClientInterface receive path: 8 framed packets fed in 256-byte reads
+    Bytes stream;
+    for (int k = 0; k < 8; k++) stream.append(HDLC::frame(mtu));
+    HDLCDecoder<1064> decoder;
+    bench("hdlc.decode_stream_500b", [&](uint64_t n) {
+        size_t bytes = 0;
+        for (uint64_t i = 0; i < n; i += 8) {
+            for (size_t off = 0; off < stream.size(); off += 256) {
+                size_t len = stream.size() - off < 256 ? stream.size() - off : 256;
+                decoder.feed(stream.data() + off, len, [&](const uint8_t* f, size_t flen) {
+                    bytes += flen;
+                    bench_keep(f[0]);
+                });
+            }
+        }
+        bench_keep(bytes);
+    });
+
+    // TCPClientInterface::send_outgoing path: frame into a reused buffer
+    uint8_t frame_buf[500 * 2 + 2];
+    bench("hdlc.frame_into_500b", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            size_t len = HDLC::frame_into(mtu.data(), mtu.size(), frame_buf, sizeof(frame_buf));
+            bench_keep(frame_buf[len - 1]);
+        }
+    });
+}
@@ -0,0 +1,99 @@
+// AutoInterface peer table at event-site scale: 300 peers on one segment,
+// each heard every ANNOUNCE_INTERVAL.
+//
+// discovery_300 is one discovery packet's add_or_refresh_peer() against a
+// full table, round-robin over the peers. loop_300 is one loop() pass of
+// expiry + reverse-peering bookkeeping when nothing is due (the common
+// case). vector_reference_* is the std::vector scan this replaced.
+
+#include "../../lib/auto_interface/AutoPeerTable.h"
+#include "bench.h"
+
+#include <vector>
+
+const char* const BENCH_SUITE = "peers";
+
+static const size_t PEERS = 300;
+static const double TIMEOUT = 22.0;
+static const double REVERSE_INTERVAL = 1.6 * 3.25;
+
+static struct in6_addr link_local(uint32_t id) {
+    struct in6_addr a;
+    memset(&a, 0, sizeof(a));
+    uint8_t* b = reinterpret_cast<uint8_t*>(&a);
+    b[0] = 0xfe;
+    b[1] = 0x80;
+    b[8] = 0x02;
+    b[11] = 0xff;
+    b[12] = 0xfe;
+    b[13] = (uint8_t)(id >> 16);
+    b[14] = (uint8_t)(id >> 8);
+    b[15] = (uint8_t)id;
+    return a;
+}
+
+void bench_body() {
+    std::vector<struct in6_addr> addrs;
+    for (uint32_t i = 0; i < PEERS; i++) addrs.push_back(link_local(0x1000 + i * 37));
+
+    AutoPeerTable table;
+    table.init(PEERS);
+    std::vector<AutoInterfacePeer> vec;
+    for (const auto& a : addrs) {
+        table.refresh_or_add(reinterpret_cast<const uint8_t*>(&a), AutoInterfacePeer(a, 42671, 0), 0);
+        vec.push_back(AutoInterfacePeer(a, 42671, 0));
+    }
+
+    bench("peers.discovery_300", [&](uint64_t n) {
+        double now = 1.0;
+        for (uint64_t i = 0; i < n; i++) {
+            const struct in6_addr& a = addrs[i % PEERS];
+            auto r = table.refresh_or_add(reinterpret_cast<const uint8_t*>(&a),
+                                          AutoInterfacePeer(a, 42671, now), now);
+            bench_keep(r);
+            now += 1e-6;
+        }
+    });
+    bench("peers.vector_reference_discovery_300", [&](uint64_t n) {
+        double now = 1.0;
+        for (uint64_t i = 0; i < n; i++) {
+            const struct in6_addr& a = addrs[i % PEERS];
+            for (auto& peer : vec) {
+                if (peer.same_address(a)) {
+                    peer.last_heard = now;
+                    break;
+                }
+            }
+            now += 1e-6;
+        }
+        bench_keep(vec);
+    });
+
+    // Everything heard and reverse-peered recently: nothing expires or is due
+    double now = 2.0;
+    table.due_outbound(now, REVERSE_INTERVAL, [](AutoInterfacePeer&) {});
+    for (auto& peer : vec) peer.last_outbound = now;
+    bench("peers.loop_300", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            size_t removed = table.expire(now, TIMEOUT, [](const AutoInterfacePeer&) {});
+            size_t due = table.due_outbound(now, REVERSE_INTERVAL, [](AutoInterfacePeer&) {});
+            bench_keep(removed);
+            bench_keep(due);
+        }
+    });
+    bench("peers.vector_reference_loop_300", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) {
+            size_t stale = 0;
+            size_t due = 0;
+            for (const auto& peer : vec) stale += now - peer.last_heard > TIMEOUT;
+            for (auto& peer : vec) {
+                if (now > peer.last_outbound + REVERSE_INTERVAL) {
+                    peer.last_outbound = now;
+                    due++;
+                }
+            }
+            bench_keep(stale);
+            bench_keep(due);
+        }
+    });
+}
@@ -0,0 +1,248 @@
+#!/usr/bin/env python3
+"""Build and run the pyxis native micro-benchmarks, compare against baseline.
+
+Run all suites and compare with the checked-in baseline (exit 1 on a
+regression beyond the threshold):
+    python3 tests/bench/run_bench.py
+
+Save the raw results, or accept the current numbers as the new baseline:
+    python3 tests/bench/run_bench.py -o results.json
+    python3 tests/bench/run_bench.py --update-baseline
+
+Each suite is one bench_<suite>.cpp compiled with the same g++/clang++
+wrapper pattern as tests/native, at -O2. Every suite also times a fixed
+integer workload (calibrate.lcg); comparisons use each case's ns/op divided
+by its own binary's calibration, so a faster or slower host does not read as
+a regression. Compiler and architecture still shift the ratios, so refresh
+the baseline when either changes (the host is recorded in baseline.json).
+Suites with an apparent regression are rerun once and each case keeps its
+faster result before anything is reported.
+
+The codec2 suite needs the host codec2 library: found via pkg-config, or
+CODEC2_DIR pointing at an install prefix (include/codec2, lib). Without it
+the suite is skipped and its baseline entries are not compared. The datagram
+suite is skipped the same way on a host without an IPv6 loopback.
+"""
+import argparse
+import json
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+from pathlib import Path
+
+HERE = Path(__file__).resolve().parent
+PYXIS_ROOT = HERE.parent.parent
+NATIVE = PYXIS_ROOT / "tests" / "native"
+SHIM = PYXIS_ROOT / "lib" / "microreticulum-shim"
+LXST = PYXIS_ROOT / "lib" / "lxst_audio"
+BLE = PYXIS_ROOT / "lib" / "ble_interface"
+AUTO = PYXIS_ROOT / "lib" / "auto_interface"
+BASELINE = HERE / "baseline.json"
+CALIBRATION = "calibrate.lcg"
+DEFAULT_THRESHOLD = 0.25
+
+# suite -> (extra include dirs, extra sources). tests/native supplies the
+# Bytes/Log/OS/heap_caps shims for every suite.
+SUITES = {
+    "hdlc": ([], []),
+    "ble_fragmenter": ([BLE, SHIM], [BLE / "BLEFragmenter.cpp", BLE / "BLEReassembler.cpp"]),
+    "audio": ([LXST], [LXST / "audio_filters.cpp", LXST / "encoded_ring_buffer.cpp",
+                       LXST / "packet_ring_buffer.cpp"]),
+    "codec2": ([LXST], [LXST / "codec_wrapper.cpp"]),
+    "bytes_pool": ([SHIM], []),
+    "dedup": ([AUTO, SHIM], []),
+    "peers": ([AUTO], []),
+    "datagram": ([AUTO], []),
+}
+
+
+def find_cxx():
+    """Pick a C++ compiler. Prefer clang++ (Mac default), fall back to g++."""
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    return None
+
+
+def codec2_flags():
+    """Compile/link flags for host codec2, or None if it is not installed."""
+    prefix = os.environ.get("CODEC2_DIR")
+    if prefix:
+        inc = Path(prefix) / "include" / "codec2"
+        if (inc / "codec2.h").exists():
+            lib = Path(prefix) / "lib"
+            return [f"-I{inc}"], [f"-L{lib}", f"-Wl,-rpath,{lib}", "-lcodec2"]
+    if shutil.which("pkg-config"):
+        cflags = subprocess.run(["pkg-config", "--cflags", "codec2"], capture_output=True, text=True)
+        libs = subprocess.run(["pkg-config", "--libs", "codec2"], capture_output=True, text=True)
+        if cflags.returncode == 0 and libs.returncode == 0:
+            return cflags.stdout.split(), libs.stdout.split()
+    return None
+
+
+def build(cxx, suite, out_dir):
+    """Compile bench_<suite>.cpp. Returns the binary path, or None if skipped."""
+    includes, sources = SUITES[suite]
+    cflags, ldflags = [], []
+    if suite == "codec2":
+        flags = codec2_flags()
+        if flags is None:
+            return None
+        cflags, ldflags = flags
+    binary = Path(out_dir) / f"bench_{suite}"
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        "-pthread",
+        f"-I{NATIVE}",
+        *[f"-I{d}" for d in includes],
+        *cflags,
+        str(HERE / f"bench_{suite}.cpp"),
+        *[str(s) for s in sources],
+        *ldflags,
+        "-o", str(binary),
+    ]
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    if result.returncode != 0:
+        raise RuntimeError(f"compilation failed:\n--- cmd ---\n{' '.join(cmd)}\n"
+                           f"--- stderr ---\n{result.stderr}")
+    return binary
+
+
+def run_suites(suites=None, quick=False):
+    """Build and run suites. Returns ({case: {ns_per_op, iters, ratio}}, [skipped])."""
+    cxx = find_cxx()
+    if cxx is None:
+        raise RuntimeError("no C++ compiler found")
+    results, skipped = {}, []
+    with tempfile.TemporaryDirectory() as tmp:
+        for suite in suites or SUITES:
+            binary = build(cxx, suite, tmp)
+            if binary is None:
+                skipped.append(suite)
+                continue
+            run = subprocess.run([str(binary)] + (["--quick"] if quick else []),
+                                 capture_output=True, text=True, timeout=600)
+            if run.returncode != 0 and "no IPv6 loopback" in run.stdout:
+                skipped.append(suite)
+                continue
+            if run.returncode != 0:
+                raise RuntimeError(f"bench_{suite} failed:\n{run.stdout}\n{run.stderr}")
+            # The JSON object is last; units may log to stdout before it
+            cases = json.loads(run.stdout[run.stdout.rindex('{"suite"'):])["results"]
+            calibration = cases.pop(CALIBRATION)["ns_per_op"]
+            for name, case in cases.items():
+                case["ratio"] = case["ns_per_op"] / calibration
+                results[name] = case
+    return results, skipped
+
+
+def suite_of(case):
+    """Map a case name back to its suite (case names are <prefix>.<what>)."""
+    prefix = case.split(".", 1)[0]
+    return {"ble": "ble_fragmenter"}.get(prefix, prefix)
+
+
+def compare(results, baseline, threshold, skipped=()):
+    """Return (regressions, missing): cases slower than baseline * (1 + threshold),
+    and baseline cases that did not run (outside skipped suites)."""
+    regressions, missing = [], []
+    for name, base in baseline["results"].items():
+        if name not in results:
+            if suite_of(name) not in skipped:
+                missing.append(name)
+            continue
+        change = results[name]["ratio"] / base["ratio"] - 1.0
+        if change > threshold:
+            regressions.append((name, change))
+    return regressions, missing
+
+
+def host_info(cxx):
+    version = subprocess.run([cxx, "--version"], capture_output=True, text=True).stdout
+    return {
+        "machine": platform.machine(),
+        "system": platform.system(),
+        "compiler": version.splitlines()[0] if version else cxx,
+    }
+
+
+def print_table(results, baseline):
+    base = baseline["results"] if baseline else {}
+    print(f"{'case':44} {'ns/op':>12} {'ratio':>9} {'vs base':>8}")
+    for name in sorted(results):
+        r = results[name]
+        delta = ""
+        if name in base:
+            delta = f"{(r['ratio'] / base[name]['ratio'] - 1.0) * 100:+.1f}%"
+        print(f"{name:44} {r['ns_per_op']:12.1f} {r['ratio']:9.2f} {delta:>8}")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("suites", nargs="*", help=f"suites to run (default: all of {', '.join(SUITES)})")
+    ap.add_argument("-o", "--output", help="write results JSON here")
+    ap.add_argument("--baseline", default=str(BASELINE))
+    ap.add_argument("--threshold", type=float,
+                    help=f"allowed slowdown as a fraction (default: baseline's, else {DEFAULT_THRESHOLD})")
+    ap.add_argument("--update-baseline", action="store_true",
+                    help="write these results as the new baseline instead of comparing")
+    ap.add_argument("--quick", action="store_true", help="one short sample per case (smoke run)")
+    args = ap.parse_args()
+    for suite in args.suites:
+        if suite not in SUITES:
+            ap.error(f"unknown suite {suite!r}")
+
+    results, skipped = run_suites(args.suites or None, quick=args.quick)
+    for suite in skipped:
+        print(f"skipped {suite}: not supported on this host", file=sys.stderr)
+
+    baseline = None
+    if Path(args.baseline).exists():
+        baseline = json.loads(Path(args.baseline).read_text())
+    print_table(results, baseline)
+
+    threshold = args.threshold
+    if threshold is None:
+        threshold = baseline.get("threshold", DEFAULT_THRESHOLD) if baseline else DEFAULT_THRESHOLD
+    doc = {"host": host_info(find_cxx()), "threshold": threshold, "results": results}
+    if args.output:
+        Path(args.output).write_text(json.dumps(doc, indent=2, sort_keys=True) + "\n")
+    if args.update_baseline:
+        Path(args.baseline).write_text(json.dumps(doc, indent=2, sort_keys=True) + "\n")
+        print(f"baseline written: {args.baseline}")
+        return 0
+    if baseline is None:
+        print(f"no baseline at {args.baseline}; run with --update-baseline", file=sys.stderr)
+        return 1
+
+    if baseline.get("host") != doc["host"]:
+        print(f"note: baseline host {baseline.get('host')} differs from {doc['host']}", file=sys.stderr)
+    not_run = skipped + [s for s in SUITES if args.suites and s not in args.suites]
+    regressions, missing = compare(results, baseline, threshold, not_run)
+    if regressions:
+        # Confirm before failing: rerun the suites involved and keep each
+        # case's faster ratio, so one noisy sample is not a regression
+        retry = sorted({suite_of(name) for name, _ in regressions})
+        print(f"rerunning {', '.join(retry)} to confirm", file=sys.stderr)
+        again, _ = run_suites(retry, quick=args.quick)
+        for name, case in again.items():
+            if case["ratio"] < results[name]["ratio"]:
+                results[name] = case
+        regressions, missing = compare(results, baseline, threshold, not_run)
+    for name in missing:
+        print(f"MISSING {name}: in baseline but not run", file=sys.stderr)
+    for name, change in regressions:
+        print(f"REGRESSION {name}: {change * 100:+.1f}% (threshold {threshold * 100:.0f}%)", file=sys.stderr)
+    return 1 if regressions or missing else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,52 @@
+"""Pytest smoke run of the native micro-benchmarks.
+
+Timing is machine-dependent, so this only checks every suite builds and runs
+(in --quick mode) and still covers the checked-in baseline, plus the
+comparison logic on fixed numbers. The regression gate itself is
+`python3 tests/bench/run_bench.py`.
+"""
+
+import json
+import sys
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+sys.path.insert(0, str(HERE))
+
+import run_bench  # noqa: E402
+
+
+def test_bench_suites_cover_baseline():
+    if run_bench.find_cxx() is None:
+        pytest.skip("no C++ compiler found")
+    results, skipped = run_bench.run_suites(quick=True)
+    print(json.dumps(results, indent=1))
+
+    baseline = json.loads(run_bench.BASELINE.read_text())
+    _, missing = run_bench.compare(results, baseline, threshold=float("inf"), skipped=skipped)
+    assert missing == [], f"baseline cases no longer run: {missing}"
+    for name in results:
+        assert name in baseline["results"], f"{name} not in baseline.json; run --update-baseline"
+        assert results[name]["ns_per_op"] > 0, name
+        assert run_bench.suite_of(name) in run_bench.SUITES, name
+
+
+def test_compare_flags_regressions_and_missing():
+    baseline = {"results": {
+        "hdlc.escape_500b": {"ratio": 100.0},
+        "hdlc.frame_500b": {"ratio": 100.0},
+        "ble.fragment_500b_mtu23": {"ratio": 100.0},
+        "codec2.encode_1600_batch": {"ratio": 100.0},
+    }}
+    results = {
+        "hdlc.escape_500b": {"ratio": 124.0},     # inside 25%
+        "hdlc.frame_500b": {"ratio": 130.0},      # regression
+    }
+    regressions, missing = run_bench.compare(results, baseline, 0.25, skipped=["codec2"])
+    assert [name for name, _ in regressions] == ["hdlc.frame_500b"]
+    assert abs(regressions[0][1] - 0.30) < 1e-9
+    # codec2 was skipped (no host library) so its cases are not missing
+    assert missing == ["ble.fragment_500b_mtu23"]
@@ -349,6 +349,52 @@ def poll_tdeck_rx(t, expected_substring, timeout=60):
     return None
 
 
+def scrape_metrics(t, timeout=10):
+    """Send `T:METRICS` and parse the `T:M` lines into {name: value}.
+
+    Counters and gauges map to ints; histograms to a dict of their
+    key=value fields (count, sum, cumulative le_* buckets). Returns None if
+    the dump never completed.
+    """
+    t.ser.write(b"T:METRICS\n")
+    metrics = {}
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        line = t.wait_for_line(
+            lambda L: L.startswith("T:M ") or L.startswith("T:OK metrics="),
+            timeout=max(0.1, deadline - time.time()))
+        if line is None:
+            break
+        if line.startswith("T:OK"):
+            return metrics
+        parts = line.split()
+        if len(parts) < 4:
+            continue
+        name, kind = parts[1], parts[2]
+        if kind == "histogram":
+            metrics[name] = {k: int(v) for k, v in (f.split("=", 1) for f in parts[3:])}
+        else:
+            metrics[name] = int(parts[3])
+    log("HARNESS", "T:METRICS did not complete")
+    return None
+
+
+def log_interface_metrics(metrics):
+    """One HARNESS line per interface that has seen traffic."""
+    for iface in ("auto", "tcp", "lora", "ble"):
+        p = f"iface.{iface}."
+        rx, tx = metrics.get(p + "rx_packets", 0), metrics.get(p + "tx_packets", 0)
+        if not rx and not tx:
+            continue
+        lat = metrics.get(p + "rx_latency_us", {})
+        mean = lat.get("sum", 0) // lat["count"] if lat.get("count") else 0
+        log("METRICS", f"{iface}: rx={rx} ({metrics.get(p + 'rx_bytes', 0)}B, "
+                       f"{metrics.get(p + 'rx_drops', 0)} dropped) "
+                       f"tx={tx} ({metrics.get(p + 'tx_bytes', 0)}B, "
+                       f"{metrics.get(p + 'tx_drops', 0)} dropped) "
+                       f"queue={metrics.get(p + 'queue_depth', 0)} rx_lat_mean={mean}us")
+
+
 def main():
     global _log_fh
     parser = argparse.ArgumentParser()
@@ -643,6 +689,10 @@ def main():
                 deadline = 0
                 break
 
+        metrics = scrape_metrics(t)
+        if metrics:
+            log_interface_metrics(metrics)
+
         time.sleep(args.cadence)
 
     log("HARNESS", f"Soak complete. successes={successes} fails={fails}")
@@ -26,8 +26,53 @@
 #ifndef ERROR
 #define ERROR(...)        ((void)0)
 #endif
+#ifndef NOTICE
+#define NOTICE(...)       ((void)0)
+#endif
+#ifndef VERBOSE
+#define VERBOSE(...)      ((void)0)
+#endif
+
+// printf-style variants (BytesPool, MemoryMonitor).
+#ifndef TRACEF
+#define TRACEF(...)       ((void)0)
+#endif
+#ifndef DEBUGF
+#define DEBUGF(...)       ((void)0)
+#endif
+#ifndef VERBOSEF
+#define VERBOSEF(...)     ((void)0)
+#endif
+#ifndef INFOF
+#define INFOF(...)        ((void)0)
+#endif
+#ifndef NOTICEF
+#define NOTICEF(...)      ((void)0)
+#endif
+#ifndef WARNINGF
+#define WARNINGF(...)     ((void)0)
+#endif
+#ifndef ERRORF
+#define ERRORF(...)       ((void)0)
+#endif
 
 namespace RNS {
+// Levels in microReticulum's order; tests always run at LOG_NONE, so
+// level-gated debug blocks compile but never run
+enum LogLevel {
+    LOG_NONE = 0,
+    LOG_CRITICAL,
+    LOG_ERROR,
+    LOG_WARNING,
+    LOG_NOTICE,
+    LOG_INFO,
+    LOG_VERBOSE,
+    LOG_DEBUG,
+    LOG_EXTREME,
+    LOG_MEM,
+};
+inline LogLevel loglevel() { return LOG_NONE; }
+
 namespace Log {
     inline void log(const char*) {}
     inline void log(const char*, ...) {}
@@ -0,0 +1,50 @@
+// Native-test shim for ESP-IDF's esp_heap_caps.h.
+//
+// Maps heap_caps_* onto malloc/realloc/free and counts calls per capability
+// (internal vs SPIRAM) so tests can check which heap an allocator routed a
+// request to. Only the calls pyxis allocators use are provided.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1u << 2)
+#define MALLOC_CAP_SPIRAM   (1u << 10)
+#define MALLOC_CAP_INTERNAL (1u << 11)
+
+struct heap_caps_shim_counters {
+    size_t internal_allocs;
+    size_t spiram_allocs;
+    size_t frees;
+};
+
+inline heap_caps_shim_counters& heap_caps_shim() {
+    static heap_caps_shim_counters counters = {0, 0, 0};
+    return counters;
+}
+
+inline void heap_caps_shim_count(uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) heap_caps_shim().spiram_allocs++;
+    else heap_caps_shim().internal_allocs++;
+}
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    heap_caps_shim_count(caps);
+    return malloc(size);
+}
+
+inline void* heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) {
+    heap_caps_shim_count(caps);
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void* heap_caps_realloc(void* ptr, size_t size, uint32_t caps) {
+    heap_caps_shim_count(caps);
+    return realloc(ptr, size);
+}
+
+inline void heap_caps_free(void* ptr) {
+    heap_caps_shim().frees++;
+    free(ptr);
+}
@@ -0,0 +1,110 @@
+// Host-side stand-in for RadioLib's SX1262, for the LoRa receive path tests.
+//
+// Models what LoRaReceiver relies on: one receive buffer, IRQ flags that
+// stay set until readData()/startReceive() clear them, and DIO1 as the OR
+// of the flags with the DIO1 action called on its rising edge (as RadioLib
+// attaches it). Every call that would be an SPI transaction on the device
+// is counted, so tests can check the bus is only touched after DIO1.
+//
+// The test thread plays the air side (receive(), raise_irq()); the
+// "LoRa task" side calls the RadioLib-named methods. The frame is published
+// with the IRQ flags (release/acquire), so the two may be different
+// threads as long as the air side waits for the re-arm (start_receive_calls)
+// before the next frame, as a real packet's airtime would.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class FakeLoRaRadio {
+public:
+    static const int16_t ERR_NONE = 0;                  // RADIOLIB_ERR_NONE
+    static const int16_t ERR_RX_TIMEOUT = -6;           // RADIOLIB_ERR_RX_TIMEOUT
+    static const int16_t ERR_CRC_MISMATCH = -7;         // RADIOLIB_ERR_CRC_MISMATCH
+    static const uint16_t IRQ_TX_DONE = 0x0001;         // RADIOLIB_SX126X_IRQ_*
+    static const uint16_t IRQ_RX_DONE = 0x0002;
+    static const uint16_t IRQ_HEADER_ERR = 0x0020;
+    static const uint16_t IRQ_CRC_ERR = 0x0040;
+
+    // ── RadioLib API (LoRa task side) ──
+
+    void setDio1Action(void (*func)(void)) { _action = func; }
+    void clearDio1Action() { _action = nullptr; }
+
+    uint16_t getIrqStatus() {
+        spi_transactions++;
+        return _irq.load(std::memory_order_acquire);
+    }
+
+    // Copies min(len, packet length) bytes and clears the IRQ flags, like
+    // SX126x::readData()
+    int16_t readData(uint8_t* data, size_t len) {
+        spi_transactions++;
+        read_calls++;
+        size_t n = _frame.size() < len ? _frame.size() : len;
+        memcpy(data, _frame.data(), n);
+        _irq.store(0, std::memory_order_release);
+        return _state;
+    }
+
+    size_t getPacketLength() {
+        spi_transactions++;
+        return _frame.size();
+    }
+
+    float getRSSI() {
+        spi_transactions++;
+        return _rssi;
+    }
+
+    float getSNR() {
+        spi_transactions++;
+        return _snr;
+    }
+
+    int16_t startReceive() {
+        spi_transactions++;
+        start_receive_calls++;
+        _irq.store(0, std::memory_order_release);
+        return start_receive_state;
+    }
+
+    // ── Air side (test) ──
+
+    /**
+     * A frame finished arriving: latch it with its RSSI/SNR and the status
+     * readData() will return, set RX done (plus CRC error when state says
+     * so) and raise DIO1.
+     */
+    void receive(const std::vector<uint8_t>& frame, float rssi, float snr, int16_t state = ERR_NONE) {
+        _frame = frame;
+        _rssi = rssi;
+        _snr = snr;
+        _state = state;
+        raise_irq(state == ERR_CRC_MISMATCH ? (IRQ_RX_DONE | IRQ_CRC_ERR) : IRQ_RX_DONE);
+    }
+
+    /** Set IRQ flags; DIO1's rising edge calls the action. */
+    void raise_irq(uint16_t flags) {
+        uint16_t before = _irq.fetch_or(flags, std::memory_order_acq_rel);
+        if (before == 0 && _action) _action();
+    }
+
+    bool dio1() const { return _irq.load(std::memory_order_acquire) != 0; }
+
+    std::atomic<uint32_t> spi_transactions{0};
+    std::atomic<uint32_t> read_calls{0};
+    std::atomic<uint32_t> start_receive_calls{0};
+    int16_t start_receive_state = ERR_NONE;
+
+private:
+    std::atomic<uint16_t> _irq{0};
+    void (*_action)(void) = nullptr;
+    std::vector<uint8_t> _frame;
+    float _rssi = 0.0f;
+    float _snr = 0.0f;
+    int16_t _state = ERR_NONE;
+};
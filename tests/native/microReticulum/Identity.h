@@ -0,0 +1,30 @@
+#pragma once
+// Native-test shim: Identity::full_hash() only. A 32-byte FNV-1a/splitmix
+// digest stands in for SHA-256; interface tests need it deterministic and
+// distinct per input, not cryptographic.
+#include "Bytes.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace RNS {
+
+class Identity {
+public:
+    static Bytes full_hash(const Bytes& data) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < data.size(); ++i) {
+            h ^= data.data()[i];
+            h *= 1099511628211ull;
+        }
+        uint8_t out[32];
+        for (size_t i = 0; i < sizeof(out); ++i) {
+            h ^= h >> 29;
+            h *= 0xBF58476D1CE4E5B9ull;
+            out[i] = static_cast<uint8_t>(h >> 56);
+        }
+        return Bytes(out, sizeof(out));
+    }
+};
+
+}  // namespace RNS
@@ -0,0 +1,40 @@
+#pragma once
+// Native-test shim for microReticulum's Interface.h: just the InterfaceImpl
+// members pyxis interfaces use. handle_incoming() keeps every packet so a
+// test can read back what the interface delivered (main loop side only).
+#include "Bytes.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RNS {
+
+class InterfaceImpl {
+public:
+    explicit InterfaceImpl(const char* name) : _name(name) {}
+    virtual ~InterfaceImpl() = default;
+
+    virtual bool start() { return true; }
+    virtual void stop() {}
+    virtual void loop() {}
+    virtual std::string toString() const { return "Interface[" + _name + "]"; }
+
+    bool online() const { return _online; }
+
+    std::vector<Bytes> incoming;
+
+protected:
+    virtual bool send_outgoing(const Bytes& data) { return false; }
+    void handle_incoming(const Bytes& data) { incoming.push_back(data); }
+    void handle_outgoing(const Bytes& data) {}
+
+    std::string _name;
+    bool _IN = false;
+    bool _OUT = false;
+    bool _online = false;
+    double _bitrate = 0;
+    uint32_t _HW_MTU = 0;
+};
+
+}  // namespace RNS
@@ -0,0 +1,3 @@
+#pragma once
+// Native-test shim: interfaces include Transport.h but the standalone
+// interface tests drive them directly, so nothing from it is needed.
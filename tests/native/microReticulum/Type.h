@@ -0,0 +1,12 @@
+#pragma once
+// Native-test shim: the microReticulum Type constants pyxis interfaces use.
+#include <cstddef>
+
+namespace RNS {
+namespace Type {
+namespace Reticulum {
+    // 2-byte header + one truncated (128-bit) destination hash
+    static const size_t HEADER_MINSIZE = 19;
+}  // namespace Reticulum
+}  // namespace Type
+}  // namespace RNS
@@ -0,0 +1,201 @@
+"""Tests for the host-side allocation trace tools (tools/alloc_trace/).
+
+Builds alloc_replay, feeds it synthetic traces in the firmware's dump format
+and checks routing, accounting and that candidate policies are told apart.
+Also round-trips the capture script's serial and UDP decoders.
+"""
+
+import random
+import shutil
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+PYXIS_ROOT = HERE.parent.parent
+SHIM = PYXIS_ROOT / "lib" / "microreticulum-shim"
+TOOLS = PYXIS_ROOT / "tools" / "alloc_trace"
+
+sys.path.insert(0, str(TOOLS))
+import capture_alloc_trace as capture  # noqa: E402
+
+
+OP_ALLOC, OP_FREE, OP_MARK = 1, 2, 3
+CAPS_DEFAULT, CAPS_INTERNAL, CAPS_SPIRAM = 0x1, 0x2, 0x4
+MARK_ANNOUNCE_SKIPPED = 2
+INTERNAL_BASE = 0x3FC90000
+PSRAM_BASE = 0x3D000000
+
+
+def _find_cxx():
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    pytest.skip("no C++ compiler found")
+
+
+def _compile(tmp_path, source, extra=()):
+    cxx = _find_cxx()
+    binary = tmp_path / source.stem
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        "-pthread",
+        *extra,
+        f"-I{HERE}",
+        f"-I{SHIM}",
+        str(source),
+        "-o", str(binary),
+    ]
+    compile_result = subprocess.run(cmd, capture_output=True, text=True)
+    assert compile_result.returncode == 0, (
+        f"compilation failed:\n--- cmd ---\n{' '.join(cmd)}\n"
+        f"--- stderr ---\n{compile_result.stderr}"
+    )
+    return binary
+
+
+def _record(t, op, caps, size, ptr=0, caller=0x42001234):
+    return struct.pack("<IIII", t, ptr, caller, (op << 28) | (caps << 24) | size)
+
+
+def _trace(records, internal_free, spiram_free, dropped=0):
+    return capture.build_header(len(records), dropped, internal_free, spiram_free) + b"".join(records)
+
+
+def _replay(binary, tmp_path, trace, *args):
+    path = tmp_path / "run.atrace"
+    path.write_bytes(trace)
+    result = subprocess.run([str(binary), str(path), *args],
+                            capture_output=True, text=True, timeout=60)
+    assert result.returncode == 0, result.stdout + result.stderr
+    rows = {}
+    lines = result.stdout.splitlines()
+    header = next(i for i, l in enumerate(lines) if l.startswith("policy"))
+    for line in lines[header + 1:]:
+        if not line.strip():
+            break
+        p = line.split()
+        rows[p[0]] = {
+            "allocs": int(p[1]), "fail": int(p[2]), "unk": int(p[3]),
+            "peak_used": int(p[4]), "min_free": int(p[5]), "min_big": int(p[6]),
+            "low": float(p[8].rstrip("%")), "slab": int(p[9]), "pool": int(p[10]),
+        }
+    return rows, result.stdout
+
+
+@pytest.fixture(scope="module")
+def replayer(tmp_path_factory):
+    return _compile(tmp_path_factory.mktemp("alloc_replay"), TOOLS / "alloc_replay.cpp", extra=("-O2",))
+
+
+def test_replay_routing_and_accounting(replayer, tmp_path):
+    recs = [
+        _record(1, OP_MARK, 0, 1),
+        _record(10, OP_ALLOC, CAPS_SPIRAM, 100000, PSRAM_BASE),
+        _record(20, OP_ALLOC, CAPS_DEFAULT, 8000, PSRAM_BASE + 0x20000),   # went to PSRAM
+        _record(30, OP_ALLOC, CAPS_DEFAULT, 1000, INTERNAL_BASE),          # stayed internal
+        _record(40, OP_FREE, CAPS_DEFAULT, 0, 0x3FCA0000),                 # before the trace
+        _record(50, OP_MARK, 0, MARK_ANNOUNCE_SKIPPED),
+        _record(60, OP_FREE, CAPS_DEFAULT, 0, INTERNAL_BASE),
+    ]
+    rows, out = _replay(replayer, tmp_path, _trace(recs, 65536, 1 << 20), "baseline")
+    base = rows["baseline"]
+    assert base["allocs"] == 3
+    assert base["fail"] == 0
+    assert base["unk"] == 1
+    assert base["peak_used"] == 1004          # only the 1000-byte block, plus its header
+    assert "mark=2" in out
+
+
+def test_replay_internal_failure_counted(replayer, tmp_path):
+    recs = [_record(1, OP_ALLOC, CAPS_INTERNAL, 6000, INTERNAL_BASE + i * 0x2000) for i in range(3)]
+    rows, _ = _replay(replayer, tmp_path, _trace(recs, 16384, 1 << 20), "baseline")
+    assert rows["baseline"]["allocs"] == 3
+    assert rows["baseline"]["fail"] == 1      # internal-only caps never fall back to PSRAM
+
+
+def _fragmenting_workload():
+    # Interleaved small/large buffers, free the large ones, then ask for 8KB:
+    # the small survivors pin the holes on the real heap
+    recs = []
+    t = 0
+    small = [INTERNAL_BASE + i * 0x40 for i in range(40)]
+    big = [INTERNAL_BASE + 0x8000 + i * 0x200 for i in range(40)]
+    for s, b in zip(small, big):
+        recs.append(_record(t, OP_ALLOC, CAPS_DEFAULT, 64, s)); t += 5
+        recs.append(_record(t, OP_ALLOC, CAPS_DEFAULT, 512, b)); t += 5
+    for b in big:
+        recs.append(_record(t, OP_FREE, CAPS_DEFAULT, 0, b)); t += 5
+    recs.append(_record(t, OP_ALLOC, CAPS_DEFAULT, 8192, INTERNAL_BASE + 0x10000))
+    recs.append(_record(t + 5, OP_MARK, 0, MARK_ANNOUNCE_SKIPPED))
+    return recs
+
+
+def test_replay_policies_reduce_fragmentation(replayer, tmp_path):
+    rows, out = _replay(replayer, tmp_path, _trace(_fragmenting_workload(), 32768, 1 << 20),
+                        "baseline", "slab:4096", "psram:256", "bytespool", "slab:4096+psram:256")
+    base = rows["baseline"]
+    assert base["fail"] == 0
+    assert base["min_big"] < 2048, out
+
+    assert rows["slab:4096"]["slab"] == 40
+    assert rows["slab:4096"]["min_big"] > base["min_big"], out
+    assert rows["psram:256"]["min_big"] > base["min_big"], out
+    assert rows["bytespool"]["pool"] == 80
+    assert rows["bytespool"]["min_big"] > base["min_big"], out
+    assert rows["slab:4096+psram:256"]["slab"] == 40
+    for row in rows.values():
+        assert row["allocs"] == 81
+
+    # At the skip mark the baseline heap can't hold an 8KB block; with the
+    # small objects in the slab the freed buffers coalesce again
+    at_mark = {l.split()[0]: int(l.split("max_block=")[1])
+               for l in out.splitlines() if "mark=2" in l}
+    assert at_mark["baseline"] < 8000
+    assert at_mark["slab:4096"] > 16384
+
+
+def test_replay_rejects_bad_input(replayer, tmp_path):
+    bad = tmp_path / "bad.atrace"
+    bad.write_bytes(b"\0" * 64)
+    result = subprocess.run([str(replayer), str(bad)], capture_output=True, text=True)
+    assert result.returncode != 0
+    good = tmp_path / "good.atrace"
+    good.write_bytes(_trace([], 1024, 1024))
+    result = subprocess.run([str(replayer), str(good), "nosuch:1"], capture_output=True, text=True)
+    assert result.returncode != 0
+
+
+def test_capture_serial_and_udp_decoders():
+    recs = _fragmenting_workload()
+    body = b"".join(recs)
+    expected = _trace(recs, 32768, 1 << 20, dropped=7)
+
+    lines = ["[HEAP] noise before the dump", "T:OK",
+             f"ATRACE_BEGIN {len(recs)} 7 32768 {1 << 20} {sum(body)}"]
+    lines += [body[i:i + 64].hex().upper() for i in range(0, len(body), 64)]
+    lines.append("ATRACE_END")
+    assert capture.parse_serial_dump(lines) == expected
+
+    corrupt = list(lines)
+    corrupt[3] = "FF" + corrupt[3][2:]
+    with pytest.raises(ValueError):
+        capture.parse_serial_dump(corrupt)
+    with pytest.raises(ValueError):
+        capture.parse_serial_dump(lines[:-1])
+
+    # Datagrams as the firmware sends them, delivered out of order
+    dgrams = []
+    for off in range(0, len(expected), 1280):
+        dgrams.append(struct.pack("<I", off) + expected[off:off + 1280])
+    random.Random(3).shuffle(dgrams)
+    assert capture.reassemble_udp(dgrams[:-1]) is None
+    assert capture.reassemble_udp(dgrams) == expected
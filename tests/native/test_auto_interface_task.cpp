@@ -0,0 +1,303 @@
+// Native AutoInterface socket task tests over the host's IPv6 link-local
+// address.
+//
+// The interface runs its real POSIX auto_task (std::thread, eventfd wake,
+// select()) and a sender in this process writes datagrams to its data
+// socket. Checked here:
+//   - while loop() isn't called, auto_task keeps taking datagrams off the
+//     socket; the next loop() hands them all to Transport, more than one
+//     poll-mode pass (RX_BUDGET) could read
+//   - with loop() stalled past RX_PACKET_SLOTS, auto_task pauses reading
+//     instead of dropping; loop() draining the queue resumes it and every
+//     datagram arrives once, intact and in order
+//   - stop() joins the task promptly, start() while running is a no-op,
+//     and stop()/start() brings the task back without stale packets
+//
+// Build: see test_auto_interface_task.py for the g++ invocation. Prints
+// "no IPv6 link-local address" and exits 0 when the host has none.
+
+#include "../../lib/auto_interface/AutoInterface.h"
+
+#include <Instrumentation/Metrics.h>
+
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using RNS::Bytes;
+using namespace RNS::Instrumentation;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsed_ms(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+}
+
+static void sleep_ms(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// ── link-local sender ──
+
+// The address AutoInterface binds its data socket to: the first link-local
+// address outside "lo", picked the same way get_link_local_address() does
+static bool find_link_local(sockaddr_in6* out) {
+    ifaddrs* ifaddr;
+    if (getifaddrs(&ifaddr) == -1) return false;
+    bool found = false;
+    for (ifaddrs* ifa = ifaddr; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_addr->sa_family != AF_INET6) continue;
+        if (strcmp(ifa->ifa_name, "lo") == 0) continue;
+        const sockaddr_in6* addr6 = reinterpret_cast<const sockaddr_in6*>(ifa->ifa_addr);
+        if (!IN6_IS_ADDR_LINKLOCAL(&addr6->sin6_addr)) continue;
+        memset(out, 0, sizeof(*out));
+        out->sin6_family = AF_INET6;
+        out->sin6_addr = addr6->sin6_addr;
+        out->sin6_scope_id = if_nametoindex(ifa->ifa_name);
+        found = true;
+        break;
+    }
+    freeifaddrs(ifaddr);
+    return found;
+}
+
+static sockaddr_in6 g_link_local;
+
+// Ports of our own so a running rnsd (or a parallel test) can't answer
+static const uint16_t DATA_PORT = static_cast<uint16_t>(43000 + getpid() % 8000);
+static const uint16_t DISCOVERY_PORT = static_cast<uint16_t>(DATA_PORT + 8000);
+
+class Sender {
+public:
+    Sender() {
+        _fd = socket(AF_INET6, SOCK_DGRAM, 0);
+        if (_fd < 0) throw std::runtime_error("sender: cannot create socket");
+        _to = g_link_local;
+        _to.sin6_port = htons(DATA_PORT);
+    }
+    ~Sender() { close(_fd); }
+
+    // Paced so the whole burst fits the data socket's receive buffer
+    void send(const std::vector<uint8_t>& p) {
+        if (sendto(_fd, p.data(), p.size(), 0, reinterpret_cast<const sockaddr*>(&_to),
+                   sizeof(_to)) != static_cast<ssize_t>(p.size())) {
+            throw std::runtime_error("sender: sendto failed");
+        }
+        if (++_sent % 16 == 0) sleep_ms(1);
+    }
+
+private:
+    int _fd = -1;
+    sockaddr_in6 _to;
+    size_t _sent = 0;
+};
+
+// ── interface under test ──
+
+struct Auto : AutoInterface {
+    Auto() : AutoInterface("test") {
+        set_group_id("pyxis-native-test");
+        set_data_port(DATA_PORT);
+        set_discovery_port(DISCOVERY_PORT);
+        set_socket_task(true);
+    }
+
+    // Call loop() until `count` packets have arrived in total
+    bool wait_incoming(size_t count, int timeout_ms = 10000) {
+        Clock::time_point t0 = Clock::now();
+        while (incoming.size() < count && elapsed_ms(t0) < timeout_ms) {
+            loop();
+            if (incoming.size() < count) sleep_ms(1);
+        }
+        return incoming.size() >= count;
+    }
+};
+
+// [tag][id:4][(id + i) ...], unique per (tag, id) so the dedup window
+// never drops one
+static std::vector<uint8_t> make_packet(uint8_t tag, uint32_t id, size_t len = 120) {
+    std::vector<uint8_t> p(len);
+    p[0] = tag;
+    memcpy(&p[1], &id, sizeof(id));
+    for (size_t i = 5; i < len; ++i) p[i] = static_cast<uint8_t>(id + i);
+    return p;
+}
+
+// incoming[first..first + n) are tag's packets 0..n-1, in order and intact
+static void expect_delivered(const Auto& a, size_t first, uint8_t tag, uint32_t n) {
+    EXPECT_TRUE(a.incoming.size() >= first + n);
+    for (uint32_t id = 0; id < n; ++id) {
+        std::vector<uint8_t> p = make_packet(tag, id);
+        const Bytes& b = a.incoming[first + id];
+        EXPECT_EQ(b.size(), p.size());
+        EXPECT_TRUE(memcmp(b.data(), p.data(), p.size()) == 0);
+    }
+}
+
+// ── tests ──
+
+static void task_delivers_while_loop_is_stalled() {
+    Auto a;
+    uint32_t rx_drops = Metrics::counter(METRIC_AUTO_RX_DROPS);
+    EXPECT_TRUE(a.start());
+    EXPECT_TRUE(a.online());
+
+    // Fewer than the queue holds, more than one poll-mode pass reads
+    const uint32_t n = AutoInterface::RX_BUDGET + AutoInterface::RX_PACKET_SLOTS / 4;
+    static_assert(AutoInterface::RX_BUDGET + AutoInterface::RX_PACKET_SLOTS / 4 <
+                      AutoInterface::RX_PACKET_SLOTS,
+                  "burst must fit the RX queue");
+    {
+        Sender s;
+        for (uint32_t id = 0; id < n; ++id) s.send(make_packet(1, id));
+    }
+    sleep_ms(300);
+    EXPECT_TRUE(a.incoming.empty());
+
+    // auto_task already has them queued: one pass hands over the lot
+    a.loop();
+    EXPECT_EQ(a.incoming.size(), (size_t)n);
+    expect_delivered(a, 0, 1, n);
+    EXPECT_EQ(Metrics::counter(METRIC_AUTO_RX_DROPS), rx_drops);
+    a.stop();
+}
+
+static void full_rx_queue_pauses_reads_instead_of_dropping() {
+    Auto a;
+    uint32_t rx_drops = Metrics::counter(METRIC_AUTO_RX_DROPS);
+    EXPECT_TRUE(a.start());
+
+    // Twice the queue's slots while loop() isn't called: auto_task fills
+    // _rx_packets, sets _rx_paused and leaves the rest in the socket buffer
+    const uint32_t n = AutoInterface::RX_PACKET_SLOTS * 2;
+    {
+        Sender s;
+        for (uint32_t id = 0; id < n; ++id) s.send(make_packet(2, id));
+    }
+    sleep_ms(300);
+    EXPECT_TRUE(a.incoming.empty());
+    EXPECT_EQ(Metrics::counter(METRIC_AUTO_RX_DROPS), rx_drops);
+
+    // One pass drains exactly what the queue held...
+    a.loop();
+    EXPECT_EQ(a.incoming.size(), (size_t)AutoInterface::RX_PACKET_SLOTS);
+
+    // ...and wakes the task, which picks the socket up where it paused
+    EXPECT_TRUE(a.wait_incoming(n));
+    sleep_ms(100);
+    a.loop();
+    EXPECT_EQ(a.incoming.size(), (size_t)n);
+    expect_delivered(a, 0, 2, n);
+    EXPECT_EQ(Metrics::counter(METRIC_AUTO_RX_DROPS), rx_drops);
+    a.stop();
+}
+
+static void stop_and_start_bring_the_task_back() {
+    Auto a;
+    EXPECT_TRUE(a.start());
+    // Already running: must not spawn a second task or reopen the sockets
+    EXPECT_TRUE(a.start());
+    {
+        Sender s;
+        for (uint32_t id = 0; id < 8; ++id) s.send(make_packet(3, id));
+    }
+    EXPECT_TRUE(a.wait_incoming(8));
+    expect_delivered(a, 0, 3, 8);
+
+    // Queued by the task but never delivered: gone with stop()
+    {
+        Sender s;
+        for (uint32_t id = 0; id < 8; ++id) s.send(make_packet(4, id));
+    }
+    sleep_ms(200);
+    Clock::time_point s0 = Clock::now();
+    a.stop();
+    EXPECT_TRUE(elapsed_ms(s0) < 2000);
+    EXPECT_TRUE(!a.online());
+    a.loop();
+    EXPECT_EQ(a.incoming.size(), (size_t)8);
+    a.stop();   // twice is harmless
+
+    for (int round = 0; round < 3; ++round) {
+        a.incoming.clear();
+        EXPECT_TRUE(a.start());
+        EXPECT_TRUE(a.online());
+        {
+            Sender s;
+            for (uint32_t id = 0; id < 16; ++id) s.send(make_packet(5 + round, id));
+        }
+        EXPECT_TRUE(a.wait_incoming(16));
+        sleep_ms(50);
+        a.loop();
+        EXPECT_EQ(a.incoming.size(), (size_t)16);
+        expect_delivered(a, 0, 5 + round, 16);
+        s0 = Clock::now();
+        a.stop();
+        EXPECT_TRUE(elapsed_ms(s0) < 2000);
+    }
+}
+
+int main() {
+    if (!find_link_local(&g_link_local)) {
+        std::printf("no IPv6 link-local address\n");
+        return 0;
+    }
+
+    RUN(task_delivers_while_loop_is_stalled);
+    RUN(full_rx_queue_pauses_reads_instead_of_dropping);
+    RUN(stop_and_start_bring_the_task_back);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
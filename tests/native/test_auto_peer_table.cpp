@@ -0,0 +1,273 @@
+// Native AutoPeerTable unit tests.
+//
+// AutoInterface's peer table: an address-keyed index plus last_heard and
+// last_outbound orderings. Checked here:
+//   - add, refresh and lookup by raw address; unknown addresses miss
+//   - expiry takes only peers past the timeout, oldest first, and refreshed
+//     peers survive
+//   - a full table evicts the least recently heard peer (LRU), reporting it
+//   - reverse peering visits only due peers, oldest first, new peers first
+//   - a 300-peer segment with churn and clock steps against a std::map
+//     model (probe runs survive backward-shift removal)
+//
+// Build: see test_auto_peer_table.py for the g++ invocation.
+
+#include "../../lib/auto_interface/AutoPeerTable.h"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+using Addr = std::array<uint8_t, 16>;
+
+// fe80::<interface id>, as on a WiFi segment
+static Addr link_local(uint32_t id) {
+    Addr a = {};
+    a[0] = 0xfe;
+    a[1] = 0x80;
+    a[8] = 0x02;
+    a[11] = 0xff;
+    a[12] = 0xfe;
+    a[13] = (uint8_t)(id >> 16);
+    a[14] = (uint8_t)(id >> 8);
+    a[15] = (uint8_t)id;
+    return a;
+}
+
+static AutoInterfacePeer make_peer(const Addr& a) {
+    struct in6_addr in;
+    memcpy(&in, a.data(), 16);
+    return AutoInterfacePeer(in, 42671, 0);
+}
+
+static AutoPeerTable::Add add(AutoPeerTable& t, uint32_t id, double now, AutoInterfacePeer* evicted = nullptr) {
+    Addr a = link_local(id);
+    return t.refresh_or_add(a.data(), make_peer(a), now, evicted);
+}
+
+static bool has(AutoPeerTable& t, uint32_t id) {
+    return t.find(link_local(id).data()) != nullptr;
+}
+
+static uint32_t id_of(const AutoInterfacePeer& p) {
+    const uint8_t* b = reinterpret_cast<const uint8_t*>(&p.address);
+    return ((uint32_t)b[13] << 16) | ((uint32_t)b[14] << 8) | b[15];
+}
+
+// ── tests ──
+
+static void add_refresh_and_find() {
+    AutoPeerTable t;
+    EXPECT_TRUE(add(t, 1, 0.0) == AutoPeerTable::Add::FULL);   // before init()
+    EXPECT_TRUE(t.init(8));
+    EXPECT_EQ(t.capacity(), (size_t)8);
+
+    EXPECT_TRUE(add(t, 1, 1.0) == AutoPeerTable::Add::ADDED);
+    EXPECT_TRUE(add(t, 2, 1.5) == AutoPeerTable::Add::ADDED);
+    EXPECT_TRUE(add(t, 1, 2.0) == AutoPeerTable::Add::REFRESHED);
+    EXPECT_EQ(t.size(), (size_t)2);
+
+    AutoInterfacePeer* p = t.find(link_local(1).data());
+    EXPECT_TRUE(p != nullptr);
+    EXPECT_EQ(p->last_heard, 2.0);
+    EXPECT_EQ(p->data_port, (uint16_t)42671);
+    EXPECT_EQ(id_of(*p), (uint32_t)1);
+    EXPECT_TRUE(!has(t, 3));
+
+    EXPECT_TRUE(t.erase(link_local(1).data()));
+    EXPECT_TRUE(!t.erase(link_local(1).data()));
+    EXPECT_TRUE(!has(t, 1));
+    EXPECT_TRUE(has(t, 2));
+    EXPECT_EQ(t.size(), (size_t)1);
+
+    t.clear();
+    EXPECT_EQ(t.size(), (size_t)0);
+    EXPECT_TRUE(!has(t, 2));
+}
+
+static void expire_takes_only_stale_peers_oldest_first() {
+    AutoPeerTable t;
+    t.init(16);
+    for (uint32_t id = 0; id < 5; id++) add(t, id, (double)id);
+    add(t, 0, 5.0);                          // refreshed: no longer oldest
+
+    std::vector<uint32_t> removed;
+    auto record = [&](const AutoInterfacePeer& p) { removed.push_back(id_of(p)); };
+    EXPECT_EQ(t.expire(10.0, 22.0, record), (size_t)0);
+    EXPECT_EQ(t.expire(24.5, 22.0, record), (size_t)2);   // heard at 1 and 2
+    EXPECT_EQ(removed.size(), (size_t)2);
+    EXPECT_EQ(removed[0], (uint32_t)1);
+    EXPECT_EQ(removed[1], (uint32_t)2);
+    EXPECT_TRUE(has(t, 0));
+    EXPECT_TRUE(has(t, 3));
+
+    removed.clear();
+    EXPECT_EQ(t.expire(26.0, 22.0, record), (size_t)1);  // 3; 4 is exactly 22 old
+    EXPECT_EQ(removed[0], (uint32_t)3);
+    EXPECT_TRUE(has(t, 4));
+    EXPECT_EQ(t.expire(100.0, 22.0, record), (size_t)2);
+    EXPECT_EQ(t.size(), (size_t)0);
+}
+
+static void full_table_evicts_least_recently_heard() {
+    AutoPeerTable t;
+    t.init(4);
+    for (uint32_t id = 0; id < 4; id++) add(t, id, (double)id);
+    add(t, 0, 10.0);                         // 1 is now least recently heard
+
+    AutoInterfacePeer evicted;
+    EXPECT_TRUE(add(t, 9, 11.0, &evicted) == AutoPeerTable::Add::EVICTED);
+    EXPECT_EQ(id_of(evicted), (uint32_t)1);
+    EXPECT_EQ(t.size(), (size_t)4);
+    EXPECT_TRUE(!has(t, 1));
+    EXPECT_TRUE(has(t, 0) && has(t, 2) && has(t, 3) && has(t, 9));
+
+    EXPECT_TRUE(add(t, 10, 12.0, &evicted) == AutoPeerTable::Add::EVICTED);
+    EXPECT_EQ(id_of(evicted), (uint32_t)2);
+}
+
+static void reverse_peering_visits_due_peers_oldest_first() {
+    AutoPeerTable t;
+    t.init(8);
+    const double interval = 5.2;
+    for (uint32_t id = 0; id < 3; id++) add(t, id, 0.0);
+
+    std::vector<uint32_t> sent;
+    auto send = [&](AutoInterfacePeer& p) { sent.push_back(id_of(p)); };
+    EXPECT_EQ(t.due_outbound(1.0, interval, send), (size_t)0);   // 1.0 > 0 + 5.2 is false
+    EXPECT_EQ(t.due_outbound(6.0, interval, send), (size_t)3);
+    EXPECT_EQ(t.find(link_local(2).data())->last_outbound, 6.0);
+
+    add(t, 7, 8.0);                          // new peer, never sent: due at once
+    sent.clear();
+    EXPECT_EQ(t.due_outbound(8.0, interval, send), (size_t)1);
+    EXPECT_EQ(sent[0], (uint32_t)7);
+    EXPECT_EQ(t.due_outbound(11.0, interval, send), (size_t)0);
+    EXPECT_EQ(t.due_outbound(11.5, interval, send), (size_t)3);
+
+    sent.clear();
+    EXPECT_EQ(t.due_outbound(12.0, interval, send), (size_t)0);
+    EXPECT_EQ(t.due_outbound(16.8, interval, send), (size_t)4);
+}
+
+static void churn_matches_map_model() {
+    struct Model {
+        double heard;
+        double outbound;
+    };
+    const size_t cap = 300;
+    std::map<uint32_t, Model> model;
+    AutoPeerTable t;
+    t.init(cap);
+    std::mt19937 rng(0xA070);
+
+    double now = 0;
+    for (int step = 0; step < 60000; step++) {
+        now += (rng() % 100) / 1000.0;
+        uint32_t r = rng() % 100;
+        if (r < 85) {
+            // Discovery from one of 400 nodes (more than the cap)
+            uint32_t id = rng() % 400;
+            AutoInterfacePeer evicted;
+            AutoPeerTable::Add res = add(t, id, now, &evicted);
+            auto it = model.find(id);
+            if (it != model.end()) {
+                EXPECT_TRUE(res == AutoPeerTable::Add::REFRESHED);
+                it->second.heard = now;
+            } else {
+                if (model.size() == cap) {
+                    EXPECT_TRUE(res == AutoPeerTable::Add::EVICTED);
+                    auto oldest = model.begin();
+                    for (auto m = model.begin(); m != model.end(); ++m) {
+                        if (m->second.heard < oldest->second.heard) oldest = m;
+                    }
+                    EXPECT_EQ(id_of(evicted), oldest->first);
+                    model.erase(oldest);
+                } else {
+                    EXPECT_TRUE(res == AutoPeerTable::Add::ADDED);
+                }
+                model[id] = Model{now, 0};
+            }
+        } else if (r < 95) {
+            size_t expected = 0;
+            for (auto m = model.begin(); m != model.end();) {
+                if (now - m->second.heard > 22.0) { m = model.erase(m); expected++; }
+                else ++m;
+            }
+            EXPECT_EQ(t.expire(now, 22.0, [](const AutoInterfacePeer&) {}), expected);
+        } else {
+            size_t expected = 0;
+            for (auto& m : model) {
+                if (now > m.second.outbound + 5.2) { m.second.outbound = now; expected++; }
+            }
+            EXPECT_EQ(t.due_outbound(now, 5.2, [](AutoInterfacePeer&) {}), expected);
+        }
+        EXPECT_EQ(t.size(), model.size());
+        if (step % 997 == 0) {
+            for (uint32_t id = 0; id < 400; id++) EXPECT_EQ(has(t, id), model.count(id) == 1);
+            size_t visited = 0;
+            t.for_each([&](const AutoInterfacePeer& p) {
+                visited++;
+                EXPECT_TRUE(model.count(id_of(p)) == 1);
+            });
+            EXPECT_EQ(visited, model.size());
+        }
+    }
+    EXPECT_TRUE(model.size() > 100);
+}
+
+int main() {
+    RUN(add_refresh_and_find);
+    RUN(expire_takes_only_stale_peers_oldest_first);
+    RUN(full_table_evicts_least_recently_heard);
+    RUN(reverse_peering_visits_due_peers_oldest_first);
+    RUN(churn_matches_map_model);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -11,6 +11,8 @@
 //   - fragment-without-START (orphan) rejection
 //   - per-peer isolation (one peer's reassembly doesn't bleed into another's)
 //   - MTU change between packets
+//   - burst of more concurrent peers than one slab holds: the session pool
+//     grows, then returns idle slabs after its quiet period
 
 #include "../../lib/ble_interface/BLEFragmenter.h"
 #include "../../lib/ble_interface/BLEReassembler.h"
@@ -295,6 +297,46 @@ static void clear_for_peer_drops_only_that_peer() {
     EXPECT_TRUE(r.hasPending(peer_b));
 }
 
+static void burst_of_peers_grows_then_trims_pool() {
+    RNS::Utilities::OS::set_fake_time(0.0);
+    BLEFragmenter f(32);
+    BLEReassembler r;
+    Capture cap; cap.wire(r);
+    EXPECT_EQ(r.poolSlabs(), (size_t)0);   // nothing reserved up front
+
+    const size_t PEERS = 10;               // old fixed pool held 4
+    std::vector<std::vector<Bytes>> frags;
+    for (size_t p = 0; p < PEERS; ++p) {
+        frags.push_back(f.fragment(make_payload(100, (uint8_t)p)));
+        EXPECT_TRUE(r.processFragment(make_peer((uint8_t)(0x40 + p)), frags[p][0]));
+    }
+    EXPECT_EQ(r.pendingCount(), PEERS);
+    EXPECT_EQ(r.poolSlabs(), (PEERS + RNS::BLE::REASSEMBLY_SLAB_SLOTS - 1) /
+                                 RNS::BLE::REASSEMBLY_SLAB_SLOTS);
+
+    for (size_t p = 0; p < PEERS; ++p) {
+        for (size_t i = 1; i < frags[p].size(); ++i) {
+            EXPECT_TRUE(r.processFragment(make_peer((uint8_t)(0x40 + p)), frags[p][i]));
+        }
+    }
+    EXPECT_EQ(cap.packets.size(), PEERS);
+    for (size_t p = 0; p < PEERS; ++p) {
+        EXPECT_EQ(cap.packets[p].second, make_payload(100, (uint8_t)p));
+    }
+    EXPECT_EQ(r.pendingCount(), (size_t)0);
+
+    // First sweep notes the slabs empty, the one after the quiet period
+    // frees all but the one the pool keeps warm.
+    r.checkTimeouts();
+    EXPECT_TRUE(r.poolSlabs() > 1);
+    RNS::Utilities::OS::set_fake_time(120.0);
+    r.checkTimeouts();
+    EXPECT_EQ(r.poolSlabs(), (size_t)1);
+    EXPECT_EQ(r.poolPeakSlabs(), (PEERS + 1) / 2);
+    EXPECT_TRUE(cap.timeouts.empty());
+    RNS::Utilities::OS::clear_fake_time();
+}
+
 int main() {
     RUN(single_fragment_round_trip);
     RUN(multi_fragment_round_trip_in_order);
@@ -306,6 +348,7 @@ int main() {
     RUN(fragment_count_matches_calculator);
     RUN(mtu_change_affects_subsequent_fragments);
     RUN(clear_for_peer_drops_only_that_peer);
+    RUN(burst_of_peers_grows_then_trims_pool);
 
     std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
     return g_fail == 0 ? 0 : 1;
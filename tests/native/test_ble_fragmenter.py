@@ -36,6 +36,7 @@ def test_ble_fragmenter_round_trip(tmp_path):
         "-Wno-unused-parameter",
         f"-I{HERE}",                                        # shims
         f"-I{PYXIS_ROOT / 'lib' / 'ble_interface'}",
+        f"-I{PYXIS_ROOT / 'lib' / 'microreticulum-shim'}",    # ObjectPool.h, FixedHash.h
         str(TEST_SOURCE),
         str(PYXIS_ROOT / "lib" / "ble_interface" / "BLEFragmenter.cpp"),
         str(PYXIS_ROOT / "lib" / "ble_interface" / "BLEReassembler.cpp"),
@@ -57,4 +58,4 @@ def test_ble_fragmenter_round_trip(tmp_path):
     pass_count = int(parts[0])
     fail_count = int(parts[2])
     assert fail_count == 0, run_result.stdout
-    assert pass_count >= 10, f"expected at least 10 BLE fragmenter tests, ran {pass_count}"
+    assert pass_count >= 11, f"expected at least 11 BLE fragmenter tests, ran {pass_count}"
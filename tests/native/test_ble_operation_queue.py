@@ -31,6 +31,7 @@ def test_ble_operation_queue(tmp_path):
         "-Wno-unused-parameter",
         f"-I{HERE}",
         f"-I{PYXIS_ROOT / 'lib' / 'ble_interface'}",
+        f"-I{PYXIS_ROOT / 'lib' / 'microreticulum-shim'}",    # FixedHash.h
         str(TEST_SOURCE),
         str(PYXIS_ROOT / "lib" / "ble_interface" / "BLEOperationQueue.cpp"),
         "-o", str(binary),
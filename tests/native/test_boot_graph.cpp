@@ -0,0 +1,236 @@
+// Native unit tests for the boot dependency graph (BootGraph.h).
+//
+// setup() hands every init phase to BootGraph, so a phase started before
+// its dependencies, or an LVGL phase run off loopTask, is a boot crash on
+// the device. Phases here sleep instead of doing work. Tests:
+//
+//   - add() rejects forward/unknown dependencies and a full graph; run()
+//     then refuses to start anything
+//   - with no workers, phases run in add order on the caller without overlap
+//   - with workers, no phase starts before all of its dependencies ended
+//   - independent waits run at once: wall time drops below the phase sum and
+//     the overlap is reported per phase
+//   - MAIN phases stay on the calling task, and a MAIN phase doesn't wait
+//     behind a slow phase it doesn't depend on
+//   - the critical path follows the longest dependency chain by duration
+
+#include "../../lib/microreticulum-shim/BootGraph.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+using RNS::BootGraph;
+namespace Cfg = RNS::BootGraphConfig;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// ── phase fixtures ──
+
+static constexpr int N = 8;
+static std::atomic<int> g_seq{0};
+static int g_start_seq[N];
+static int g_end_seq[N];
+static int g_sleep_ms[N];
+static std::thread::id g_thread[N];
+
+static void reset(std::initializer_list<int> sleeps = {}) {
+    g_seq = 0;
+    for (int i = 0; i < N; i++) {
+        g_start_seq[i] = g_end_seq[i] = -1;
+        g_sleep_ms[i] = 0;
+        g_thread[i] = std::thread::id();
+    }
+    int i = 0;
+    for (int ms : sleeps) g_sleep_ms[i++] = ms;
+}
+
+template <int I>
+static void phase() {
+    g_start_seq[I] = g_seq++;
+    g_thread[I] = std::this_thread::get_id();
+    if (g_sleep_ms[I]) std::this_thread::sleep_for(std::chrono::milliseconds(g_sleep_ms[I]));
+    g_end_seq[I] = g_seq++;
+}
+
+static void expect_deps_respected(const BootGraph& g) {
+    for (size_t i = 0; i < g.size(); i++) {
+        EXPECT_TRUE(g_end_seq[i] >= 0);
+        for (size_t d = 0; d < i; d++) {
+            if (g.phase(i).deps & (1u << d)) EXPECT_TRUE(g_end_seq[d] < g_start_seq[i]);
+        }
+    }
+}
+
+// ── tests ──
+
+static void bad_dependencies_rejected() {
+    reset();
+    BootGraph g;
+    int a = g.add("a", phase<0>);
+    EXPECT_EQ(a, 0);
+    EXPECT_EQ(g.add("fwd", phase<1>, {1}), -1);
+    EXPECT_TRUE(!g.run());
+    EXPECT_EQ(g_start_seq[0], -1);
+
+    BootGraph full;
+    for (size_t i = 0; i < Cfg::MAX_PHASES; i++) EXPECT_TRUE(full.add("p", phase<0>) >= 0);
+    EXPECT_EQ(full.add("one too many", phase<0>), -1);
+    EXPECT_TRUE(!full.run());
+
+    BootGraph neg;
+    EXPECT_EQ(neg.add("neg", phase<0>, {-1}), -1);
+    EXPECT_TRUE(!neg.run());
+}
+
+static void no_workers_runs_in_add_order() {
+    reset({5, 5, 5});
+    BootGraph g;
+    int a = g.add("a", phase<0>);
+    g.add("b", phase<1>);
+    g.add("c", phase<2>, {a});
+    EXPECT_TRUE(g.run(0));
+    EXPECT_TRUE(!g.run(0));   // single shot
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(g_start_seq[i], 2 * i);
+        EXPECT_EQ(g.phase(i).runner, (uint8_t)0);
+        EXPECT_EQ(g.overlapMs(i), (uint32_t)0);
+    }
+    EXPECT_TRUE(g.wallMs() >= g.busyMs());
+}
+
+static void dependencies_respected_in_parallel() {
+    for (int round = 0; round < 20; round++) {
+        reset({3, 1, 2, 0, 1, 2, 0, 1});
+        BootGraph g;
+        int p0 = g.add("p0", phase<0>);
+        int p1 = g.add("p1", phase<1>);
+        int p2 = g.add("p2", phase<2>, {p0});
+        int p3 = g.add("p3", phase<3>, {p1, p2}, BootGraph::MAIN);
+        int p4 = g.add("p4", phase<4>, {p0});
+        int p5 = g.add("p5", phase<5>, {p3, p4});
+        g.add("p6", phase<6>, {p5}, BootGraph::MAIN);
+        g.add("p7", phase<7>);
+        EXPECT_TRUE(g.run(2));
+        expect_deps_respected(g);
+    }
+}
+
+static void independent_waits_overlap() {
+    reset({80, 80, 10});
+    BootGraph g;
+    int gps = g.add("gps", phase<0>);
+    int wifi = g.add("wifi", phase<1>);
+    g.add("join", phase<2>, {gps, wifi});
+    EXPECT_TRUE(g.run(1));
+    expect_deps_respected(g);
+
+    EXPECT_TRUE(g.busyMs() >= 170);
+    EXPECT_TRUE(g.wallMs() < 150);
+    EXPECT_TRUE(g.overlapMs(gps) >= 60);
+    EXPECT_TRUE(g.overlapMs(wifi) >= 60);
+    EXPECT_TRUE(g.overlapMs(gps) <= g.durationMs(gps));
+    EXPECT_EQ(g.overlapMs(2), (uint32_t)0);   // ran after both ended
+    EXPECT_TRUE(g.phase(gps).runner != g.phase(wifi).runner);
+}
+
+static void main_phases_stay_on_caller_and_skip_unrelated_waits() {
+    reset({150, 10, 10, 10});
+    const std::thread::id caller = std::this_thread::get_id();
+    BootGraph g;
+    int slow = g.add("gps", phase<0>);          // nothing on the UI path needs it
+    int lvgl = g.add("lvgl", phase<1>, {}, BootGraph::MAIN);
+    int lxmf = g.add("lxmf", phase<2>);
+    int ui = g.add("ui", phase<3>, {lvgl, lxmf}, BootGraph::MAIN);
+    EXPECT_TRUE(g.run(1));
+    expect_deps_respected(g);
+
+    EXPECT_TRUE(g_thread[lvgl] == caller);
+    EXPECT_TRUE(g_thread[ui] == caller);
+    EXPECT_EQ(g.phase(ui).runner, (uint8_t)0);
+    // The caller never picked up the slow leaf, and the UI finished first
+    EXPECT_TRUE(g_thread[slow] != caller);
+    EXPECT_TRUE(g_end_seq[ui] < g_end_seq[slow]);
+    EXPECT_TRUE(g.startMs(ui) + g.durationMs(ui) < g.durationMs(slow));
+}
+
+static void critical_path_is_longest_chain() {
+    reset({20, 70, 5, 10, 5});
+    BootGraph g;
+    int a = g.add("a", phase<0>);
+    int b = g.add("b", phase<1>, {a});
+    int c = g.add("c", phase<2>, {a});
+    int d = g.add("d", phase<3>, {b, c});
+    g.add("e", phase<4>);
+    EXPECT_TRUE(g.run(2));
+    expect_deps_respected(g);
+
+    uint8_t path[Cfg::MAX_PHASES];
+    uint32_t total = 0;
+    size_t n = g.criticalPath(path, Cfg::MAX_PHASES, &total);
+    EXPECT_EQ(n, (size_t)3);
+    EXPECT_EQ(path[0], (uint8_t)a);
+    EXPECT_EQ(path[1], (uint8_t)b);
+    EXPECT_EQ(path[2], (uint8_t)d);
+    EXPECT_EQ(total, g.durationMs(a) + g.durationMs(b) + g.durationMs(d));
+    EXPECT_TRUE(total >= 100);
+    EXPECT_TRUE(g.wallMs() >= total);
+
+    // Truncated output keeps the head of the chain
+    uint8_t head[2];
+    EXPECT_EQ(g.criticalPath(head, 2), (size_t)2);
+    EXPECT_EQ(head[0], (uint8_t)a);
+    EXPECT_EQ(head[1], (uint8_t)b);
+}
+
+int main() {
+    RUN(bad_dependencies_rejected);
+    RUN(no_workers_runs_in_add_order);
+    RUN(dependencies_respected_in_parallel);
+    RUN(independent_waits_overlap);
+    RUN(main_phases_stay_on_caller_and_skip_unrelated_waits);
+    RUN(critical_path_is_longest_chain);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,295 @@
+// Native unit tests for the buddy allocator behind BytesPool's TIER_BUDDY.
+//
+// Resource segments and decompressed LXMF bodies live in these blocks, so a
+// block handed out twice or a merge with a live buddy corrupts a transfer
+// long after the cause. Tests:
+//
+//   - sizes round up to the smallest power of two, 1KB minimum, 64KB cap
+//   - splits halve a 64KB block down to the request; frees merge all the
+//     way back up, so alternating sizes end fully coalesced
+//   - a buddy still in use blocks the merge; fragmentation reports the
+//     free space stranded below 64KB
+//   - exhaustion fails cleanly and recovers after frees
+//   - foreign, interior and double frees are ignored
+//   - BytesPool routes XL-and-up requests the fixed tiers can't serve to
+//     TIER_BUDDY, and releasing them returns the block; vector regrowth
+//     past the block moves to the heap
+//   - threaded churn with stamped blocks: no block is handed out twice
+
+#include "../../lib/microreticulum-shim/BytesPool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using RNS::BuddyAllocator;
+using RNS::BuddyStats;
+using RNS::BytesPool;
+using RNS::BytesPoolDeleter;
+using RNS::PooledData;
+namespace Cfg = RNS::BytesPoolConfig;
+namespace BuddyCfg = RNS::BuddyConfig;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+static constexpr size_t WHOLE_BLOCKS = BuddyCfg::REGION_BYTES / BuddyCfg::MAX_BLOCK;
+
+// Every test leaves the region fully free and coalesced.
+static void expect_all_free() {
+    BuddyStats s = BuddyAllocator::instance().stats();
+    EXPECT_EQ(s.bytes_in_use, (size_t)0);
+    EXPECT_EQ(s.free_bytes, BuddyCfg::REGION_BYTES);
+    EXPECT_EQ(s.free_blocks[BuddyCfg::ORDER_COUNT - 1], WHOLE_BLOCKS);
+    EXPECT_EQ(s.fragmentation, (uint8_t)0);
+}
+
+// ── tests ──
+
+static void sizes_round_to_powers_of_two() {
+    auto& buddy = BuddyAllocator::instance();
+    struct Case { size_t request; size_t block; };
+    const Case cases[] = {
+        {1, 1024}, {1024, 1024}, {1025, 2048}, {4097, 8192},
+        {40000, 65536}, {BuddyCfg::MAX_BLOCK, BuddyCfg::MAX_BLOCK},
+    };
+    for (const Case& c : cases) {
+        void* p = buddy.allocate(c.request);
+        EXPECT_TRUE(p != nullptr);
+        EXPECT_EQ(buddy.blockSize(p), c.block);
+        std::memset(p, 0x5A, c.block);
+        buddy.free(p);
+    }
+    EXPECT_TRUE(buddy.allocate(0) == nullptr);
+    EXPECT_TRUE(buddy.allocate(BuddyCfg::MAX_BLOCK + 1) == nullptr);
+    expect_all_free();
+}
+
+static void splits_and_merges_are_counted() {
+    auto& buddy = BuddyAllocator::instance();
+    buddy.resetStats();
+
+    // One 1KB block from a whole 64KB block: six halvings
+    void* a = buddy.allocate(1000);
+    BuddyStats s = buddy.stats();
+    EXPECT_EQ(s.splits, (size_t)(BuddyCfg::MAX_ORDER - BuddyCfg::MIN_ORDER));
+    EXPECT_EQ(s.bytes_in_use, (size_t)1024);
+    for (size_t o = 0; o + 1 < BuddyCfg::ORDER_COUNT; o++) {
+        EXPECT_EQ(s.free_blocks[o], (size_t)1);   // One spare half at each order
+    }
+    EXPECT_EQ(s.free_blocks[BuddyCfg::ORDER_COUNT - 1], WHOLE_BLOCKS - 1);
+
+    // Its buddy comes straight off the 1KB list, no new split
+    void* b = buddy.allocate(1024);
+    EXPECT_EQ(buddy.stats().splits, s.splits);
+    EXPECT_EQ((size_t)(static_cast<uint8_t*>(b) - static_cast<uint8_t*>(a)), (size_t)1024);
+
+    buddy.free(a);
+    EXPECT_EQ(buddy.stats().merges, (size_t)0);   // Buddy b still live
+    buddy.free(b);
+    EXPECT_EQ(buddy.stats().merges, (size_t)(BuddyCfg::MAX_ORDER - BuddyCfg::MIN_ORDER));
+    EXPECT_EQ(buddy.stats().allocations, (size_t)2);
+    EXPECT_EQ(buddy.stats().frees, (size_t)2);
+    expect_all_free();
+}
+
+static void live_buddy_blocks_merge_and_shows_fragmentation() {
+    auto& buddy = BuddyAllocator::instance();
+    // Fill one 64KB block with 2KB pieces, then free every other one:
+    // half the block is free but nothing merges
+    std::vector<void*> pieces;
+    for (size_t i = 0; i < BuddyCfg::MAX_BLOCK / 2048; i++) pieces.push_back(buddy.allocate(2048));
+    for (size_t i = 0; i < pieces.size(); i += 2) buddy.free(pieces[i]);
+
+    BuddyStats s = buddy.stats();
+    EXPECT_EQ(s.free_blocks[1], pieces.size() / 2);   // 2KB order
+    EXPECT_EQ(s.largest_free, BuddyCfg::MAX_BLOCK);   // Untouched whole blocks
+    size_t stranded = BuddyCfg::MAX_BLOCK / 2;
+    EXPECT_EQ(s.fragmentation, (uint8_t)(stranded * 100 / s.free_bytes));
+    EXPECT_TRUE(s.fragmentation > 0);
+
+    for (size_t i = 1; i < pieces.size(); i += 2) buddy.free(pieces[i]);
+    expect_all_free();
+}
+
+static void exhaustion_fails_then_recovers() {
+    auto& buddy = BuddyAllocator::instance();
+    size_t failures = buddy.stats().failures;
+    std::vector<void*> held;
+    for (size_t i = 0; i < WHOLE_BLOCKS; i++) held.push_back(buddy.allocate(BuddyCfg::MAX_BLOCK));
+    for (void* p : held) EXPECT_TRUE(p != nullptr);
+    EXPECT_TRUE(buddy.allocate(1) == nullptr);
+    EXPECT_EQ(buddy.stats().failures, failures + 1);
+    EXPECT_EQ(buddy.stats().largest_free, (size_t)0);
+
+    buddy.free(held.back());
+    held.pop_back();
+    void* small = buddy.allocate(1);
+    EXPECT_TRUE(small != nullptr);
+    buddy.free(small);
+    for (void* p : held) buddy.free(p);
+    expect_all_free();
+}
+
+static void bad_frees_ignored() {
+    auto& buddy = BuddyAllocator::instance();
+    uint8_t outsider[64];
+    buddy.free(outsider);
+    buddy.free(nullptr);
+
+    uint8_t* p = static_cast<uint8_t*>(buddy.allocate(4096));
+    buddy.free(p + 16);      // Interior of the block
+    buddy.free(p + 1024);    // Unit start inside the block
+    EXPECT_EQ(buddy.stats().bytes_in_use, (size_t)4096);
+    buddy.free(p);
+    size_t frees = buddy.stats().frees;
+    buddy.free(p);           // Double free
+    EXPECT_EQ(buddy.stats().frees, frees);
+    expect_all_free();
+}
+
+static void bytes_pool_routes_large_requests() {
+    auto& pool = BytesPool::instance();
+    // Over the XXL tier: straight to the buddy region
+    auto [big, big_tier] = pool.acquire(10000);
+    EXPECT_TRUE(big != nullptr);
+    EXPECT_EQ(big_tier, Cfg::TIER_BUDDY);
+    EXPECT_TRUE(BuddyAllocator::instance().owns(big));
+    EXPECT_TRUE(BuddyAllocator::instance().owns(big->data()));
+    EXPECT_TRUE(big->capacity() >= 10000);
+    EXPECT_EQ(BuddyAllocator::instance().blockSize(big), (size_t)16384);
+    big->assign(10000, 0xCD);
+    EXPECT_EQ((*big)[9999], (uint8_t)0xCD);
+    pool.release(big, big_tier);
+
+    // XL/XXL tiers still come first
+    auto [xl, xl_tier] = pool.acquire(3000);
+    EXPECT_EQ(xl_tier, Cfg::TIER_4096);
+    pool.release(xl, xl_tier);
+
+    // Small sizes never reach the buddy region
+    auto [tiny, tiny_tier] = pool.acquire(32);
+    EXPECT_EQ(tiny_tier, Cfg::TIER_64);
+    pool.release(tiny, tiny_tier);
+    expect_all_free();
+}
+
+static void xxl_tier_dry_spills_to_buddy() {
+    auto& pool = BytesPool::instance();
+    std::vector<std::pair<PooledData*, Cfg::Tier>> held;
+    bool saw_buddy = false;
+    // XXL ceiling is a handful of slots; the next ones go to the buddy region
+    for (size_t i = 0; i < Cfg::XXL_MAX_SLOTS + 4; i++) {
+        auto got = pool.acquire(4000);
+        EXPECT_TRUE(got.first != nullptr);
+        if (got.second == Cfg::TIER_BUDDY) saw_buddy = true;
+        held.push_back(got);
+    }
+    EXPECT_TRUE(saw_buddy);
+    for (auto& h : held) pool.release(h.first, h.second);
+    expect_all_free();
+}
+
+static void regrowth_leaves_buddy_block() {
+    using Buffer = std::shared_ptr<PooledData>;
+    auto [data, tier] = BytesPool::instance().acquire(5000);
+    EXPECT_EQ(tier, Cfg::TIER_BUDDY);
+    Buffer b(data, BytesPoolDeleter{tier});
+    b->assign(b->capacity(), 1);
+    b->push_back(2);                 // Past capacity: vector reallocates via PSRAMAllocator
+    EXPECT_TRUE(!BuddyAllocator::instance().owns(b->data()));
+    EXPECT_EQ((*b)[b->size() - 1], (uint8_t)2);
+    b.reset();                       // Heap buffer freed, block returned
+    expect_all_free();
+}
+
+static void threaded_churn_no_double_handout() {
+    constexpr int THREADS = 6;
+    constexpr int ITERATIONS = 4000;
+    std::vector<std::thread> threads;
+    std::vector<int> corrupted(THREADS, 0);
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([t, &corrupted] {
+            auto& buddy = BuddyAllocator::instance();
+            std::mt19937 rng(t * 7919 + 1);
+            std::vector<std::pair<uint8_t*, size_t>> mine;
+            for (int i = 0; i < ITERATIONS; i++) {
+                if (mine.size() < 4 && (rng() & 1)) {
+                    size_t size = 1024u << (rng() % 4);   // 1KB..8KB
+                    auto* p = static_cast<uint8_t*>(buddy.allocate(size));
+                    if (!p) continue;
+                    std::memset(p, t + 1, size);
+                    mine.push_back({p, size});
+                } else if (!mine.empty()) {
+                    auto [p, size] = mine.back();
+                    mine.pop_back();
+                    for (size_t k = 0; k < size; k += 97) {
+                        if (p[k] != t + 1) corrupted[t]++;
+                    }
+                    buddy.free(p);
+                }
+            }
+            for (auto& [p, size] : mine) buddy.free(p);
+        });
+    }
+    for (auto& th : threads) th.join();
+    for (int c : corrupted) EXPECT_EQ(c, 0);
+    expect_all_free();
+}
+
+int main() {
+    RUN(sizes_round_to_powers_of_two);
+    RUN(splits_and_merges_are_counted);
+    RUN(live_buddy_blocks_merge_and_shows_fragmentation);
+    RUN(exhaustion_fails_then_recovers);
+    RUN(bad_frees_ignored);
+    RUN(bytes_pool_routes_large_requests);
+    RUN(xxl_tier_dry_spills_to_buddy);
+    RUN(regrowth_leaves_buddy_block);
+    RUN(threaded_churn_no_double_handout);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,345 @@
+// Native unit tests for the lock-free BytesPool.
+//
+// BytesPool sits under every RNS::Bytes allocation, so a lost or doubly
+// handed-out slot corrupts packets far from the cause. Tests:
+//
+//   - acquire picks the smallest tier that fits; beyond the buddy region misses
+//   - release restores availability; foreign pointers are ignored
+//   - tiny tier hands out every slot (magazine + shared stack), grows when
+//     dry, and stops at its ceiling / the growth reserve
+//   - small tiers grow the same way (no magazine stranding)
+//   - size histogram buckets, high-water marks, learned/applied profiles
+//   - counters stay consistent: requests == hits + misses
+//   - MPMC stress: 8 threads churn acquire/release on the tiny and small
+//     tiers; each owner stamps its slot and re-checks the stamp before
+//     release, so a slot handed to two threads at once is detected
+
+#include "../../lib/microreticulum-shim/BytesPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using RNS::BytesPool;
+using RNS::BytesPoolProfile;
+using RNS::PooledData;
+namespace Cfg = RNS::BytesPoolConfig;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// Every test leaves the singleton fully released so the next one starts
+// from the same state.
+static void expect_all_free() {
+    auto& pool = BytesPool::instance();
+    for (size_t i = 1; i <= Cfg::TIER_COUNT; ++i) {
+        auto tier = static_cast<Cfg::Tier>(i);
+        EXPECT_EQ(pool.available(tier), pool.slots(tier));
+    }
+}
+
+// Growth never hands out more than the reserve it was given.
+static void expect_reserve_accounted() {
+    auto& pool = BytesPool::instance();
+    size_t spent = 0;
+    for (size_t i = 1; i <= Cfg::TIER_COUNT; ++i) {
+        auto st = pool.tierStats(static_cast<Cfg::Tier>(i));
+        EXPECT_TRUE(st.slots <= st.max_slots);
+        spent += st.grown * st.capacity;
+    }
+    EXPECT_EQ(pool.reserve_remaining() + spent, Cfg::GROWTH_RESERVE_BYTES);
+}
+
+// Acquire from one tier until it (and its growth) runs dry.
+static std::vector<PooledData*> drain(size_t req, Cfg::Tier expected) {
+    auto& pool = BytesPool::instance();
+    std::vector<PooledData*> held;
+    while (true) {
+        auto [data, tier] = pool.acquire(req);
+        if (!data) break;
+        EXPECT_EQ(tier, expected);
+        held.push_back(data);
+    }
+    return held;
+}
+
+static void tier_selection() {
+    auto& pool = BytesPool::instance();
+    struct Case { size_t req; Cfg::Tier tier; size_t cap; };
+    const Case cases[] = {
+        {0, Cfg::TIER_64, 64},       {16, Cfg::TIER_64, 64},
+        {64, Cfg::TIER_64, 64},      {65, Cfg::TIER_256, 256},
+        {256, Cfg::TIER_256, 256},   {500, Cfg::TIER_512, 512},
+        {1024, Cfg::TIER_1024, 1024},{1500, Cfg::TIER_2048, 2048},
+        {4096, Cfg::TIER_4096, 4096},
+    };
+    for (const auto& c : cases) {
+        auto [data, tier] = pool.acquire(c.req);
+        EXPECT_TRUE(data != nullptr);
+        EXPECT_EQ(tier, c.tier);
+        EXPECT_TRUE(data->empty());
+        EXPECT_TRUE(data->capacity() >= c.cap);
+        pool.release(data, tier);
+    }
+    expect_all_free();
+}
+
+static void oversize_is_a_miss() {
+    // Above the XXL tier the buddy region takes over (test_buddy_allocator);
+    // only requests its largest block can't hold go to the heap.
+    auto& pool = BytesPool::instance();
+    size_t misses = pool.pool_misses();
+    auto [data, tier] = pool.acquire(RNS::BuddyConfig::MAX_BLOCK);
+    EXPECT_TRUE(data == nullptr);
+    EXPECT_EQ(tier, Cfg::TIER_NONE);
+    EXPECT_EQ(pool.pool_misses(), misses + 1);
+}
+
+static void release_clears_but_keeps_capacity() {
+    auto& pool = BytesPool::instance();
+    auto [data, tier] = pool.acquire(32);
+    for (int i = 0; i < 32; ++i) data->push_back((uint8_t)i);
+    pool.release(data, tier);
+
+    // LIFO: the same slot comes straight back from the magazine / stack top.
+    auto [again, tier2] = pool.acquire(32);
+    EXPECT_TRUE(again == data);
+    EXPECT_TRUE(again->empty());
+    EXPECT_TRUE(again->capacity() >= 64);
+    pool.release(again, tier2);
+    expect_all_free();
+}
+
+static void foreign_pointer_ignored() {
+    auto& pool = BytesPool::instance();
+    PooledData outsider;
+    pool.release(&outsider, Cfg::TIER_64);
+    pool.release(nullptr, Cfg::TIER_64);
+    pool.release(&outsider, Cfg::TIER_NONE);
+    expect_all_free();
+}
+
+static void tiny_tier_grows_then_exhausts() {
+    auto& pool = BytesPool::instance();
+    size_t tier_misses = pool.tierStats(Cfg::TIER_64).misses;
+    std::vector<PooledData*> held = drain(16, Cfg::TIER_64);
+
+    auto st = pool.tierStats(Cfg::TIER_64);
+    EXPECT_TRUE(held.size() > Cfg::TINY_SLOTS);
+    EXPECT_EQ(held.size(), st.slots);
+    EXPECT_EQ(st.grown, st.slots - Cfg::TINY_SLOTS);
+    EXPECT_EQ(st.in_use, st.slots);
+    EXPECT_EQ(st.high_water, st.slots);
+    EXPECT_EQ(st.misses, tier_misses + 1);
+    EXPECT_EQ(pool.tiny_available(), (size_t)0);
+
+    // Every slot distinct, grown ones included, and all at full capacity
+    std::vector<PooledData*> sorted = held;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+    for (auto* d : held) EXPECT_TRUE(d->capacity() >= Cfg::TIER_TINY);
+
+    for (auto* d : held) pool.release(d, Cfg::TIER_64);
+    expect_all_free();
+    expect_reserve_accounted();
+}
+
+static void small_tier_grows_then_exhausts() {
+    auto& pool = BytesPool::instance();
+    std::vector<PooledData*> held = drain(200, Cfg::TIER_256);
+    EXPECT_TRUE(held.size() > Cfg::SMALL_SLOTS);
+    EXPECT_EQ(held.size(), pool.slots(Cfg::TIER_256));
+    for (auto* d : held) pool.release(d, Cfg::TIER_256);
+    expect_all_free();
+    expect_reserve_accounted();
+}
+
+static void grown_tiers_start_empty() {
+    auto& pool = BytesPool::instance();
+    auto [xl, xl_tier] = pool.acquire(3000);
+    EXPECT_TRUE(xl != nullptr);
+    EXPECT_EQ(xl_tier, Cfg::TIER_4096);
+    EXPECT_TRUE(xl->capacity() >= Cfg::TIER_XXL);
+    EXPECT_TRUE(pool.tierStats(Cfg::TIER_4096).grown >= 1);
+    pool.release(xl, xl_tier);
+    expect_all_free();
+}
+
+static void size_histogram() {
+    auto& pool = BytesPool::instance();
+    pool.resetStats();
+    for (size_t b = 0; b < Cfg::HISTOGRAM_BUCKETS; ++b) EXPECT_EQ(pool.histogram(b), (size_t)0);
+
+    const size_t sizes[] = {0, 1, 2, 3, 64, 65, 500, 5000, 100000};
+    for (size_t req : sizes) {
+        auto [data, tier] = pool.acquire(req);
+        if (data) pool.release(data, tier);
+    }
+    EXPECT_EQ(pool.histogram(0), (size_t)2);   // 0, 1
+    EXPECT_EQ(pool.histogram(1), (size_t)1);   // 2
+    EXPECT_EQ(pool.histogram(2), (size_t)1);   // 3
+    EXPECT_EQ(pool.histogram(6), (size_t)1);   // 64
+    EXPECT_EQ(pool.histogram(7), (size_t)1);   // 65
+    EXPECT_EQ(pool.histogram(9), (size_t)1);   // 500
+    EXPECT_EQ(pool.histogram(13), (size_t)1);  // 5000
+    EXPECT_EQ(pool.histogram(Cfg::HISTOGRAM_BUCKETS - 1), (size_t)1);  // > 64KB
+    EXPECT_EQ(BytesPool::histogramBound(6), (size_t)64);
+    EXPECT_EQ(BytesPool::histogramBound(Cfg::HISTOGRAM_BUCKETS - 1), (size_t)0);
+    expect_all_free();
+}
+
+static void high_water_and_profile() {
+    auto& pool = BytesPool::instance();
+    pool.resetStats();
+    EXPECT_EQ(pool.tierStats(Cfg::TIER_512).high_water, (size_t)0);
+
+    std::vector<PooledData*> held;
+    for (int i = 0; i < 8; ++i) held.push_back(pool.acquire(400).first);
+    for (auto* d : held) pool.release(d, Cfg::TIER_512);
+    EXPECT_EQ(pool.tierStats(Cfg::TIER_512).high_water, (size_t)8);
+    EXPECT_EQ(pool.tierStats(Cfg::TIER_512).in_use, (size_t)0);
+
+    // Peak 8 + 25% = 10, clamped up to the compiled-in base
+    BytesPoolProfile profile = pool.learnedProfile();
+    EXPECT_EQ(profile.magic, BytesPoolProfile::MAGIC);
+    EXPECT_EQ(profile.slots[Cfg::TIER_512 - 1], (uint16_t)Cfg::MEDIUM_SLOTS);
+    EXPECT_EQ(profile.slots[Cfg::TIER_2048 - 1], (uint16_t)Cfg::XL_SLOTS);
+
+    // Apply grows toward targets, clamps at the ceiling, never shrinks
+    BytesPoolProfile bad;
+    EXPECT_TRUE(!pool.applyProfile(bad));
+    profile.slots[Cfg::TIER_512 - 1] = (uint16_t)(Cfg::MEDIUM_SLOTS + 6);
+    profile.slots[Cfg::TIER_2048 - 1] = 0xFFFF;
+    profile.slots[Cfg::TIER_64 - 1] = 1;
+    size_t tiny_before = pool.slots(Cfg::TIER_64);
+    EXPECT_TRUE(pool.applyProfile(profile));
+    EXPECT_TRUE(pool.slots(Cfg::TIER_512) >= Cfg::MEDIUM_SLOTS + 6);
+    EXPECT_EQ(pool.slots(Cfg::TIER_2048), Cfg::XL_MAX_SLOTS);
+    EXPECT_EQ(pool.slots(Cfg::TIER_64), tiny_before);
+    expect_all_free();
+    expect_reserve_accounted();
+}
+
+static void counters_consistent() {
+    auto& pool = BytesPool::instance();
+    EXPECT_EQ(pool.total_requests(), pool.pool_hits() + pool.pool_misses());
+}
+
+// MPMC stress. Each thread keeps a small window of held slots, stamps
+// every slot it acquires with its id + sequence, and verifies the stamp is
+// untouched before releasing. Two owners of one slot overwrite each other.
+static void mpmc_threaded_stress() {
+    auto& pool = BytesPool::instance();
+    const int THREADS = 8;
+    const int OPS = 100000;
+    const size_t WINDOW = 24;
+    std::atomic<int> corruptions{0};
+    std::atomic<int> dirty_acquires{0};
+    size_t requests_before = pool.total_requests();
+    size_t hits_before = pool.pool_hits();
+    size_t misses_before = pool.pool_misses();
+    std::atomic<size_t> hits{0};
+    std::atomic<size_t> misses{0};
+
+    auto worker = [&](int id) {
+        struct Held { PooledData* data; Cfg::Tier tier; uint32_t seq; };
+        std::vector<Held> window;
+        uint32_t seq = 0;
+        uint32_t rng = 0x9E3779B9u * (uint32_t)(id + 1);
+        for (int op = 0; op < OPS; ++op) {
+            rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+            bool do_acquire = window.size() < WINDOW && (window.empty() || (rng & 1));
+            if (do_acquire) {
+                size_t req = (rng & 0x70) ? 32 : 200;  // mostly tiny, some small
+                auto [data, tier] = pool.acquire(req);
+                if (!data) { ++misses; continue; }
+                ++hits;
+                if (!data->empty()) ++dirty_acquires;
+                ++seq;
+                data->push_back((uint8_t)id);
+                for (int b = 0; b < 4; ++b) data->push_back((uint8_t)(seq >> (8 * b)));
+                window.push_back({data, tier, seq});
+            } else {
+                size_t pick = rng % window.size();
+                Held h = window[pick];
+                window[pick] = window.back();
+                window.pop_back();
+                const PooledData& d = *h.data;
+                bool ok = d.size() == 5 && d[0] == (uint8_t)id;
+                for (int b = 0; ok && b < 4; ++b) ok = d[1 + b] == (uint8_t)(h.seq >> (8 * b));
+                if (!ok) ++corruptions;
+                pool.release(h.data, h.tier);
+            }
+        }
+        for (auto& h : window) pool.release(h.data, h.tier);
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i) threads.emplace_back(worker, i);
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(corruptions.load(), 0);
+    EXPECT_EQ(dirty_acquires.load(), 0);
+    EXPECT_EQ(pool.pool_hits() - hits_before, hits.load());
+    EXPECT_EQ(pool.pool_misses() - misses_before, misses.load());
+    EXPECT_EQ(pool.total_requests() - requests_before, hits.load() + misses.load());
+    expect_all_free();
+}
+
+int main() {
+    RUN(tier_selection);
+    RUN(oversize_is_a_miss);
+    RUN(release_clears_but_keeps_capacity);
+    RUN(foreign_pointer_ignored);
+    RUN(tiny_tier_grows_then_exhausts);
+    RUN(small_tier_grows_then_exhausts);
+    RUN(grown_tiers_start_empty);
+    RUN(size_histogram);
+    RUN(high_water_and_profile);
+    RUN(counters_consistent);
+    RUN(mpmc_threaded_stress);
+    RUN(counters_consistent);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
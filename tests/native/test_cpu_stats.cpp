@@ -0,0 +1,279 @@
+// Native unit tests for CpuStats (CpuMonitor's arithmetic).
+//
+// CpuMonitor feeds it uxTaskGetSystemState() snapshots on the device; here
+// the snapshots are synthetic. Tests:
+//
+//   - first snapshot only primes; loads appear from the second
+//   - task load as a share of one core, rounding, clamping at 100%
+//   - per-core idle time and load from each core's IDLE task
+//   - run-time counter and total clock wrapping at 2^32
+//   - jump flagging: only on a rise of JUMP_TENTHS over a measured
+//     interval; new tasks and tasks returning after a gap are not flagged
+//   - tasks appearing, disappearing, and over MAX_TASKS; repeated
+//     snapshot at the same instant keeps the last interval
+
+#include "../../lib/microreticulum-shim/Instrumentation/CpuStats.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace RNS::Instrumentation;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// ── helpers ──
+
+// A scripted set of tasks whose run-time counters the tests advance
+struct FakeKernel {
+    std::vector<CpuTaskSample> tasks;
+    uint32_t total = 0;
+
+    size_t add(uintptr_t id, const char* name, int8_t core, int8_t idle_core = CpuStatsConfig::NO_CORE) {
+        CpuTaskSample s;
+        s.id = id;
+        s.name = name;
+        s.core = core;
+        s.idle_core = idle_core;
+        tasks.push_back(s);
+        return tasks.size() - 1;
+    }
+
+    // Advance the clock; each core's unclaimed time goes to its IDLE task
+    void run(uint32_t elapsed, std::vector<std::pair<size_t, uint32_t>> busy) {
+        uint32_t used[CpuStatsConfig::CORES] = {};
+        for (auto& b : busy) {
+            tasks[b.first].runtime += b.second;
+            int8_t core = tasks[b.first].core < 0 ? 0 : tasks[b.first].core;
+            used[core] += b.second;
+        }
+        for (auto& t : tasks) {
+            if (t.idle_core >= 0) t.runtime += elapsed - used[t.idle_core];
+        }
+        total += elapsed;
+    }
+
+    void sample(CpuStats& st) { st.update(tasks.data(), tasks.size(), total); }
+};
+
+static const CpuTaskLoad* findTask(const CpuStats& st, const char* name) {
+    for (size_t i = 0; i < st.size(); i++) {
+        if (std::strcmp(st.task(i).name, name) == 0) return &st.task(i);
+    }
+    return nullptr;
+}
+
+// ── tests ──
+
+static void first_sample_only_primes() {
+    CpuStats st;
+    FakeKernel k;
+    size_t a = k.add(1, "lxst_cap", 1);
+    k.add(2, "IDLE1", 1, 1);
+    k.run(1000, {{a, 300}});
+    k.sample(st);
+    EXPECT_EQ(st.intervals(), (uint32_t)0);
+    EXPECT_EQ(st.size(), (size_t)2);
+    EXPECT_EQ(findTask(st, "lxst_cap")->load_tenths, (uint16_t)0);
+    EXPECT_TRUE(!findTask(st, "lxst_cap")->is_new);
+    EXPECT_EQ(st.coreLoadTenths(1), (uint16_t)0);
+
+    k.run(1000, {{a, 300}});
+    k.sample(st);
+    EXPECT_EQ(st.intervals(), (uint32_t)1);
+    EXPECT_EQ(st.elapsed(), (uint32_t)1000);
+    EXPECT_EQ(findTask(st, "lxst_cap")->load_tenths, (uint16_t)300);
+}
+
+static void task_and_core_loads() {
+    CpuStats st;
+    FakeKernel k;
+    k.add(10, "IDLE0", 0, 0);
+    k.add(11, "IDLE1", 1, 1);
+    size_t cap = k.add(1, "lxst_cap", 1);
+    size_t lvgl = k.add(2, "lvgl", 1);
+    size_t ble = k.add(3, "nimble_host", 0);
+    size_t any = k.add(4, "loopTask", CpuStatsConfig::NO_CORE);
+    k.sample(st);
+
+    k.run(30000000, {{cap, 15000000}, {lvgl, 9000000}, {ble, 3000000}, {any, 1}});
+    k.sample(st);
+    EXPECT_EQ(findTask(st, "lxst_cap")->load_tenths, (uint16_t)500);
+    EXPECT_EQ(findTask(st, "lvgl")->load_tenths, (uint16_t)300);
+    EXPECT_EQ(findTask(st, "nimble_host")->load_tenths, (uint16_t)100);
+    EXPECT_EQ(findTask(st, "loopTask")->load_tenths, (uint16_t)0);   // Rounds down
+    EXPECT_EQ(findTask(st, "loopTask")->core, CpuStatsConfig::NO_CORE);
+    EXPECT_EQ(findTask(st, "lvgl")->core, (int8_t)1);
+
+    EXPECT_EQ(st.coreIdle(1), (uint32_t)6000000);
+    EXPECT_EQ(st.coreIdleTenths(1), (uint16_t)200);
+    EXPECT_EQ(st.coreLoadTenths(1), (uint16_t)800);
+    EXPECT_EQ(st.coreLoadTenths(0), (uint16_t)100);
+    EXPECT_EQ(st.coreIdle(7), (uint32_t)0);
+
+    // Sampling skew can make a delta overrun the interval: clamp to 100%
+    k.tasks[cap].runtime += 31000000;
+    k.total += 30000000;
+    k.sample(st);
+    EXPECT_EQ(findTask(st, "lxst_cap")->load_tenths, (uint16_t)1000);
+}
+
+static void counters_wrap() {
+    CpuStats st;
+    FakeKernel k;
+    size_t a = k.add(1, "tcp_task", 0);
+    k.add(2, "IDLE0", 0, 0);
+    k.total = 0xFFFFFF00u;
+    k.tasks[a].runtime = 0xFFFFFFF0u;
+    k.tasks[1].runtime = 0xFFFFFF00u;
+    k.sample(st);
+    k.run(1000, {{a, 250}});
+    EXPECT_TRUE(k.total < 0x1000u);
+    EXPECT_TRUE(k.tasks[a].runtime < 0x1000u);
+    k.sample(st);
+    EXPECT_EQ(st.elapsed(), (uint32_t)1000);
+    EXPECT_EQ(findTask(st, "tcp_task")->load_tenths, (uint16_t)250);
+    EXPECT_EQ(st.coreLoadTenths(0), (uint16_t)250);
+}
+
+static void jumps_are_flagged() {
+    CpuStats st;
+    FakeKernel k;
+    size_t lvgl = k.add(1, "lvgl", 1);
+    size_t cap = k.add(2, "lxst_cap", 1);
+    k.sample(st);
+    k.run(1000, {{lvgl, 40}, {cap, 100}});
+    k.sample(st);
+    EXPECT_EQ(st.jumps(), (size_t)0);               // No previous interval
+
+    k.run(1000, {{lvgl, 613}, {cap, 340}});         // +57.3 and +24.0 points
+    k.sample(st);
+    EXPECT_EQ(st.jumps(), (size_t)1);
+    EXPECT_TRUE(findTask(st, "lvgl")->jumped);
+    EXPECT_EQ(findTask(st, "lvgl")->prev_tenths, (uint16_t)40);
+    EXPECT_EQ(findTask(st, "lvgl")->load_tenths, (uint16_t)613);
+    EXPECT_TRUE(!findTask(st, "lxst_cap")->jumped);
+
+    k.run(1000, {{lvgl, 600}, {cap, 590}});         // Exactly +25.0 points
+    k.sample(st);
+    EXPECT_TRUE(!findTask(st, "lvgl")->jumped);     // Staying high is not a jump
+    EXPECT_TRUE(findTask(st, "lxst_cap")->jumped);
+
+    k.run(1000, {{lvgl, 10}, {cap, 10}});           // Falling is never flagged
+    k.sample(st);
+    EXPECT_EQ(st.jumps(), (size_t)0);
+}
+
+static void tasks_come_and_go() {
+    CpuStats st;
+    FakeKernel k;
+    size_t a = k.add(1, "loopTask", 1);
+    k.sample(st);
+    k.run(1000, {{a, 100}});
+    k.sample(st);
+
+    // A new capture task starts mid-interval with a large counter
+    size_t cap = k.add(2, "lxst_cap", 1);
+    k.tasks[cap].runtime = 900;
+    k.run(1000, {{a, 100}});
+    k.sample(st);
+    const CpuTaskLoad* t = findTask(st, "lxst_cap");
+    EXPECT_TRUE(t != nullptr && t->is_new);
+    EXPECT_EQ(t->load_tenths, (uint16_t)0);
+
+    // First measured interval for it: not a jump even from 0 to 90%
+    k.run(1000, {{cap, 900}});
+    k.sample(st);
+    t = findTask(st, "lxst_cap");
+    EXPECT_TRUE(!t->is_new);
+    EXPECT_EQ(t->load_tenths, (uint16_t)900);
+    EXPECT_TRUE(!t->jumped);
+
+    // Task deleted: it drops out of the table
+    k.tasks.erase(k.tasks.begin() + cap);
+    k.run(1000, {});
+    k.sample(st);
+    EXPECT_EQ(st.size(), (size_t)1);
+    EXPECT_TRUE(findTask(st, "lxst_cap") == nullptr);
+
+    // Same instant again: ignored, last interval kept
+    k.sample(st);
+    EXPECT_EQ(st.elapsed(), (uint32_t)1000);
+    EXPECT_EQ(st.intervals(), (uint32_t)4);
+}
+
+static void too_many_tasks() {
+    CpuStats st;
+    FakeKernel k;
+    static char names[CpuStatsConfig::MAX_TASKS + 3][CpuStatsConfig::NAME_LEN];
+    for (size_t i = 0; i < CpuStatsConfig::MAX_TASKS + 3; i++) {
+        std::snprintf(names[i], sizeof(names[i]), "t%zu", i);
+        k.add(100 + i, names[i], 0);
+    }
+    k.add(999, "a_name_longer_than_fifteen", 0);
+    k.sample(st);
+    EXPECT_EQ(st.size(), CpuStatsConfig::MAX_TASKS);
+    EXPECT_EQ(st.dropped(), (size_t)4);
+
+    CpuStats st2;
+    FakeKernel k2;
+    k2.add(1, "a_name_longer_than_fifteen", 0);
+    k2.sample(st2);
+    EXPECT_EQ(std::string(st2.task(0).name), std::string("a_name_longer_t"));
+
+    st.reset();
+    EXPECT_EQ(st.size(), (size_t)0);
+    EXPECT_EQ(st.intervals(), (uint32_t)0);
+}
+
+int main() {
+    RUN(first_sample_only_primes);
+    RUN(task_and_core_loads);
+    RUN(counters_wrap);
+    RUN(jumps_are_flagged);
+    RUN(tasks_come_and_go);
+    RUN(too_many_tasks);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,59 @@
+"""Pytest wrapper for the CpuStats tests (CpuMonitor arithmetic)."""
+
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+PYXIS_ROOT = HERE.parent.parent
+SHIM = PYXIS_ROOT / "lib" / "microreticulum-shim"
+
+
+def _find_cxx():
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    pytest.skip("no C++ compiler found")
+
+
+def _compile(tmp_path, source, extra=()):
+    cxx = _find_cxx()
+    binary = tmp_path / source.stem
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        "-pthread",
+        *extra,
+        f"-I{HERE}",
+        f"-I{SHIM}",
+        str(source),
+        "-o", str(binary),
+    ]
+    compile_result = subprocess.run(cmd, capture_output=True, text=True)
+    assert compile_result.returncode == 0, (
+        f"compilation failed:\n--- cmd ---\n{' '.join(cmd)}\n"
+        f"--- stderr ---\n{compile_result.stderr}"
+    )
+    return binary
+
+
+def test_cpu_stats(tmp_path):
+    binary = _compile(tmp_path, HERE / "test_cpu_stats.cpp")
+
+    run_result = subprocess.run([str(binary)], capture_output=True, text=True, timeout=60)
+    assert run_result.returncode == 0, (
+        f"tests failed:\n--- stdout ---\n{run_result.stdout}\n"
+        f"--- stderr ---\n{run_result.stderr}"
+    )
+    summary = run_result.stdout.strip().splitlines()[-1]
+    parts = summary.split()
+    pass_count = int(parts[0])
+    fail_count = int(parts[2])
+    assert fail_count == 0, run_result.stdout
+    assert pass_count >= 6, f"expected at least 6 CpuStats tests, ran {pass_count}"
@@ -0,0 +1,336 @@
+// Native unit tests for the timeline trace recorder (EventTrace.h/.cpp).
+//
+// T:TRACE dumps are read back by tools/trace/trace_to_perfetto.py, so a
+// wrong ring order or header field shows up as a garbled timeline. Built
+// with EVENT_TRACE_RINGS=4 so ring exhaustion is reachable. Tests:
+//
+//   - nothing records before init(); init rounds ring size to a power of two
+//   - spans, instants and counters land on the caller's ring in order
+//   - a full ring overwrites oldest first and reports what it dropped
+//   - concurrent tasks each get their own ring, with no lost or torn events
+//   - released rings are reused; with every ring owned, events count as lost
+//   - stop/start/clear; dump size and layout match the format header
+//   - record() cost per event
+//
+// `test_event_trace --dump <file>` writes a multi-task dump for the
+// converter test in test_event_trace.py instead of running the tests.
+
+#include "../../lib/microreticulum-shim/Instrumentation/EventTrace.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace RNS::Instrumentation;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// ── helpers ──
+
+struct Ring {
+    std::string task;
+    uint32_t dropped;
+    std::vector<EventTraceRecord> records;
+};
+
+struct Dump {
+    EventTraceHeader header;
+    std::vector<std::string> names;
+    std::vector<Ring> rings;
+};
+
+static std::vector<uint8_t> dumpBytes() {
+    std::vector<uint8_t> out;
+    size_t n = EventTrace::dump([](const uint8_t* data, size_t len, void* ctx) {
+        auto* v = static_cast<std::vector<uint8_t>*>(ctx);
+        v->insert(v->end(), data, data + len);
+    }, &out);
+    if (n != out.size()) throw std::runtime_error("dump() return value != bytes written");
+    return out;
+}
+
+static Dump parse(const std::vector<uint8_t>& b) {
+    Dump d;
+    size_t pos = 0;
+    auto take = [&](void* dst, size_t len) {
+        if (pos + len > b.size()) throw std::runtime_error("dump truncated");
+        memcpy(dst, b.data() + pos, len);
+        pos += len;
+    };
+    take(&d.header, sizeof(d.header));
+    for (uint16_t i = 0; i < d.header.name_count; i++) {
+        uint8_t len;
+        take(&len, 1);
+        std::string s(len, '\0');
+        take(&s[0], len);
+        d.names.push_back(s);
+    }
+    for (uint16_t i = 0; i < d.header.ring_count; i++) {
+        EventTraceRingHeader rh;
+        take(&rh, sizeof(rh));
+        Ring r;
+        r.task = std::string(rh.task, strnlen(rh.task, sizeof(rh.task)));
+        r.dropped = rh.dropped;
+        r.records.resize(rh.count);
+        if (rh.count) take(r.records.data(), rh.count * sizeof(EventTraceRecord));
+        d.rings.push_back(r);
+    }
+    if (pos != b.size()) throw std::runtime_error("trailing bytes after last ring");
+    return d;
+}
+
+// Ring holding events with `name` (each test uses its own names/values)
+static const Ring* ringWith(const Dump& d, uint16_t name) {
+    for (const Ring& r : d.rings) {
+        for (const EventTraceRecord& rec : r.records) {
+            if (rec.name == name) return &r;
+        }
+    }
+    return nullptr;
+}
+
+static constexpr size_t RING_EVENTS = 64;
+
+// ── tests ──
+
+static void nothing_recorded_before_init() {
+    EventTrace::start();
+    EXPECT_TRUE(!EventTrace::running());
+    EventTrace::record(TRACE_NAME_USER, EVENT_TRACE_INSTANT, 1);
+    EXPECT_EQ(EventTrace::ringCount(), (size_t)0);
+
+    EXPECT_TRUE(EventTrace::init(100));   // Rounds down to 64
+    EXPECT_TRUE(EventTrace::running());
+    EXPECT_TRUE(EventTrace::init(100));   // Second call is a no-op
+    EXPECT_EQ(EventTrace::ringCount(), (size_t)0);
+
+    EventTraceHeader h = EventTrace::header();
+    EXPECT_EQ(h.magic, EVENT_TRACE_MAGIC);
+    EXPECT_EQ(h.cpu_mhz, (uint32_t)1000);
+    EXPECT_EQ(h.name_count, (uint16_t)TRACE_NAME_COUNT);
+}
+
+static void events_land_in_order() {
+    EventTrace::clear();
+    {
+        EVENT_TRACE_SCOPE_V(RETICULUM_LOOP, 7);
+        EVENT_TRACE_SCOPE(LVGL_FLUSH);
+        EVENT_TRACE_INSTANT(USER, -3);
+    }
+    EVENT_TRACE_COUNTER(CAPTURE_RING_DROPS, 42);
+
+    Dump d = parse(dumpBytes());
+    EXPECT_EQ(d.header.ring_count, (uint16_t)1);
+    EXPECT_EQ(d.names.size(), (size_t)TRACE_NAME_COUNT);
+    EXPECT_EQ(d.names[TRACE_NAME_PUMP_CALL_TX], std::string("ui.pump_call_tx"));
+    EXPECT_EQ(d.rings[0].task, std::string("thread"));
+
+    const std::vector<EventTraceRecord>& r = d.rings[0].records;
+    EXPECT_EQ(r.size(), (size_t)6);
+    const uint16_t names[] = {TRACE_NAME_RETICULUM_LOOP, TRACE_NAME_LVGL_FLUSH, TRACE_NAME_USER,
+                              TRACE_NAME_LVGL_FLUSH, TRACE_NAME_RETICULUM_LOOP,
+                              TRACE_NAME_CAPTURE_RING_DROPS};
+    const uint8_t types[] = {EVENT_TRACE_BEGIN, EVENT_TRACE_BEGIN, EVENT_TRACE_INSTANT,
+                             EVENT_TRACE_END, EVENT_TRACE_END, EVENT_TRACE_COUNTER};
+    for (size_t i = 0; i < r.size(); i++) {
+        EXPECT_EQ(r[i].name, names[i]);
+        EXPECT_EQ(r[i].type, types[i]);
+        if (i > 0) EXPECT_TRUE(static_cast<int32_t>(r[i].cycles - r[i - 1].cycles) >= 0);
+    }
+    EXPECT_EQ(r[0].value, 7);
+    EXPECT_EQ(r[2].value, -3);
+    EXPECT_EQ(r[5].value, 42);
+}
+
+static void full_ring_overwrites_oldest() {
+    EventTrace::clear();
+    for (int i = 0; i < 100; i++) EVENT_TRACE_INSTANT(USER, i);
+
+    Dump d = parse(dumpBytes());
+    EXPECT_EQ(d.rings.size(), (size_t)1);
+    EXPECT_EQ(d.rings[0].records.size(), RING_EVENTS);
+    EXPECT_EQ(d.rings[0].dropped, (uint32_t)(100 - RING_EVENTS));
+    for (size_t i = 0; i < RING_EVENTS; i++) {
+        EXPECT_EQ(d.rings[0].records[i].value, (int32_t)(100 - RING_EVENTS + i));
+    }
+}
+
+static void concurrent_tasks_get_own_rings() {
+    EventTrace::clear();
+    static constexpr int THREADS = 3;
+    static constexpr int EVENTS = 50;
+    const uint16_t names[THREADS] = {TRACE_NAME_AUTO_TX, TRACE_NAME_TCP_TX, TRACE_NAME_LORA_TX};
+    std::atomic<bool> go{false};
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t] {
+            while (!go.load()) std::this_thread::yield();
+            for (int i = 0; i < EVENTS; i++) EventTrace::record(names[t], EVENT_TRACE_INSTANT, i);
+            // Hold the ring until all are done; a released ring would be
+            // handed to the next same-named task
+            finished++;
+            while (finished.load() < THREADS) std::this_thread::yield();
+            EventTrace::releaseThread();
+        });
+    }
+    go = true;
+    for (auto& th : threads) th.join();
+
+    Dump d = parse(dumpBytes());
+    EXPECT_EQ(d.header.lost, (uint32_t)0);
+    for (int t = 0; t < THREADS; t++) {
+        const Ring* r = ringWith(d, names[t]);
+        EXPECT_TRUE(r != nullptr);
+        EXPECT_EQ(r->records.size(), (size_t)EVENTS);
+        for (int i = 0; i < EVENTS; i++) {
+            EXPECT_EQ(r->records[i].name, names[t]);
+            EXPECT_EQ(r->records[i].value, i);
+        }
+    }
+}
+
+static void released_rings_reused_then_exhausted() {
+    EventTrace::clear();
+    size_t rings_before = EventTrace::ringCount();
+
+    // Same task name coming back keeps appending to its old ring
+    std::thread([] { EVENT_TRACE_INSTANT(BLE_TX, 1); EVENT_TRACE_THREAD_EXIT(); }).join();
+    std::thread([] { EVENT_TRACE_INSTANT(BLE_TX, 2); EVENT_TRACE_THREAD_EXIT(); }).join();
+    EXPECT_EQ(EventTrace::ringCount(), rings_before);
+    Dump d = parse(dumpBytes());
+    const Ring* r = ringWith(d, TRACE_NAME_BLE_TX);
+    EXPECT_TRUE(r != nullptr);
+    EXPECT_EQ(r->records.size(), (size_t)2);
+
+    // Main thread holds one ring; three live holders take the rest
+    EVENT_TRACE_INSTANT(USER, 0);
+    std::atomic<int> claimed{0};
+    std::atomic<bool> done{false};
+    std::vector<std::thread> holders;
+    for (int t = 0; t < EVENT_TRACE_RINGS - 1; t++) {
+        holders.emplace_back([&] {
+            EVENT_TRACE_INSTANT(BLE_RX, 1);
+            claimed++;
+            while (!done.load()) std::this_thread::yield();
+            EVENT_TRACE_THREAD_EXIT();
+        });
+    }
+    while (claimed.load() < EVENT_TRACE_RINGS - 1) std::this_thread::yield();
+    std::thread([] { EVENT_TRACE_INSTANT(LORA_RX, 1); EVENT_TRACE_INSTANT(LORA_RX, 2); }).join();
+    done = true;
+    for (auto& th : holders) th.join();
+
+    EXPECT_EQ(EventTrace::header().lost, (uint32_t)2);
+    EXPECT_EQ(EventTrace::ringCount(), (size_t)EVENT_TRACE_RINGS);
+    EXPECT_TRUE(ringWith(parse(dumpBytes()), TRACE_NAME_LORA_RX) == nullptr);
+}
+
+static void stop_start_clear() {
+    EventTrace::clear();
+    EXPECT_EQ(EventTrace::header().lost, (uint32_t)0);
+    EventTrace::stop();
+    EVENT_TRACE_INSTANT(USER, 1);
+    EventTrace::start();
+    EVENT_TRACE_INSTANT(USER, 2);
+
+    std::vector<uint8_t> b = dumpBytes();
+    EXPECT_EQ(b.size(), EventTrace::dumpSize());
+    Dump d = parse(b);
+    size_t total = 0;
+    for (const Ring& r : d.rings) total += r.records.size();
+    EXPECT_EQ(total, (size_t)1);
+    EXPECT_EQ(ringWith(d, TRACE_NAME_USER)->records[0].value, 2);
+}
+
+static void record_cost_per_event() {
+    EventTrace::clear();
+    static constexpr int N = 1000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) EventTrace::record(TRACE_NAME_USER, EVENT_TRACE_INSTANT, i);
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    std::printf("  record(): %.1f ns/event\n", ns);
+    // Native cost is dominated by steady_clock; the device reads a register
+    EXPECT_TRUE(ns < 500.0);
+}
+
+// Multi-task dump for the converter test: two tasks, nested spans, a counter
+static int writeDump(const char* path) {
+    EventTrace::init(RING_EVENTS);
+    std::thread([] {
+        for (int i = 0; i < 3; i++) {
+            EVENT_TRACE_SCOPE_V(RETICULUM_LOOP, i);
+            EVENT_TRACE_SCOPE_V(TCP_RX, 100 + i);
+        }
+        // No THREAD_EXIT: native tasks share a name, so main would reuse the ring
+    }).join();
+    {
+        EVENT_TRACE_SCOPE(LVGL_FLUSH);
+        EVENT_TRACE_COUNTER(CAPTURE_RING_DROPS, 5);
+    }
+    EventTrace::stop();
+    std::vector<uint8_t> b = dumpBytes();
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return 1;
+    std::fwrite(b.data(), 1, b.size(), f);
+    std::fclose(f);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--dump") == 0) return writeDump(argv[2]);
+
+    RUN(nothing_recorded_before_init);
+    RUN(events_land_in_order);
+    RUN(full_ring_overwrites_oldest);
+    RUN(concurrent_tasks_get_own_rings);
+    RUN(released_rings_reused_then_exhausted);
+    RUN(stop_start_clear);
+    RUN(record_cost_per_event);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
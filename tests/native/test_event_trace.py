@@ -0,0 +1,174 @@
+"""Tests for the timeline trace recorder and its host-side converter.
+
+Runs the native EventTrace tests, then converts a dump written by the same
+binary with tools/trace/trace_to_perfetto.py and checks the Chrome/Perfetto
+JSON. Also covers the serial block extraction and cycle-counter unwrapping.
+"""
+
+import json
+import shutil
+import struct
+import subprocess
+import sys
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+PYXIS_ROOT = HERE.parent.parent
+SHIM = PYXIS_ROOT / "lib" / "microreticulum-shim"
+TRACE_SOURCE = SHIM / "Instrumentation" / "EventTrace.cpp"
+TOOLS = PYXIS_ROOT / "tools" / "trace"
+
+sys.path.insert(0, str(TOOLS))
+import trace_to_perfetto as convert  # noqa: E402
+
+
+def _find_cxx():
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    pytest.skip("no C++ compiler found")
+
+
+def _compile(tmp_path, source, extra=()):
+    cxx = _find_cxx()
+    binary = tmp_path / source.stem
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-O2",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        "-pthread",
+        "-DEVENT_TRACE_ENABLED",
+        "-DEVENT_TRACE_RINGS=4",
+        *extra,
+        f"-I{HERE}",
+        f"-I{SHIM}",
+        str(source),
+        str(TRACE_SOURCE),
+        "-o", str(binary),
+    ]
+    compile_result = subprocess.run(cmd, capture_output=True, text=True)
+    assert compile_result.returncode == 0, (
+        f"compilation failed:\n--- cmd ---\n{' '.join(cmd)}\n"
+        f"--- stderr ---\n{compile_result.stderr}"
+    )
+    return binary
+
+
+@pytest.fixture(scope="module")
+def binary(tmp_path_factory):
+    return _compile(tmp_path_factory.mktemp("event_trace"), HERE / "test_event_trace.cpp")
+
+
+def test_event_trace(binary):
+    run_result = subprocess.run([str(binary)], capture_output=True, text=True, timeout=60)
+    assert run_result.returncode == 0, (
+        f"tests failed:\n--- stdout ---\n{run_result.stdout}\n"
+        f"--- stderr ---\n{run_result.stderr}"
+    )
+    summary = run_result.stdout.strip().splitlines()[-1]
+    parts = summary.split()
+    pass_count = int(parts[0])
+    fail_count = int(parts[2])
+    assert fail_count == 0, run_result.stdout
+    assert pass_count >= 7, f"expected at least 7 event trace tests, ran {pass_count}"
+
+
+def test_converter_round_trip(binary, tmp_path):
+    dump = tmp_path / "run.etrace"
+    subprocess.run([str(binary), "--dump", str(dump)], check=True, timeout=30)
+
+    trace = convert.parse_dump(dump.read_bytes())
+    assert trace["cpu_mhz"] == 1000
+    assert trace["names"][0] == "reticulum.loop"
+    assert len(trace["rings"]) == 2
+
+    out = tmp_path / "trace.json"
+    subprocess.run([sys.executable, str(TOOLS / "trace_to_perfetto.py"), str(dump), "-o", str(out)],
+                   check=True, timeout=30)
+    events = json.loads(out.read_text())["traceEvents"]
+
+    threads = [e for e in events if e["ph"] == "M" and e["name"] == "thread_name"]
+    assert [t["args"]["name"] for t in threads] == ["thread", "thread"]
+
+    timed = [e for e in events if e["ph"] != "M"]
+    assert min(e["ts"] for e in timed) == 0
+    worker = [e for e in timed if e["tid"] == 1]
+    assert [(e["ph"], e["name"]) for e in worker[:4]] == [
+        ("B", "reticulum.loop"), ("B", "tcp.handle_incoming"),
+        ("E", "tcp.handle_incoming"), ("E", "reticulum.loop")]
+    assert worker[1]["args"] == {"value": 100, "core": 0}
+    assert len(worker) == 12
+    assert all(b["ts"] <= a["ts"] for b, a in zip(worker, worker[1:]))
+
+    counters = [e for e in timed if e["ph"] == "C"]
+    assert counters == [{"pid": 1, "tid": 2, "ts": counters[0]["ts"],
+                         "name": "audio.capture_ring_drops", "ph": "C", "args": {"value": 5}}]
+
+
+def _synthetic_dump(records, mhz=240, offsets=(0, 0), dropped=0):
+    names = [b"reticulum.loop", b"lvgl.flush"]
+    blob = convert.HEADER.pack(convert.MAGIC, convert.VERSION, convert.RECORD.size, mhz,
+                               offsets[0], offsets[1], len(names), 1, 0)
+    for n in names:
+        blob += bytes([len(n)]) + n
+    blob += convert.RING_HEADER.pack(b"loopTask", len(records), dropped)
+    for r in records:
+        blob += convert.RECORD.pack(*r)
+    return blob
+
+
+def test_unwraps_cycles_and_aligns_cores():
+    mhz = 240
+    wrap_ms = 2**32 // (mhz * 1000)   # ~17.9s
+    # Same instant 30s in (one wrap), seen from core 0 and from core 1 whose
+    # counter runs 1000 cycles behind
+    full = 30_000 * 1000 * mhz
+    records = [
+        (0, 0, 0, convert.BEGIN, 0, 0),
+        (full & 0xFFFFFFFF, 30_000, 1, convert.INSTANT, 0, 0),
+        ((full - 1000) & 0xFFFFFFFF, 30_000, 1, convert.INSTANT, 1, 0),
+        ((full + 5 * mhz) & 0xFFFFFFFF, 30_000, 0, convert.END, 0, 0),
+    ]
+    trace = convert.parse_dump(_synthetic_dump(records, mhz, offsets=(0, 1000)))
+    ts = [e["ts"] for e in convert.to_chrome(trace)["traceEvents"] if e["ph"] != "M"]
+    assert wrap_ms < 30_000
+    assert ts == [0, 30_000_000, 30_000_000, 30_000_005]
+
+
+def test_drops_end_whose_begin_was_overwritten():
+    records = [
+        (100, 0, 0, convert.END, 0, 0),
+        (200, 0, 1, convert.BEGIN, 0, 9),
+        (300, 0, 1, convert.END, 0, 0),
+    ]
+    trace = convert.parse_dump(_synthetic_dump(records, dropped=40))
+    chrome = convert.to_chrome(trace)
+    timed = [e for e in chrome["traceEvents"] if e["ph"] != "M"]
+    assert [(e["ph"], e["name"]) for e in timed] == [("B", "lvgl.flush"), ("E", "lvgl.flush")]
+    thread = [e for e in chrome["traceEvents"] if e.get("name") == "thread_name"][0]
+    assert "40 older events overwritten" in thread["args"]["name"]
+
+
+def test_serial_extraction():
+    body = _synthetic_dump([(1, 0, 0, convert.INSTANT, 0, 3)])
+    # The end marker inside the binary must not cut the block short
+    body += b"ETRACE_END\n"
+    framed = (b"[INFO] log line\r\n"
+              + f"ETRACE_BEGIN {len(body)} {sum(body)}\n".encode()
+              + body + b"\r\nETRACE_END\r\n")
+    assert convert.extract_serial_dump(framed) == body
+
+    with pytest.raises(ValueError, match="checksum"):
+        convert.extract_serial_dump(framed.replace(b"loopTask", b"loopTasK"))
+    with pytest.raises(ValueError, match="expected"):
+        convert.extract_serial_dump(framed[:60])
+    with pytest.raises(ValueError, match="no ETRACE_BEGIN"):
+        convert.extract_serial_dump(b"nothing here")
+    with pytest.raises(ValueError, match="bad trace header"):
+        convert.parse_dump(struct.pack("<I", 0) + body[4:])
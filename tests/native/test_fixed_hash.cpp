@@ -0,0 +1,177 @@
+// Native unit tests for FixedHash (Hash16/Hash32) inline key values.
+//
+// These replace RNS::Bytes keys in the AutoInterface dedup deque and the
+// BLE reassembler/peer/identity tables, so a wrong equality or a silent
+// truncation merges two peers or drops a packet as a duplicate. Tests:
+//
+//   - round trip with Bytes; size is part of equality
+//   - oversize input yields an empty value, never a truncated one
+//   - a 6-byte MAC and a 16-byte identity with the same prefix differ
+//   - Bytes-side comparisons in both directions
+//   - trivially copyable; copies compare equal without sharing state
+//   - hash() spreads sequential and single-bit-different keys; usable in
+//     std::unordered_set
+
+#include "../../lib/microreticulum-shim/FixedHash.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_set>
+
+using RNS::Bytes;
+using RNS::FixedHash;
+using RNS::Hash16;
+using RNS::Hash32;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+static Bytes pattern(size_t n, uint8_t seed) {
+    Bytes b;
+    for (size_t i = 0; i < n; i++) b.append((uint8_t)(seed + i * 7));
+    return b;
+}
+
+// ── tests ──
+
+static void round_trip_with_bytes() {
+    Bytes id = pattern(16, 1);
+    Hash16 h(id);
+    EXPECT_EQ(h.size(), (size_t)16);
+    EXPECT_TRUE(!h.empty());
+    EXPECT_TRUE(h.toBytes() == id);
+    EXPECT_EQ(std::memcmp(h.data(), id.data(), 16), 0);
+
+    Hash32 full(pattern(32, 9));
+    EXPECT_EQ(full.size(), (size_t)32);
+    EXPECT_TRUE(full.toBytes() == pattern(32, 9));
+}
+
+static void oversize_is_empty() {
+    Hash16 h(pattern(17, 1));
+    EXPECT_TRUE(h.empty());
+    Hash16 ok;
+    EXPECT_TRUE(ok.assign(pattern(16, 1).data(), 16));
+    EXPECT_TRUE(!ok.assign(pattern(32, 1).data(), 32));
+    EXPECT_TRUE(ok.empty());
+    EXPECT_TRUE(ok == Hash16());
+}
+
+static void size_is_part_of_equality() {
+    Bytes id = pattern(16, 3);
+    Hash16 identity(id);
+    Hash16 mac(id.data(), 6);         // Same leading bytes, MAC-sized
+    EXPECT_TRUE(identity != mac);
+    uint8_t zero_mac[6] = {0};
+    Hash16 zeros(zero_mac, 6);
+    EXPECT_TRUE(zeros != Hash16());  // Six zero bytes is not the empty key
+    mac.clear();
+    EXPECT_TRUE(mac.empty());
+    EXPECT_TRUE(mac == Hash16());
+}
+
+static void compares_against_bytes() {
+    Bytes id = pattern(16, 5);
+    Bytes other = pattern(16, 6);
+    Hash16 h(id);
+    EXPECT_TRUE(h == id);
+    EXPECT_TRUE(id == h);
+    EXPECT_TRUE(h != other);
+    EXPECT_TRUE(other != h);
+    EXPECT_TRUE(h != Bytes(id.data(), 15));
+    EXPECT_TRUE(Hash16() == Bytes());
+}
+
+static void trivially_copyable() {
+    EXPECT_TRUE(std::is_trivially_copyable<Hash16>::value);
+    EXPECT_TRUE(std::is_trivially_copyable<Hash32>::value);
+    Hash16 a(pattern(16, 7));
+    Hash16 b = a;
+    EXPECT_TRUE(a == b);
+    b.assign(pattern(16, 8).data(), 16);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(a == pattern(16, 7));
+    Hash16 c;
+    std::memcpy(&c, &a, sizeof(Hash16));
+    EXPECT_TRUE(c == a);
+}
+
+static void hash_spreads_and_works_in_sets() {
+    // Sequential keys differing in one byte, as BLE MAC counters do
+    std::unordered_set<uint32_t> buckets;
+    for (int i = 0; i < 256; i++) {
+        uint8_t mac[6] = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, (uint8_t)i};
+        buckets.insert(FixedHash<6>(mac, 6).hash() & 63);
+    }
+    EXPECT_TRUE(buckets.size() >= 48);   // Low bits usable for a 64-slot table
+
+    Hash32 a(pattern(32, 1));
+    Bytes flipped = pattern(32, 1);
+    flipped.data()[31] ^= 0x01;
+    EXPECT_TRUE(a.hash() != Hash32(flipped).hash());
+
+    std::unordered_set<Hash16> set;
+    for (uint8_t s = 0; s < 100; s++) set.insert(Hash16(pattern(16, s)));
+    set.insert(Hash16(pattern(16, 42)));
+    EXPECT_EQ(set.size(), (size_t)100);
+    EXPECT_TRUE(set.count(Hash16(pattern(16, 99))) == 1);
+    EXPECT_TRUE(set.count(Hash16(pattern(16, 100))) == 0);
+}
+
+static void hex_matches_bytes() {
+    uint8_t raw[3] = {0x00, 0xAB, 0x7F};
+    FixedHash<4> h(raw, 3);
+    EXPECT_TRUE(h.toHex() == "00ab7f");
+}
+
+int main() {
+    RUN(round_trip_with_bytes);
+    RUN(oversize_is_empty);
+    RUN(size_is_part_of_equality);
+    RUN(compares_against_bytes);
+    RUN(trivially_copyable);
+    RUN(hash_spreads_and_works_in_sets);
+    RUN(hex_matches_bytes);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -7,6 +7,16 @@
 //   In payload: 0x7E -> 0x7D 0x5E   (ESC + (FLAG ^ ESC_MASK))
 //               0x7D -> 0x7D 0x5D   (ESC + (ESC  ^ ESC_MASK))
 //
+// The word-at-a-time scan is checked against a byte-by-byte reference over
+// every length and special-byte position that straddles a word boundary,
+// plus frame_into() sizing.
+//
+// HDLCDecoder (streaming receive) is checked against the buffer-scanning
+// extractor it replaced in TCPClientInterface: random streams with garbage,
+// empty frames, bare-ESC endings and non-canonical escapes, fed in random
+// chunk sizes, must produce the same frames and drop counts (a garbage run
+// now counts as one drop however many reads it spans).
+//
 // Build: see test_hdlc.py for the g++ invocation.
 
 #include "../../src/HDLC.h"
@@ -183,6 +193,246 @@ static void golden_vector_matches_python_rns() {
     EXPECT_EQ(hex(framed), std::string("7e017d5e7d5d027e"));
 }
 
+// Byte-by-byte reference: the pre-SWAR implementation
+static Bytes reference_escape(const Bytes& data) {
+    Bytes result;
+    for (size_t i = 0; i < data.size(); ++i) {
+        uint8_t byte = data.data()[i];
+        if (byte == HDLC::ESC || byte == HDLC::FLAG) {
+            result.append(HDLC::ESC);
+            result.append((uint8_t)(byte ^ HDLC::ESC_MASK));
+        } else {
+            result.append(byte);
+        }
+    }
+    return result;
+}
+
+static void swar_matches_reference_at_every_position() {
+    // Lengths 0..40 cover partial and whole 4/8-byte words; each special
+    // byte (plus neighbours that differ from it only in bit 7 or bit 0,
+    // which a carrying SWAR compare would confuse) at every position.
+    const uint8_t probes[] = {HDLC::FLAG, HDLC::ESC, 0xFE, 0xFD, 0x7F, 0x7C, 0x00, 0xFF};
+    for (size_t len = 0; len <= 40; ++len) {
+        for (size_t pos = 0; pos <= len; ++pos) {
+            for (uint8_t probe : probes) {
+                Bytes data;
+                for (size_t i = 0; i < len; ++i) {
+                    data.append(i == pos ? probe : (uint8_t)(0x41 + i));
+                }
+                Bytes expect = reference_escape(data);
+                Bytes esc = HDLC::escape(data);
+                if (esc != expect) {
+                    std::printf("    len=%zu pos=%zu probe=%02x\n", len, pos, probe);
+                }
+                EXPECT_EQ(esc, expect);
+                EXPECT_EQ(HDLC::escaped_size(data.data(), data.size()), expect.size());
+                EXPECT_EQ(HDLC::unescape(esc), data);
+            }
+        }
+    }
+}
+
+static void swar_matches_reference_random() {
+    uint32_t x = 0xC0FFEE;
+    for (int round = 0; round < 2000; ++round) {
+        x = x * 1664525u + 1013904223u;
+        size_t len = x % 300;
+        Bytes data;
+        for (size_t i = 0; i < len; ++i) {
+            x = x * 1664525u + 1013904223u;
+            // Dense specials half the time
+            uint8_t v = (uint8_t)(x >> 24);
+            if ((round & 1) && (x & 3) == 0) v = (x & 4) ? HDLC::FLAG : HDLC::ESC;
+            data.append(v);
+        }
+        Bytes expect = reference_escape(data);
+        EXPECT_EQ(HDLC::escape(data), expect);
+        EXPECT_EQ(HDLC::unescape(expect), data);
+    }
+}
+
+static void clean_payload_passes_through_unchanged() {
+    Bytes data;
+    for (int i = 0; i < 37; ++i) data.append((uint8_t)(0x30 + i));
+    EXPECT_EQ(HDLC::escape(data), data);
+    EXPECT_EQ(HDLC::unescape(data), data);
+    EXPECT_EQ(HDLC::escaped_size(data.data(), data.size()), data.size());
+}
+
+static void unescape_truncated_after_long_run() {
+    // Trailing ESC found by the word scan, not the byte tail
+    Bytes broken;
+    for (int i = 0; i < 31; ++i) broken.append((uint8_t)i);
+    broken.append(HDLC::ESC);
+    EXPECT_EQ(HDLC::unescape(broken).size(), (size_t)0);
+}
+
+static void frame_into_sizes_exactly() {
+    Bytes payload = make_bytes({0x01, 0x7E, 0x7D, 0x02});
+    EXPECT_EQ(HDLC::frame_size(payload.data(), payload.size()), (size_t)8);
+
+    uint8_t buf[16];
+    std::memset(buf, 0xAA, sizeof(buf));
+    // One byte short: nothing written
+    EXPECT_EQ(HDLC::frame_into(payload.data(), payload.size(), buf, 7), (size_t)0);
+    EXPECT_EQ(buf[0], 0xAA);
+
+    size_t n = HDLC::frame_into(payload.data(), payload.size(), buf, 8);
+    EXPECT_EQ(n, (size_t)8);
+    EXPECT_EQ(hex(Bytes(buf, n)), std::string("7e017d5e7d5d027e"));
+    EXPECT_EQ(buf[8], 0xAA);  // no overrun
+
+    // Empty payload frames to two FLAGs
+    EXPECT_EQ(HDLC::frame_into(nullptr, 0, buf, sizeof(buf)), (size_t)2);
+    EXPECT_EQ(buf[0], HDLC::FLAG);
+    EXPECT_EQ(buf[1], HDLC::FLAG);
+}
+
+// The pre-streaming TCPClientInterface::extract_and_process_frames(), minus
+// I/O: rescan the accumulated buffer for FLAG pairs, unescape between them.
+struct ReferenceExtractor {
+    Bytes buffer;
+    std::vector<Bytes> frames;
+    uint32_t escape_drops = 0;
+
+    void feed(const uint8_t* data, size_t len) {
+        buffer.append(data, len);
+        while (buffer.size() > 0) {
+            int start = -1;
+            for (size_t i = 0; i < buffer.size(); ++i) {
+                if (buffer.data()[i] == HDLC::FLAG) { start = (int)i; break; }
+            }
+            // Garbage: counted once per read here, once per run by the decoder
+            if (start < 0) { buffer.clear(); break; }
+            if (start > 0) { buffer = buffer.mid(start); }
+            int end = -1;
+            for (size_t i = 1; i < buffer.size(); ++i) {
+                if (buffer.data()[i] == HDLC::FLAG) { end = (int)i; break; }
+            }
+            if (end < 0) break;
+            Bytes content = buffer.mid(1, end - 1);
+            buffer = buffer.mid(end);
+            if (content.size() == 0) continue;
+            Bytes unescaped = HDLC::unescape(content);
+            if (unescaped.size() == 0) { escape_drops++; continue; }
+            frames.push_back(unescaped);
+        }
+    }
+};
+
+static void decoder_matches_buffer_scan_random_streams() {
+    uint32_t x = 0xBADC0DE;
+    auto rnd = [&x]() { x = x * 1664525u + 1013904223u; return x >> 8; };
+    for (int round = 0; round < 300; ++round) {
+        // Build a stream: leading garbage (no FLAG) then frames of mixed kinds
+        Bytes stream;
+        size_t garbage = rnd() % 8;
+        for (size_t i = 0; i < garbage; ++i) stream.append((uint8_t)(0x20 + rnd() % 64));
+        int frames = 1 + rnd() % 12;
+        for (int f = 0; f < frames; ++f) {
+            Bytes payload;
+            size_t len = rnd() % 200;
+            for (size_t i = 0; i < len; ++i) payload.append((uint8_t)rnd());
+            Bytes framed = HDLC::frame(payload);
+            switch (rnd() % 6) {
+                case 0:  // bare ESC before the closing FLAG
+                    stream.append(framed.data(), framed.size() - 1);
+                    stream.append(HDLC::ESC);
+                    stream.append(HDLC::FLAG);
+                    break;
+                case 1:  // non-canonical escape
+                    stream.append(HDLC::FLAG);
+                    stream.append(HDLC::ESC);
+                    stream.append((uint8_t)0x00);
+                    stream.append(framed.data() + 1, framed.size() - 1);
+                    break;
+                default:
+                    stream.append(framed);
+                    break;
+            }
+        }
+        // Trailing partial frame
+        if (rnd() & 1) { stream.append(HDLC::FLAG); stream.append((uint8_t)0x42); }
+
+        ReferenceExtractor ref;
+        RNS::HDLCDecoder<512> dec;
+        std::vector<Bytes> got;
+        size_t off = 0;
+        while (off < stream.size()) {
+            size_t n = 1 + rnd() % 64;
+            if (n > stream.size() - off) n = stream.size() - off;
+            ref.feed(stream.data() + off, n);
+            dec.feed(stream.data() + off, n, [&](const uint8_t* f, size_t len) {
+                got.push_back(Bytes(f, len));
+            });
+            off += n;
+        }
+        EXPECT_EQ(got.size(), ref.frames.size());
+        for (size_t i = 0; i < got.size() && i < ref.frames.size(); ++i) {
+            EXPECT_EQ(got[i], ref.frames[i]);
+        }
+        EXPECT_EQ(dec.dropped(), ref.escape_drops + (garbage > 0 ? 1u : 0u));
+        EXPECT_EQ(dec.discarded_bytes(), (uint32_t)garbage);
+        EXPECT_EQ(dec.frames(), (uint32_t)ref.frames.size());
+    }
+}
+
+static void decoder_emits_on_closing_flag_at_every_split() {
+    Bytes payload;
+    for (int i = 0; i < 40; ++i) payload.append((uint8_t)(i % 3 == 0 ? HDLC::ESC : 0x30 + i));
+    Bytes framed = HDLC::frame(payload);
+    for (size_t split = 0; split <= framed.size(); ++split) {
+        RNS::HDLCDecoder<128> dec;
+        int emitted = 0;
+        auto on_frame = [&](const uint8_t* f, size_t len) {
+            emitted++;
+            EXPECT_EQ(Bytes(f, len), payload);
+        };
+        dec.feed(framed.data(), split, on_frame);
+        EXPECT_EQ(emitted, split == framed.size() ? 1 : 0);
+        dec.feed(framed.data() + split, framed.size() - split, on_frame);
+        EXPECT_EQ(emitted, 1);
+    }
+}
+
+static void decoder_drops_oversize_frame_and_recovers() {
+    RNS::HDLCDecoder<16> dec;
+    std::vector<Bytes> got;
+    auto on_frame = [&](const uint8_t* f, size_t len) { got.push_back(Bytes(f, len)); };
+
+    Bytes exact, big, after;
+    for (int i = 0; i < 16; ++i) exact.append((uint8_t)i);
+    for (int i = 0; i < 17; ++i) big.append((uint8_t)i);
+    big.data()[16] = HDLC::FLAG;              // overflow lands on an escaped byte
+    after.append((uint8_t)0x55);
+    Bytes stream = HDLC::frame(exact);
+    stream.append(HDLC::frame(big));
+    stream.append(HDLC::frame(after));
+    dec.feed(stream.data(), stream.size(), on_frame);
+
+    EXPECT_EQ(got.size(), (size_t)2);
+    EXPECT_EQ(got[0], exact);
+    EXPECT_EQ(got[1], after);
+    EXPECT_EQ(dec.dropped(), (uint32_t)1);
+}
+
+static void decoder_reset_discards_partial_frame() {
+    RNS::HDLCDecoder<64> dec;
+    int emitted = 0;
+    auto on_frame = [&](const uint8_t*, size_t) { emitted++; };
+    Bytes partial = make_bytes({HDLC::FLAG, 0x01, 0x02, 0x03});
+    dec.feed(partial.data(), partial.size(), on_frame);
+    EXPECT_EQ(dec.pending(), (size_t)3);
+    dec.reset();
+    EXPECT_EQ(dec.pending(), (size_t)0);
+    // Without a fresh opening FLAG these bytes are garbage, not a frame end
+    Bytes rest = make_bytes({0x04, HDLC::FLAG, 0x05, HDLC::FLAG});
+    dec.feed(rest.data(), rest.size(), on_frame);
+    EXPECT_EQ(emitted, 1);                     // just {0x05}
+    EXPECT_EQ(dec.discarded_bytes(), (uint32_t)1);
+}
+
 int main() {
     RUN(empty_payload_escape);
     RUN(plain_payload_passes_through);
@@ -195,6 +445,15 @@ int main() {
     RUN(round_trip_long_payload_with_many_escapes);
     RUN(escape_worst_case_doubles_size);
     RUN(golden_vector_matches_python_rns);
+    RUN(swar_matches_reference_at_every_position);
+    RUN(swar_matches_reference_random);
+    RUN(clean_payload_passes_through_unchanged);
+    RUN(unescape_truncated_after_long_run);
+    RUN(frame_into_sizes_exactly);
+    RUN(decoder_matches_buffer_scan_random_streams);
+    RUN(decoder_emits_on_closing_flag_at_every_split);
+    RUN(decoder_drops_oversize_frame_and_recovers);
+    RUN(decoder_reset_discards_partial_frame);
 
     std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
     return g_fail == 0 ? 0 : 1;
@@ -63,4 +63,4 @@ def test_hdlc_compiles_and_passes(tmp_path):
     pass_count = int(parts[0])
     fail_count = int(parts[2])
     assert fail_count == 0, run_result.stdout
-    assert pass_count >= 10, f"expected at least 10 HDLC tests, ran {pass_count}"
+    assert pass_count >= 20, f"expected at least 20 HDLC tests, ran {pass_count}"
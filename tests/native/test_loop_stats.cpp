@@ -0,0 +1,216 @@
+// Native unit tests for the main-loop step histograms (LoopStats.h).
+//
+// T:LOOPSTATS is how loop stalls get quantified on the device, so wrong
+// bucket edges or percentiles send a stall hunt after the wrong step. Tests:
+//
+//   - bucket edges: every bucket's lower bound maps back to it, buckets are
+//     contiguous and monotonic, huge durations saturate the last bucket
+//   - p50/p99 land within a bucket of the true value and never exceed max;
+//     max, count and total are exact
+//   - step() times the step it closes; an out-of-range step only closes
+//   - over-budget steps are counted and reported once each, and the report
+//     isn't charged to the next step
+//   - reset clears everything; step() overhead stays well under 1us
+
+#include "../../lib/microreticulum-shim/Instrumentation/LoopStats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+
+using RNS::Instrumentation::LoopStats;
+using RNS::Instrumentation::LoopStepStats;
+namespace Cfg = RNS::Instrumentation::LoopStatsConfig;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+static LoopStats& stats() {
+    LoopStats& s = LoopStats::instance();
+    s.step(Cfg::MAX_STEPS);   // Close whatever a previous test left running
+    s.setOverBudgetHandler(nullptr);
+    s.setBudgetMs(1000);
+    s.reset();
+    return s;
+}
+
+static void sleep_ms(int ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static int g_over_calls = 0;
+static uint8_t g_over_step = 0xFF;
+static uint32_t g_over_us = 0;
+static int g_over_sleep_ms = 0;
+
+static void over_handler(uint8_t step, uint32_t us) {
+    g_over_calls++;
+    g_over_step = step;
+    g_over_us = us;
+    if (g_over_sleep_ms) sleep_ms(g_over_sleep_ms);
+}
+
+// ── tests ──
+
+static void bucket_edges_contiguous() {
+    EXPECT_EQ(LoopStats::bucketOf(0), (uint8_t)0);
+    EXPECT_EQ(LoopStats::bucketOf(1), (uint8_t)0);
+    for (uint8_t i = 1; i < Cfg::BUCKETS; i++) {
+        uint32_t lo = LoopStats::bucketLowerUs(i);
+        EXPECT_TRUE(lo > LoopStats::bucketLowerUs(i - 1));
+        EXPECT_EQ(LoopStats::bucketOf(lo), i);
+        EXPECT_EQ(LoopStats::bucketOf(lo - 1), (uint8_t)(i - 1));
+    }
+    // Two buckets per power of two: 4..5 and 6..7
+    EXPECT_EQ(LoopStats::bucketOf(4), LoopStats::bucketOf(5));
+    EXPECT_TRUE(LoopStats::bucketOf(6) == LoopStats::bucketOf(5) + 1);
+    EXPECT_EQ(LoopStats::bucketOf(0xFFFFFFFFu), (uint8_t)(Cfg::BUCKETS - 1));
+    // 15s stalls still get their own bucket below the saturated one
+    EXPECT_TRUE(LoopStats::bucketOf(15000000) < Cfg::BUCKETS - 1);
+}
+
+static void percentiles_and_exact_max() {
+    LoopStats& s = stats();
+    for (int i = 0; i < 99; i++) s.record(4, 100);
+    s.record(4, 50000);
+    LoopStepStats st = s.stats(4);
+    EXPECT_EQ(st.count, (uint32_t)100);
+    EXPECT_EQ(st.max_us, (uint32_t)50000);
+    EXPECT_EQ(st.total_us, (uint64_t)(99 * 100 + 50000));
+    EXPECT_TRUE(st.p50_us >= 100 && st.p50_us < 128);
+    EXPECT_TRUE(st.p99_us >= 100 && st.p99_us < 128);
+
+    // A 10% tail moves p99 but not p50
+    for (int i = 0; i < 90; i++) s.record(5, 10);
+    for (int i = 0; i < 10; i++) s.record(5, 5000);
+    st = s.stats(5);
+    EXPECT_TRUE(st.p50_us >= 10 && st.p50_us < 12);
+    EXPECT_EQ(st.p99_us, (uint32_t)5000);   // bucket edge capped at max
+    EXPECT_EQ(st.max_us, (uint32_t)5000);
+
+    // Untouched and out-of-range steps read as empty
+    EXPECT_EQ(s.stats(9).count, (uint32_t)0);
+    EXPECT_EQ(s.stats(Cfg::MAX_STEPS).count, (uint32_t)0);
+    EXPECT_TRUE(!s.record(Cfg::MAX_STEPS, 1));
+}
+
+static void step_times_the_closed_step() {
+    LoopStats& s = stats();
+    s.step(1);
+    sleep_ms(3);
+    s.step(2);
+    s.step(Cfg::MAX_STEPS);
+    LoopStepStats one = s.stats(1);
+    EXPECT_EQ(one.count, (uint32_t)1);
+    EXPECT_TRUE(one.max_us >= 3000 && one.max_us < 100000);
+    EXPECT_EQ(s.stats(2).count, (uint32_t)1);
+    EXPECT_TRUE(s.stats(2).max_us < 3000);
+
+    // Nothing is running now: another close records nothing
+    s.step(Cfg::MAX_STEPS);
+    EXPECT_EQ(s.stats(2).count, (uint32_t)1);
+}
+
+static void over_budget_reported_not_charged() {
+    LoopStats& s = stats();
+    s.setOverBudgetHandler(over_handler);
+    s.setBudgetMs(2);
+    EXPECT_EQ(s.budgetMs(), (uint32_t)2);
+    g_over_calls = 0;
+    g_over_sleep_ms = 30;   // A slow report must not land in step 4
+
+    s.step(3);
+    sleep_ms(5);
+    s.step(4);
+    s.step(Cfg::MAX_STEPS);
+
+    EXPECT_EQ(g_over_calls, 1);
+    EXPECT_EQ(g_over_step, (uint8_t)3);
+    EXPECT_TRUE(g_over_us >= 5000);
+    EXPECT_EQ(s.stats(3).over_budget, (uint32_t)1);
+    EXPECT_EQ(s.stats(4).over_budget, (uint32_t)0);
+    EXPECT_TRUE(s.stats(4).max_us < 2000);
+
+    // record() reports over-budget samples to the caller too
+    EXPECT_TRUE(s.record(6, 2001));
+    EXPECT_TRUE(!s.record(6, 2000));
+    EXPECT_EQ(s.stats(6).over_budget, (uint32_t)1);
+    g_over_sleep_ms = 0;
+}
+
+static void reset_clears() {
+    LoopStats& s = stats();
+    s.record(7, 1234);
+    s.record(7, 99999);
+    s.reset();
+    LoopStepStats st = s.stats(7);
+    EXPECT_EQ(st.count, (uint32_t)0);
+    EXPECT_EQ(st.max_us, (uint32_t)0);
+    EXPECT_EQ(st.p99_us, (uint32_t)0);
+    EXPECT_EQ(st.over_budget, (uint32_t)0);
+}
+
+static void step_overhead_under_a_microsecond() {
+    LoopStats& s = stats();
+    const int N = 200000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) s.step(static_cast<uint8_t>(i % Cfg::MAX_STEPS));
+    auto t1 = std::chrono::steady_clock::now();
+    s.step(Cfg::MAX_STEPS);
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    std::printf("  step(): %.1f ns/call\n", ns);
+    EXPECT_TRUE(ns < 1000.0);
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < Cfg::MAX_STEPS; i++) total += s.stats(i).count;
+    EXPECT_EQ(total, (uint32_t)N);
+}
+
+int main() {
+    RUN(bucket_edges_contiguous);
+    RUN(percentiles_and_exact_max);
+    RUN(step_times_the_closed_step);
+    RUN(over_budget_reported_not_charged);
+    RUN(reset_clears);
+    RUN(step_overhead_under_a_microsecond);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,325 @@
+// Native LoRaReceiver unit tests, against FakeLoRaRadio.
+//
+// The SX1262 receive path: DIO1 wakes the LoRa task, service() reads the
+// packet with its RSSI/SNR, re-arms RX and queues the payload, and the main
+// loop takes it with deliver(). Checked here: a received packet's call
+// sequence and record (RNode header stripped), a wake with no IRQ pending
+// costing one status read, other IRQs cleared without a read, CRC errors,
+// RX timeouts and runts, a full queue, deliver() budget and order, and a
+// threaded run with the fake's DIO1 edge driving a task thread while the
+// main thread drains.
+//
+// Build: see test_lora_receiver.py for the g++ invocation.
+
+#include "fake_lora_radio.h"
+#include "../../lib/sx1262_interface/LoRaReceiver.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using RNS::Instrumentation::Metrics;
+using RNS::Instrumentation::METRIC_LORA_RX_DROPS;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// ── helpers ──
+
+static const size_t MTU = 255;
+using Receiver = LoRaReceiver<MTU>;
+using Result = Receiver::Result;
+
+struct Delivered {
+    std::vector<uint8_t> payload;
+    float rssi;
+    float snr;
+    uint32_t rx_us;
+};
+
+static std::vector<Delivered> drain(Receiver& rx, size_t budget = 1000) {
+    std::vector<Delivered> out;
+    rx.deliver(budget, [&](const uint8_t* payload, size_t len, float rssi, float snr, uint32_t rx_us) {
+        out.push_back({std::vector<uint8_t>(payload, payload + len), rssi, snr, rx_us});
+    });
+    return out;
+}
+
+// [header][seq][len-2 bytes derived from seq]
+static std::vector<uint8_t> frame(uint32_t seq, size_t len) {
+    std::vector<uint8_t> f(len);
+    f[0] = static_cast<uint8_t>(0xA0 | (seq & 0x0F));   // RNode random header
+    for (size_t i = 1; i < len; ++i) f[i] = static_cast<uint8_t>(seq * 31 + i);
+    return f;
+}
+
+// ── tests ──
+
+static void received_packet_is_read_rearmed_and_queued() {
+    FakeLoRaRadio radio;
+    Receiver rx(4);
+    EXPECT_TRUE(rx.valid());
+
+    std::vector<uint8_t> f = frame(7, 40);
+    radio.receive(f, -97.5f, 6.25f);
+    EXPECT_TRUE(radio.dio1());
+
+    EXPECT_TRUE(rx.service(radio, 1234) == Result::QUEUED);
+    // status, readData, length, RSSI, SNR, startReceive
+    EXPECT_EQ(radio.spi_transactions.load(), 6u);
+    EXPECT_EQ(radio.start_receive_calls.load(), 1u);
+    EXPECT_TRUE(!radio.dio1());
+    EXPECT_EQ(rx.queued(), (size_t)1);
+
+    std::vector<Delivered> got = drain(rx);
+    EXPECT_EQ(got.size(), (size_t)1);
+    EXPECT_TRUE(got[0].payload == std::vector<uint8_t>(f.begin() + 1, f.end()));
+    EXPECT_EQ(got[0].rssi, -97.5f);
+    EXPECT_EQ(got[0].snr, 6.25f);
+    EXPECT_EQ(got[0].rx_us, 1234u);
+    EXPECT_EQ(rx.queued(), (size_t)0);
+
+    // Full-size frame: every payload byte survives the in-place header
+    std::vector<uint8_t> big = frame(9, MTU);
+    radio.receive(big, -120.0f, -12.5f);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::QUEUED);
+    got = drain(rx);
+    EXPECT_EQ(got.size(), (size_t)1);
+    EXPECT_TRUE(got[0].payload == std::vector<uint8_t>(big.begin() + 1, big.end()));
+}
+
+static void wake_without_packet_costs_one_status_read() {
+    FakeLoRaRadio radio;
+    Receiver rx(4);
+
+    // DIO1 from TX done, already cleared by send_outgoing()'s startReceive()
+    EXPECT_TRUE(rx.service(radio, 0) == Result::IDLE);
+    EXPECT_EQ(radio.spi_transactions.load(), 1u);
+    EXPECT_EQ(radio.read_calls.load(), 0u);
+
+    // Header error: cleared by re-arming, nothing read
+    radio.raise_irq(FakeLoRaRadio::IRQ_HEADER_ERR);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::REARMED);
+    EXPECT_EQ(radio.read_calls.load(), 0u);
+    EXPECT_EQ(radio.start_receive_calls.load(), 1u);
+    EXPECT_TRUE(!radio.dio1());
+
+    // Cleared, so the next packet gives DIO1 a fresh edge
+    int edges = 0;
+    static int* s_edges;
+    s_edges = &edges;
+    radio.setDio1Action([] { ++*s_edges; });
+    radio.receive(frame(1, 10), -80.0f, 9.0f);
+    EXPECT_EQ(edges, 1);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::QUEUED);
+
+    // Nothing queued and nothing pending: the main loop's side never
+    // touches the radio
+    drain(rx);
+    uint32_t before = radio.spi_transactions.load();
+    EXPECT_EQ(drain(rx).size(), (size_t)0);
+    EXPECT_EQ(radio.spi_transactions.load(), before);
+}
+
+static void errors_and_runts_are_dropped_and_rearmed() {
+    FakeLoRaRadio radio;
+    Receiver rx(4);
+    uint32_t drops = Metrics::counter(METRIC_LORA_RX_DROPS);
+
+    radio.receive(frame(1, 30), -90.0f, 1.0f, FakeLoRaRadio::ERR_CRC_MISMATCH);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::DROPPED);
+    EXPECT_EQ(rx.last_state(), FakeLoRaRadio::ERR_CRC_MISMATCH);
+    EXPECT_EQ(radio.start_receive_calls.load(), 1u);
+    EXPECT_EQ(Metrics::counter(METRIC_LORA_RX_DROPS), drops + 1);
+
+    // A timeout is not a drop
+    radio.receive(frame(2, 30), -90.0f, 1.0f, FakeLoRaRadio::ERR_RX_TIMEOUT);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::REARMED);
+    EXPECT_EQ(radio.start_receive_calls.load(), 2u);
+    EXPECT_EQ(Metrics::counter(METRIC_LORA_RX_DROPS), drops + 1);
+
+    // Header-only runt
+    radio.receive(std::vector<uint8_t>{0xA0}, -90.0f, 1.0f);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::DROPPED);
+    EXPECT_EQ(rx.last_state(), FakeLoRaRadio::ERR_NONE);
+    EXPECT_EQ(radio.start_receive_calls.load(), 3u);
+    EXPECT_EQ(Metrics::counter(METRIC_LORA_RX_DROPS), drops + 2);
+
+    // Failed re-arm is reported, the packet still queued
+    radio.start_receive_state = -2;
+    radio.receive(frame(3, 20), -90.0f, 1.0f);
+    EXPECT_TRUE(rx.service(radio, 0) == Result::QUEUED);
+    EXPECT_EQ(rx.last_state(), (int16_t)-2);
+
+    EXPECT_EQ(rx.queued(), (size_t)1);
+}
+
+static void full_queue_drops_newest_and_keeps_listening() {
+    FakeLoRaRadio radio;
+    Receiver rx(3);
+    uint32_t drops = Metrics::counter(METRIC_LORA_RX_DROPS);
+
+    for (uint32_t seq = 0; seq < 5; ++seq) {
+        radio.receive(frame(seq, 12 + seq), -100.0f, 0.0f);
+        rx.service(radio, seq);
+    }
+    EXPECT_EQ(rx.queued(), (size_t)3);
+    EXPECT_EQ(Metrics::counter(METRIC_LORA_RX_DROPS), drops + 2);
+    EXPECT_EQ(radio.start_receive_calls.load(), 5u);
+
+    std::vector<Delivered> got = drain(rx);
+    EXPECT_EQ(got.size(), (size_t)3);
+    for (uint32_t seq = 0; seq < 3; ++seq) {
+        std::vector<uint8_t> f = frame(seq, 12 + seq);
+        EXPECT_TRUE(got[seq].payload == std::vector<uint8_t>(f.begin() + 1, f.end()));
+        EXPECT_EQ(got[seq].rx_us, seq);
+    }
+}
+
+static void deliver_respects_budget_in_order() {
+    FakeLoRaRadio radio;
+    Receiver rx(8);
+    for (uint32_t seq = 0; seq < 5; ++seq) {
+        radio.receive(frame(seq, 16), -60.0f - seq, static_cast<float>(seq));
+        rx.service(radio, 100 + seq);
+    }
+
+    std::vector<Delivered> first = drain(rx, 2);
+    EXPECT_EQ(first.size(), (size_t)2);
+    EXPECT_EQ(rx.queued(), (size_t)3);
+    std::vector<Delivered> rest = drain(rx);
+    EXPECT_EQ(rest.size(), (size_t)3);
+
+    first.insert(first.end(), rest.begin(), rest.end());
+    for (uint32_t seq = 0; seq < 5; ++seq) {
+        EXPECT_EQ(first[seq].rx_us, 100 + seq);
+        EXPECT_EQ(first[seq].rssi, -60.0f - seq);
+        EXPECT_EQ(first[seq].snr, static_cast<float>(seq));
+    }
+}
+
+// DIO1 edge -> notification -> task thread service() under an "SPI mutex",
+// main thread draining concurrently. Every frame arrives once, in order,
+// and the bus sees exactly one status read and five packet calls per frame.
+static std::mutex s_notify_mutex;
+static std::condition_variable s_notify_cv;
+static uint32_t s_notifications = 0;
+
+static void dio1_isr() {
+    std::lock_guard<std::mutex> lock(s_notify_mutex);
+    ++s_notifications;          // ulTaskNotifyTake()'s counting semantics
+    s_notify_cv.notify_one();
+}
+
+static void dio1_drives_task_while_main_loop_drains() {
+    const uint32_t FRAMES = 20000;
+    FakeLoRaRadio radio;
+    Receiver rx(16);
+    radio.setDio1Action(dio1_isr);
+    s_notifications = 0;
+
+    std::atomic<bool> running{true};
+    std::mutex spi;
+    std::thread task([&] {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(s_notify_mutex);
+                s_notify_cv.wait(lock, [&] { return s_notifications > 0 || !running.load(); });
+                if (!running.load() && s_notifications == 0) return;
+                s_notifications = 0;
+            }
+            std::lock_guard<std::mutex> bus(spi);
+            rx.service(radio, 0);
+        }
+    });
+
+    std::thread air([&] {
+        for (uint32_t seq = 0; seq < FRAMES; ++seq) {
+            // Airtime: the next frame only after the radio was re-armed,
+            // and only while the main loop has room (no drops in this run)
+            while (radio.start_receive_calls.load() < seq || rx.queued() >= 15) {
+                std::this_thread::yield();
+            }
+            radio.receive(frame(seq, 2 + seq % (MTU - 1)), -(float)(seq % 120), (float)(seq % 20));
+        }
+    });
+
+    std::vector<Delivered> got;
+    got.reserve(FRAMES);
+    while (got.size() < FRAMES) {
+        rx.deliver(4, [&](const uint8_t* payload, size_t len, float rssi, float snr, uint32_t) {
+            got.push_back({std::vector<uint8_t>(payload, payload + len), rssi, snr, 0});
+        });
+        std::this_thread::yield();
+    }
+    air.join();
+    {
+        std::lock_guard<std::mutex> lock(s_notify_mutex);
+        running = false;
+        s_notify_cv.notify_one();
+    }
+    task.join();
+
+    for (uint32_t seq = 0; seq < FRAMES; ++seq) {
+        std::vector<uint8_t> f = frame(seq, 2 + seq % (MTU - 1));
+        EXPECT_TRUE(got[seq].payload == std::vector<uint8_t>(f.begin() + 1, f.end()));
+        EXPECT_EQ(got[seq].rssi, -(float)(seq % 120));
+        EXPECT_EQ(got[seq].snr, (float)(seq % 20));
+    }
+    EXPECT_EQ(radio.read_calls.load(), FRAMES);
+    EXPECT_EQ(radio.spi_transactions.load(), FRAMES * 6);
+}
+
+int main() {
+    RUN(received_packet_is_read_rearmed_and_queued);
+    RUN(wake_without_packet_costs_one_status_read);
+    RUN(errors_and_runts_are_dropped_and_rearmed);
+    RUN(full_queue_drops_newest_and_keeps_listening);
+    RUN(deliver_respects_budget_in_order);
+    RUN(dio1_drives_task_while_main_loop_drains);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+// Native unit tests for the LVGL slab allocator (lv_mem_slab) and the
+// lv_mem_hybrid routing on top of it.
+//
+// Every small LVGL object goes through this path, so a block handed out
+// twice corrupts the widget tree, and a leak into the general internal heap
+// brings back the fragmentation the slab exists to prevent. Tests:
+//
+//   - size classes: 1..256 bytes land in the region with the right class
+//   - > 256 bytes goes to PSRAM and is counted as large
+//   - a fully freed page returns to the free list and another class reuses it
+//   - region full: the hybrid falls back to PSRAM, never internal heap
+//   - fragmentation stat tracks free blocks on assigned pages
+//   - realloc: shrink in place, grow across classes and out to PSRAM, keep
+//     contents; size 0 frees
+//   - double free / stray pointers are ignored
+//   - randomized churn with stamped blocks: no block is handed out twice,
+//     and no small request touches the internal heap
+
+#include "../../lib/lv_mem_hybrid.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+static lv_mem_slab_stats_t stats(lv_mem_slab_class_stats_t* classes = nullptr) {
+    lv_mem_slab_stats_t st;
+    lv_mem_slab_get_stats(&st, classes);
+    return st;
+}
+
+static void expect_region_empty() {
+    lv_mem_slab_stats_t st = stats();
+    EXPECT_EQ((unsigned)st.pages_free, (unsigned)LV_MEM_SLAB_PAGE_COUNT);
+}
+
+// ── tests ──
+
+static void init_reserves_region() {
+    EXPECT_TRUE(lv_mem_slab_init());
+    EXPECT_TRUE(lv_mem_slab_init());   // Idempotent
+    lv_mem_slab_stats_t st = stats();
+    EXPECT_EQ((unsigned)st.region_bytes, (unsigned)LV_MEM_SLAB_REGION_BYTES);
+    EXPECT_EQ((unsigned)st.pages_total, (unsigned)LV_MEM_SLAB_PAGE_COUNT);
+    expect_region_empty();
+}
+
+static void size_classes() {
+    const size_t sizes[] = {1, 16, 17, 48, 100, 129, 256};
+    const size_t expect[] = {16, 16, 32, 48, 128, 192, 256};
+    void* p[7];
+    for (int i = 0; i < 7; i++) {
+        p[i] = lv_mem_hybrid_alloc(sizes[i]);
+        EXPECT_TRUE(lv_mem_slab_owns(p[i]));
+        EXPECT_EQ(lv_mem_slab_block_size(p[i]), expect[i]);
+        EXPECT_EQ((uintptr_t)p[i] % 16, (uintptr_t)0);
+        std::memset(p[i], 0xA5, sizes[i]);
+    }
+    lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT];
+    stats(classes);
+    EXPECT_EQ(classes[0].in_use, 2u);    // 1 and 16
+    EXPECT_EQ(classes[0].blocks, 64u);   // One 1KB page of 16-byte blocks
+    for (int i = 0; i < 7; i++) lv_mem_hybrid_free(p[i]);
+    expect_region_empty();
+}
+
+static void large_goes_to_psram() {
+    size_t spiram_before = heap_caps_shim().spiram_allocs;
+    size_t large_before = stats().large_allocs;
+    void* p = lv_mem_hybrid_alloc(257);
+    EXPECT_TRUE(p != nullptr);
+    EXPECT_TRUE(!lv_mem_slab_owns(p));
+    EXPECT_EQ(heap_caps_shim().spiram_allocs, spiram_before + 1);
+    EXPECT_EQ(stats().large_allocs, large_before + 1);
+    size_t frees_before = heap_caps_shim().frees;
+    lv_mem_hybrid_free(p);
+    EXPECT_EQ(heap_caps_shim().frees, frees_before + 1);
+}
+
+static void empty_page_reused_by_other_class() {
+    std::vector<void*> small;
+    for (int i = 0; i < 64; i++) small.push_back(lv_mem_hybrid_alloc(16));
+    EXPECT_EQ((unsigned)stats().pages_free, (unsigned)LV_MEM_SLAB_PAGE_COUNT - 1);
+    uintptr_t page = (uintptr_t)small[0] & ~(uintptr_t)(LV_MEM_SLAB_PAGE_BYTES - 1);
+    for (void* p : small) lv_mem_hybrid_free(p);
+    expect_region_empty();
+    void* big = lv_mem_hybrid_alloc(200);
+    EXPECT_EQ((uintptr_t)big & ~(uintptr_t)(LV_MEM_SLAB_PAGE_BYTES - 1), page);
+    EXPECT_EQ(lv_mem_slab_block_size(big), (size_t)256);
+    lv_mem_hybrid_free(big);
+    expect_region_empty();
+}
+
+static void full_region_falls_back_to_psram() {
+    lv_mem_slab_reset_peaks();
+    size_t internal_before = heap_caps_shim().internal_allocs;
+    std::vector<void*> blocks;
+    const size_t capacity = LV_MEM_SLAB_PAGE_COUNT * (LV_MEM_SLAB_PAGE_BYTES / 256);
+    for (size_t i = 0; i < capacity; i++) {
+        void* p = lv_mem_hybrid_alloc(256);
+        EXPECT_TRUE(lv_mem_slab_owns(p));
+        blocks.push_back(p);
+    }
+    EXPECT_EQ((unsigned)stats().pages_free, 0u);
+    void* spill = lv_mem_hybrid_alloc(24);
+    EXPECT_TRUE(spill != nullptr);
+    EXPECT_TRUE(!lv_mem_slab_owns(spill));
+    EXPECT_EQ(heap_caps_shim().internal_allocs, internal_before);
+
+    lv_mem_slab_class_stats_t classes[LV_MEM_SLAB_CLASS_COUNT];
+    stats(classes);
+    EXPECT_EQ(classes[1].fallbacks, 1u);      // 24 bytes -> 32-byte class
+    EXPECT_EQ(classes[7].peak, (uint32_t)capacity);
+    lv_mem_hybrid_free(spill);
+    for (void* p : blocks) lv_mem_hybrid_free(p);
+    expect_region_empty();
+}
+
+static void fragmentation_stat() {
+    std::vector<void*> blocks;
+    for (int i = 0; i < 64; i++) blocks.push_back(lv_mem_hybrid_alloc(16));
+    EXPECT_EQ((unsigned)stats().fragmentation, 0u);
+    for (int i = 0; i < 64; i += 2) lv_mem_hybrid_free(blocks[i]);
+    EXPECT_EQ((unsigned)stats().fragmentation, 50u);
+    for (int i = 1; i < 64; i += 2) lv_mem_hybrid_free(blocks[i]);
+    EXPECT_EQ((unsigned)stats().fragmentation, 0u);   // Page released
+    expect_region_empty();
+}
+
+static void realloc_paths() {
+    char* p = (char*)lv_mem_hybrid_realloc(nullptr, 40);
+    EXPECT_TRUE(lv_mem_slab_owns(p));
+    std::strcpy(p, "lvgl label text");
+    EXPECT_TRUE(lv_mem_hybrid_realloc(p, 20) == p);       // Shrink in place
+    EXPECT_TRUE(lv_mem_hybrid_realloc(p, 48) == p);       // Still fits its class
+
+    char* q = (char*)lv_mem_hybrid_realloc(p, 150);      // Moves to 192 class
+    EXPECT_TRUE(q != p);
+    EXPECT_TRUE(lv_mem_slab_owns(q));
+    EXPECT_EQ(lv_mem_slab_block_size(q), (size_t)192);
+    EXPECT_EQ(std::strcmp(q, "lvgl label text"), 0);
+
+    char* r = (char*)lv_mem_hybrid_realloc(q, 1000);     // Out to PSRAM
+    EXPECT_TRUE(!lv_mem_slab_owns(r));
+    EXPECT_EQ(std::strcmp(r, "lvgl label text"), 0);
+    expect_region_empty();
+
+    char* s = (char*)lv_mem_hybrid_realloc(r, 2000);     // Heap block stays on heap
+    EXPECT_EQ(std::strcmp(s, "lvgl label text"), 0);
+    EXPECT_TRUE(lv_mem_hybrid_realloc(s, 0) == nullptr);  // Frees
+}
+
+static void stray_and_double_free_ignored() {
+    void* a = lv_mem_hybrid_alloc(64);
+    void* b = lv_mem_hybrid_alloc(64);
+    lv_mem_slab_free(a);
+    lv_mem_slab_free(b);
+    lv_mem_slab_free(b);                 // Page already released
+    int on_stack = 0;
+    lv_mem_slab_free(&on_stack);         // Not in region
+    lv_mem_slab_free(nullptr);
+    expect_region_empty();
+    void* c = lv_mem_hybrid_alloc(64);
+    void* d = lv_mem_hybrid_alloc(64);
+    EXPECT_TRUE(c != d);
+    lv_mem_hybrid_free(c);
+    lv_mem_hybrid_free(d);
+}
+
+static void randomized_churn() {
+    struct Block { uint8_t* p; size_t size; uint8_t stamp; };
+    std::vector<Block> live;
+    size_t internal_before = heap_caps_shim().internal_allocs;
+    uint32_t rng = 0xC0FFEE;
+    for (int step = 0; step < 200000; step++) {
+        rng = rng * 1664525u + 1013904223u;
+        bool alloc = live.empty() || ((rng >> 16) % 100) < 55 || live.size() < 32;
+        if (live.size() > 400) alloc = false;
+        if (alloc) {
+            size_t size = 1 + (rng >> 8) % 256;
+            uint8_t stamp = (uint8_t)(rng >> 24);
+            uint8_t* p = (uint8_t*)lv_mem_hybrid_alloc(size);
+            EXPECT_TRUE(p != nullptr);
+            std::memset(p, stamp, size);
+            live.push_back({p, size, stamp});
+        } else {
+            size_t i = (rng >> 8) % live.size();
+            Block b = live[i];
+            for (size_t k = 0; k < b.size; k++) {
+                if (b.p[k] != b.stamp) throw std::runtime_error("block overwritten: handed out twice");
+            }
+            lv_mem_hybrid_free(b.p);
+            live[i] = live.back();
+            live.pop_back();
+        }
+    }
+    for (const Block& b : live) lv_mem_hybrid_free(b.p);
+    EXPECT_EQ(heap_caps_shim().internal_allocs, internal_before);
+    expect_region_empty();
+}
+
+int main() {
+    RUN(init_reserves_region);
+    RUN(size_classes);
+    RUN(large_goes_to_psram);
+    RUN(empty_page_reused_by_other_class);
+    RUN(full_region_falls_back_to_psram);
+    RUN(fragmentation_stat);
+    RUN(realloc_paths);
+    RUN(stray_and_double_free_ignored);
+    RUN(randomized_churn);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+// Native unit tests for the metrics registry (Metrics.h).
+//
+// T:METRICS is scraped by the soak harness, so the line format and names are
+// an interface. Tests:
+//
+//   - the compile-time list expands to consistent enums and unique names;
+//     every interface exports the same metric set
+//   - counters add and wrap at 2^32; gauges hold the last value
+//   - histogram buckets: a value equal to a bound lands in that bucket,
+//     anything above the last bound in the overflow bucket; count/sum exact
+//   - dump: header, one line per metric in registry order, cumulative
+//     buckets ending at le_inf == count, footer; worst-case line fits
+//   - concurrent adds from several threads lose nothing; add() cost
+
+#include "../../lib/microreticulum-shim/Instrumentation/Metrics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace RNS::Instrumentation;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// ── helpers ──
+
+static std::vector<std::string> dumpLines(uint32_t uptime_ms = 1234) {
+    std::vector<std::string> lines;
+    Metrics::dump([](const char* line, void* ctx) {
+        static_cast<std::vector<std::string>*>(ctx)->push_back(line);
+    }, &lines, uptime_ms);
+    return lines;
+}
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    size_t pos = 0;
+    while (pos < s.size()) {
+        size_t end = s.find(' ', pos);
+        if (end == std::string::npos) end = s.size();
+        out.push_back(s.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return out;
+}
+
+// ── tests ──
+
+static void registry_is_consistent() {
+    EXPECT_EQ(Metrics::count(),
+              (size_t)(METRIC_COUNTER_COUNT + METRIC_GAUGE_COUNT + METRIC_HISTOGRAM_COUNT));
+    std::set<std::string> names;
+    for (size_t i = 0; i < METRIC_COUNTER_COUNT; i++) names.insert(Metrics::name(static_cast<MetricCounter>(i)));
+    for (size_t i = 0; i < METRIC_GAUGE_COUNT; i++) names.insert(Metrics::name(static_cast<MetricGauge>(i)));
+    for (size_t i = 0; i < METRIC_HISTOGRAM_COUNT; i++) names.insert(Metrics::name(static_cast<MetricHistogram>(i)));
+    EXPECT_EQ(names.size(), Metrics::count());
+
+    const char* suffixes[] = {".rx_packets", ".rx_bytes", ".rx_drops", ".tx_packets", ".tx_bytes",
+                              ".tx_drops", ".queue_depth", ".rx_latency_us"};
+    for (const char* iface : {"iface.auto", "iface.tcp", "iface.lora", "iface.ble"}) {
+        for (const char* suffix : suffixes) {
+            EXPECT_TRUE(names.count(std::string(iface) + suffix) == 1);
+        }
+    }
+    EXPECT_EQ(std::string(Metrics::name(METRIC_TCP_RX_LATENCY)), std::string("iface.tcp.rx_latency_us"));
+    EXPECT_EQ(std::string(Metrics::name(METRIC_BLE_QUEUE_DEPTH)), std::string("iface.ble.queue_depth"));
+}
+
+static void counters_and_gauges() {
+    Metrics::reset();
+    Metrics::add(METRIC_TCP_RX_PACKETS);
+    Metrics::add(METRIC_TCP_RX_PACKETS);
+    Metrics::add(METRIC_TCP_RX_BYTES, 300);
+    EXPECT_EQ(Metrics::counter(METRIC_TCP_RX_PACKETS), (uint32_t)2);
+    EXPECT_EQ(Metrics::counter(METRIC_TCP_RX_BYTES), (uint32_t)300);
+    EXPECT_EQ(Metrics::counter(METRIC_AUTO_RX_PACKETS), (uint32_t)0);
+
+    Metrics::add(METRIC_LORA_TX_BYTES, 0xFFFFFFF0u);
+    Metrics::add(METRIC_LORA_TX_BYTES, 0x20);
+    EXPECT_EQ(Metrics::counter(METRIC_LORA_TX_BYTES), (uint32_t)0x10);
+
+    Metrics::set(METRIC_BLE_QUEUE_DEPTH, 5);
+    Metrics::set(METRIC_BLE_QUEUE_DEPTH, 3);
+    EXPECT_EQ(Metrics::gauge(METRIC_BLE_QUEUE_DEPTH), 3);
+    Metrics::set(METRIC_HEAP_INTERNAL_FREE, -1);
+    EXPECT_EQ(Metrics::gauge(METRIC_HEAP_INTERNAL_FREE), -1);
+
+    Metrics::reset();
+    EXPECT_EQ(Metrics::counter(METRIC_TCP_RX_PACKETS), (uint32_t)0);
+    EXPECT_EQ(Metrics::gauge(METRIC_BLE_QUEUE_DEPTH), 0);
+}
+
+static void histogram_buckets() {
+    Metrics::reset();
+    namespace Cfg = MetricsConfig;
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, 0);
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, Cfg::BOUNDS_US[0]);        // Inclusive upper bound
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, Cfg::BOUNDS_US[0] + 1);
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, Cfg::BOUNDS_US[Cfg::BOUNDS - 1]);
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, Cfg::BOUNDS_US[Cfg::BOUNDS - 1] + 1);
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, 0xFFFFFFFFu);
+
+    MetricHistogramSnapshot s = Metrics::histogram(METRIC_AUTO_RX_LATENCY);
+    EXPECT_EQ(s.count, (uint32_t)6);
+    EXPECT_EQ(s.buckets[0], (uint32_t)2);
+    EXPECT_EQ(s.buckets[1], (uint32_t)1);
+    EXPECT_EQ(s.buckets[Cfg::BOUNDS - 1], (uint32_t)1);
+    EXPECT_EQ(s.buckets[Cfg::BOUNDS], (uint32_t)2);
+    uint32_t expected_sum = 0 + Cfg::BOUNDS_US[0] + Cfg::BOUNDS_US[0] + 1 +
+                            Cfg::BOUNDS_US[Cfg::BOUNDS - 1] + Cfg::BOUNDS_US[Cfg::BOUNDS - 1] + 1 +
+                            0xFFFFFFFFu;   // Wraps, like the device's counter
+    EXPECT_EQ(s.sum_us, expected_sum);
+
+    uint32_t start = Metrics::nowUs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    Metrics::observeSince(METRIC_TCP_RX_LATENCY, start);
+    s = Metrics::histogram(METRIC_TCP_RX_LATENCY);
+    EXPECT_EQ(s.count, (uint32_t)1);
+    EXPECT_TRUE(s.sum_us >= 2000 && s.sum_us < 1000000);
+}
+
+static void dump_format() {
+    Metrics::reset();
+    Metrics::add(METRIC_AUTO_TX_PACKETS, 7);
+    Metrics::set(METRIC_AUTO_PEERS, -2);
+    Metrics::observe(METRIC_LORA_RX_LATENCY, 300);
+    Metrics::observe(METRIC_LORA_RX_LATENCY, 5000000);
+
+    std::vector<std::string> lines = dumpLines(1234);
+    EXPECT_EQ(lines.size(), Metrics::count() + 2);
+    char header[64];
+    std::snprintf(header, sizeof(header), "T:METRICS v1 count=%u uptime_ms=1234", (unsigned)Metrics::count());
+    EXPECT_EQ(lines.front(), std::string(header));
+    char footer[32];
+    std::snprintf(footer, sizeof(footer), "T:OK metrics=%u", (unsigned)Metrics::count());
+    EXPECT_EQ(lines.back(), std::string(footer));
+
+    // Registry order: counters, gauges, histograms
+    EXPECT_EQ(lines[1], std::string("T:M iface.auto.rx_packets counter 0"));
+    EXPECT_EQ(lines[1 + METRIC_AUTO_TX_PACKETS], std::string("T:M iface.auto.tx_packets counter 7"));
+    EXPECT_EQ(lines[1 + METRIC_COUNTER_COUNT + METRIC_AUTO_PEERS],
+              std::string("T:M auto.peers gauge -2"));
+
+    std::vector<std::string> f = split(lines[1 + METRIC_COUNTER_COUNT + METRIC_GAUGE_COUNT + METRIC_LORA_RX_LATENCY]);
+    EXPECT_EQ(f[1], std::string("iface.lora.rx_latency_us"));
+    EXPECT_EQ(f[2], std::string("histogram"));
+    EXPECT_EQ(f[3], std::string("count=2"));
+    EXPECT_EQ(f[4], std::string("sum=5000300"));
+    EXPECT_EQ(f.size(), (size_t)(5 + MetricsConfig::BUCKETS));
+    EXPECT_EQ(f[5], std::string("le_100=0"));
+    EXPECT_EQ(f[6], std::string("le_250=0"));
+    EXPECT_EQ(f[7], std::string("le_500=1"));                                  // Cumulative from here
+    EXPECT_EQ(f[4 + MetricsConfig::BOUNDS], std::string("le_1000000=1"));
+    EXPECT_EQ(f.back(), std::string("le_inf=2"));
+}
+
+static void worst_case_line_fits() {
+    // Longest possible line: the longest histogram name with count, sum and
+    // every cumulative bucket at 10 digits (2^32-1)
+    size_t longest_name = 0;
+    for (size_t i = 0; i < METRIC_HISTOGRAM_COUNT; i++) {
+        longest_name = std::max(longest_name, std::strlen(Metrics::name(static_cast<MetricHistogram>(i))));
+    }
+    size_t worst = std::strlen("T:M  histogram count=4294967295 sum=4294967295") + longest_name;
+    for (size_t b = 0; b < MetricsConfig::BOUNDS; b++) {
+        worst += std::strlen(" le_=4294967295") + std::to_string(MetricsConfig::BOUNDS_US[b]).size();
+    }
+    worst += std::strlen(" le_inf=4294967295");
+    EXPECT_TRUE(worst < MetricsConfig::LINE_MAX);   // Room for the terminator
+
+    // And a populated line is not truncated
+    Metrics::reset();
+    for (size_t b = 0; b < MetricsConfig::BOUNDS; b++) {
+        Metrics::observe(METRIC_AUTO_RX_LATENCY, MetricsConfig::BOUNDS_US[b]);
+    }
+    Metrics::observe(METRIC_AUTO_RX_LATENCY, 0xFFFFFFFFu);
+    std::vector<std::string> lines = dumpLines();
+    const std::string& line = lines[1 + METRIC_COUNTER_COUNT + METRIC_GAUGE_COUNT + METRIC_AUTO_RX_LATENCY];
+    EXPECT_EQ(split(line).back(), "le_inf=" + std::to_string(MetricsConfig::BUCKETS));
+}
+
+static void concurrent_adds_lose_nothing() {
+    Metrics::reset();
+    static constexpr int THREADS = 4;
+    static constexpr int N = 100000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([] {
+            for (int i = 0; i < N; i++) {
+                Metrics::add(METRIC_BLE_RX_PACKETS);
+                Metrics::observe(METRIC_BLE_RX_LATENCY, static_cast<uint32_t>(i % 2000));
+            }
+        });
+    }
+    for (auto& th : threads) th.join();
+    EXPECT_EQ(Metrics::counter(METRIC_BLE_RX_PACKETS), (uint32_t)(THREADS * N));
+    MetricHistogramSnapshot s = Metrics::histogram(METRIC_BLE_RX_LATENCY);
+    EXPECT_EQ(s.count, (uint32_t)(THREADS * N));
+    uint32_t total = 0;
+    for (uint32_t b : s.buckets) total += b;
+    EXPECT_EQ(total, s.count);
+}
+
+static void add_cost() {
+    static constexpr int N = 10000000;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) Metrics::add(METRIC_TCP_TX_PACKETS);
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; i++) Metrics::observe(METRIC_TCP_RX_LATENCY, static_cast<uint32_t>(i & 0xFFFF));
+    auto t2 = std::chrono::steady_clock::now();
+    double add_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / N;
+    double obs_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / N;
+    std::printf("  add(): %.1f ns, observe(): %.1f ns\n", add_ns, obs_ns);
+    EXPECT_TRUE(add_ns < 100.0);
+    EXPECT_TRUE(obs_ns < 200.0);
+}
+
+int main() {
+    RUN(registry_is_consistent);
+    RUN(counters_and_gauges);
+    RUN(histogram_buckets);
+    RUN(dump_format);
+    RUN(worst_case_line_fits);
+    RUN(concurrent_adds_lose_nothing);
+    RUN(add_cost);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+// Native unit tests for SegmentedObjectPool (ObjectPool.h).
+//
+// The segmented pool backs the BLE reassembly sessions and pending-data
+// queue, so a lost slot or a slab freed while still in use corrupts BLE
+// traffic. Tests:
+//
+//   - nothing is allocated until first use; slabs are added one at a time
+//   - allocate/deallocate construct and destroy (live-object count)
+//   - exhaustion at SLAB_SLOTS * MAX_SLABS returns nullptr and is counted
+//   - slots freed back are reused before a new slab is added
+//   - trim() only frees slabs that stayed empty for the quiet period and
+//     keeps min_slabs warm
+//   - foreign pointers are ignored by deallocate() and owns()
+//   - threaded churn keeps every live object intact
+
+#include "../../lib/microreticulum-shim/ObjectPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using RNS::SegmentedObjectPool;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// Counts live instances so leaks / double destruction show up.
+struct Tracked {
+    static std::atomic<int> live;   // threaded_churn constructs concurrently
+    uint32_t a;
+    uint32_t b;
+    Tracked(uint32_t x = 0, uint32_t y = 0) : a(x), b(y) { ++live; }
+    ~Tracked() { --live; }
+};
+std::atomic<int> Tracked::live{0};
+
+using Pool = SegmentedObjectPool<Tracked, 4, 3>;
+
+static void lazy_slab_growth() {
+    Pool pool;
+    EXPECT_EQ(pool.slabs(), (size_t)0);
+    EXPECT_EQ(pool.capacity(), (size_t)0);
+    EXPECT_EQ(Pool::max_capacity(), (size_t)12);
+
+    std::vector<Tracked*> held;
+    for (size_t i = 0; i < 5; ++i) {
+        Tracked* t = pool.allocate((uint32_t)i, (uint32_t)(i * 2));
+        EXPECT_TRUE(t != nullptr);
+        EXPECT_EQ(t->a, (uint32_t)i);
+        EXPECT_EQ(t->b, (uint32_t)(i * 2));
+        held.push_back(t);
+    }
+    EXPECT_EQ(pool.slabs(), (size_t)2);
+    EXPECT_EQ(pool.allocated(), (size_t)5);
+    EXPECT_EQ(pool.available(), (size_t)3);
+    EXPECT_EQ(Tracked::live.load(), 5);
+
+    for (auto* t : held) pool.deallocate(t);
+    EXPECT_EQ(pool.allocated(), (size_t)0);
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+static void exhausts_at_ceiling() {
+    Pool pool;
+    std::vector<Tracked*> held;
+    for (size_t i = 0; i < Pool::max_capacity(); ++i) {
+        Tracked* t = pool.allocate();
+        EXPECT_TRUE(t != nullptr);
+        held.push_back(t);
+    }
+    EXPECT_TRUE(pool.allocate() == nullptr);
+    EXPECT_EQ(pool.exhausted(), (size_t)1);
+    EXPECT_EQ(pool.slabs(), (size_t)3);
+
+    std::vector<Tracked*> sorted = held;
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) == sorted.end());
+
+    for (auto* t : held) pool.deallocate(t);
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+static void freed_slots_reused_before_growth() {
+    Pool pool;
+    Tracked* first = pool.allocate();
+    pool.deallocate(first);
+    std::vector<Tracked*> held = {pool.allocate()};
+    EXPECT_TRUE(held[0] == first);         // LIFO within the slab
+    for (int i = 0; i < 3; ++i) held.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabs(), (size_t)1);    // 4 live fits one slab
+    Tracked* fifth = pool.allocate();
+    EXPECT_EQ(pool.slabs(), (size_t)2);
+    pool.deallocate(fifth);
+    held.push_back(pool.allocate());
+    EXPECT_TRUE(held.back() == fifth);
+    EXPECT_EQ(pool.slabs(), (size_t)2);
+    for (auto* t : held) pool.deallocate(t);
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+static void trim_after_quiet_period() {
+    Pool pool;   // min_slabs = 1
+    std::vector<Tracked*> held;
+    for (int i = 0; i < 12; ++i) held.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabs(), (size_t)3);
+
+    // Slabs in use are never trimmed
+    EXPECT_EQ(pool.trim(0.0, 10.0), (size_t)0);
+    EXPECT_EQ(pool.trim(100.0, 10.0), (size_t)0);
+
+    // Drain the last slab only
+    for (int i = 8; i < 12; ++i) pool.deallocate(held[i]);
+    held.resize(8);
+    EXPECT_EQ(pool.trim(200.0, 10.0), (size_t)0);   // first seen empty
+    EXPECT_EQ(pool.trim(205.0, 10.0), (size_t)0);   // not quiet long enough
+    EXPECT_EQ(pool.trim(210.0, 10.0), (size_t)1);
+    EXPECT_EQ(pool.slabs(), (size_t)2);
+    EXPECT_EQ(pool.slabs_freed(), (size_t)1);
+
+    // Reuse resets the quiet timer of the slab that was touched
+    for (int i = 0; i < 8; ++i) pool.deallocate(held[i]);
+    held.clear();
+    EXPECT_EQ(pool.trim(300.0, 10.0), (size_t)0);
+    Tracked* t = pool.allocate();
+    pool.deallocate(t);
+    EXPECT_EQ(pool.trim(311.0, 10.0), (size_t)1);   // untouched slab goes
+    EXPECT_EQ(pool.slabs(), (size_t)1);
+    EXPECT_EQ(pool.trim(400.0, 10.0), (size_t)0);   // keeps min_slabs
+    EXPECT_EQ(pool.slabs(), (size_t)1);
+    EXPECT_EQ(pool.peak_slabs(), (size_t)3);
+    EXPECT_EQ(Tracked::live.load(), 0);
+
+    // Trimmed capacity comes back on demand
+    for (int i = 0; i < 12; ++i) held.push_back(pool.allocate());
+    EXPECT_EQ(pool.slabs(), (size_t)3);
+    for (auto* p : held) pool.deallocate(p);
+    EXPECT_EQ(Tracked::live.load(), 0);
+}
+
+static void min_slabs_zero_frees_everything() {
+    SegmentedObjectPool<Tracked, 2, 2> pool(0);
+    Tracked* t = pool.allocate();
+    pool.deallocate(t);
+    pool.trim(0.0, 1.0);
+    EXPECT_EQ(pool.trim(1.0, 1.0), (size_t)1);
+    EXPECT_EQ(pool.slabs(), (size_t)0);
+}
+
+static void foreign_pointer_ignored() {
+    Pool pool;
+    Tracked* mine = pool.allocate(7, 7);
+    Tracked outsider;
+    EXPECT_TRUE(pool.owns(mine));
+    EXPECT_TRUE(!pool.owns(&outsider));
+    EXPECT_TRUE(!pool.owns(nullptr));
+    pool.deallocate(&outsider);
+    pool.deallocate(nullptr);
+    EXPECT_EQ(pool.allocated(), (size_t)1);
+    EXPECT_EQ(Tracked::live.load(), 2);
+    pool.deallocate(mine);
+}
+
+// Threads churn a shared pool; each stamps its objects and re-checks the
+// stamp before freeing, so a slot handed out twice is detected.
+static void threaded_churn() {
+    SegmentedObjectPool<Tracked, 8, 16> pool;
+    const int THREADS = 4;
+    const int OPS = 50000;
+    std::atomic<int> corruptions{0};
+
+    auto worker = [&](int id) {
+        std::vector<Tracked*> window;
+        uint32_t rng = 0x9E3779B9u * (uint32_t)(id + 1);
+        for (int op = 0; op < OPS; ++op) {
+            rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+            if (window.size() < 24 && (window.empty() || (rng & 1))) {
+                Tracked* t = pool.allocate((uint32_t)id, (uint32_t)op);
+                if (t) window.push_back(t);
+            } else {
+                size_t pick = rng % window.size();
+                Tracked* t = window[pick];
+                window[pick] = window.back();
+                window.pop_back();
+                if (t->a != (uint32_t)id) ++corruptions;
+                pool.deallocate(t);
+            }
+            if ((op & 1023) == 0) pool.trim(op, 0.0);
+        }
+        for (auto* t : window) pool.deallocate(t);
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i) threads.emplace_back(worker, i);
+    for (auto& t : threads) t.join();
+
+    EXPECT_EQ(corruptions.load(), 0);
+    EXPECT_EQ(pool.allocated(), (size_t)0);
+    EXPECT_EQ(Tracked::live.load(), 0);
+    EXPECT_TRUE(pool.peak_slabs() <= 16);
+}
+
+int main() {
+    RUN(lazy_slab_growth);
+    RUN(exhausts_at_ceiling);
+    RUN(freed_slots_reused_before_growth);
+    RUN(trim_after_quiet_period);
+    RUN(min_slabs_zero_frees_everything);
+    RUN(foreign_pointer_ignored);
+    RUN(threaded_churn);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,218 @@
+// Native PacketDedupWindow unit tests.
+//
+// AutoInterface's duplicate filter: the last WINDOW packet hashes seen
+// within a TTL, in a fixed ring with a linear-probed index. Checked here:
+//   - first sighting recorded, repeat reported, nothing recorded twice
+//   - displacement of the oldest entry once WINDOW are live
+//   - TTL expiry, both from expire() and on the next check_and_add()
+//   - key is the first 16 bytes: longer hashes truncated, shorter padded
+//   - colliding index homes survive removal of entries ahead of them
+//   - 200k-packet random stream (repeats, bursts, clock steps) against a
+//     std::deque model of the old filter
+//
+// Build: see test_packet_dedup_window.py for the g++ invocation.
+
+#include "../../lib/auto_interface/PacketDedupWindow.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+using Hash = std::vector<uint8_t>;
+
+static const size_t WINDOW = 48;
+static const double TTL = 0.75;
+
+// A 32-byte "full hash" from a counter, spread like SHA-256 output
+static Hash make_hash(uint64_t id) {
+    Hash h(32);
+    uint64_t x = id * 0x9E3779B97F4A7C15ull + 1;
+    for (size_t i = 0; i < h.size(); i++) {
+        x ^= x >> 29;
+        x *= 0xBF58476D1CE4E5B9ull;
+        h[i] = (uint8_t)(x >> 56);
+    }
+    return h;
+}
+
+static bool check(PacketDedupWindow<WINDOW>& w, const Hash& h, double now) {
+    return w.check_and_add(h.data(), h.size(), now);
+}
+
+// ── tests ──
+
+static void repeat_is_duplicate() {
+    PacketDedupWindow<WINDOW> w(TTL);
+    Hash a = make_hash(1), b = make_hash(2);
+    EXPECT_TRUE(!check(w, a, 0.0));
+    EXPECT_TRUE(check(w, a, 0.1));
+    EXPECT_TRUE(!check(w, b, 0.1));
+    EXPECT_TRUE(check(w, b, 0.2));
+    EXPECT_TRUE(check(w, a, 0.2));
+    EXPECT_EQ(w.size(), (size_t)2);      // duplicates are not recorded again
+    EXPECT_TRUE(w.contains(a.data(), a.size()));
+}
+
+static void oldest_displaced_when_window_full() {
+    PacketDedupWindow<WINDOW> w(TTL);
+    for (uint64_t i = 0; i < WINDOW; i++) EXPECT_TRUE(!check(w, make_hash(i), 0.0));
+    EXPECT_EQ(w.size(), WINDOW);
+
+    EXPECT_TRUE(!check(w, make_hash(1000), 0.0));
+    EXPECT_EQ(w.size(), WINDOW);
+    Hash first = make_hash(0);
+    EXPECT_TRUE(!w.contains(first.data(), first.size()));
+    for (uint64_t i = 1; i < WINDOW; i++) EXPECT_TRUE(check(w, make_hash(i), 0.0));
+    EXPECT_TRUE(check(w, make_hash(1000), 0.0));
+}
+
+static void entries_expire_after_ttl() {
+    PacketDedupWindow<WINDOW> w(TTL);
+    check(w, make_hash(1), 0.0);
+    check(w, make_hash(2), 0.5);
+
+    w.expire(0.75);                      // exactly TTL old: kept
+    EXPECT_EQ(w.size(), (size_t)2);
+    w.expire(0.8);
+    EXPECT_EQ(w.size(), (size_t)1);
+
+    // check_and_add expires first, so a stale repeat is new again
+    EXPECT_TRUE(!check(w, make_hash(2), 1.3));
+    EXPECT_EQ(w.size(), (size_t)1);
+    EXPECT_TRUE(check(w, make_hash(2), 1.4));
+
+    w.clear();
+    EXPECT_EQ(w.size(), (size_t)0);
+    EXPECT_TRUE(!check(w, make_hash(2), 1.4));
+}
+
+static void key_is_first_16_bytes() {
+    PacketDedupWindow<WINDOW> w(TTL);
+    Hash a = make_hash(7);
+    Hash tail_differs = a;
+    tail_differs[31] ^= 0xFF;
+    EXPECT_TRUE(!check(w, a, 0.0));
+    EXPECT_TRUE(check(w, tail_differs, 0.0));
+
+    Hash head_differs = a;
+    head_differs[15] ^= 0x01;
+    EXPECT_TRUE(!check(w, head_differs, 0.0));
+
+    const uint8_t short_key[3] = {1, 2, 3};
+    const uint8_t padded[16] = {1, 2, 3};
+    EXPECT_TRUE(!w.check_and_add(short_key, sizeof(short_key), 0.0));
+    EXPECT_TRUE(w.contains(padded, sizeof(padded)));
+}
+
+static void colliding_homes_survive_removal() {
+    // Small window: 8 index slots, so 4 live keys collide often. Walk many
+    // keys through it; every live one must stay findable after each removal.
+    PacketDedupWindow<4> w(TTL);
+    for (uint64_t i = 0; i < 2000; i++) {
+        Hash h = make_hash(i);
+        EXPECT_TRUE(!w.check_and_add(h.data(), h.size(), 0.0));
+        uint64_t oldest = i >= 3 ? i - 3 : 0;
+        for (uint64_t j = oldest; j <= i; j++) {
+            Hash live = make_hash(j);
+            EXPECT_TRUE(w.contains(live.data(), live.size()));
+        }
+        if (i >= 4) {
+            Hash gone = make_hash(i - 4);
+            EXPECT_TRUE(!w.contains(gone.data(), gone.size()));
+        }
+    }
+}
+
+static void random_stream_matches_deque_model() {
+    struct ModelEntry { Hash hash; double stamp; };
+    std::deque<ModelEntry> model;
+    PacketDedupWindow<WINDOW> w(TTL);
+    std::mt19937_64 rng(0xA070);
+
+    double now = 0.0;
+    uint64_t next_id = 0;
+    size_t duplicates = 0;
+    for (int i = 0; i < 200000; i++) {
+        // Mostly sub-millisecond spacing with occasional idle gaps
+        now += (rng() % 64 == 0) ? (rng() % 1000) / 1000.0 : (rng() % 500) / 1e6;
+
+        // New packets, recent repeats (the same datagram on another path)
+        // and occasionally a repeat from long ago
+        uint64_t id;
+        uint32_t r = rng() % 10;
+        if (r < 5 || next_id == 0) id = next_id++;
+        else if (r < 9) id = next_id - 1 - rng() % (next_id < 60 ? next_id : 60);
+        else id = rng() % next_id;
+        Hash h = make_hash(id);
+
+        while (!model.empty() && now - model.front().stamp > TTL) model.pop_front();
+        bool expected = false;
+        for (const auto& e : model) {
+            if (e.hash == h) { expected = true; break; }
+        }
+        if (!expected) {
+            model.push_back({h, now});
+            if (model.size() > WINDOW) model.pop_front();
+        }
+
+        EXPECT_EQ(check(w, h, now), expected);
+        EXPECT_EQ(w.size(), model.size());
+        if (expected) duplicates++;
+    }
+    EXPECT_TRUE(duplicates > 20000);     // the repeat paths were exercised
+}
+
+int main() {
+    RUN(repeat_is_duplicate);
+    RUN(oldest_displaced_when_window_full);
+    RUN(entries_expire_after_ttl);
+    RUN(key_is_first_16_bytes);
+    RUN(colliding_homes_survive_removal);
+    RUN(random_stream_matches_deque_model);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
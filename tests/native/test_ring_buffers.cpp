@@ -15,6 +15,10 @@
 //     - availableFrames consistent across operations
 //     - reset clears producer + consumer
 //     - SPSC stress: producer thread + consumer thread, no loss/reorder
+//     - latency stamps ride with their frame across wraparound;
+//       unstamped writes read back zeroed
+//     - without stamp storage (allocation failed) audio still flows and
+//       stamps read back zeroed
 //
 //   EncodedRingBuffer (variable-length slots):
 //     - length=0 rejected
@@ -22,13 +26,20 @@
 //     - round-trip preserves payload + length
 //     - read with too-small dest advances read cursor and returns false
 //     - wraparound
+//     - latency stamps ride with their slot across wraparound
+//     - without stamp storage payloads still flow
+//
+//   LxstTimingExt (in-band TX age):
+//     - write/read round-trip; wrong key and truncated input rejected
 
 #include "../../lib/lxst_audio/packet_ring_buffer.h"
 #include "../../lib/lxst_audio/encoded_ring_buffer.h"
+#include "../../lib/lxst_audio/audio_latency.h"
 
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <stdexcept>
 #include <thread>
@@ -73,6 +84,22 @@ static int g_fail = 0;
         }                                                                      \
     } while (0)
 
+// ── allocation failure injection ──
+
+// The next malloc() of exactly this many bytes returns nullptr (glibc), so
+// a ring buffer can be built without its stamp storage.
+static std::atomic<size_t> g_fail_malloc_size{0};
+
+extern "C" void* __libc_malloc(size_t size);
+
+extern "C" void* malloc(size_t size) {
+    size_t armed = size;
+    if (size != 0 && g_fail_malloc_size.compare_exchange_strong(armed, 0)) {
+        return nullptr;
+    }
+    return __libc_malloc(size);
+}
+
 // ── PacketRingBuffer tests ──
 
 static std::vector<int16_t> make_frame(int n, int seed) {
@@ -158,6 +185,49 @@ static void prb_reset_clears_state() {
     EXPECT_EQ(rb.availableFrames(), 0);
 }
 
+static void prb_stamps_follow_frames() {
+    PacketRingBuffer rb(4, 4);
+    int16_t out[4];
+    for (int i = 0; i < 10; ++i) {
+        auto f = make_frame(4, 0x50 + i);
+        AudioStamp in;
+        in.origin_us = 1000u + i;
+        in.queued_us = 2000u + i;
+        in.upstream_us = 3000u + i;
+        EXPECT_TRUE(rb.write(f.data(), 4, &in));
+        // An unstamped frame behind it must not inherit the stamp
+        EXPECT_TRUE(rb.write(f.data(), 4));
+        AudioStamp st;
+        EXPECT_TRUE(rb.read(out, 4, &st));
+        EXPECT_EQ(st.origin_us, 1000u + i);
+        EXPECT_EQ(st.queued_us, 2000u + i);
+        EXPECT_EQ(st.upstream_us, 3000u + i);
+        EXPECT_TRUE(rb.read(out, 4, &st));
+        EXPECT_EQ(st.origin_us, 0u);
+        EXPECT_EQ(st.queued_us, 0u);
+        EXPECT_EQ(st.upstream_us, 0u);
+    }
+}
+
+static void prb_no_stamp_storage_still_moves_audio() {
+    // 5 frames x 8 samples = 80 buffer bytes; the stamps take 5 x 12 = 60
+    g_fail_malloc_size = sizeof(AudioStamp) * 5;
+    PacketRingBuffer rb(5, 8);
+    EXPECT_EQ(g_fail_malloc_size.load(), 0u);
+    int16_t out[8];
+    for (int i = 0; i < 12; ++i) {
+        auto f = make_frame(8, 0x60 + i);
+        AudioStamp in;
+        in.origin_us = 1000u + i;
+        EXPECT_TRUE(rb.write(f.data(), 8, &in));
+        AudioStamp st;
+        st.origin_us = 7;
+        EXPECT_TRUE(rb.read(out, 8, &st));
+        EXPECT_TRUE(std::memcmp(out, f.data(), sizeof(out)) == 0);
+        EXPECT_EQ(st.origin_us, 0u);
+    }
+}
+
 // SPSC stress: separate producer and consumer threads exchange a million
 // frames. Verifies acquire/release ordering on writeIndex_/readIndex_ keeps
 // data intact (no torn frame, no reordering, no loss when sized big enough).
@@ -283,6 +353,78 @@ static void erb_full_then_drain() {
     EXPECT_EQ(eb.availableSlots(), 0);
 }
 
+static void erb_stamps_follow_slots() {
+    EncodedRingBuffer eb(4, 8);
+    uint8_t buf[8] = {0};
+    for (int i = 0; i < 12; ++i) {
+        AudioStamp in;
+        in.origin_us = 0xFFFFFF00u + i;   // across the 32-bit wrap
+        in.queued_us = 7u * i;
+        EXPECT_TRUE(eb.write(buf, 8, &in));
+        EXPECT_TRUE(eb.write(buf, 4));
+        uint8_t out[8];
+        int actual = -1;
+        AudioStamp st;
+        EXPECT_TRUE(eb.read(out, 8, &actual, &st));
+        EXPECT_EQ(st.origin_us, 0xFFFFFF00u + i);
+        EXPECT_EQ(st.queued_us, 7u * i);
+        EXPECT_EQ(st.upstream_us, 0u);
+        EXPECT_TRUE(eb.read(out, 8, &actual, &st));
+        EXPECT_EQ(actual, 4);
+        EXPECT_EQ(st.origin_us, 0u);
+    }
+}
+
+static void erb_no_stamp_storage_still_moves_payload() {
+    // 5 slots x (4 + 16) = 100 buffer bytes; the stamps take 5 x 12 = 60
+    g_fail_malloc_size = sizeof(AudioStamp) * 5;
+    EncodedRingBuffer eb(5, 16);
+    EXPECT_EQ(g_fail_malloc_size.load(), 0u);
+    for (int i = 0; i < 12; ++i) {
+        uint8_t in[16];
+        for (int k = 0; k < 16; ++k) in[k] = (uint8_t)(i * 16 + k);
+        AudioStamp stamp;
+        stamp.origin_us = 1000u + i;
+        EXPECT_TRUE(eb.write(in, 1 + i, &stamp));
+        uint8_t out[16];
+        int actual = -1;
+        AudioStamp st;
+        st.origin_us = 7;
+        EXPECT_TRUE(eb.read(out, 16, &actual, &st));
+        EXPECT_EQ(actual, 1 + i);
+        EXPECT_TRUE(std::memcmp(out, in, actual) == 0);
+        EXPECT_EQ(st.origin_us, 0u);
+    }
+}
+
+static void timing_ext_round_trip() {
+    uint8_t buf[LxstTimingExt::SIZE + 1];
+    EXPECT_EQ(LxstTimingExt::write(buf, 0x01234567u), LxstTimingExt::SIZE);
+    EXPECT_EQ(buf[0], LxstTimingExt::FIELD);
+    EXPECT_EQ(buf[1], 0xCE);
+    EXPECT_EQ(buf[2], 0x01);
+    EXPECT_EQ(buf[5], 0x67);
+    uint32_t age = 0;
+    EXPECT_TRUE(LxstTimingExt::read(buf, LxstTimingExt::SIZE, &age));
+    EXPECT_EQ(age, 0x01234567u);
+}
+
+static void timing_ext_rejects_bad_input() {
+    uint8_t buf[LxstTimingExt::SIZE];
+    LxstTimingExt::write(buf, 42);
+    uint32_t age = 7;
+    // Truncated
+    EXPECT_TRUE(!LxstTimingExt::read(buf, LxstTimingExt::SIZE - 1, &age));
+    // A plain LXST packet starts its map with the frames key
+    buf[0] = 0x01;
+    EXPECT_TRUE(!LxstTimingExt::read(buf, LxstTimingExt::SIZE, &age));
+    // Right key, wrong value type
+    buf[0] = LxstTimingExt::FIELD;
+    buf[1] = 0xCD;
+    EXPECT_TRUE(!LxstTimingExt::read(buf, LxstTimingExt::SIZE, &age));
+    EXPECT_EQ(age, 7u);                   // untouched on failure
+}
+
 int main() {
     RUN(prb_empty_read_returns_false);
     RUN(prb_write_read_round_trip);
@@ -291,6 +433,8 @@ int main() {
     RUN(prb_partial_drain_frees_slots);
     RUN(prb_wraparound_preserves_data);
     RUN(prb_reset_clears_state);
+    RUN(prb_stamps_follow_frames);
+    RUN(prb_no_stamp_storage_still_moves_audio);
     RUN(prb_spsc_threaded_stress);
 
     RUN(erb_zero_length_rejected);
@@ -299,6 +443,11 @@ int main() {
     RUN(erb_too_small_dest_advances_cursor);
     RUN(erb_wraparound);
     RUN(erb_full_then_drain);
+    RUN(erb_stamps_follow_slots);
+    RUN(erb_no_stamp_storage_still_moves_payload);
+
+    RUN(timing_ext_round_trip);
+    RUN(timing_ext_rejects_bad_input);
 
     std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
     return g_fail == 0 ? 0 : 1;
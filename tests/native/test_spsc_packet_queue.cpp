@@ -0,0 +1,195 @@
+// Native SPSCPacketQueue unit tests.
+//
+// The queue hands whole packets between TCPClientInterface's socket task and
+// the main loop. Checked here: FIFO order with lengths and stamps, full and
+// oversize refusal, in-place front()/pop() across index wrap, and a 200k-packet
+// two-thread producer/consumer stress with variable lengths.
+//
+// Build: see test_spsc_packet_queue.py for the g++ invocation.
+
+#include "../../lib/microreticulum-shim/SPSCPacketQueue.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using RNS::SPSCPacketQueue;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+// Deterministic contents for packet n
+static size_t packet_len(uint32_t n) { return 1 + (n * 7919u) % 200; }
+static uint8_t packet_byte(uint32_t n, size_t i) { return static_cast<uint8_t>(n * 31u + i); }
+
+static std::vector<uint8_t> make_packet(uint32_t n) {
+    std::vector<uint8_t> p(packet_len(n));
+    for (size_t i = 0; i < p.size(); ++i) p[i] = packet_byte(n, i);
+    return p;
+}
+
+// ── tests ──
+
+static void fifo_with_lengths_and_stamps() {
+    SPSCPacketQueue q(4, 200);
+    EXPECT_TRUE(q.valid());
+    EXPECT_TRUE(q.empty());
+    for (uint32_t n = 0; n < 3; ++n) {
+        auto p = make_packet(n);
+        EXPECT_TRUE(q.push(p.data(), p.size(), 1000 + n));
+    }
+    EXPECT_EQ(q.size(), (size_t)3);
+    for (uint32_t n = 0; n < 3; ++n) {
+        const uint8_t* data;
+        size_t len;
+        uint32_t stamp;
+        EXPECT_TRUE(q.front(&data, &len, &stamp));
+        auto p = make_packet(n);
+        EXPECT_EQ(len, p.size());
+        EXPECT_TRUE(std::memcmp(data, p.data(), len) == 0);
+        EXPECT_EQ(stamp, 1000 + n);
+        q.pop();
+    }
+    const uint8_t* data;
+    size_t len;
+    EXPECT_TRUE(!q.front(&data, &len));
+}
+
+static void full_and_oversize_are_refused() {
+    SPSCPacketQueue q(2, 16);
+    uint8_t buf[17] = {};
+    EXPECT_TRUE(!q.push(buf, 17));
+    EXPECT_TRUE(q.push(buf, 16));
+    EXPECT_TRUE(q.push(buf, 0));          // empty packets are allowed
+    EXPECT_TRUE(!q.push(buf, 1));         // full at the requested slot count
+    q.pop();
+    EXPECT_TRUE(q.push(buf, 1));
+    EXPECT_EQ(q.size(), (size_t)2);
+}
+
+static void pop_on_empty_is_harmless() {
+    SPSCPacketQueue q(2, 16);
+    q.pop();
+    uint8_t b = 0x42;
+    EXPECT_TRUE(q.push(&b, 1));
+    const uint8_t* data;
+    size_t len;
+    EXPECT_TRUE(q.front(&data, &len));
+    EXPECT_EQ(*data, (uint8_t)0x42);
+}
+
+static void wraps_many_times() {
+    SPSCPacketQueue q(3, 200);
+    uint32_t next_in = 0, next_out = 0;
+    for (int round = 0; round < 1000; ++round) {
+        // Push 0-3, pop 0-3, so the indices wrap at every offset
+        for (int i = 0; i < round % 4; ++i) {
+            auto p = make_packet(next_in);
+            if (q.push(p.data(), p.size(), next_in)) ++next_in;
+        }
+        for (int i = 0; i < (round / 4) % 4; ++i) {
+            const uint8_t* data;
+            size_t len;
+            uint32_t stamp;
+            if (!q.front(&data, &len, &stamp)) break;
+            EXPECT_EQ(stamp, next_out);
+            EXPECT_EQ(len, packet_len(next_out));
+            EXPECT_EQ(data[len - 1], packet_byte(next_out, len - 1));
+            q.pop();
+            ++next_out;
+        }
+    }
+    EXPECT_TRUE(next_out > 500);
+    EXPECT_EQ(q.size(), (size_t)(next_in - next_out));
+}
+
+static void threaded_stress_preserves_order_and_contents() {
+    const uint32_t N = 200000;
+    SPSCPacketQueue q(32, 200);
+    std::thread producer([&]() {
+        for (uint32_t n = 0; n < N;) {
+            auto p = make_packet(n);
+            if (q.push(p.data(), p.size(), n)) {
+                ++n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    uint32_t bad = 0;
+    for (uint32_t n = 0; n < N;) {
+        const uint8_t* data;
+        size_t len;
+        uint32_t stamp;
+        if (!q.front(&data, &len, &stamp)) {
+            std::this_thread::yield();
+            continue;
+        }
+        if (stamp != n || len != packet_len(n)) {
+            ++bad;
+        } else {
+            for (size_t i = 0; i < len; ++i) {
+                if (data[i] != packet_byte(n, i)) {
+                    ++bad;
+                    break;
+                }
+            }
+        }
+        q.pop();
+        ++n;
+    }
+    producer.join();
+    EXPECT_EQ(bad, (uint32_t)0);
+    EXPECT_TRUE(q.empty());
+}
+
+int main() {
+    RUN(fifo_with_lengths_and_stamps);
+    RUN(full_and_oversize_are_refused);
+    RUN(pop_on_empty_is_harmless);
+    RUN(wraps_many_times);
+    RUN(threaded_stress_preserves_order_and_contents);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
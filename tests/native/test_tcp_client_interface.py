@@ -0,0 +1,57 @@
+"""Pytest wrapper for native TCPClientInterface tests (POSIX tcp_task against a loopback peer)."""
+
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+PYXIS_ROOT = HERE.parent.parent
+TEST_SOURCE = HERE / "test_tcp_client_interface.cpp"
+
+
+def _find_cxx():
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    pytest.skip("no C++ compiler found")
+
+
+def test_tcp_client_interface(tmp_path):
+    cxx = _find_cxx()
+    binary = tmp_path / "test_tcp_client_interface"
+
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-O1",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        "-pthread",
+        f"-I{HERE}",                                          # microReticulum shims
+        f"-I{PYXIS_ROOT / 'lib' / 'microreticulum-shim'}",    # SPSCPacketQueue.h, Metrics.h
+        f"-I{PYXIS_ROOT / 'src'}",                            # HDLC.h, TCPTxQueue.h, TCPUpstreams.h
+        str(TEST_SOURCE),
+        str(PYXIS_ROOT / "src" / "TCPClientInterface.cpp"),
+        "-o", str(binary),
+    ]
+    compile_result = subprocess.run(cmd, capture_output=True, text=True)
+    assert compile_result.returncode == 0, (
+        f"compilation failed:\n--- cmd ---\n{' '.join(cmd)}\n"
+        f"--- stderr ---\n{compile_result.stderr}"
+    )
+
+    run_result = subprocess.run([str(binary)], capture_output=True, text=True, timeout=120)
+    assert run_result.returncode == 0, (
+        f"tests failed:\n--- stdout ---\n{run_result.stdout}\n"
+        f"--- stderr ---\n{run_result.stderr}"
+    )
+    summary = run_result.stdout.strip().splitlines()[-1]
+    parts = summary.split()
+    pass_count = int(parts[0])
+    fail_count = int(parts[2])
+    assert fail_count == 0, run_result.stdout
+    assert pass_count >= 4, f"expected at least 4 TCPClientInterface tests, ran {pass_count}"
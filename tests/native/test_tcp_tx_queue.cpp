@@ -0,0 +1,290 @@
+// Native TCPTxQueue unit tests.
+//
+// The queue HDLC-frames packets into urgent/bulk byte rings for
+// TCPClientInterface's non-blocking writes. Checked here:
+//   - the byte stream drained through peek()/consume() with arbitrary short
+//     writes decodes back to the queued packets, in order, across ring wraps
+//   - several whole frames coalesce into one peek()
+//   - link packets overtake queued bulk frames, but only at a frame boundary
+//   - bulk high/low watermark hysteresis; urgent still queues while congested
+//
+// Build: see test_tcp_tx_queue.py for the g++ invocation.
+
+#include "../../src/TCPTxQueue.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using RNS::HDLC;
+using RNS::HDLCDecoder;
+using RNS::TCPTxQueue;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+using Packet = std::vector<uint8_t>;
+
+static const size_t MTU = 64;
+
+// Header byte 0 for a DATA packet to a LINK (urgent) or SINGLE (bulk) destination
+static const uint8_t LINK_DATA = 0x0C;
+static const uint8_t SINGLE_DATA = 0x00;
+
+static Packet make_packet(uint8_t header, size_t len, uint8_t fill) {
+    Packet p(len, fill);
+    if (len > 0) p[0] = header;
+    return p;
+}
+
+// The far end of the socket: decodes whatever the queue hands out
+struct Wire {
+    HDLCDecoder<MTU> dec;
+    std::vector<Packet> packets;
+    size_t writes = 0;
+
+    // One send() that accepts at most max_write bytes; returns bytes taken
+    size_t write(TCPTxQueue& q, size_t max_write) {
+        const uint8_t* data;
+        size_t n = q.peek(&data);
+        if (n == 0) return 0;
+        size_t w = n < max_write ? n : max_write;
+        dec.feed(data, w, [&](const uint8_t* f, size_t len) { packets.emplace_back(f, f + len); });
+        q.consume(w);
+        ++writes;
+        return w;
+    }
+
+    void drain(TCPTxQueue& q, size_t max_write = SIZE_MAX) {
+        while (write(q, max_write) > 0) {}
+    }
+};
+
+static Packet random_packet(std::mt19937& rng, uint8_t header) {
+    Packet p(1 + rng() % MTU);
+    for (auto& b : p) {
+        // Plenty of FLAG/ESC bytes so framed sizes vary
+        b = static_cast<uint8_t>(rng() % 4 == 0 ? 0x7D + rng() % 2 : rng());
+    }
+    p[0] = header;
+    return p;
+}
+
+// ── tests ──
+
+static void classify_link_packets_as_urgent() {
+    uint8_t hdr[2] = {LINK_DATA, 0};
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 2), TCPTxQueue::URGENT);
+    hdr[0] = 0x0F;                           // LINK proof
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 2), TCPTxQueue::URGENT);
+    hdr[0] = 0x01;                           // SINGLE announce
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 2), TCPTxQueue::BULK);
+    hdr[0] = 0x08;                           // PLAIN data
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 2), TCPTxQueue::BULK);
+    hdr[0] = 0x8C;                           // IFAC-masked: unreadable
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 2), TCPTxQueue::BULK);
+    EXPECT_EQ(TCPTxQueue::classify(hdr, 0), TCPTxQueue::BULK);
+}
+
+static void short_writes_round_trip_across_wraps() {
+    std::mt19937 rng(1234);
+    // Small rings so frames wrap constantly
+    TCPTxQueue q(200, 300, MTU, 16);
+    EXPECT_TRUE(q.valid());
+    Wire wire;
+    std::vector<Packet> sent;
+    for (int round = 0; round < 5000; ++round) {
+        int pushes = rng() % 3;
+        for (int i = 0; i < pushes; ++i) {
+            Packet p = random_packet(rng, SINGLE_DATA);
+            if (q.push(p.data(), p.size(), TCPTxQueue::BULK) == TCPTxQueue::Push::QUEUED) {
+                sent.push_back(p);
+            }
+        }
+        wire.write(q, 1 + rng() % 40);
+    }
+    wire.drain(q, 7);
+    EXPECT_TRUE(sent.size() > 1000);
+    EXPECT_EQ(wire.packets.size(), sent.size());
+    EXPECT_TRUE(wire.packets == sent);
+    EXPECT_EQ(wire.dec.dropped(), (uint32_t)0);
+    EXPECT_EQ(q.queued_bytes(), (size_t)0);
+    EXPECT_EQ(q.queued_frames(), (size_t)0);
+}
+
+static void whole_frames_coalesce_into_one_write() {
+    TCPTxQueue q(512, 1024, MTU, 16);
+    size_t framed = 0;
+    for (int i = 0; i < 5; ++i) {
+        Packet p = make_packet(SINGLE_DATA, 20, static_cast<uint8_t>(i));
+        EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::BULK), TCPTxQueue::Push::QUEUED);
+        framed += HDLC::frame_size(p.data(), p.size());
+    }
+    const uint8_t* data;
+    EXPECT_EQ(q.peek(&data), framed);
+
+    uint32_t frames = 0, payload = 0;
+    q.consume(framed, &frames, &payload);
+    EXPECT_EQ(frames, (uint32_t)5);
+    EXPECT_EQ(payload, (uint32_t)100);
+    EXPECT_EQ(q.peek(&data), (size_t)0);
+}
+
+static void partial_write_counts_frame_once_finished() {
+    TCPTxQueue q(512, 1024, MTU, 16);
+    Packet p = make_packet(SINGLE_DATA, 30, 0x11);
+    q.push(p.data(), p.size(), TCPTxQueue::BULK);
+    size_t framed = HDLC::frame_size(p.data(), p.size());
+
+    uint32_t frames = 0, payload = 0;
+    const uint8_t* data;
+    EXPECT_EQ(q.peek(&data), framed);
+    q.consume(10, &frames, &payload);
+    EXPECT_EQ(frames, (uint32_t)0);
+    EXPECT_EQ(q.peek(&data), framed - 10);
+    q.consume(framed - 10, &frames, &payload);
+    EXPECT_EQ(frames, (uint32_t)1);
+    EXPECT_EQ(payload, (uint32_t)30);
+}
+
+static void link_packets_overtake_bulk_at_frame_boundary() {
+    TCPTxQueue q(512, 1024, MTU, 16);
+    Wire wire;
+    std::vector<Packet> bulk;
+    for (int i = 0; i < 3; ++i) {
+        bulk.push_back(make_packet(SINGLE_DATA | 0x01, 40, static_cast<uint8_t>(0x20 + i)));
+        q.push(bulk.back().data(), bulk.back().size(), TCPTxQueue::BULK);
+    }
+    // The socket takes part of the first announce...
+    wire.write(q, 15);
+
+    // ...then an audio packet arrives
+    Packet audio = make_packet(LINK_DATA, 24, 0x55);
+    EXPECT_EQ(q.push(audio.data(), audio.size(), TCPTxQueue::URGENT), TCPTxQueue::Push::QUEUED);
+
+    // The rest of the half-written frame goes first, and only that frame
+    const uint8_t* data;
+    size_t first = HDLC::frame_size(bulk[0].data(), bulk[0].size());
+    EXPECT_EQ(q.peek(&data), first - 15);
+    wire.drain(q);
+
+    std::vector<Packet> expected = {bulk[0], audio, bulk[1], bulk[2]};
+    EXPECT_TRUE(wire.packets == expected);
+}
+
+static void bulk_watermarks_apply_backpressure() {
+    // 400-byte bulk ring: congested at >= 300, clears at <= 100
+    TCPTxQueue q(256, 400, MTU, 64);
+    Packet p = make_packet(SINGLE_DATA, 48, 0x01);    // 50 bytes framed
+    int queued = 0;
+    while (q.push(p.data(), p.size(), TCPTxQueue::BULK) == TCPTxQueue::Push::QUEUED) ++queued;
+    EXPECT_EQ(queued, 6);
+    EXPECT_TRUE(q.congested());
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::BULK), TCPTxQueue::Push::CONGESTED);
+
+    // Link traffic still gets through
+    Packet audio = make_packet(LINK_DATA, 48, 0x02);
+    EXPECT_EQ(q.push(audio.data(), audio.size(), TCPTxQueue::URGENT), TCPTxQueue::Push::QUEUED);
+
+    // Drain to 150 bytes: still above the low mark
+    Wire wire;
+    wire.write(q, SIZE_MAX);                         // the urgent frame
+    wire.write(q, 150);
+    EXPECT_EQ(q.queued_bytes(), (size_t)150);
+    EXPECT_TRUE(q.congested());
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::BULK), TCPTxQueue::Push::CONGESTED);
+
+    // Already admitted elsewhere: only a full ring refuses it
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::BULK, true), TCPTxQueue::Push::QUEUED);
+    wire.write(q, 100);
+    EXPECT_TRUE(!q.congested());
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::BULK), TCPTxQueue::Push::QUEUED);
+}
+
+static void full_and_oversize_pushes_are_refused() {
+    TCPTxQueue q(100, 1000, MTU, 2);
+    Packet p = make_packet(LINK_DATA, 40, 0x03);
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::URGENT), TCPTxQueue::Push::QUEUED);
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::URGENT), TCPTxQueue::Push::QUEUED);
+    EXPECT_EQ(q.push(p.data(), p.size(), TCPTxQueue::URGENT), TCPTxQueue::Push::FULL);   // bytes
+    Packet small = make_packet(SINGLE_DATA, 4, 0x03);
+    EXPECT_EQ(q.push(small.data(), small.size(), TCPTxQueue::BULK), TCPTxQueue::Push::QUEUED);
+    EXPECT_EQ(q.push(small.data(), small.size(), TCPTxQueue::BULK), TCPTxQueue::Push::QUEUED);
+    EXPECT_EQ(q.push(small.data(), small.size(), TCPTxQueue::BULK), TCPTxQueue::Push::FULL); // slots
+
+    Packet big(MTU + 1, 0x7E);
+    EXPECT_EQ(q.push(big.data(), big.size(), TCPTxQueue::BULK), TCPTxQueue::Push::TOO_BIG);
+}
+
+static void clear_drops_partly_written_frame() {
+    TCPTxQueue q(512, 1024, MTU, 16);
+    Packet p = make_packet(SINGLE_DATA, 30, 0x11);
+    q.push(p.data(), p.size(), TCPTxQueue::BULK);
+    Wire wire;
+    wire.write(q, 5);
+    q.clear();
+    EXPECT_EQ(q.queued_bytes(), (size_t)0);
+    const uint8_t* data;
+    EXPECT_EQ(q.peek(&data), (size_t)0);
+
+    // A new connection starts on a frame boundary
+    Wire fresh;
+    q.push(p.data(), p.size(), TCPTxQueue::BULK);
+    fresh.drain(q);
+    EXPECT_EQ(fresh.packets.size(), (size_t)1);
+    EXPECT_TRUE(fresh.packets[0] == p);
+}
+
+int main() {
+    RUN(classify_link_packets_as_urgent);
+    RUN(short_writes_round_trip_across_wraps);
+    RUN(whole_frames_coalesce_into_one_write);
+    RUN(partial_write_counts_frame_once_finished);
+    RUN(link_packets_overtake_bulk_at_frame_boundary);
+    RUN(bulk_watermarks_apply_backpressure);
+    RUN(full_and_oversize_pushes_are_refused);
+    RUN(clear_drops_partly_written_frame);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
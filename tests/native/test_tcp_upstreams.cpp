@@ -0,0 +1,207 @@
+// Native TCPUpstreams unit tests.
+//
+// The upstream list behind TCPClientInterface's failover. Checked here:
+//   - "host[:port],..." parsing: default port, whitespace, bad entries
+//     skipped, at most MAX_UPSTREAMS kept
+//   - cached DNS answers expire after DNS_TTL_MS and are dropped when a
+//     connect fails
+//   - the smoothed connect RTT (1/8 EWMA) and failure counting
+//   - dial order: fewest failures, then unmeasured, then lowest RTT,
+//     list order on ties
+//
+// Build: see test_tcp_upstreams.py for the g++ invocation.
+
+#include "../../src/TCPUpstreams.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+using RNS::TCPUpstreams;
+
+// ── minimal test framework ──
+
+static int g_pass = 0;
+static int g_fail = 0;
+
+#define EXPECT_EQ(actual, expected)                                            \
+    do {                                                                       \
+        auto _a = (actual);                                                    \
+        auto _e = (expected);                                                  \
+        if (!(_a == _e)) {                                                     \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: %s != %s",                 \
+                          __FILE__, __LINE__, #actual, #expected);             \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define EXPECT_TRUE(cond)                                                      \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            char buf[256];                                                     \
+            std::snprintf(buf, sizeof(buf), "%s:%d: expected %s",              \
+                          __FILE__, __LINE__, #cond);                          \
+            throw std::runtime_error(buf);                                     \
+        }                                                                      \
+    } while (0)
+
+#define RUN(name)                                                              \
+    do {                                                                       \
+        try {                                                                  \
+            name();                                                            \
+            ++g_pass;                                                          \
+            std::printf("PASS %s\n", #name);                                   \
+        } catch (const std::exception& e) {                                    \
+            ++g_fail;                                                          \
+            std::printf("FAIL %s: %s\n", #name, e.what());                     \
+        }                                                                      \
+    } while (0)
+
+static void expect_order(const TCPUpstreams& u, const size_t* expected) {
+    size_t order[TCPUpstreams::MAX_UPSTREAMS];
+    size_t n = u.rank(order);
+    EXPECT_EQ(n, u.size());
+    for (size_t i = 0; i < n; ++i) EXPECT_EQ(order[i], expected[i]);
+}
+
+// ── tests ──
+
+static void parse_single_host_uses_default_port() {
+    TCPUpstreams u;
+    EXPECT_EQ(u.parse("192.168.1.100", 4965), (size_t)1);
+    EXPECT_EQ(u[0].host, std::string("192.168.1.100"));
+    EXPECT_EQ(u[0].port, (uint16_t)4965);
+    EXPECT_EQ(u[0].srtt_ms, (uint32_t)0);
+    EXPECT_EQ(u[0].failures, (uint8_t)0);
+}
+
+static void parse_list_with_ports_and_whitespace() {
+    TCPUpstreams u;
+    EXPECT_EQ(u.parse(" hub-a , hub-b:4242,\t10.0.0.1 :80 ", 4965), (size_t)3);
+    EXPECT_EQ(u[0].host, std::string("hub-a"));
+    EXPECT_EQ(u[0].port, (uint16_t)4965);
+    EXPECT_EQ(u[1].host, std::string("hub-b"));
+    EXPECT_EQ(u[1].port, (uint16_t)4242);
+    EXPECT_EQ(u[2].host, std::string("10.0.0.1"));
+    EXPECT_EQ(u[2].port, (uint16_t)80);
+}
+
+static void parse_skips_bad_entries_and_caps_count() {
+    TCPUpstreams u;
+    EXPECT_EQ(u.parse(",a:0,b:70000,c:,d:x1,:99,, e ,f:1", 7), (size_t)2);
+    EXPECT_EQ(u[0].host, std::string("e"));
+    EXPECT_EQ(u[1].host, std::string("f"));
+    EXPECT_EQ(u[1].port, (uint16_t)1);
+
+    EXPECT_EQ(u.parse("h1,h2,h3,h4,h5,h6", 7), TCPUpstreams::MAX_UPSTREAMS);
+    EXPECT_EQ(u[TCPUpstreams::MAX_UPSTREAMS - 1].host, std::string("h4"));
+
+    EXPECT_EQ(u.parse("", 7), (size_t)0);
+    EXPECT_EQ(u.parse(" , ", 7), (size_t)0);
+}
+
+static void reparse_resets_state() {
+    TCPUpstreams u;
+    u.parse("a,b", 1);
+    u.on_connected(0, 40);
+    u.on_failed(1, false);
+    u.store_address(0, 0x0100007f, 0);
+    u.parse("a,b", 1);
+    uint32_t addr = 0;
+    EXPECT_EQ(u[0].srtt_ms, (uint32_t)0);
+    EXPECT_EQ(u[1].failures, (uint8_t)0);
+    EXPECT_TRUE(!u.cached_address(0, 0, &addr));
+}
+
+static void dns_cache_expires_and_is_forgotten_on_failure() {
+    TCPUpstreams u;
+    u.parse("hub", 1);
+    uint32_t addr = 0;
+    EXPECT_TRUE(!u.cached_address(0, 1000, &addr));
+
+    // Stored near the millis() wrap: age is computed modulo 2^32
+    const uint32_t t0 = 0xFFFFF000u;
+    u.store_address(0, 0x0a000001, t0);
+    EXPECT_TRUE(u.cached_address(0, t0, &addr));
+    EXPECT_EQ(addr, (uint32_t)0x0a000001);
+    EXPECT_TRUE(u.cached_address(0, t0 + TCPUpstreams::DNS_TTL_MS - 1, &addr));
+    EXPECT_TRUE(!u.cached_address(0, t0 + TCPUpstreams::DNS_TTL_MS, &addr));
+
+    // A dropped connection keeps the address; a failed connect forgets it
+    u.store_address(0, 0x0a000002, 5000);
+    u.on_failed(0, false);
+    EXPECT_TRUE(u.cached_address(0, 5000, &addr));
+    u.on_failed(0, true);
+    EXPECT_TRUE(!u.cached_address(0, 5000, &addr));
+}
+
+static void connect_rtt_is_smoothed_and_clears_failures() {
+    TCPUpstreams u;
+    u.parse("hub", 1);
+    u.on_failed(0, false);
+    u.on_failed(0, false);
+    EXPECT_EQ(u[0].failures, (uint8_t)2);
+
+    u.on_connected(0, 80);               // first sample taken as is
+    EXPECT_EQ(u[0].srtt_ms, (uint32_t)80);
+    EXPECT_EQ(u[0].failures, (uint8_t)0);
+    u.on_connected(0, 160);              // 80 - 10 + 20
+    EXPECT_EQ(u[0].srtt_ms, (uint32_t)90);
+    for (int i = 0; i < 100; ++i) u.on_connected(0, 0);
+    EXPECT_TRUE(u[0].srtt_ms >= 1);      // never back to "unmeasured"
+
+    for (int i = 0; i < 100; ++i) u.on_failed(0, false);
+    EXPECT_EQ(u[0].failures, TCPUpstreams::MAX_FAILURES);
+}
+
+static void rank_prefers_fewer_failures_then_lower_rtt() {
+    TCPUpstreams u;
+    u.parse("a,b,c,d", 1);
+    const size_t list[] = {0, 1, 2, 3};
+    expect_order(u, list);               // nothing measured: list order
+
+    u.on_connected(0, 300);
+    u.on_connected(1, 50);
+    u.on_connected(2, 120);
+    u.on_connected(3, 50);
+    const size_t by_rtt[] = {1, 3, 2, 0};   // b and d tie: list order
+    expect_order(u, by_rtt);
+
+    u.on_failed(1, false);
+    const size_t b_failed[] = {3, 2, 0, 1};
+    expect_order(u, b_failed);
+
+    u.on_failed(3, false);
+    u.on_failed(3, false);
+    const size_t d_twice[] = {2, 0, 1, 3};
+    expect_order(u, d_twice);
+}
+
+static void rank_tries_unmeasured_before_measured() {
+    TCPUpstreams u;
+    u.parse("a,b,c", 1);
+    u.on_connected(0, 20);
+    const size_t order[] = {1, 2, 0};
+    expect_order(u, order);
+
+    // ...but not ahead of a healthier one
+    u.on_failed(1, false);
+    const size_t b_failed[] = {2, 0, 1};
+    expect_order(u, b_failed);
+}
+
+int main() {
+    RUN(parse_single_host_uses_default_port);
+    RUN(parse_list_with_ports_and_whitespace);
+    RUN(parse_skips_bad_entries_and_caps_count);
+    RUN(reparse_resets_state);
+    RUN(dns_cache_expires_and_is_forgotten_on_failure);
+    RUN(connect_rtt_is_smoothed_and_clears_failures);
+    RUN(rank_prefers_fewer_failures_then_lower_rtt);
+    RUN(rank_tries_unmeasured_before_measured);
+
+    std::printf("\n%d passed, %d failed\n", g_pass, g_fail);
+    return g_fail == 0 ? 0 : 1;
+}
@@ -0,0 +1,62 @@
+"""
+Pytest wrapper that compiles + runs the native TCPUpstreams C++ tests.
+
+This sidesteps PlatformIO entirely — we compile the C++ test directly with
+the system g++/clang++. TCPUpstreams.h is standard C++ only, so no shims
+are needed.
+"""
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+
+import pytest
+
+
+HERE = Path(__file__).resolve().parent
+TEST_SOURCE = HERE / "test_tcp_upstreams.cpp"
+
+
+def _find_cxx():
+    """Pick a C++ compiler. Prefer clang++ (Mac default), fall back to g++."""
+    for cmd in ("clang++", "g++"):
+        if shutil.which(cmd):
+            return cmd
+    pytest.skip("no C++ compiler found")
+
+
+def test_tcp_upstreams_compiles_and_passes(tmp_path):
+    cxx = _find_cxx()
+    binary = tmp_path / "test_tcp_upstreams"
+
+    cmd = [
+        cxx,
+        "-std=c++17",
+        "-Wall",
+        "-Wextra",
+        "-Wno-unused-parameter",
+        str(TEST_SOURCE),
+        "-o", str(binary),
+    ]
+    compile_result = subprocess.run(cmd, capture_output=True, text=True)
+    assert compile_result.returncode == 0, (
+        f"compilation failed:\n"
+        f"--- cmd ---\n{' '.join(cmd)}\n"
+        f"--- stderr ---\n{compile_result.stderr}"
+    )
+
+    run_result = subprocess.run([str(binary)], capture_output=True, text=True, timeout=10)
+    assert run_result.returncode == 0, (
+        f"tests failed:\n--- stdout ---\n{run_result.stdout}\n"
+        f"--- stderr ---\n{run_result.stderr}"
+    )
+
+    # Sanity: parse the "N passed, M failed" tail line to confirm tests ran.
+    # Catches a regression where main() forgets to RUN() any tests.
+    summary = run_result.stdout.strip().splitlines()[-1]  # "N passed, M failed"
+    parts = summary.split()
+    pass_count = int(parts[0])
+    fail_count = int(parts[2])
+    assert fail_count == 0, run_result.stdout
+    assert pass_count >= 8, f"expected at least 8 TCPUpstreams tests, ran {pass_count}"
@@ -0,0 +1,559 @@
+/*
+ * alloc_replay - Replay a pyxis allocation trace against heap models
+ *
+ * Reads a .atrace capture (AllocTraceHeader + records, see
+ * lib/microreticulum-shim/Instrumentation/AllocTraceFormat.h) and replays
+ * every alloc/free against a model of the ESP-IDF TLSF heaps (internal and
+ * PSRAM), once per policy. The baseline policy routes each allocation to the
+ * heap the device actually used; candidate policies reroute some of them so
+ * their effect on internal fragmentation can be compared on the same
+ * workload before touching firmware.
+ *
+ * Build (from the repo root):
+ *   g++ -O2 -std=c++17 -pthread -Ilib/microreticulum-shim -Itests/native \
+ *       tools/alloc_trace/alloc_replay.cpp -o alloc_replay
+ *
+ * Usage:
+ *   alloc_replay trace.atrace [policy ...] [--internal BYTES] [--spiram BYTES]
+ *                [--callers N]
+ *
+ * Policies (combine with '+', e.g. slab:16384+psram:1024):
+ *   baseline        Route as the device did (pointer address, else caps)
+ *   psram:<N>       Default-caps requests larger than N bytes go to PSRAM
+ *   slab:<BYTES>    Reserve BYTES of internal RAM as an lv_mem_slab style
+ *                   size-class region for requests <= 256 bytes
+ *   bytespool       Default-caps requests <= 4096 bytes are served from fixed
+ *                   tiers sized like BytesPoolConfig's growth ceilings
+ */
+
+#include <Instrumentation/AllocTraceFormat.h>
+#include <BytesPool.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace RNS::Instrumentation;
+
+namespace {
+
+// ESP32-S3 external RAM data window; everything else is internal DRAM
+constexpr uint32_t PSRAM_ADDR_LO = 0x3C000000;
+constexpr uint32_t PSRAM_ADDR_HI = 0x3E000000;
+
+// IDF default: malloc() requests up to this size stay internal
+// (CONFIG_SPIRAM_MALLOC_ALWAYSINTERNAL)
+constexpr uint32_t DEFAULT_ALWAYS_INTERNAL = 4096;
+
+// AutoInterface skips announces below this internal max block
+constexpr uint32_t LOW_BLOCK_THRESHOLD = 8000;
+
+// ---------------------------------------------------------------------------
+// TLSF heap model
+//
+// Good-fit like multi_heap's TLSF: the request is rounded up to its
+// second-level bin and the smallest free block at least that large is used,
+// splitting off the tail; frees coalesce with both neighbours. Each block
+// carries a 4-byte header and blocks are 4-byte aligned with a 12-byte
+// minimum, as in IDF's tlsf block_header_t.
+// ---------------------------------------------------------------------------
+class TlsfModel {
+public:
+    static constexpr uint32_t OVERHEAD = 4;
+    static constexpr uint32_t ALIGN = 4;
+    static constexpr uint32_t MIN_BLOCK = 12;
+    static constexpr uint32_t SL_LOG2 = 5;   // 32 second-level bins
+
+    explicit TlsfModel(uint32_t size) : _size(size), _free_bytes(size) {
+        if (size) insertFree(0, size);
+        _min_free = size;
+        _min_largest = size;
+    }
+
+    // Returns model address, or UINT32_MAX on failure
+    uint32_t alloc(uint32_t request) {
+        uint32_t need = blockSize(request);
+        uint32_t search = roundToBin(need);
+        auto it = _by_size.lower_bound({search, 0});
+        if (it == _by_size.end()) {
+            // Rounding can skip a block that fits exactly; TLSF would too,
+            // except when the request is in the block's own bin
+            it = _by_size.lower_bound({need, 0});
+            if (it == _by_size.end() || binOf(it->first) != binOf(need)) return UINT32_MAX;
+        }
+        uint32_t addr = it->second;
+        uint32_t block = it->first;
+        eraseFree(addr, block);
+        if (block - need >= MIN_BLOCK) {
+            insertFree(addr + need, block - need);
+        } else {
+            need = block;
+        }
+        _used[addr] = need;
+        _free_bytes -= need;
+        noteLow();
+        return addr;
+    }
+
+    void free(uint32_t addr) {
+        auto u = _used.find(addr);
+        if (u == _used.end()) return;
+        uint32_t size = u->second;
+        _used.erase(u);
+        _free_bytes += size;
+
+        auto next = _by_addr.find(addr + size);
+        if (next != _by_addr.end()) {
+            size += next->second;
+            eraseFree(next->first, next->second);
+        }
+        auto prev = _by_addr.lower_bound(addr);
+        if (prev != _by_addr.begin()) {
+            --prev;
+            if (prev->first + prev->second == addr) {
+                addr = prev->first;
+                size += prev->second;
+                eraseFree(prev->first, prev->second);
+            }
+        }
+        insertFree(addr, size);
+    }
+
+    uint32_t size() const { return _size; }
+    uint32_t freeBytes() const { return _free_bytes; }
+    uint32_t largest() const { return _by_size.empty() ? 0 : _by_size.rbegin()->first - OVERHEAD; }
+    uint32_t minFree() const { return _min_free; }
+    uint32_t minLargest() const { return _min_largest; }
+    // Fragmentation when the largest block was smallest: 1 - largest/free
+    uint32_t fragAtMin() const { return _frag_at_min; }
+
+private:
+    static uint32_t blockSize(uint32_t request) {
+        uint32_t n = (request + OVERHEAD + ALIGN - 1) & ~(ALIGN - 1);
+        return n < MIN_BLOCK ? MIN_BLOCK : n;
+    }
+    static uint32_t fls(uint32_t v) { return 31 - __builtin_clz(v); }
+    static uint64_t binOf(uint32_t size) {
+        if (size < (1u << (SL_LOG2 + 2))) return size / ALIGN;
+        uint32_t fl = fls(size);
+        uint32_t sl = (size >> (fl - SL_LOG2)) & ((1u << SL_LOG2) - 1);
+        return (uint64_t(fl) << 8) | sl;
+    }
+    static uint32_t roundToBin(uint32_t size) {
+        if (size < (1u << (SL_LOG2 + 2))) return size;
+        uint32_t round = (1u << (fls(size) - SL_LOG2)) - 1;
+        return size + round;
+    }
+
+    void insertFree(uint32_t addr, uint32_t size) {
+        _by_addr[addr] = size;
+        _by_size.insert({size, addr});
+    }
+    void eraseFree(uint32_t addr, uint32_t size) {
+        _by_addr.erase(addr);
+        _by_size.erase({size, addr});
+    }
+    void noteLow() {
+        if (_free_bytes < _min_free) _min_free = _free_bytes;
+        uint32_t big = largest();
+        if (big < _min_largest) {
+            _min_largest = big;
+            _frag_at_min = _free_bytes ? 100 - uint32_t(uint64_t(big) * 100 / _free_bytes) : 0;
+        }
+    }
+
+    uint32_t _size;
+    uint32_t _free_bytes;
+    uint32_t _min_free = 0;
+    uint32_t _min_largest = 0;
+    uint32_t _frag_at_min = 0;
+    std::map<uint32_t, uint32_t> _by_addr;              // free: addr -> size
+    std::set<std::pair<uint32_t, uint32_t>> _by_size;   // free: (size, addr)
+    std::unordered_map<uint32_t, uint32_t> _used;       // addr -> block size
+};
+
+// ---------------------------------------------------------------------------
+// Slab region model (lib/lv_mem_slab): 1KB pages assigned to one size class
+// on demand and released when empty
+// ---------------------------------------------------------------------------
+class SlabModel {
+public:
+    static constexpr uint32_t PAGE = 1024;
+    static constexpr uint32_t MAX_SIZE = 256;
+
+    explicit SlabModel(uint32_t bytes) : _pages(bytes / PAGE) {
+        _page_class.assign(_pages, -1);
+        _page_used.assign(_pages, 0);
+    }
+
+    // Returns page index, or -1 if the region has no room
+    int alloc(uint32_t size) {
+        int cls = classFor(size);
+        if (cls < 0) return -1;
+        int spare = -1;
+        for (int p = 0; p < int(_pages); p++) {
+            if (_page_class[p] == cls && _page_used[p] < PAGE / kClass[cls]) {
+                _page_used[p]++;
+                return p;
+            }
+            if (spare < 0 && _page_class[p] < 0) spare = p;
+        }
+        if (spare < 0) return -1;
+        _page_class[spare] = cls;
+        _page_used[spare] = 1;
+        return spare;
+    }
+
+    void free(int page) {
+        if (--_page_used[page] == 0) _page_class[page] = -1;
+    }
+
+    uint32_t bytes() const { return _pages * PAGE; }
+
+private:
+    static constexpr uint16_t kClass[8] = {16, 32, 48, 64, 96, 128, 192, 256};
+    static int classFor(uint32_t size) {
+        for (int c = 0; c < 8; c++) if (size && size <= kClass[c]) return c;
+        return -1;
+    }
+    uint32_t _pages;
+    std::vector<int> _page_class;
+    std::vector<uint32_t> _page_used;
+};
+constexpr uint16_t SlabModel::kClass[8];
+
+// ---------------------------------------------------------------------------
+// BytesPool model: fixed slots per tier up to the growth ceilings, storage
+// outside both heaps (the real pool keeps slot buffers in PSRAM)
+// ---------------------------------------------------------------------------
+class PoolModel {
+public:
+    PoolModel() {
+        using namespace RNS::BytesPoolConfig;
+        _tiers = {{TIER_TINY, TINY_MAX_SLOTS}, {TIER_SMALL, SMALL_MAX_SLOTS},
+                  {TIER_MEDIUM, MEDIUM_MAX_SLOTS}, {TIER_LARGE, LARGE_MAX_SLOTS},
+                  {TIER_XL, XL_MAX_SLOTS}, {TIER_XXL, XXL_MAX_SLOTS}};
+    }
+
+    // Returns tier index, or -1 on a miss
+    int alloc(uint32_t size) {
+        for (size_t t = 0; t < _tiers.size(); t++) {
+            Tier& tier = _tiers[t];
+            if (size > tier.capacity) continue;
+            if (tier.in_use >= tier.slots) { _misses++; return -1; }
+            tier.in_use++;
+            return int(t);
+        }
+        return -1;
+    }
+    void free(int tier) { _tiers[tier].in_use--; }
+    uint32_t misses() const { return _misses; }
+
+private:
+    struct Tier { size_t capacity; size_t slots; size_t in_use = 0;
+                  Tier(size_t c, size_t s) : capacity(c), slots(s) {} };
+    std::vector<Tier> _tiers;
+    uint32_t _misses = 0;
+};
+
+// ---------------------------------------------------------------------------
+// Policy
+// ---------------------------------------------------------------------------
+struct Policy {
+    std::string name;
+    uint32_t psram_threshold = 0;   // 0 = baseline routing
+    uint32_t slab_bytes = 0;
+    bool bytespool = false;
+};
+
+bool parsePolicy(const std::string& spec, Policy& out) {
+    out = Policy();
+    out.name = spec;
+    size_t start = 0;
+    while (start <= spec.size()) {
+        size_t end = spec.find('+', start);
+        if (end == std::string::npos) end = spec.size();
+        std::string part = spec.substr(start, end - start);
+        if (part == "baseline") {
+        } else if (part == "bytespool") {
+            out.bytespool = true;
+        } else if (part.rfind("psram:", 0) == 0) {
+            out.psram_threshold = uint32_t(strtoul(part.c_str() + 6, nullptr, 0));
+        } else if (part.rfind("slab:", 0) == 0) {
+            out.slab_bytes = uint32_t(strtoul(part.c_str() + 5, nullptr, 0));
+        } else {
+            return false;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+enum class Where : uint8_t { INTERNAL, SPIRAM, SLAB, POOL };
+
+struct Live {
+    Where where;
+    uint32_t addr;   // heap address, slab page or pool tier
+};
+
+struct Result {
+    uint32_t allocs = 0;
+    uint32_t frees = 0;
+    uint32_t unknown_frees = 0;
+    uint32_t failures = 0;
+    uint32_t low_block_ops = 0;
+    uint32_t slab_hits = 0;
+    uint32_t pool_hits = 0;
+    uint32_t pool_misses = 0;
+    uint32_t internal_peak_used = 0;
+    uint32_t internal_min_free = 0;
+    uint32_t internal_min_largest = 0;
+    uint32_t internal_frag_at_min = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> marks;   // (mark id, internal largest)
+};
+
+bool inPsramWindow(uint32_t ptr) {
+    return ptr >= PSRAM_ADDR_LO && ptr < PSRAM_ADDR_HI;
+}
+
+void releasePlacement(const Live& l, TlsfModel& internal, TlsfModel& spiram,
+                      SlabModel& slab, PoolModel& pool) {
+    switch (l.where) {
+        case Where::INTERNAL: internal.free(l.addr); break;
+        case Where::SPIRAM: spiram.free(l.addr); break;
+        case Where::SLAB: slab.free(int(l.addr)); break;
+        case Where::POOL: pool.free(int(l.addr)); break;
+    }
+}
+
+Result replay(const std::vector<AllocTraceRecord>& records, const Policy& policy,
+              uint32_t internal_size, uint32_t spiram_size) {
+    uint32_t slab_bytes = std::min(policy.slab_bytes, internal_size);
+    TlsfModel internal(internal_size - slab_bytes);
+    TlsfModel spiram(spiram_size);
+    SlabModel slab(slab_bytes);
+    PoolModel pool;
+    std::unordered_map<uint32_t, Live> live;   // trace ptr -> model placement
+    Result r;
+
+    for (const AllocTraceRecord& rec : records) {
+        uint8_t op = rec.op();
+        if (op == ALLOC_TRACE_OP_MARK) {
+            r.marks.push_back({rec.size(), internal.largest()});
+            continue;
+        }
+        if (op == ALLOC_TRACE_OP_FREE) {
+            auto it = live.find(rec.ptr);
+            if (it == live.end()) { r.unknown_frees++; continue; }
+            releasePlacement(it->second, internal, spiram, slab, pool);
+            live.erase(it);
+            r.frees++;
+            continue;
+        }
+        if (op != ALLOC_TRACE_OP_ALLOC) continue;
+
+        r.allocs++;
+        uint32_t size = rec.size();
+        uint8_t caps = rec.caps();
+        bool must_internal = caps & (ALLOC_TRACE_CAPS_INTERNAL | ALLOC_TRACE_CAPS_DMA);
+        bool must_spiram = caps & ALLOC_TRACE_CAPS_SPIRAM;
+        bool is_default = !must_internal && !must_spiram;
+        Live placed{Where::INTERNAL, UINT32_MAX};
+
+        // Candidate layers first; each falls through on a miss
+        if (policy.slab_bytes && !must_spiram && size <= SlabModel::MAX_SIZE) {
+            int page = slab.alloc(size);
+            if (page >= 0) { placed = {Where::SLAB, uint32_t(page)}; r.slab_hits++; }
+        }
+        if (placed.addr == UINT32_MAX && policy.bytespool && is_default &&
+            size <= RNS::BytesPoolConfig::TIER_XXL) {
+            int tier = pool.alloc(size);
+            if (tier >= 0) { placed = {Where::POOL, uint32_t(tier)}; r.pool_hits++; }
+        }
+
+        if (placed.addr == UINT32_MAX) {
+            bool want_spiram;
+            if (must_spiram) want_spiram = true;
+            else if (must_internal) want_spiram = false;
+            else if (policy.psram_threshold) want_spiram = size > policy.psram_threshold;
+            else if (rec.ptr) want_spiram = inPsramWindow(rec.ptr);
+            else want_spiram = size > DEFAULT_ALWAYS_INTERNAL;
+
+            TlsfModel& first = want_spiram ? spiram : internal;
+            uint32_t addr = first.alloc(size);
+            Where where = want_spiram ? Where::SPIRAM : Where::INTERNAL;
+            if (addr == UINT32_MAX && is_default) {
+                // IDF default malloc tries the other heap before failing
+                TlsfModel& second = want_spiram ? internal : spiram;
+                addr = second.alloc(size);
+                where = want_spiram ? Where::INTERNAL : Where::SPIRAM;
+            }
+            if (addr == UINT32_MAX) {
+                r.failures++;
+            } else {
+                placed = {where, addr};
+            }
+        }
+
+        if (placed.addr != UINT32_MAX && !rec.ptr) {
+            // Failed on the device: the caller got nothing, so nothing stays live
+            releasePlacement(placed, internal, spiram, slab, pool);
+        } else if (placed.addr != UINT32_MAX) {
+            // A stale entry means the device reused the address after a free
+            // the trace dropped; release the old placement first
+            auto it = live.find(rec.ptr);
+            if (it != live.end()) releasePlacement(it->second, internal, spiram, slab, pool);
+            live[rec.ptr] = placed;
+        }
+        uint32_t used = internal.size() - internal.freeBytes();
+        if (used > r.internal_peak_used) r.internal_peak_used = used;
+        if (internal.largest() < LOW_BLOCK_THRESHOLD) r.low_block_ops++;
+    }
+
+    r.pool_misses = pool.misses();
+    r.internal_min_free = internal.minFree();
+    r.internal_min_largest = internal.minLargest();
+    r.internal_frag_at_min = internal.fragAtMin();
+    return r;
+}
+
+void printCallers(const std::vector<AllocTraceRecord>& records, size_t top) {
+    // Internal-heap allocations by caller PC (baseline routing)
+    struct Stat { uint32_t count = 0; uint64_t bytes = 0; };
+    std::unordered_map<uint32_t, Stat> by_caller;
+    for (const AllocTraceRecord& rec : records) {
+        if (rec.op() != ALLOC_TRACE_OP_ALLOC || !rec.ptr || inPsramWindow(rec.ptr)) continue;
+        Stat& s = by_caller[rec.caller];
+        s.count++;
+        s.bytes += rec.size();
+    }
+    std::vector<std::pair<uint32_t, Stat>> sorted(by_caller.begin(), by_caller.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.count != b.second.count ? a.second.count > b.second.count
+                                                : a.first < b.first;
+    });
+    printf("\ntop internal-heap callers (resolve with xtensa-esp32s3-elf-addr2line -e firmware.elf):\n");
+    printf("%-12s %10s %12s\n", "caller", "allocs", "bytes");
+    for (size_t i = 0; i < sorted.size() && i < top; i++) {
+        printf("0x%08" PRIx32 "   %10" PRIu32 " %12" PRIu64 "\n", sorted[i].first,
+               sorted[i].second.count, sorted[i].second.bytes);
+    }
+}
+
+int usage() {
+    fprintf(stderr,
+            "usage: alloc_replay trace.atrace [policy ...] [--internal BYTES] "
+            "[--spiram BYTES] [--callers N]\n"
+            "policies: baseline, psram:<N>, slab:<BYTES>, bytespool (combine with '+')\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage();
+
+    const char* path = nullptr;
+    std::vector<Policy> policies;
+    uint32_t internal_size = 0;
+    uint32_t spiram_size = 0;
+    size_t callers = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if ((arg == "--internal" || arg == "--spiram" || arg == "--callers") && i + 1 < argc) {
+            unsigned long v = strtoul(argv[++i], nullptr, 0);
+            if (arg == "--internal") internal_size = uint32_t(v);
+            else if (arg == "--spiram") spiram_size = uint32_t(v);
+            else callers = v;
+        } else if (!path) {
+            path = argv[i];
+        } else {
+            Policy p;
+            if (!parsePolicy(arg, p)) {
+                fprintf(stderr, "unknown policy: %s\n", arg.c_str());
+                return usage();
+            }
+            policies.push_back(p);
+        }
+    }
+    if (!path) return usage();
+    if (policies.empty()) {
+        Policy p;
+        parsePolicy("baseline", p);
+        policies.push_back(p);
+    }
+
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    AllocTraceHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || header.magic != ALLOC_TRACE_MAGIC ||
+        header.version != ALLOC_TRACE_VERSION || header.record_size != sizeof(AllocTraceRecord)) {
+        fprintf(stderr, "%s: not an allocation trace (bad header)\n", path);
+        fclose(f);
+        return 1;
+    }
+    std::vector<AllocTraceRecord> records(header.count);
+    size_t got = header.count ? fread(records.data(), sizeof(AllocTraceRecord), header.count, f) : 0;
+    fclose(f);
+    if (got != header.count) {
+        fprintf(stderr, "%s: truncated (%zu of %" PRIu32 " records)\n", path, got, header.count);
+        records.resize(got);
+    }
+
+    if (!internal_size) internal_size = header.internal_free;
+    if (!spiram_size) spiram_size = header.spiram_free;
+
+    // Unwrap the 32-bit timestamps for the duration line
+    uint64_t span_us = 0;
+    for (size_t i = 1; i < records.size(); i++) {
+        span_us += uint32_t(records[i].time_us - records[i - 1].time_us);
+    }
+
+    printf("trace: %zu records (%" PRIu32 " dropped), %.1f s, internal %" PRIu32
+           " B, spiram %" PRIu32 " B\n",
+           records.size(), header.dropped, span_us / 1e6, internal_size, spiram_size);
+    if (header.dropped) {
+        printf("note: ring overflowed; frees of allocations made before the first record are ignored\n");
+    }
+
+    printf("\n%-28s %8s %6s %6s %9s %9s %9s %5s %6s %8s %8s\n", "policy", "allocs", "fail",
+           "unk", "peak_used", "min_free", "min_big", "frag", "low%", "slab", "pool");
+    std::vector<Result> results;
+    for (const Policy& p : policies) {
+        Result r = replay(records, p, internal_size, spiram_size);
+        double low_pct = r.allocs ? 100.0 * r.low_block_ops / r.allocs : 0.0;
+        printf("%-28s %8" PRIu32 " %6" PRIu32 " %6" PRIu32 " %9" PRIu32 " %9" PRIu32
+               " %9" PRIu32 " %4" PRIu32 "%% %5.1f%% %8" PRIu32 " %8" PRIu32 "\n",
+               p.name.c_str(), r.allocs, r.failures, r.unknown_frees, r.internal_peak_used,
+               r.internal_min_free, r.internal_min_largest, r.internal_frag_at_min, low_pct,
+               r.slab_hits, r.pool_hits);
+        results.push_back(r);
+    }
+
+    // Device-side events with the modelled internal max block at that point,
+    // e.g. to check the model predicts the announce skips the device logged
+    bool any_marks = false;
+    for (size_t i = 0; i < results.size(); i++) {
+        for (const auto& m : results[i].marks) {
+            if (m.first == ALLOC_TRACE_MARK_START) continue;
+            if (!any_marks) printf("\nmarks (internal max block per policy):\n");
+            any_marks = true;
+            printf("  %-28s mark=%-5" PRIu32 " max_block=%" PRIu32 "\n",
+                   policies[i].name.c_str(), m.first, m.second);
+        }
+    }
+
+    if (callers) printCallers(records, callers);
+    return 0;
+}
@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Pull an allocation trace off a tdeck-alloctrace build into a .atrace file.
+
+Serial (reliable, ~1 min for a full 512KB ring at 115200):
+    python3 capture_alloc_trace.py --port /dev/cu.usbmodem101 -o boot.atrace
+
+UDP (fast; the device sends to the harness host, else multicast 239.0.99.99:9997):
+    python3 capture_alloc_trace.py --port /dev/cu.usbmodem101 --udp -o boot.atrace
+
+The output is AllocTraceHeader + records exactly as alloc_replay reads them
+(see lib/microreticulum-shim/Instrumentation/AllocTraceFormat.h).
+"""
+import argparse
+import socket
+import struct
+import sys
+import time
+
+MAGIC = 0x43525441
+VERSION = 1
+RECORD_SIZE = 16
+HEADER = struct.Struct("<IHHIIII")
+UDP_PORT = 9997
+
+
+def build_header(count, dropped, internal_free, spiram_free):
+    return HEADER.pack(MAGIC, VERSION, RECORD_SIZE, count, dropped, internal_free, spiram_free)
+
+
+def parse_serial_dump(lines):
+    """Decode the ATRACE_BEGIN ... ATRACE_END block from T:ALLOCTRACE dump.
+
+    Lines outside the block (logs interleaved before it) are skipped. Raises
+    ValueError on a missing block, short data or checksum mismatch.
+    """
+    it = iter(lines)
+    for line in it:
+        line = line.strip()
+        if line.startswith("ATRACE_BEGIN"):
+            fields = [int(x) for x in line.split()[1:6]]
+            if len(fields) != 5:
+                raise ValueError(f"bad ATRACE_BEGIN line: {line!r}")
+            count, dropped, internal_free, spiram_free, checksum = fields
+            break
+    else:
+        raise ValueError("no ATRACE_BEGIN in dump")
+
+    data = bytearray()
+    for line in it:
+        line = line.strip()
+        if line == "ATRACE_END":
+            break
+        if line and all(c in "0123456789ABCDEFabcdef" for c in line):
+            data += bytes.fromhex(line)
+    else:
+        raise ValueError("dump ended before ATRACE_END")
+
+    if len(data) != count * RECORD_SIZE:
+        raise ValueError(f"expected {count * RECORD_SIZE} bytes, got {len(data)}")
+    if sum(data) & 0xFFFFFFFF != checksum:
+        raise ValueError("checksum mismatch")
+    return build_header(count, dropped, internal_free, spiram_free) + bytes(data)
+
+
+def reassemble_udp(datagrams):
+    """Rebuild the trace from [uint32 LE offset][payload] datagrams.
+
+    Returns the trace bytes, or None while the header or any range is missing.
+    """
+    chunks = {}
+    for d in datagrams:
+        if len(d) < 4:
+            continue
+        chunks[struct.unpack_from("<I", d)[0]] = d[4:]
+    if 0 not in chunks or len(chunks[0]) < HEADER.size:
+        return None
+    magic, _version, record_size, count = HEADER.unpack_from(chunks[0])[:4]
+    if magic != MAGIC or record_size != RECORD_SIZE:
+        raise ValueError("bad trace header")
+    total = HEADER.size + count * RECORD_SIZE
+    out = bytearray()
+    while len(out) < total:
+        part = chunks.get(len(out))
+        if not part:
+            return None
+        out += part
+    return bytes(out[:total])
+
+
+def capture_serial(port, timeout):
+    import serial  # pyserial
+
+    with serial.Serial(port, 115200, timeout=1) as s:
+        s.reset_input_buffer()
+        s.write(b"T:ALLOCTRACE dump\n")
+        lines = []
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            line = s.readline().decode(errors="replace")
+            if line:
+                lines.append(line)
+                if line.strip() == "ATRACE_END":
+                    break
+        return parse_serial_dump(lines)
+
+
+def capture_udp(port, timeout):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 * 1024 * 1024)
+    sock.bind(("", UDP_PORT))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP,
+                    struct.pack("=4sl", socket.inet_aton("239.0.99.99"), socket.INADDR_ANY))
+    sock.settimeout(1.0)
+
+    if port:
+        import serial  # pyserial
+
+        with serial.Serial(port, 115200, timeout=1) as s:
+            s.write(b"T:ALLOCTRACE udp\n")
+
+    datagrams = []
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        try:
+            datagrams.append(sock.recv(2048))
+        except socket.timeout:
+            if datagrams:
+                break
+            continue
+        trace = reassemble_udp(datagrams)
+        if trace:
+            return trace
+    trace = reassemble_udp(datagrams)
+    if trace is None:
+        raise ValueError(f"incomplete UDP dump ({len(datagrams)} datagrams); retry or use serial")
+    return trace
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--port", help="device serial port (sends the dump command)")
+    ap.add_argument("--udp", action="store_true", help="receive the dump over UDP :9997")
+    ap.add_argument("--timeout", type=float, default=180.0)
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    if not args.udp and not args.port:
+        ap.error("--port is required for a serial dump")
+    trace = capture_udp(args.port, args.timeout) if args.udp else capture_serial(args.port, args.timeout)
+
+    with open(args.output, "wb") as f:
+        f.write(trace)
+    count = (len(trace) - HEADER.size) // RECORD_SIZE
+    print(f"wrote {args.output}: {count} records", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
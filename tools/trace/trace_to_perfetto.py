@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""Convert a T:TRACE dump from a tdeck-trace build to Chrome/Perfetto JSON.
+
+Capture from the device and convert in one go (needs pyserial):
+    python3 trace_to_perfetto.py --port /dev/cu.usbmodem101 -o trace.json
+
+Keep the raw dump too, or convert a saved one later:
+    python3 trace_to_perfetto.py --port /dev/cu.usbmodem101 --raw run.etrace -o trace.json
+    python3 trace_to_perfetto.py run.etrace -o trace.json
+
+Open the JSON in https://ui.perfetto.dev (or chrome://tracing). Each task is a
+track; spans, instants and counters carry the recording core in their args.
+The binary layout is documented in
+lib/microreticulum-shim/Instrumentation/EventTraceFormat.h.
+"""
+import argparse
+import json
+import struct
+import sys
+import time
+
+MAGIC = 0x43525445
+VERSION = 1
+HEADER = struct.Struct("<IHHIiiHHI")
+RING_HEADER = struct.Struct("<16sII")
+RECORD = struct.Struct("<IIHBBi")
+
+BEGIN, END, INSTANT, COUNTER = 1, 2, 3, 4
+
+
+def extract_serial_dump(data):
+    """Pull the raw dump out of serial output from T:TRACE dump.
+
+    The block is `ETRACE_BEGIN <bytes> <byte_sum>\\n`, exactly <bytes> of binary,
+    then `\\nETRACE_END`. Anything before it (log lines) is skipped. Raises
+    ValueError on a missing block, short data or checksum mismatch.
+    """
+    start = data.find(b"ETRACE_BEGIN ")
+    if start < 0:
+        raise ValueError("no ETRACE_BEGIN in dump")
+    eol = data.find(b"\n", start)
+    if eol < 0:
+        raise ValueError("truncated ETRACE_BEGIN line")
+    fields = data[start:eol].split()[1:3]
+    if len(fields) != 2:
+        raise ValueError(f"bad ETRACE_BEGIN line: {data[start:eol]!r}")
+    size, checksum = (int(x) for x in fields)
+    body = data[eol + 1:eol + 1 + size]
+    if len(body) != size:
+        raise ValueError(f"expected {size} bytes, got {len(body)}")
+    if sum(body) & 0xFFFFFFFF != checksum:
+        raise ValueError("checksum mismatch")
+    return bytes(body)
+
+
+def parse_dump(blob):
+    """Decode a raw dump into header fields, the name table and per-ring records."""
+    if len(blob) < HEADER.size:
+        raise ValueError("dump shorter than its header")
+    (magic, version, record_size, cpu_mhz, off0, off1,
+     name_count, ring_count, lost) = HEADER.unpack_from(blob, 0)
+    if magic != MAGIC or version != VERSION or record_size != RECORD.size:
+        raise ValueError("bad trace header")
+    if cpu_mhz == 0:
+        raise ValueError("trace header has no CPU frequency")
+    pos = HEADER.size
+
+    names = []
+    for _ in range(name_count):
+        n = blob[pos]
+        names.append(blob[pos + 1:pos + 1 + n].decode(errors="replace"))
+        pos += 1 + n
+
+    rings = []
+    for _ in range(ring_count):
+        task, count, dropped = RING_HEADER.unpack_from(blob, pos)
+        pos += RING_HEADER.size
+        end = pos + count * RECORD.size
+        if end > len(blob):
+            raise ValueError("dump ends inside a ring")
+        records = [RECORD.unpack_from(blob, p) for p in range(pos, end, RECORD.size)]
+        pos = end
+        rings.append({
+            "task": task.split(b"\0", 1)[0].decode(errors="replace"),
+            "dropped": dropped,
+            "records": records,
+        })
+
+    return {
+        "cpu_mhz": cpu_mhz,
+        "core_offset": (off0, off1),
+        "lost": lost,
+        "names": names,
+        "rings": rings,
+    }
+
+
+def timestamp_us(trace, cycles, tick_ms, core):
+    """Microseconds on core 0's cycle timebase, with the 32-bit wrap undone.
+
+    The millisecond tick is wrap-free but coarse; it picks which multiple of
+    2^32 cycles the counter has wrapped, the cycles give the precision.
+    """
+    mhz = trace["cpu_mhz"]
+    c = (cycles + trace["core_offset"][core & 1]) & 0xFFFFFFFF
+    estimate = tick_ms * 1000 * mhz
+    wraps = round((estimate - c) / 2**32)
+    return (c + wraps * 2**32) / mhz
+
+
+def to_chrome(trace):
+    """Build the Chrome trace-event JSON object (loadable by Perfetto)."""
+    names = trace["names"]
+
+    def name_of(i):
+        return names[i] if i < len(names) else f"event{i}"
+
+    events = [{"ph": "M", "pid": 1, "name": "process_name", "args": {"name": "pyxis"}}]
+    timed = []
+    for tid, ring in enumerate(trace["rings"], start=1):
+        label = ring["task"] or f"ring{tid}"
+        if ring["dropped"]:
+            label += f" ({ring['dropped']} older events overwritten)"
+        events.append({"ph": "M", "pid": 1, "tid": tid, "name": "thread_name",
+                       "args": {"name": label}})
+
+        open_spans = {}
+        for cycles, tick_ms, name, etype, core, value in ring["records"]:
+            ts = timestamp_us(trace, cycles, tick_ms, core)
+            ev = {"pid": 1, "tid": tid, "ts": ts, "name": name_of(name)}
+            if etype == BEGIN:
+                open_spans[name] = open_spans.get(name, 0) + 1
+                ev.update(ph="B", args={"value": value, "core": core})
+            elif etype == END:
+                # The ring may have overwritten this span's BEGIN
+                if not open_spans.get(name):
+                    continue
+                open_spans[name] -= 1
+                ev.update(ph="E")
+            elif etype == INSTANT:
+                ev.update(ph="i", s="t", args={"value": value, "core": core})
+            elif etype == COUNTER:
+                ev.update(ph="C", args={"value": value})
+            else:
+                continue
+            timed.append(ev)
+
+    if timed:
+        t0 = min(ev["ts"] for ev in timed)
+        for ev in timed:
+            ev["ts"] = round(ev["ts"] - t0, 3)
+    return {
+        "traceEvents": events + timed,
+        "displayTimeUnit": "ns",
+        "otherData": {"cpu_mhz": trace["cpu_mhz"], "lost": trace["lost"]},
+    }
+
+
+def capture_serial(port, timeout):
+    import serial  # pyserial
+
+    with serial.Serial(port, 115200, timeout=1) as s:
+        s.reset_input_buffer()
+        s.write(b"T:TRACE dump\n")
+        data = bytearray()
+        deadline = time.time() + timeout
+        while time.time() < deadline:
+            data += s.read(4096)
+            start = data.find(b"ETRACE_BEGIN ")
+            if start >= 0 and data.find(b"ETRACE_END", start) >= 0:
+                # The end marker can also occur inside the binary; only stop
+                # once the announced byte count is in.
+                try:
+                    return extract_serial_dump(bytes(data))
+                except ValueError:
+                    pass
+        return extract_serial_dump(bytes(data))
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("input", nargs="?", help="raw dump file (.etrace) to convert")
+    ap.add_argument("--port", help="device serial port (sends T:TRACE dump)")
+    ap.add_argument("--raw", help="also save the raw dump here")
+    ap.add_argument("--timeout", type=float, default=120.0)
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    if bool(args.input) == bool(args.port):
+        ap.error("give either a dump file or --port")
+    if args.port:
+        blob = capture_serial(args.port, args.timeout)
+    else:
+        with open(args.input, "rb") as f:
+            blob = f.read()
+    if args.raw:
+        with open(args.raw, "wb") as f:
+            f.write(blob)
+
+    trace = parse_dump(blob)
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(trace), f)
+    count = sum(len(r["records"]) for r in trace["rings"])
+    print(f"wrote {args.output}: {count} events from {len(trace['rings'])} tasks"
+          f" ({trace['lost']} lost)", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()